@@ -157,3 +157,14 @@ IF(ENABLE_STRICT_COMPILE)
 ENDIF(ENABLE_STRICT_COMPILE)
 MARK_AS_ADVANCED(STRICT_FLAGS)
 
+# CHECK_C_FLAG_GATHER does not pass the flag to the linker, so it
+# rejects -fsanitize=thread.  The flags are set without a check.
+IF(ENABLE_THREAD_SANITIZER)
+	SET(TSAN_FLAGS "-fsanitize=thread -fno-omit-frame-pointer")
+	SET(CMAKE_C_FLAGS "${CMAKE_C_FLAGS} ${TSAN_FLAGS}")
+	SET(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} ${TSAN_FLAGS}")
+	SET(CMAKE_EXE_LINKER_FLAGS "${CMAKE_EXE_LINKER_FLAGS} ${TSAN_FLAGS}")
+	SET(CMAKE_SHARED_LINKER_FLAGS "${CMAKE_SHARED_LINKER_FLAGS} ${TSAN_FLAGS}")
+ENDIF(ENABLE_THREAD_SANITIZER)
+MARK_AS_ADVANCED(TSAN_FLAGS)
+
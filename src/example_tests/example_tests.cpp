@@ -0,0 +1,56 @@
+#include "../opennurbs.h"
+#include "example_tests.h"
+
+static int g_check_count = 0;
+static int g_failed_count = 0;
+
+void Check( bool bPassed, const char* description )
+{
+  g_check_count++;
+  if ( !bPassed )
+    g_failed_count++;
+  printf("%s %s\n", bPassed ? "passed" : "FAILED", description);
+}
+
+bool IsNear( double a, double b, double tolerance )
+{
+  return fabs(a-b) <= tolerance*(1.0 + fabs(b));
+}
+
+int CheckSummary()
+{
+  printf("%d of %d checks failed\n",g_failed_count,g_check_count);
+  return g_failed_count;
+}
+
+// Quad mesh of a torus.  The grid is welded where it wraps around,
+// so the mesh is closed, oriented and manifold.
+ON_Mesh* MakeTorusMesh( int u_count, int v_count )
+{
+  const double R = 4.0;
+  const double r = 1.0;
+  ON_Mesh* mesh = new ON_Mesh(u_count*v_count,u_count*v_count,false,false);
+  int i, j;
+  for ( i = 0; i < u_count; i++ )
+  {
+    const double a = 2.0*ON_PI*i/u_count;
+    for ( j = 0; j < v_count; j++ )
+    {
+      const double b = 2.0*ON_PI*j/v_count;
+      mesh->SetVertex( i*v_count+j, ON_3dPoint( (R + r*cos(b))*cos(a), (R + r*cos(b))*sin(a), r*sin(b) ) );
+    }
+  }
+  for ( i = 0; i < u_count; i++ )
+  {
+    for ( j = 0; j < v_count; j++ )
+    {
+      mesh->SetQuad( i*v_count+j,
+                     i*v_count+j,
+                     ((i+1)%u_count)*v_count+j,
+                     ((i+1)%u_count)*v_count+(j+1)%v_count,
+                     i*v_count+(j+1)%v_count );
+    }
+  }
+  mesh->ComputeVertexNormals();
+  return mesh;
+}
@@ -0,0 +1,38 @@
+/*
+Helpers shared by the test programs in this directory.  Each program
+checks results against values that are known exactly, prints one
+line per check and returns the number of failed checks.
+*/
+
+#if !defined(OPENNURBS_EXAMPLE_TESTS_INC_)
+#define OPENNURBS_EXAMPLE_TESTS_INC_
+
+/*
+Description:
+  Count a check and print "passed" or "FAILED" and its description.
+*/
+void Check( bool bPassed, const char* description );
+
+/*
+Returns:
+  True if |a-b| <= tolerance*(1+|b|).
+*/
+bool IsNear( double a, double b, double tolerance );
+
+/*
+Description:
+  Print the number of failed checks.
+Returns:
+  Number of failed checks.
+*/
+int CheckSummary();
+
+/*
+Returns:
+  A quad mesh of a torus.  The grid is welded where it wraps
+  around, so the mesh is closed, oriented and manifold.
+  The caller must delete the mesh.
+*/
+ON_Mesh* MakeTorusMesh( int u_count, int v_count );
+
+#endif
@@ -0,0 +1,103 @@
+// uncomment the "ON_DLL_IMPORTS" define to use opennurbs as a Windows DLL
+//#define ON_DLL_IMPORTS
+#include "../opennurbs.h"
+#include "../examples_linking_pragmas.h"
+#include "example_tests.h"
+
+// This program checks arc length tables against curves whose
+// lengths are known exactly.
+
+///////////////////////////////////////////////////////////////////////
+//
+// Arc length
+//
+
+static void TestArcLength()
+{
+  const double r = 3.0;
+  ON_Circle circle(ON_xy_plane,r);
+
+  // Rational NURBS circle.  ON_NurbsCurve uses the arc length table.
+  ON_NurbsCurve nurbs_circle;
+  circle.GetNurbForm(nurbs_circle);
+  double length = 0.0;
+  Check( nurbs_circle.GetLength(&length) && IsNear(length,2.0*ON_PI*r,1.0e-10),
+         "arc length of a NURBS circle is 2 pi r" );
+
+  // Quarter of the length is at a quarter of the angle.
+  double t = ON_UNSET_VALUE;
+  int i;
+  Check(    nurbs_circle.GetNormalizedArcLengthPoint(0.25,&t)
+         && nurbs_circle.PointAt(t).DistanceTo(circle.PointAt(0.5*ON_PI)) <= 1.0e-10,
+         "normalized arc length point of a NURBS circle" );
+
+  // The quarter point above is symmetric within a span of the
+  // circle.  These lengths are not.
+  const double a[3] = {0.0625, 0.3, 0.7};
+  for ( i = 0; i < 3; i++ )
+  {
+    const ON_3dPoint P = circle.PointAt(2.0*ON_PI*a[i]);
+    t = ON_UNSET_VALUE;
+    Check(    nurbs_circle.GetNormalizedArcLengthPoint(a[i],&t)
+           && nurbs_circle.PointAt(t).DistanceTo(P) <= 2.0e-8*length,
+           "normalized arc length point of a NURBS circle off a span's midpoint" );
+    t = ON_UNSET_VALUE;
+    Check(    nurbs_circle.GetNormalizedArcLengthPoint(a[i],&t,1.0e-10)
+           && nurbs_circle.PointAt(t).DistanceTo(P) <= 2.0e-10*length,
+           "normalized arc length point of a NURBS circle with a tight tolerance" );
+  }
+
+  // Length of part of the circle.
+  const ON_Interval d = nurbs_circle.Domain();
+  const ON_Interval sub_domain(d[0],d.ParameterAt(0.5));
+  Check( nurbs_circle.GetLength(&length,1.0e-8,&sub_domain) && length > 0.0 && length < 2.0*ON_PI*r,
+         "arc length of part of a NURBS circle" );
+
+  // A cubic with unevenly spaced control points on a line.  Its 
+  // speed is not constant but its length is the line's length.
+  ON_NurbsCurve line(3,false,4,6);
+  line.MakeClampedUniformKnotVector();
+  const double x[6] = {0.0, 0.1, 0.2, 5.0, 9.0, 10.0};
+  for ( i = 0; i < 6; i++ )
+    line.SetCV(i,ON_3dPoint(x[i],0.0,0.0));
+  Check( line.GetLength(&length) && IsNear(length,10.0,1.0e-10),
+         "arc length of an unevenly parameterized line" );
+
+  // The table's fractional tolerance is 1e-8, so the points may
+  // be off by about 1e-8 times the length.
+  double s[5] = {0.0, 0.25, 0.5, 0.75, 1.0};
+  double ts[5];
+  bool bOnLine = line.GetNormalizedArcLengthPoints(5,s,ts);
+  for ( i = 0; bOnLine && i < 5; i++ )
+  {
+    if ( fabs(line.PointAt(ts[i]).x - 10.0*s[i]) > 2.0e-8*10.0 )
+      bOnLine = false;
+  }
+  Check( bOnLine, "normalized arc length points of an unevenly parameterized line" );
+
+  // Closed curve: the table spans the whole periodic domain.
+  ON_NurbsCurve periodic;
+  ON_3dPoint P[4] = { ON_3dPoint(0,0,0), ON_3dPoint(1,0,0), ON_3dPoint(1,1,0), ON_3dPoint(0,1,0) };
+  periodic.CreatePeriodicUniformNurbs(3,2,4,P);
+  const ON_CurveArcLengthTable* table = periodic.ArcLengthTable();
+  Check(    periodic.IsClosed() 
+         && 0 != table 
+         && table->Domain() == periodic.Domain()
+         && periodic.GetLength(&length) 
+         && IsNear(length,table->Length(),1.0e-12)
+         && IsNear(table->LengthAt(periodic.Domain()[1]),length,1.0e-12),
+         "arc length table of a closed curve" );
+}
+
+int main()
+{
+  ON::Begin();
+
+  TestArcLength();
+
+  const int failed_count = CheckSummary();
+
+  ON::End();
+
+  return failed_count;
+}
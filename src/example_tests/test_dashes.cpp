@@ -0,0 +1,126 @@
+// uncomment the "ON_DLL_IMPORTS" define to use opennurbs as a Windows DLL
+//#define ON_DLL_IMPORTS
+#include "../opennurbs.h"
+#include "../examples_linking_pragmas.h"
+#include "example_tests.h"
+
+// This program checks ON_Linetype::GetCurveDashes() on lines and
+// circles, where the dash positions are known exactly.
+
+///////////////////////////////////////////////////////////////////////
+//
+// Linetype dashes
+//
+
+static void TestDashes()
+{
+  ON_Linetype linetype;
+  ON_LinetypeSegment dash;
+  dash.m_length = 1.0;
+  dash.m_seg_type = ON_LinetypeSegment::stLine;
+  ON_LinetypeSegment gap;
+  gap.m_length = 0.5;
+  gap.m_seg_type = ON_LinetypeSegment::stSpace;
+  linetype.AppendSegment(dash);
+  linetype.AppendSegment(gap);
+
+  ON_LineCurve line(ON_3dPoint(0.0,0.0,0.0),ON_3dPoint(10.0,0.0,0.0));
+  ON_SimpleArray<ON_Interval> intervals;
+  ON_ClassArray<ON_Polyline> polylines;
+  bool rc = linetype.GetCurveDashes(line,1.0,1.0e-6,&intervals,&polylines);
+  // dashes start at 0, 1.5, 3, ..., 9 and the last one is cut at 10
+  bool bExact = (rc && 7 == intervals.Count() && 7 == polylines.Count());
+  int i;
+  for ( i = 0; bExact && i < 7; i++ )
+  {
+    const double x0 = 1.5*i;
+    const double x1 = (i < 6) ? x0 + 1.0 : 10.0;
+    if (    !IsNear(line.PointAt(intervals[i][0]).x,x0,1.0e-9) 
+         || !IsNear(line.PointAt(intervals[i][1]).x,x1,1.0e-9) )
+      bExact = false;
+  }
+  Check( bExact, "dashes of a line" );
+
+  // A zero length dash is a dot.
+  ON_Linetype dots;
+  ON_LinetypeSegment dot;
+  dot.m_length = 0.0;
+  dot.m_seg_type = ON_LinetypeSegment::stLine;
+  dots.AppendSegment(dot);
+  dots.AppendSegment(gap);
+  intervals.SetCount(0);
+  polylines.SetCount(0);
+  rc = dots.GetCurveDashes(line,1.0,1.0e-6,&intervals,&polylines);
+  bool bDots = (rc && 21 == intervals.Count() && 21 == polylines.Count());
+  for ( i = 0; bDots && i < intervals.Count(); i++ )
+  {
+    if ( intervals[i].Length() != 0.0 || 2 != polylines[i].Count() || polylines[i][0] != polylines[i][1] )
+      bDots = false;
+  }
+  Check( bDots, "zero length dashes are dots" );
+
+  // On a circle the dash lengths are arc lengths.
+  ON_ArcCurve circle(ON_Circle(ON_xy_plane,1.0));
+  intervals.SetCount(0);
+  rc = linetype.GetCurveDashes(circle,ON_PI/6.0,1.0e-8,&intervals,0);
+  // pattern length is 1.5*pi/6 = pi/4, so 8 dashes of length pi/6
+  bool bArcs = (rc && 8 == intervals.Count());
+  for ( i = 0; bArcs && i < 8; i++ )
+  {
+    double length = 0.0;
+    if ( !circle.GetLength(&length,1.0e-10,&intervals[i]) || !IsNear(length,ON_PI/6.0,1.0e-6) )
+      bArcs = false;
+  }
+  Check( bArcs, "dashes of a circle have the dash length" );
+
+  // On a large circle with the default tolerance the dashes do 
+  // not drift.  The i-th dash starts at arc length 1.5*i.
+  const double r = 100.0;
+  ON_ArcCurve big_circle(ON_Circle(ON_xy_plane,r));
+  ON_NurbsCurve nurbs_circle;
+  big_circle.GetNurbForm(nurbs_circle);
+  const ON_Curve* curves[2] = {&big_circle,&nurbs_circle};
+  const char* descriptions[2] = 
+  {
+    "dashes of a radius 100 arc curve do not drift",
+    "dashes of a radius 100 NURBS circle do not drift"
+  };
+  int c;
+  for ( c = 0; c < 2; c++ )
+  {
+    const ON_Curve& curve = *curves[c];
+    intervals.SetCount(0);
+    polylines.SetCount(0);
+    rc = linetype.GetCurveDashes(curve,1.0,0.0,&intervals,&polylines);
+    const int dash_count = (int)ceil(2.0*ON_PI*r/1.5);
+    bool bNoDrift = (rc && dash_count == intervals.Count() && dash_count == polylines.Count());
+    for ( i = 0; bNoDrift && i < dash_count; i++ )
+    {
+      const ON_3dPoint P = curve.PointAt(intervals[i][0]);
+      double a = atan2(P.y,P.x);
+      if ( a < 0.0 )
+        a += 2.0*ON_PI;
+      if ( 0 == i )
+        a = 0.0;
+      if (    fabs(r*a - 1.5*i) > 1.0e-5 
+              || polylines[i].Count() < 2
+              || polylines[i][0].DistanceTo(P) > 1.0e-9
+              || polylines[i][polylines[i].Count()-1].DistanceTo(curve.PointAt(intervals[i][1])) > 1.0e-9 )
+        bNoDrift = false;
+    }
+    Check( bNoDrift, descriptions[c] );
+  }
+}
+
+int main()
+{
+  ON::Begin();
+
+  TestDashes();
+
+  const int failed_count = CheckSummary();
+
+  ON::End();
+
+  return failed_count;
+}
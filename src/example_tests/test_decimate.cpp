@@ -0,0 +1,102 @@
+// uncomment the "ON_DLL_IMPORTS" define to use opennurbs as a Windows DLL
+//#define ON_DLL_IMPORTS
+#include "../opennurbs.h"
+#include "../examples_linking_pragmas.h"
+#include "example_tests.h"
+
+// This program checks the results of mesh decimation.
+
+///////////////////////////////////////////////////////////////////////
+//
+// Mesh decimation
+//
+
+// Flat n x n grid of quads in the unit square.
+static ON_Mesh* MakeGridMesh( int n )
+{
+  ON_Mesh* mesh = new ON_Mesh(n*n,(n+1)*(n+1),false,false);
+  int i, j;
+  for ( i = 0; i <= n; i++ )
+  {
+    for ( j = 0; j <= n; j++ )
+      mesh->SetVertex( i*(n+1)+j, ON_3dPoint( ((double)i)/n, ((double)j)/n, 0.0 ) );
+  }
+  for ( i = 0; i < n; i++ )
+  {
+    for ( j = 0; j < n; j++ )
+      mesh->SetQuad( i*n+j, i*(n+1)+j, (i+1)*(n+1)+j, (i+1)*(n+1)+j+1, i*(n+1)+j+1 );
+  }
+  return mesh;
+}
+
+static void TestDecimate()
+{
+  {
+    ON_Mesh* mesh = MakeTorusMesh(48,24);
+    const int target_face_count = 400;
+    const bool rc = mesh->Decimate(target_face_count,0.0,1);
+    const int face_count = mesh->FaceCount();
+    Check( rc, "Decimate() closed torus" );
+    Check( face_count <= target_face_count && face_count >= target_face_count-2,
+           "Decimate() face count is the target face count" );
+    Check( mesh->TriangleCount() == face_count, "Decimate() makes triangles" );
+    Check( mesh->IsValid(), "decimated torus IsValid()" );
+    bool bIsOriented = false;
+    bool bHasBoundary = true;
+    Check( mesh->IsManifold(true,&bIsOriented,&bHasBoundary) && bIsOriented && !bHasBoundary,
+           "decimated torus is an oriented closed manifold" );
+    // Euler characteristic of a torus is 0 and each triangle has
+    // 3 half edges, so V - E + F = V - 3F/2 + F = 0.
+    Check( 2*mesh->VertexCount() == face_count, "decimated torus has genus one" );
+    delete mesh;
+  }
+
+  {
+    ON_Mesh* mesh = MakeTorusMesh(48,24);
+    ON_Mesh* mesh1 = MakeTorusMesh(48,24);
+    mesh->Decimate(600,0.0,1);
+    mesh1->Decimate(600,0.0,4);
+    Check( mesh1->FaceCount() <= 600 && mesh1->IsManifold(true),
+           "Decimate() with several threads keeps the torus manifold" );
+    delete mesh1;
+    delete mesh;
+  }
+
+  {
+    ON_Mesh* mesh = MakeGridMesh(20);
+    const bool rc = mesh->Decimate(0,1.0e-12,1);
+    bool bIsOriented = false;
+    bool bHasBoundary = false;
+    ON_BoundingBox bbox = mesh->BoundingBox();
+    Check( rc && mesh->FaceCount() < 800, "Decimate() flat grid with max_error" );
+    Check( mesh->IsManifold(true,&bIsOriented,&bHasBoundary) && bIsOriented && bHasBoundary,
+           "decimated grid is an oriented manifold with a boundary" );
+    Check( bbox.m_min == ON_3dPoint(0.0,0.0,0.0) && bbox.m_max == ON_3dPoint(1.0,1.0,0.0),
+           "decimated grid keeps its boundary" );
+    double area = 0.0;
+    int fi;
+    for ( fi = 0; fi < mesh->FaceCount(); fi++ )
+    {
+      const ON_MeshFace& f = mesh->m_F[fi];
+      const ON_3fPoint& A = mesh->m_V[f.vi[0]];
+      const ON_3fPoint& B = mesh->m_V[f.vi[1]];
+      const ON_3fPoint& C = mesh->m_V[f.vi[2]];
+      area += 0.5*((B.x-A.x)*(C.y-A.y) - (B.y-A.y)*(C.x-A.x));
+    }
+    Check( IsNear(area,1.0,1.0e-6), "decimated grid keeps its area" );
+    delete mesh;
+  }
+}
+
+int main()
+{
+  ON::Begin();
+
+  TestDecimate();
+
+  const int failed_count = CheckSummary();
+
+  ON::End();
+
+  return failed_count;
+}
@@ -0,0 +1,185 @@
+// uncomment the "ON_DLL_IMPORTS" define to use opennurbs as a Windows DLL
+//#define ON_DLL_IMPORTS
+#include "../opennurbs.h"
+#include "../examples_linking_pragmas.h"
+#include "example_tests.h"
+
+// This program checks the batched NURBS curve and surface
+// evaluators against Evaluate() and checks that using several
+// threads gives the same results as one thread.
+
+static const int der_count = 2;
+
+static void TestCurve( const ON_NurbsCurve& curve, const char* description )
+{
+  ON_String s;
+  const int count = 20000;
+  const int v_size = (der_count+1)*3;
+  const ON_Interval domain = curve.Domain();
+  ON_SimpleArray<double> t(count);
+  int i, k;
+  for ( i = 0; i < count; i++ )
+    t.Append( domain.ParameterAt( (double)i/(count-1) ) );
+
+  ON_SimpleArray<double> v1(count*v_size);
+  ON_SimpleArray<double> v4(count*v_size);
+  v1.SetCount(count*v_size);
+  v4.SetCount(count*v_size);
+  bool rc = curve.EvaluateMany( count, t.Array(), der_count, v1.Array(), 3, 0, 1 );
+  double e[(der_count+1)*3];
+  for ( i = 0; i < count && rc; i++ )
+  {
+    if ( !curve.Evaluate( t[i], der_count, 3, e ) )
+      rc = false;
+    for ( k = 0; k < v_size && rc; k++ )
+    {
+      if ( !IsNear( v1[i*v_size+k], e[k], 1.0e-10 ) )
+        rc = false;
+    }
+  }
+  s = description;
+  s += " EvaluateMany() agrees with Evaluate()";
+  Check( rc, s );
+
+  rc = true;
+  const int thread_count[2] = {4,0};
+  for ( i = 0; i < 2; i++ )
+  {
+    v4.Zero();
+    if (    !curve.EvaluateMany( count, t.Array(), der_count, v4.Array(), 3, 0, thread_count[i] )
+         || 0 != memcmp( v1.Array(), v4.Array(), v1.Count()*sizeof(v1[0]) ) )
+      rc = false;
+  }
+  s = description;
+  s += " EvaluateMany() results do not depend on the thread count";
+  Check( rc, s );
+}
+
+static void TestSurface( const ON_NurbsSurface& surface, const char* description )
+{
+  ON_String str;
+  const int Pcount = ((der_count+1)*(der_count+2))/2;
+  const int v_size = Pcount*3;
+  const int s_count = 150;
+  const int t_count = 100;
+  const int count = s_count*t_count;
+  const ON_Interval sdom = surface.Domain(0);
+  const ON_Interval tdom = surface.Domain(1);
+  ON_SimpleArray<double> s(s_count), t(t_count), ms(count), mt(count);
+  int i, j, k;
+  for ( i = 0; i < s_count; i++ )
+    s.Append( sdom.ParameterAt( (double)i/(s_count-1) ) );
+  for ( j = 0; j < t_count; j++ )
+    t.Append( tdom.ParameterAt( (double)j/(t_count-1) ) );
+  for ( i = 0; i < s_count; i++ )
+  {
+    for ( j = 0; j < t_count; j++ )
+    {
+      ms.Append(s[i]);
+      mt.Append(t[j]);
+    }
+  }
+
+  ON_SimpleArray<double> v1(count*v_size);
+  ON_SimpleArray<double> v4(count*v_size);
+  v1.SetCount(count*v_size);
+  v4.SetCount(count*v_size);
+  bool rc = surface.EvaluateGrid( s_count, s.Array(), t_count, t.Array(), der_count, v1.Array(), 3, 0, 1 );
+  double e[((der_count+1)*(der_count+2))/2*3];
+  for ( i = 0; i < s_count && rc; i++ )
+  {
+    for ( j = 0; j < t_count && rc; j++ )
+    {
+      if ( !surface.Evaluate( s[i], t[j], der_count, 3, e ) )
+        rc = false;
+      for ( k = 0; k < v_size && rc; k++ )
+      {
+        if ( !IsNear( v1[(i*t_count+j)*v_size+k], e[k], 1.0e-10 ) )
+          rc = false;
+      }
+    }
+  }
+  str = description;
+  str += " EvaluateGrid() agrees with Evaluate()";
+  Check( rc, str );
+
+  const int thread_count[2] = {4,0};
+  rc = true;
+  for ( i = 0; i < 2; i++ )
+  {
+    v4.Zero();
+    if (    !surface.EvaluateGrid( s_count, s.Array(), t_count, t.Array(), der_count, v4.Array(), 3, 0, thread_count[i] )
+         || 0 != memcmp( v1.Array(), v4.Array(), v1.Count()*sizeof(v1[0]) ) )
+      rc = false;
+  }
+  str = description;
+  str += " EvaluateGrid() results do not depend on the thread count";
+  Check( rc, str );
+
+  // The (s,t) pairs are the grid points in the same order.
+  rc = true;
+  for ( i = 0; i < 3; i++ )
+  {
+    v4.Zero();
+    if ( !surface.EvaluateMany( count, ms.Array(), mt.Array(), der_count, v4.Array(), 3, 0, i ? thread_count[i-1] : 1 ) )
+      rc = false;
+    for ( k = 0; k < v1.Count() && rc; k++ )
+    {
+      if ( !IsNear( v4[k], v1[k], 1.0e-12 ) )
+        rc = false;
+    }
+  }
+  str = description;
+  str += " EvaluateMany() agrees with EvaluateGrid() for every thread count";
+  Check( rc, str );
+}
+
+int main()
+{
+  ON::Begin();
+
+  {
+    ON_NurbsCurve curve;
+    ON_Circle( ON_Plane::World_xy, 3.0 ).GetNurbForm(curve);
+    TestCurve( curve, "rational circle" );
+  }
+
+  {
+    ON_3dPointArray P;
+    for ( int i = 0; i < 40; i++ )
+      P.Append( ON_3dPoint( i, sin(0.5*i), cos(0.3*i) ) );
+    ON_NurbsCurve curve;
+    curve.CreateClampedUniformNurbs( 3, 4, P.Count(), P.Array() );
+    TestCurve( curve, "cubic" );
+  }
+
+  {
+    ON_NurbsSurface surface;
+    ON_Sphere( ON_3dPoint::Origin, 2.0 ).GetNurbForm(surface);
+    TestSurface( surface, "rational sphere" );
+  }
+
+  {
+    ON_3dPointArray P;
+    for ( int i = 0; i < 12; i++ )
+    {
+      for ( int j = 0; j < 9; j++ )
+        P.Append( ON_3dPoint( i, j, sin(0.5*i)*cos(0.7*j) ) );
+    }
+    ON_NurbsSurface surface(3,false,4,4,12,9);
+    surface.MakeClampedUniformKnotVector(0);
+    surface.MakeClampedUniformKnotVector(1);
+    for ( int i = 0; i < 12; i++ )
+    {
+      for ( int j = 0; j < 9; j++ )
+        surface.SetCV( i, j, P[i*9+j] );
+    }
+    TestSurface( surface, "bicubic" );
+  }
+
+  const int failed_count = CheckSummary();
+
+  ON::End();
+
+  return failed_count;
+}
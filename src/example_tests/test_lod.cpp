@@ -0,0 +1,117 @@
+// uncomment the "ON_DLL_IMPORTS" define to use opennurbs as a Windows DLL
+//#define ON_DLL_IMPORTS
+#include "../opennurbs.h"
+#include "../examples_linking_pragmas.h"
+#include "example_tests.h"
+
+// This program checks the levels of detail made by
+// ON_Mesh::CreateLevelsOfDetail() and reading them from an archive
+// with ON_Mesh::ReadLevelsOfDetail().
+
+// Writes the mesh in an anonymous chunk of a memory archive.
+static bool WriteMesh( const ON_Mesh& mesh, ON_Write3dmBufferArchive& archive )
+{
+  if ( !archive.BeginWrite3dmChunk(TCODE_ANONYMOUS_CHUNK,0) )
+    return false;
+  bool rc = mesh.Write(archive) ? true : false;
+  if ( !archive.EndWrite3dmChunk() )
+    rc = false;
+  return rc;
+}
+
+// Reads a mesh written by WriteMesh() with ON_Mesh::Read() or
+// ON_Mesh::ReadLevelsOfDetail() and returns the archive's number
+// of bad CRCs, or -1 if the mesh could not be read.
+static int ReadMesh( const unsigned char* buffer, size_t sizeof_buffer, 
+                     const ON_Write3dmBufferArchive& w,
+                     bool bLevelsOnly, ON_Mesh& mesh )
+{
+  ON_Read3dmBufferArchive archive(sizeof_buffer,buffer,false,
+                                  w.Archive3dmVersion(),w.ArchiveOpenNURBSVersion());
+  ON__UINT32 tcode = 0;
+  ON__INT64 big_value = 0;
+  if ( !archive.BeginRead3dmBigChunk(&tcode,&big_value) )
+    return -1;
+  bool rc = bLevelsOnly 
+          ? mesh.ReadLevelsOfDetail(archive,-1) 
+          : (mesh.Read(archive) ? true : false);
+  if ( !archive.EndRead3dmChunk() )
+    rc = false;
+  return rc ? archive.BadCRCCount() : -1;
+}
+
+static void TestLevelsOfDetail()
+{
+  {
+    ON_Mesh* mesh = MakeTorusMesh(48,24);
+    const int face_count = mesh->FaceCount();
+    const bool rc = mesh->CreateLevelsOfDetail(3,0.25,1);
+    const ON_MeshLevelOfDetail* lod = mesh->LevelsOfDetail();
+    bool bDecreasing = (0 != lod && lod->LevelCount() >= 2);
+    int level;
+    for ( level = 0; bDecreasing && level+1 < lod->LevelCount(); level++ )
+    {
+      if ( lod->FaceCount(level) >= lod->FaceCount(level+1) )
+        bDecreasing = false;
+      if ( lod->Error(level) < lod->Error(level+1) )
+        bDecreasing = false;
+    }
+    Check( rc && bDecreasing && mesh->FaceCount() == face_count,
+           "CreateLevelsOfDetail() coarser levels have fewer faces" );
+
+    // Read the levels without the full resolution mesh.
+    ON_Write3dmBufferArchive w(0,0,5,ON::Version());
+    ON_Mesh levels;
+    Check(    WriteMesh(*mesh,w)
+           && 0 == ReadMesh((const unsigned char*)w.Buffer(),w.SizeOfArchive(),w,true,levels)
+           && 0 == levels.FaceCount() && 0 == levels.VertexCount()
+           && 0 != levels.LevelsOfDetail()
+           && levels.LevelsOfDetail()->LevelCount() == lod->LevelCount()
+           && 0 != levels.LevelsOfDetail()->Mesh(0)
+           && levels.LevelsOfDetail()->Mesh(0)->FaceCount() == lod->FaceCount(0),
+           "ReadLevelsOfDetail() reads the levels without the full resolution mesh" );
+
+    // The full resolution data that ReadLevelsOfDetail() reads 
+    // through is still checked.  A changed byte anywhere in the 
+    // mesh, including the compressed full resolution vertices,
+    // makes the read fail or report a bad CRC.
+    const int sizeof_buffer = (int)w.SizeOfArchive();
+    ON_SimpleArray<unsigned char> bad;
+    bool bFound = ( sizeof_buffer > 40 );
+    int i;
+    for ( i = 20; bFound && i < sizeof_buffer; i += sizeof_buffer/40 )
+    {
+      bad.SetCount(0);
+      bad.Append(sizeof_buffer,(const unsigned char*)w.Buffer());
+      bad[i] ^= 0x5A;
+      ON_Mesh bad_levels;
+      if ( 0 == ReadMesh(bad.Array(),bad.Count(),w,true,bad_levels) )
+        bFound = false;
+    }
+    Check( bFound, "ReadLevelsOfDetail() finds changed bytes in the full resolution mesh" );
+
+    delete mesh;
+  }
+
+  {
+    ON_Mesh* mesh = MakeTorusMesh(48,24);
+    mesh->CreateLevelsOfDetail(3,0.25,1);
+    Check(    mesh->Decimate(mesh->FaceCount()/2,0.0,1) 
+           && 0 == mesh->LevelsOfDetail(),
+           "Decimate() removes the levels of detail" );
+    delete mesh;
+  }
+}
+
+int main()
+{
+  ON::Begin();
+
+  TestLevelsOfDetail();
+
+  const int failed_count = CheckSummary();
+
+  ON::End();
+
+  return failed_count;
+}
@@ -0,0 +1,87 @@
+// uncomment the "ON_DLL_IMPORTS" define to use opennurbs as a Windows DLL
+//#define ON_DLL_IMPORTS
+#include "../opennurbs.h"
+#include "../examples_linking_pragmas.h"
+#include "example_tests.h"
+
+// This program checks that ON_Mesh::ComputeFaceNormals() and
+// ON_Mesh::ComputeVertexNormals() give the same normals when they
+// use several threads.
+
+static bool SameNormals( const ON_3fVectorArray& A, const ON_3fVectorArray& B )
+{
+  if ( A.Count() != B.Count() || A.Count() < 1 )
+    return false;
+  return 0 == memcmp( A.Array(), B.Array(), A.Count()*sizeof(A[0]) );
+}
+
+// Returns true if every thread count gives the single threaded normals.
+static bool TestNormals( ON_Mesh& mesh )
+{
+  bool rc = true;
+  mesh.m_FN.Destroy();
+  mesh.m_N.Destroy();
+  mesh.ComputeVertexNormals();
+  const ON_3fVectorArray FN(mesh.m_FN);
+  const ON_3fVectorArray N(mesh.m_N);
+
+  const int thread_count[3] = {0,2,8};
+  for ( int i = 0; i < 3; i++ )
+  {
+    mesh.m_FN.Destroy();
+    if ( !mesh.ComputeFaceNormals(thread_count[i]) || !SameNormals(mesh.m_FN,FN) )
+      rc = false;
+
+    mesh.m_FN.Destroy();
+    mesh.m_N.Destroy();
+    if ( !mesh.ComputeVertexNormals(thread_count[i]) || !SameNormals(mesh.m_FN,FN) || !SameNormals(mesh.m_N,N) )
+      rc = false;
+  }
+  return rc;
+}
+
+int main()
+{
+  ON::Begin();
+
+  {
+    // The torus vertex normals are close to the surface normals.
+    const int u_count = 256;
+    const int v_count = 128;
+    ON_Mesh* mesh = MakeTorusMesh(u_count,v_count);
+    mesh->ComputeVertexNormals(4);
+    bool bNear = ( mesh->m_N.Count() == u_count*v_count );
+    for ( int i = 0; i < u_count && bNear; i++ )
+    {
+      const double a = 2.0*ON_PI*i/u_count;
+      for ( int j = 0; j < v_count && bNear; j++ )
+      {
+        const double b = 2.0*ON_PI*j/v_count;
+        const ON_3dVector n( cos(b)*cos(a), cos(b)*sin(a), sin(b) );
+        if ( fabs(ON_3dVector(mesh->m_N[i*v_count+j])*n) < 0.9999 )
+          bNear = false;
+      }
+    }
+    Check( bNear, "torus: vertex normals are close to the surface normals" );
+
+    Check( TestNormals(*mesh), "quad mesh normals do not depend on the thread count" );
+
+    // Unused vertices get the z axis.
+    mesh->m_V.Append( ON_3fPoint(0.0f,0.0f,0.0f) );
+    mesh->m_N.Destroy();
+    mesh->ComputeVertexNormals(4);
+    Check( mesh->m_N.Count() == mesh->m_V.Count() && ON_3fVector(0.0f,0.0f,1.0f) == *mesh->m_N.Last(),
+           "unused vertex normal is the z axis" );
+    Check( TestNormals(*mesh), "normals with an unused vertex do not depend on the thread count" );
+
+    mesh->ConvertQuadsToTriangles();
+    Check( TestNormals(*mesh), "triangle mesh normals do not depend on the thread count" );
+    delete mesh;
+  }
+
+  const int failed_count = CheckSummary();
+
+  ON::End();
+
+  return failed_count;
+}
@@ -0,0 +1,124 @@
+// uncomment the "ON_DLL_IMPORTS" define to use opennurbs as a Windows DLL
+//#define ON_DLL_IMPORTS
+#include "../opennurbs.h"
+#include "../examples_linking_pragmas.h"
+#include "example_tests.h"
+
+// This program checks that ON_CompiledPolyCurve evaluation agrees
+// with ON_PolyCurve::Evaluate() for mixed, nested and closed
+// polycurves, including evaluation at segment ends from both sides.
+
+///////////////////////////////////////////////////////////////////////
+//
+// Compiled polycurves
+//
+
+static bool CompiledMatchesVirtual( const ON_PolyCurve& polycurve, const char* description )
+{
+  const ON_CompiledPolyCurve* compiled = polycurve.CompiledCurve();
+  if ( 0 == compiled )
+  {
+    Check(false,description);
+    return false;
+  }
+  const ON_Interval d = polycurve.Domain();
+  const int dim = polycurve.Dimension();
+  double v0[12], v1[12];
+  double max_error = 0.0;
+  bool rc = (compiled->Domain() == d && compiled->Dimension() == dim);
+  int i, j, side;
+  ON_SimpleArray<double> t(512);
+  for ( i = 0; i <= 400; i++ )
+    t.Append( d.ParameterAt(i/400.0) );
+  // segment ends are evaluated from both sides
+  for ( i = 0; i < polycurve.Count(); i++ )
+    t.Append( polycurve.SegmentDomain(i)[0] );
+  t.Append( d[1] );
+  for ( i = 0; rc && i < t.Count(); i++ )
+  {
+    for ( side = -1; rc && side <= 1; side += 2 )
+    {
+      if (    !polycurve.Evaluate(t[i],2,dim,v0,side) 
+           || !compiled->Evaluate(t[i],2,dim,v1,side) )
+      {
+        rc = false;
+        break;
+      }
+      for ( j = 0; j < 3*dim; j++ )
+      {
+        const double e = fabs(v0[j]-v1[j])/(1.0 + fabs(v0[j]));
+        if ( e > max_error )
+          max_error = e;
+      }
+    }
+  }
+  rc = rc && max_error <= 1.0e-9;
+  Check(rc,description);
+  return rc;
+}
+
+static void TestCompiledPolyCurve()
+{
+  ON_PolyCurve polycurve;
+  ON_3dPoint P(0.0,0.0,0.0);
+  ON_3dPoint Q(4.0,0.0,0.0);
+  polycurve.Append(new ON_LineCurve(P,Q));
+  ON_Arc arc(Q,ON_3dPoint(6.0,2.0,0.0),ON_3dPoint(8.0,0.0,0.0));
+  polycurve.Append(new ON_ArcCurve(arc));
+
+  ON_NurbsCurve* nurbs = new ON_NurbsCurve(3,false,4,7);
+  nurbs->MakeClampedUniformKnotVector();
+  int i;
+  for ( i = 0; i < 7; i++ )
+    nurbs->SetCV(i,ON_3dPoint(8.0+i, (i%2) ? 1.0 : -1.0, 0.5*i));
+  nurbs->SetCV(0,ON_3dPoint(8.0,0.0,0.0));
+  polycurve.Append(nurbs);
+
+  ON_Polyline pline;
+  pline.Append(nurbs->PointAtEnd());
+  pline.Append(nurbs->PointAtEnd() + ON_3dVector(1.0,1.0,0.0));
+  pline.Append(nurbs->PointAtEnd() + ON_3dVector(1.0,3.0,1.0));
+  polycurve.Append(new ON_PolylineCurve(pline));
+  CompiledMatchesVirtual(polycurve,"compiled polycurve matches ON_PolyCurve::Evaluate()");
+
+  // Nested polycurve and a reparameterized segment.
+  ON_PolyCurve nested;
+  ON_PolyCurve* inner = new ON_PolyCurve(polycurve);
+  inner->SetDomain(10.0,11.0);
+  nested.Append(inner);
+  ON_LineCurve* tail = new ON_LineCurve(inner->PointAtEnd(),inner->PointAtEnd()+ON_3dVector(0.0,0.0,5.0));
+  tail->SetDomain(0.0,100.0);
+  nested.Append(tail);
+  CompiledMatchesVirtual(nested,"compiled nested polycurve matches ON_PolyCurve::Evaluate()");
+
+  // Closed polycurve made of two arcs.
+  ON_PolyCurve closed;
+  ON_Arc upper(ON_3dPoint(1.0,0.0,0.0),ON_3dPoint(0.0,1.0,0.0),ON_3dPoint(-1.0,0.0,0.0));
+  ON_Arc lower(ON_3dPoint(-1.0,0.0,0.0),ON_3dPoint(0.0,-1.0,0.0),ON_3dPoint(1.0,0.0,0.0));
+  closed.Append(new ON_ArcCurve(upper));
+  closed.Append(new ON_ArcCurve(lower));
+  Check( closed.IsClosed(), "two arc polycurve is closed" );
+  CompiledMatchesVirtual(closed,"compiled closed polycurve matches ON_PolyCurve::Evaluate()");
+
+  // Changing a segment through the polycurve interface
+  // discards the compiled curve.
+  const ON_CompiledPolyCurve* compiled = polycurve.CompiledCurve();
+  const int span_count = compiled ? compiled->SpanCount() : 0;
+  polycurve.Append(new ON_LineCurve(pline[2],pline[2]+ON_3dVector(2.0,0.0,0.0)));
+  compiled = polycurve.CompiledCurve();
+  Check( 0 != compiled && compiled->SpanCount() == span_count+1,
+         "ON_PolyCurve::Append() discards the compiled curve" );
+}
+
+int main()
+{
+  ON::Begin();
+
+  TestCompiledPolyCurve();
+
+  const int failed_count = CheckSummary();
+
+  ON::End();
+
+  return failed_count;
+}
@@ -0,0 +1,274 @@
+// uncomment the "ON_DLL_IMPORTS" define to use opennurbs as a Windows DLL
+//#define ON_DLL_IMPORTS
+#include "../opennurbs.h"
+#include "../examples_linking_pragmas.h"
+#include "example_tests.h"
+
+// This program checks the blocked LU and Cholesky factorizations in
+// ON_Matrix, the banded solvers, and NURBS curve and surface 
+// interpolation and least squares fitting.  The systems are made
+// from known solutions and the curves and surfaces fit points on 
+// polynomials that the splines reproduce exactly.
+
+///////////////////////////////////////////////////////////////////////
+//
+// Linear solvers
+//
+
+// The matrices are larger than ON_Matrix's 64 column blocks so
+// the blocked updates are used.
+static const int solver_n = 150;
+
+// Known solution X[i] = (x,y) of the systems below.
+static void KnownSolution( int i, double* X )
+{
+  X[0] = sin(0.1*i) + 1.0;
+  X[1] = cos(0.3*i) - 0.5*i;
+}
+
+// Multiply the dense matrix A by the known solution.
+static void MultiplyKnownSolution( const ON_Matrix& A, ON_SimpleArray<double>& B )
+{
+  const int n = A.RowCount();
+  B.Reserve(2*n);
+  B.SetCount(2*n);
+  int i, j;
+  double X[2];
+  for ( i = 0; i < n; i++ )
+  {
+    B[2*i] = B[2*i+1] = 0.0;
+    for ( j = 0; j < n; j++ )
+    {
+      KnownSolution(j,X);
+      B[2*i]   += A[i][j]*X[0];
+      B[2*i+1] += A[i][j]*X[1];
+    }
+  }
+}
+
+static bool IsKnownSolution( const ON_SimpleArray<double>& B )
+{
+  int i;
+  double X[2];
+  for ( i = 0; 2*i+1 < B.Count(); i++ )
+  {
+    KnownSolution(i,X);
+    if ( !IsNear(B[2*i],X[0],1.0e-10) || !IsNear(B[2*i+1],X[1],1.0e-10) )
+      return false;
+  }
+  return true;
+}
+
+static void TestSolvers()
+{
+  const int n = solver_n;
+  int i, j;
+
+  // A general matrix whose largest entries are below the diagonal,
+  // so LUFactor() has to swap rows.
+  ON_Matrix A(n,n);
+  for ( i = 0; i < n; i++ )
+  {
+    for ( j = 0; j < n; j++ )
+      A[i][j] = sin(7.0*i + 3.0*j);
+    A[i][(i+n-1)%n] += n;
+  }
+  ON_SimpleArray<double> B;
+  MultiplyKnownSolution(A,B);
+  ON_SimpleArray<int> row_pivots(n);
+  row_pivots.SetCount(n);
+  Check(    A.LUFactor(0.0,row_pivots.Array())
+         && A.LUSolve(row_pivots.Array(),2,2,B.Array())
+         && IsKnownSolution(B),
+         "ON_Matrix::LUFactor() and LUSolve() with row pivoting" );
+
+  // Symmetric positive definite matrix A[i][j] = 0.5^|i-j|.
+  for ( i = 0; i < n; i++ )
+  {
+    for ( j = 0; j < n; j++ )
+      A[i][j] = pow(0.5,abs(i-j));
+  }
+  MultiplyKnownSolution(A,B);
+  Check(    A.CholeskyFactor()
+         && A.CholeskySolve(2,2,B.Array())
+         && IsKnownSolution(B),
+         "ON_Matrix::CholeskyFactor() and CholeskySolve()" );
+
+  // A diagonally dominant banded matrix solved as a dense and a
+  // banded system.
+  const int lower_bw = 2;
+  const int upper_bw = 3;
+  const int band_width = lower_bw + 1 + upper_bw;
+  ON_SimpleArray<double> band(n*band_width);
+  band.SetCount(n*band_width);
+  for ( i = 0; i < n; i++ )
+  {
+    for ( j = 0; j < n; j++ )
+    {
+      A[i][j] = 0.0;
+      if ( j-i >= -lower_bw && j-i <= upper_bw )
+      {
+        A[i][j] = (i==j) ? 10.0 : cos(1.0*i + 2.0*j);
+        band[i*band_width + j-i+lower_bw] = A[i][j];
+      }
+    }
+  }
+  MultiplyKnownSolution(A,B);
+  ON_SimpleArray<double> dense_B(B);
+  bool rc = ON_SolveBandedSystem(n,lower_bw,upper_bw,band.Array(),2,2,B.Array());
+  Check( rc && IsKnownSolution(B), "ON_SolveBandedSystem()" );
+  rc = A.LUFactor(0.0,row_pivots.Array()) && A.LUSolve(row_pivots.Array(),2,2,dense_B.Array());
+  for ( i = 0; rc && i < B.Count(); i++ )
+  {
+    if ( !IsNear(B[i],dense_B[i],1.0e-12) )
+      rc = false;
+  }
+  Check( rc, "ON_SolveBandedSystem() agrees with ON_Matrix::LUSolve()" );
+
+  // A symmetric positive definite banded matrix solved as a dense 
+  // and a banded system.
+  const int sym_bw = 2;
+  band.SetCount(0);
+  band.Reserve(n*(sym_bw+1));
+  band.SetCount(n*(sym_bw+1));
+  for ( i = 0; i < n; i++ )
+  {
+    for ( j = 0; j < n; j++ )
+    {
+      A[i][j] = 0.0;
+      if ( abs(i-j) <= sym_bw )
+        A[i][j] = (i==j) ? 6.0 : -1.0/abs(i-j);
+      if ( j <= i && i-j <= sym_bw )
+        band[i*(sym_bw+1) + j-i+sym_bw] = A[i][j];
+    }
+  }
+  MultiplyKnownSolution(A,B);
+  dense_B = B;
+  rc = ON_SolveBandedSymmetricSystem(n,sym_bw,band.Array(),2,2,B.Array());
+  Check( rc && IsKnownSolution(B), "ON_SolveBandedSymmetricSystem()" );
+  rc = A.CholeskyFactor() && A.CholeskySolve(2,2,dense_B.Array());
+  for ( i = 0; rc && i < B.Count(); i++ )
+  {
+    if ( !IsNear(B[i],dense_B[i],1.0e-12) )
+      rc = false;
+  }
+  Check( rc, "ON_SolveBandedSymmetricSystem() agrees with ON_Matrix::CholeskySolve()" );
+}
+
+///////////////////////////////////////////////////////////////////////
+//
+// Interpolation and least squares fitting
+//
+
+// A cubic polynomial curve.  Cubic splines reproduce it exactly.
+static ON_3dPoint CubicPoint( double t )
+{
+  return ON_3dPoint( t, 2.0*t*t - 1.0, t*t*t - t );
+}
+
+// A bicubic polynomial surface.
+static ON_3dPoint BicubicPoint( double u, double v )
+{
+  return ON_3dPoint( u, v, u*u*v - v*v*v + u*v );
+}
+
+static bool CurveIsCubic( const ON_NurbsCurve& curve )
+{
+  const ON_Interval d = curve.Domain();
+  if ( !(d[0] <= 0.0 && d[1] >= 1.0) )
+    return false;
+  int i;
+  for ( i = 0; i <= 100; i++ )
+  {
+    const double t = i/100.0;
+    if ( curve.PointAt(t).DistanceTo(CubicPoint(t)) > 1.0e-10 )
+      return false;
+  }
+  return true;
+}
+
+static void TestFitting()
+{
+  // Unevenly spaced parameters on [0,1].
+  const int point_count = 25;
+  double t[point_count];
+  ON_3dPoint P[point_count];
+  double w[point_count];
+  int i, j;
+  for ( i = 0; i < point_count; i++ )
+  {
+    const double s = ((double)i)/(point_count-1);
+    t[i] = s*s*(3.0 - 2.0*s);
+    P[i] = CubicPoint(t[i]);
+    w[i] = 1.0 + (i%3);
+  }
+
+  ON_NurbsCurve curve;
+  Check(    curve.CreateInterpolatingCurve(3,4,point_count,3,&P[0].x,t)
+         && curve.CVCount() == point_count
+         && CurveIsCubic(curve),
+         "interpolating points on a cubic reproduces the cubic" );
+
+  // Without parameters the curve interpolates the points at their
+  // chord length parameters.
+  double chord_t[point_count];
+  bool rc =    ON_GetChordLengthParameters(3,point_count,3,&P[0].x,chord_t)
+            && curve.CreateInterpolatingCurve(3,4,point_count,3,&P[0].x);
+  for ( i = 0; rc && i < point_count; i++ )
+  {
+    if ( curve.PointAt(chord_t[i]).DistanceTo(P[i]) > 1.0e-10 )
+      rc = false;
+  }
+  Check( rc, "curve interpolating points at chord length parameters" );
+
+  Check(    curve.CreateLeastSquaresCurve(3,4,8,point_count,3,&P[0].x,t)
+         && curve.CVCount() == 8
+         && CurveIsCubic(curve),
+         "least squares fit of points on a cubic reproduces the cubic" );
+
+  Check(    curve.CreateLeastSquaresCurve(3,4,8,point_count,3,&P[0].x,t,w)
+         && CurveIsCubic(curve),
+         "weighted least squares fit of points on a cubic reproduces the cubic" );
+
+  // Interpolate a grid of points on a bicubic surface.
+  const int count0 = 9;
+  const int count1 = 7;
+  double u[count0], v[count1];
+  ON_3dPoint G[count0][count1];
+  for ( i = 0; i < count0; i++ )
+    u[i] = pow(((double)i)/(count0-1),1.5);
+  for ( j = 0; j < count1; j++ )
+    v[j] = ((double)j)/(count1-1);
+  for ( i = 0; i < count0; i++ )
+  {
+    for ( j = 0; j < count1; j++ )
+      G[i][j] = BicubicPoint(u[i],v[j]);
+  }
+  ON_NurbsSurface surface;
+  rc = surface.CreateInterpolatingSurface(3,4,4,count0,count1,3*count1,3,&G[0][0].x,u,v);
+  for ( i = 0; rc && i <= 20; i++ )
+  {
+    for ( j = 0; rc && j <= 20; j++ )
+    {
+      const double a = i/20.0;
+      const double b = j/20.0;
+      if ( surface.PointAt(a,b).DistanceTo(BicubicPoint(a,b)) > 1.0e-10 )
+        rc = false;
+    }
+  }
+  Check( rc, "interpolating a grid of points on a bicubic reproduces the bicubic" );
+}
+
+int main()
+{
+  ON::Begin();
+
+  TestSolvers();
+  TestFitting();
+
+  const int failed_count = CheckSummary();
+
+  ON::End();
+
+  return failed_count;
+}
@@ -0,0 +1,132 @@
+// uncomment the "ON_DLL_IMPORTS" define to use opennurbs as a Windows DLL
+//#define ON_DLL_IMPORTS
+#include "../opennurbs.h"
+#include "../examples_linking_pragmas.h"
+#include "example_tests.h"
+
+// This program checks ON_Triangulate2dRegion() on regions whose
+// areas are known: collinear ears, closing points, zero length
+// segments, degenerate loops, holes and many reflex vertices.
+
+///////////////////////////////////////////////////////////////////////
+//
+// Planar region triangulation (ear clipping)
+//
+
+// Returns the sum of the signed triangle areas or ON_UNSET_VALUE
+// if a triangle is clockwise or uses an invalid index.
+static double TriangleArea( int point_count, const double* point, const ON_SimpleArray<ON_3dex>& triangles )
+{
+  double area = 0.0;
+  int i;
+  for ( i = 0; i < triangles.Count(); i++ )
+  {
+    const ON_3dex& t = triangles[i];
+    if (    t.i < 0 || t.i >= point_count 
+         || t.j < 0 || t.j >= point_count 
+         || t.k < 0 || t.k >= point_count )
+      return ON_UNSET_VALUE;
+    const double* A = point + 2*t.i;
+    const double* B = point + 2*t.j;
+    const double* C = point + 2*t.k;
+    const double a = 0.5*((B[0]-A[0])*(C[1]-A[1]) - (B[1]-A[1])*(C[0]-A[0]));
+    if ( a < 0.0 )
+      return ON_UNSET_VALUE;
+    area += a;
+  }
+  return area;
+}
+
+static void TestTriangulate()
+{
+  ON_SimpleArray<ON_3dex> triangles;
+
+  // Square with extra points on its sides.  The ears at the 
+  // extra points are collinear.
+  {
+    const double p[16] = { 0,0, 1,0, 2,0, 2,1, 2,2, 1,2, 0,2, 0,1 };
+    const int n = 8;
+    triangles.SetCount(0);
+    const int count = ON_Triangulate2dRegion(1,&n,2,p,triangles);
+    Check( n-2 == count && IsNear(TriangleArea(n,p,triangles),4.0,1.0e-12),
+           "triangulate square with collinear points" );
+  }
+
+  // Clockwise input and a closing point equal to the first point.
+  {
+    const double p[10] = { 0,0, 0,3, 4,3, 4,0, 0,0 };
+    const int n = 5;
+    triangles.SetCount(0);
+    const int count = ON_Triangulate2dRegion(1,&n,2,p,triangles);
+    Check( 2 == count && IsNear(TriangleArea(n,p,triangles),12.0,1.0e-12),
+           "triangulate closed clockwise rectangle" );
+  }
+
+  // Repeated points make zero length segments.
+  {
+    const double p[16] = { 0,0, 3,0, 3,0, 3,3, 1,1, 1,1, 0,3, 0,0 };
+    const int n = 8;
+    triangles.SetCount(0);
+    const int count = ON_Triangulate2dRegion(1,&n,2,p,triangles);
+    // area of the concave pentagon (0,0),(3,0),(3,3),(1,1),(0,3)
+    Check( count > 0 && IsNear(TriangleArea(n,p,triangles),6.0,1.0e-12),
+           "triangulate polygon with zero length segments" );
+  }
+
+  // A loop whose points are all on a line has no area.
+  {
+    const double p[6] = { 0,0, 1,0, 2,0 };
+    const int n = 3;
+    triangles.SetCount(0);
+    const int count = ON_Triangulate2dRegion(1,&n,2,p,triangles);
+    const double area = TriangleArea(n,p,triangles);
+    Check( ON_UNSET_VALUE != area && IsNear(area,0.0,1.0e-12) && count == triangles.Count(),
+           "triangulate degenerate triangle" );
+  }
+
+  // Square with a square hole.
+  {
+    const double p[16] = { 0,0, 4,0, 4,4, 0,4,   1,1, 1,3, 3,3, 3,1 };
+    const int n[2] = {4,4};
+    triangles.SetCount(0);
+    const int count = ON_Triangulate2dRegion(2,n,2,p,triangles);
+    Check( 8 == count && IsNear(TriangleArea(8,p,triangles),12.0,1.0e-12),
+           "triangulate square with a hole" );
+  }
+
+  // Comb shaped polygon with many reflex vertices.
+  {
+    ON_SimpleArray<double> p;
+    const int tooth_count = 50;
+    int i;
+    for ( i = 0; i < tooth_count; i++ )
+    {
+      p.Append(2.0*i);     p.Append(0.0);
+      p.Append(2.0*i+1.0); p.Append(0.0);
+      p.Append(2.0*i+1.0); p.Append(-5.0);
+      p.Append(2.0*i+2.0); p.Append(-5.0);
+    }
+    p.Append(2.0*tooth_count); p.Append(1.0);
+    p.Append(0.0); p.Append(1.0);
+    const int n = p.Count()/2;
+    triangles.SetCount(0);
+    const int count = ON_Triangulate2dRegion(1,&n,2,p.Array(),triangles);
+    // area = 1 x 100 strip plus 50 teeth of 1 x 5
+    const double area = 2.0*tooth_count*1.0 + tooth_count*5.0;
+    Check( n-2 == count && IsNear(TriangleArea(n,p.Array(),triangles),area,1.0e-12),
+           "triangulate comb with many reflex vertices" );
+  }
+}
+
+int main()
+{
+  ON::Begin();
+
+  TestTriangulate();
+
+  const int failed_count = CheckSummary();
+
+  ON::End();
+
+  return failed_count;
+}
@@ -0,0 +1,385 @@
+// uncomment the "ON_DLL_IMPORTS" define to use opennurbs as a Windows DLL
+//#define ON_DLL_IMPORTS
+#include "../opennurbs.h"
+#include "../examples_linking_pragmas.h"
+
+// This program shares const curves and surfaces between threads
+// and calls the const functions that fill in runtime caches the
+// first time they are used (see the "Threads" section in faq.txt).
+// Each round makes new objects, so the threads race to make the
+// caches.  The results are compared with results computed on one
+// thread from copies of the objects.
+//
+// Each round also has every thread make its own model, write it
+// to a memory archive and read it back, so the archive code, the
+// error counters and the class lookup run on several threads at
+// once.  The archives and the objects read from them are compared
+// with an archive written and read on one thread.
+//
+// Build it with ENABLE_THREAD_SANITIZER=ON to have ThreadSanitizer
+// check the cache locks.  The program returns 0 when every result
+// matches.
+
+static const int thread_count = 8;
+static const int task_count = 64;
+static const int round_count = 20;
+static const int sample_count = 200;
+static const int archive_task_count = 16;
+
+struct SHARED_OBJECTS
+{
+  const ON_NurbsCurve* m_curve;       // span evaluation cache on
+  const ON_NurbsSurface* m_surface;   // span evaluation cache on
+  const ON_PolyCurve* m_polycurve;
+
+  // results computed on one thread from copies
+  ON_3dPoint m_curve_point[sample_count];
+  ON_3dPoint m_surface_point[sample_count];
+  ON_3dPoint m_polycurve_point[sample_count];
+  ON_BoundingBox m_curve_tight_bbox;
+  ON_BoundingBox m_surface_tight_bbox;
+  double m_curve_length;
+
+  int m_error_count;
+};
+
+static ON_NurbsCurve* MakeCurve( int round )
+{
+  const int cv_count = 40;
+  ON_NurbsCurve* curve = new ON_NurbsCurve(3,false,4,cv_count);
+  curve->MakeClampedUniformKnotVector();
+  int i;
+  for ( i = 0; i < cv_count; i++ )
+    curve->SetCV(i,ON_3dPoint(i, sin(0.3*i+round), cos(0.7*i)));
+  return curve;
+}
+
+static ON_NurbsSurface* MakeSurface( int round )
+{
+  const int cv_count = 12;
+  ON_NurbsSurface* surface = new ON_NurbsSurface(3,false,4,4,cv_count,cv_count);
+  surface->MakeClampedUniformKnotVector(0);
+  surface->MakeClampedUniformKnotVector(1);
+  int i, j;
+  for ( i = 0; i < cv_count; i++ )
+  {
+    for ( j = 0; j < cv_count; j++ )
+      surface->SetCV(i,j,ON_3dPoint(i, j, sin(0.5*i+round)*cos(0.4*j)));
+  }
+  return surface;
+}
+
+static ON_PolyCurve* MakePolyCurve( int round )
+{
+  ON_PolyCurve* polycurve = new ON_PolyCurve();
+  ON_3dPoint P(0.0,0.0,0.0);
+  ON_3dPoint Q(10.0,round,0.0);
+  polycurve->Append(new ON_LineCurve(P,Q));
+  ON_Arc arc(Q,ON_3dPoint(15.0,5.0+round,0.0),ON_3dPoint(20.0,round,0.0));
+  polycurve->Append(new ON_ArcCurve(arc));
+  ON_NurbsCurve* curve = MakeCurve(round);
+  curve->Translate(ON_3dPoint(20.0,round,0.0) - curve->PointAtStart());
+  polycurve->Append(curve);
+  return polycurve;
+}
+
+static double SampleParameter( ON_Interval domain, int i )
+{
+  return domain.ParameterAt( ((double)i)/((double)(sample_count-1)) );
+}
+
+static bool SamePoint( const ON_3dPoint& A, const ON_3dPoint& B )
+{
+  // The span cache evaluates power basis coefficients, so its
+  // results may differ from the control point evaluation in
+  // the last few bits.
+  return A.DistanceTo(B) <= 1.0e-9*(1.0 + A.MaximumCoordinate());
+}
+
+static bool SameBox( const ON_BoundingBox& A, const ON_BoundingBox& B )
+{
+  return A.IsValid() && B.IsValid() && A.m_min == B.m_min && A.m_max == B.m_max;
+}
+
+static void StressTask( void* context, int task_index )
+{
+  SHARED_OBJECTS& shared = *((SHARED_OBJECTS*)context);
+  int errors = 0;
+  int i, k;
+
+  // Tasks start with different functions so the first use of
+  // each cache happens on different threads.
+  for ( k = 0; k < 4; k++ )
+  {
+    switch ( (task_index + k) % 4 )
+    {
+    case 0:
+      {
+        const ON_Interval d = shared.m_curve->Domain();
+        for ( i = 0; i < sample_count; i++ )
+        {
+          if ( !SamePoint(shared.m_curve->PointAt(SampleParameter(d,i)),shared.m_curve_point[i]) )
+            errors++;
+        }
+        const ON_Interval u = shared.m_surface->Domain(0);
+        const ON_Interval v = shared.m_surface->Domain(1);
+        for ( i = 0; i < sample_count; i++ )
+        {
+          if ( !SamePoint(shared.m_surface->PointAt(SampleParameter(u,i),SampleParameter(v,sample_count-1-i)),shared.m_surface_point[i]) )
+            errors++;
+        }
+      }
+      break;
+
+    case 1:
+      {
+        ON_BoundingBox bbox;
+        if ( !shared.m_curve->GetTightBoundingBox(bbox) || !SameBox(bbox,shared.m_curve_tight_bbox) )
+          errors++;
+        bbox.Destroy();
+        if ( !shared.m_surface->GetTightBoundingBox(bbox) || !SameBox(bbox,shared.m_surface_tight_bbox) )
+          errors++;
+      }
+      break;
+
+    case 2:
+      {
+        // The table is made from evaluations that may or may not
+        // use the span cache, so the length may differ slightly.
+        double length = 0.0;
+        if (    !shared.m_curve->GetLength(&length) 
+             || fabs(length - shared.m_curve_length) > 1.0e-12*shared.m_curve_length )
+          errors++;
+      }
+      break;
+
+    case 3:
+      {
+        const ON_CompiledPolyCurve* compiled = shared.m_polycurve->CompiledCurve();
+        if ( 0 == compiled )
+        {
+          errors++;
+          break;
+        }
+        const ON_Interval d = shared.m_polycurve->Domain();
+        for ( i = 0; i < sample_count; i++ )
+        {
+          if ( compiled->PointAt(SampleParameter(d,i)) != shared.m_polycurve_point[i] )
+            errors++;
+        }
+      }
+      break;
+    }
+  }
+
+  if ( errors > 0 )
+    ON_ATOMIC_INCREMENT(&shared.m_error_count);
+}
+
+static int StressRound( int round )
+{
+  SHARED_OBJECTS shared;
+  ON_NurbsCurve* curve = MakeCurve(round);
+  ON_NurbsSurface* surface = MakeSurface(round);
+  ON_PolyCurve* polycurve = MakePolyCurve(round);
+  curve->SetEvaluationCacheSize(8);
+  surface->SetEvaluationCacheSize(8);
+  shared.m_curve = curve;
+  shared.m_surface = surface;
+  shared.m_polycurve = polycurve;
+  shared.m_error_count = 0;
+
+  // Copies do not copy runtime caches, so these results are
+  // computed without touching the shared objects.
+  {
+    ON_NurbsCurve c(*curve);
+    ON_NurbsSurface s(*surface);
+    ON_PolyCurve p(*polycurve);
+    int i;
+    const ON_Interval d = c.Domain();
+    const ON_Interval u = s.Domain(0);
+    const ON_Interval v = s.Domain(1);
+    const ON_Interval pd = p.Domain();
+    const ON_CompiledPolyCurve* compiled = p.CompiledCurve();
+    for ( i = 0; i < sample_count; i++ )
+    {
+      shared.m_curve_point[i] = c.PointAt(SampleParameter(d,i));
+      shared.m_surface_point[i] = s.PointAt(SampleParameter(u,i),SampleParameter(v,sample_count-1-i));
+      shared.m_polycurve_point[i] = compiled ? compiled->PointAt(SampleParameter(pd,i)) : ON_UNSET_POINT;
+    }
+    c.GetTightBoundingBox(shared.m_curve_tight_bbox);
+    s.GetTightBoundingBox(shared.m_surface_tight_bbox);
+    shared.m_curve_length = 0.0;
+    c.GetLength(&shared.m_curve_length);
+  }
+
+  ON_ParallelFor( thread_count, task_count, StressTask, &shared );
+
+  delete polycurve;
+  delete surface;
+  delete curve;
+
+  return shared.m_error_count;
+}
+
+static ON_UUID ModelUuid( int i )
+{
+  ON_UUID id = ON_nil_uuid;
+  id.Data1 = (unsigned int)(i+1);
+  return id;
+}
+
+static void AddModelObject( ONX_Model& model, ON_Object* object )
+{
+  ONX_Model_Object& mo = model.m_object_table.AppendNew();
+  mo.m_object = object;
+  mo.m_bDeleteObject = true;
+  mo.m_attributes.m_uuid = ModelUuid(model.m_object_table.Count());
+  mo.m_attributes.m_layer_index = 0;
+}
+
+static void MakeModel( int round, ONX_Model& model )
+{
+  // The revision history and ids are set here because Polish()
+  // would use the time and new uuids, and then archives written
+  // at different times would not be the same.
+  model.m_properties.m_RevisionHistory.m_revision_count = 1;
+  model.m_properties.m_Notes.m_notes.Format("round %d",round);
+
+  ON_Layer& layer = model.m_layer_table.AppendNew();
+  layer.SetLayerName(L"Default");
+  layer.SetLayerIndex(0);
+  layer.m_layer_id = ModelUuid(1000);
+
+  AddModelObject(model,MakeCurve(round));
+  AddModelObject(model,MakeSurface(round));
+  AddModelObject(model,MakePolyCurve(round));
+
+  const ON_3dPoint box[8] = 
+  {
+    ON_3dPoint(0.0,0.0,0.0), ON_3dPoint(1.0+round,0.0,0.0), 
+    ON_3dPoint(1.0+round,1.0,0.0), ON_3dPoint(0.0,1.0,0.0),
+    ON_3dPoint(0.0,0.0,1.0), ON_3dPoint(1.0+round,0.0,1.0), 
+    ON_3dPoint(1.0+round,1.0,1.0), ON_3dPoint(0.0,1.0,1.0)
+  };
+  AddModelObject(model,ON_BrepBox(box));
+
+  const int n = 10;
+  ON_Mesh* mesh = new ON_Mesh((n-1)*(n-1),n*n,true,false);
+  int i, j;
+  for ( i = 0; i < n; i++ )
+  {
+    for ( j = 0; j < n; j++ )
+      mesh->SetVertex(i*n+j,ON_3dPoint(i, j, sin(0.5*i+round)*cos(0.4*j)));
+  }
+  for ( i = 0; i+1 < n; i++ )
+  {
+    for ( j = 0; j+1 < n; j++ )
+      mesh->SetQuad(i*(n-1)+j,i*n+j,(i+1)*n+j,(i+1)*n+j+1,i*n+j+1);
+  }
+  mesh->ComputeVertexNormals();
+  AddModelObject(model,mesh);
+
+  model.Polish();
+}
+
+static bool WriteModel( int round, ON_Write3dmBufferArchive& archive )
+{
+  ONX_Model model;
+  MakeModel(round,model);
+  return model.Write(archive,5,"example_threads");
+}
+
+// Reads an archive and gets the CRCs of the objects in it.
+static bool ReadModel( const ON_Write3dmBufferArchive& buffer, ON_SimpleArray<ON__UINT32>& crc )
+{
+  ON_Read3dmBufferArchive archive(buffer.SizeOfArchive(),buffer.Buffer(),false,
+                                  buffer.Archive3dmVersion(),buffer.ArchiveOpenNURBSVersion());
+  ONX_Model model;
+  if ( !model.Read(archive) )
+    return false;
+  int i;
+  for ( i = 0; i < model.m_object_table.Count(); i++ )
+  {
+    const ON_Object* object = model.m_object_table[i].m_object;
+    crc.Append( object ? object->DataCRC(0) : 0 );
+  }
+  return true;
+}
+
+struct SHARED_ARCHIVE
+{
+  int m_round;
+
+  // results computed on one thread
+  ON_SimpleArray<unsigned char> m_archive;
+  ON_SimpleArray<ON__UINT32> m_crc;
+
+  int m_error_count;
+};
+
+static void ArchiveTask( void* context, int task_index )
+{
+  SHARED_ARCHIVE& shared = *((SHARED_ARCHIVE*)context);
+  int errors = 0;
+
+  ON_Write3dmBufferArchive archive(0,0,5,ON::Version());
+  ON_SimpleArray<ON__UINT32> crc;
+  if (    !WriteModel(shared.m_round,archive)
+       || archive.SizeOfArchive() != (size_t)shared.m_archive.Count()
+       || 0 != memcmp(archive.Buffer(),shared.m_archive.Array(),shared.m_archive.Count())
+       || !ReadModel(archive,crc)
+       || crc.Count() != shared.m_crc.Count()
+       || 0 != memcmp(crc.Array(),shared.m_crc.Array(),crc.Count()*sizeof(crc[0])) )
+  {
+    errors++;
+  }
+
+  if ( errors > 0 )
+    ON_ATOMIC_INCREMENT(&shared.m_error_count);
+}
+
+static int ArchiveRound( int round )
+{
+  SHARED_ARCHIVE shared;
+  shared.m_round = round;
+  shared.m_error_count = 0;
+
+  const int error_count = ON_GetErrorCount();
+
+  {
+    ON_Write3dmBufferArchive archive(0,0,5,ON::Version());
+    if (    !WriteModel(round,archive) 
+         || !ReadModel(archive,shared.m_crc) 
+         || shared.m_crc.Count() < 1 )
+      return archive_task_count;
+    shared.m_archive.Append((int)archive.SizeOfArchive(),(const unsigned char*)archive.Buffer());
+  }
+
+  ON_ParallelFor( thread_count, archive_task_count, ArchiveTask, &shared );
+
+  // Writing and reading a valid model does not report errors.
+  if ( ON_GetErrorCount() != error_count )
+    shared.m_error_count++;
+
+  return shared.m_error_count;
+}
+
+int main()
+{
+  ON::Begin();
+
+  int error_count = 0;
+  int round;
+  for ( round = 0; round < round_count; round++ )
+  {
+    error_count += StressRound(round);
+    error_count += ArchiveRound(round);
+  }
+
+  printf("%d threads, %d rounds: %d failed tasks\n",thread_count,round_count,error_count);
+
+  ON::End();
+
+  return (0 == error_count) ? 0 : 1;
+}
@@ -50,6 +50,8 @@
 #include "opennurbs_xform.h"          // 4 X 4 transformation matrix
 #include "opennurbs_quaternion.h"
 #include "opennurbs_workspace.h"      // workspace memory allocation
+#include "opennurbs_parallel.h"       // run independent tasks on several threads
+#include "opennurbs_simd.h"           // SSE2/AVX point list kernels
 #include "opennurbs_plane.h"          // simple 3d plane
 #include "opennurbs_circle.h"         // simple 3d circle
 #include "opennurbs_ellipse.h"        // simple 3d ellipse
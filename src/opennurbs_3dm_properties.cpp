@@ -50,10 +50,16 @@ int ON_3dmRevisionHistory::NewRevision()
   struct tm current_time;
   memset(&current_time,0,sizeof(current_time));
   {
+    // gmtime() returns a pointer to a static struct tm that other
+    // threads may be changing, so the reentrant versions are used.
     time_t gmt = time(0);
-    const struct tm* t = gmtime(&gmt);
-    if ( t )
-      current_time = *t;
+#if defined(ON_COMPILER_MSC)
+    if ( 0 != gmtime_s(&current_time,&gmt) )
+      memset(&current_time,0,sizeof(current_time));
+#else
+    if ( 0 == gmtime_r(&gmt,&current_time) )
+      memset(&current_time,0,sizeof(current_time));
+#endif
   }
   m_last_edit_time = current_time;
 
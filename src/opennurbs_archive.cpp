@@ -148,6 +148,7 @@ ON_BinaryArchive::ON_BinaryArchive( ON::archive_mode mode )
   memset( &m_zlib.strm, 0, sizeof(m_zlib.strm) );
 
   m_V1_layer_list = 0;
+  m_deferred_reader = 0;
 }
 
 ON_BinaryArchive::~ON_BinaryArchive()
@@ -2838,6 +2839,7 @@ ON_BinaryArchive::WriteObject( const ON_Object& o )
 {
   // writes polymorphic object derived from ON_Object in a way that
   // it can be recreated from ON_BinaryArchive::ReadObject
+  ON_MemorySubsystemScope ms(ON_MEMORY_SUBSYSTEM_ARCHIVE);
   ON_UUID uuid;
   bool rc = false;
   const ON_ClassId* pID = o.ClassId();
@@ -3019,7 +3021,8 @@ bool ON_BinaryArchive::WriteObjectUserData( const ON_Object& object )
   const ON_UserData* ud;
   ON_UUID userdata_classid;
   
-  for (ud = object.m_userdata_list; ud && rc; ud = ud->m_userdata_next) 
+  // FirstUserData() replaces deferred user data with the real thing.
+  for (ud = object.FirstUserData(); ud && rc; ud = ud->m_userdata_next) 
   {
     if ( !ud->Archive() )
     {
@@ -3193,12 +3196,14 @@ int ON_BinaryArchive::ReadObject( ON_Object** ppObject )
     return 0;
   }
   *ppObject = 0;
+  ON_MemorySubsystemScope ms(ON_MEMORY_SUBSYSTEM_ARCHIVE);
   return ReadObjectHelper(ppObject);
 }
 
 int ON_BinaryArchive::ReadObject( ON_Object& object )
 {
   ON_Object* pObject = &object;
+  ON_MemorySubsystemScope ms(ON_MEMORY_SUBSYSTEM_ARCHIVE);
   return ReadObjectHelper(&pObject);
 }
 
@@ -3707,121 +3712,214 @@ bool ON_BinaryArchive::ReadObjectUserData( ON_Object& object )
       break;
     }
 
-    // attempt to get an instance of the userdata class that saved this information
-    ON_UserData* ud = 0;
-    for(;;)
+    if ( 0 != m_deferred_reader && m_deferred_reader->m_bDeferUserData )
     {
-      const ON_ClassId* udId = ON_ClassId::ClassId( ud_header.m_classid );
-      if ( 0 == udId ) 
-      {
-        // The application that created this userdata is not active
-        if ( !ON_UuidIsNil(ud_header.m_appid) )
-        {
-          // see if we can load the application
-          if ( 1 == LoadUserDataApplication(ud_header.m_appid) )
-          {
-            // try again
-            udId = ON_ClassId::ClassId( ud_header.m_classid );
-          }
-        }
+      // Attach a placeholder that remembers where the user data is.
+      ON_DeferredUserData* dud = new ON_DeferredUserData();
+      dud->m_userdata_uuid = ud_header.m_itemid;
+      dud->m_application_uuid = ud_header.m_appid;
+      dud->m_userdata_copycount = ud_header.m_copycount;
+      dud->m_userdata_xform = ud_header.m_xform;
+      dud->m_deferredclass_uuid = ud_header.m_classid;
+      dud->m_deferredapp_uuid = ud_header.m_appid;
+      dud->m_3dm_version = ud_header.m_3dm_version;
+      dud->m_3dm_opennurbs_version = ud_header.m_3dm_opennurbs_version;
+      dud->m_offset = CurrentPosition();
+      dud->m_length = length_TCODE_ANONYMOUS_CHUNK;
+      dud->SetReader(m_deferred_reader);
+
+      // skip the TCODE_ANONYMOUS_CHUNK
+      ON__UINT32 t = 0;
+      ON__INT64 length = 0;
+      rc = BeginRead3dmBigChunk( &t, &length );
+      if ( rc && !EndRead3dmChunk() )
+        rc = false;
+      if ( !rc || !object.AttachUserData( dud ) )
+        delete dud;
+      continue;
+    }
+
+    ON_UserData* ud = ReadObjectUserDataHelper( ud_header, length_TCODE_ANONYMOUS_CHUNK, object );
+    if ( 0 != ud )
+    {
+      if ( !object.AttachUserData( ud ) )
+        delete ud;
+    }
+  }
 
-        if ( 0 == udId )
+  return rc;
+}
+
+ON_UserData* ON_BinaryArchive::ReadObjectUserDataHelper(
+          CUserDataHeaderInfo& ud_header,
+          const ON__INT64 length_TCODE_ANONYMOUS_CHUNK,
+          ON_Object& object )
+{
+  // attempt to get an instance of the userdata class that saved this information
+  ON_UserData* ud = 0;
+  for(;;)
+  {
+    const ON_ClassId* udId = ON_ClassId::ClassId( ud_header.m_classid );
+    if ( 0 == udId ) 
+    {
+      // The application that created this userdata is not active
+      if ( !ON_UuidIsNil(ud_header.m_appid) )
+      {
+        // see if we can load the application
+        if ( 1 == LoadUserDataApplication(ud_header.m_appid) )
         {
-          // The application that created this user data is
-          // not available.  This information will be stored
-          // in an ON_UnknownUserData class so that it can
-          // persist.
-          udId = &ON_UnknownUserData::m_ON_UnknownUserData_class_id;
+          // try again
+          udId = ON_ClassId::ClassId( ud_header.m_classid );
         }
       }
 
-      ON_Object* tmp = udId->Create();
-      ud = ON_UserData::Cast(tmp);
-      if ( 0 == ud )
+      if ( 0 == udId )
       {
-        ON_ERROR("Reading object user data - unable to create userdata class");
-        if ( tmp )
-          delete tmp;
-        tmp = 0;
-        break;
+        // The application that created this user data is
+        // not available.  This information will be stored
+        // in an ON_UnknownUserData class so that it can
+        // persist.
+        udId = &ON_UnknownUserData::m_ON_UnknownUserData_class_id;
       }
-      tmp = 0;
-
-      break;
     }
 
+    ON_Object* tmp = udId->Create();
+    ud = ON_UserData::Cast(tmp);
     if ( 0 == ud )
     {
-      // no luck on this one 
-      // One reason can be that the plug-in userdata class has something wrong with 
-      // its ON_OBJECT_DECLARE/ON_OBJECT_IMPLEMENT stuff.
-      ON_ERROR("Unable to create object user data class. Flawed class id information.");
-      continue; // keep trying
+      ON_ERROR("Reading object user data - unable to create userdata class");
+      if ( tmp )
+        delete tmp;
+      tmp = 0;
+      break;
     }
+    tmp = 0;
+
+    break;
+  }
 
-    if ( ON_UuidIsNil(ud->m_application_uuid) )
+  if ( 0 == ud )
+  {
+    // no luck on this one 
+    // One reason can be that the plug-in userdata class has something wrong with 
+    // its ON_OBJECT_DECLARE/ON_OBJECT_IMPLEMENT stuff.
+    ON_ERROR("Unable to create object user data class. Flawed class id information.");
+    return 0;
+  }
+
+  if ( ON_UuidIsNil(ud->m_application_uuid) )
+  {
+    if ( ON_UuidIsNil(ud_header.m_appid) )
     {
-      if ( ON_UuidIsNil(ud_header.m_appid) )
+      switch( Archive3dmVersion())
       {
-        switch( Archive3dmVersion())
+      case 2:
+        // V2 archives do not contain app ids.
+        // This id flags the userdata as being read from a V3 archive.
+        ud_header.m_appid = ON_v2_userdata_id;
+        break;
+      case 3:
+        // V3 archives do not contain app ids.
+        // This id flags the userdata as being
+        // read from a V3 archive.
+        ud_header.m_appid = ON_v3_userdata_id;
+        break;
+      case 4:
+        if ( ArchiveOpenNURBSVersion() < 200909190 )
         {
-        case 2:
-          // V2 archives do not contain app ids.
-          // This id flags the userdata as being read from a V3 archive.
-          ud_header.m_appid = ON_v2_userdata_id;
-          break;
-        case 3:
-          // V3 archives do not contain app ids.
-          // This id flags the userdata as being
-          // read from a V3 archive.
-          ud_header.m_appid = ON_v3_userdata_id;
-          break;
-        case 4:
-          if ( ArchiveOpenNURBSVersion() < 200909190 )
-          {
-            // V4 archives before version 200909190
-            // did not require user data application ids.
-            ud_header.m_appid = ON_v4_userdata_id;
-          }
-          break;
+          // V4 archives before version 200909190
+          // did not require user data application ids.
+          ud_header.m_appid = ON_v4_userdata_id;
         }
-      }
-      ud->m_application_uuid = ud_header.m_appid;
-    }
-    ud->m_userdata_uuid = ud_header.m_itemid;
-    ud->m_userdata_copycount = ud_header.m_copycount;
-    ud->m_userdata_xform = ud_header.m_xform;
-    if ( ud->IsUnknownUserData() ) 
-    {
-      ON_UnknownUserData* uud = ON_UnknownUserData::Cast(ud);
-      if ( uud ) 
-      {
-        uud->m_sizeof_buffer = (int)length_TCODE_ANONYMOUS_CHUNK;
-        uud->m_unknownclass_uuid = ud_header.m_classid;
-        uud->m_3dm_version = ud_header.m_3dm_version;
-        uud->m_3dm_opennurbs_version = ud_header.m_3dm_opennurbs_version;
+        break;
       }
     }
-    ud->m_userdata_owner = &object; // so reading code can look at owner
-    bool bReadUserData = ReadObjectUserDataAnonymousChunk(
-              length_TCODE_ANONYMOUS_CHUNK,
-              ud_header.m_3dm_version,
-              ud_header.m_3dm_opennurbs_version,
-              ud
-              );
-    ud->m_userdata_owner = 0;
-    if (bReadUserData) 
+    ud->m_application_uuid = ud_header.m_appid;
+  }
+  ud->m_userdata_uuid = ud_header.m_itemid;
+  ud->m_userdata_copycount = ud_header.m_copycount;
+  ud->m_userdata_xform = ud_header.m_xform;
+  if ( ud->IsUnknownUserData() ) 
+  {
+    ON_UnknownUserData* uud = ON_UnknownUserData::Cast(ud);
+    if ( uud ) 
     {
-      if ( !object.AttachUserData( ud ) )
-        delete ud;
+      uud->m_sizeof_buffer = (int)length_TCODE_ANONYMOUS_CHUNK;
+      uud->m_unknownclass_uuid = ud_header.m_classid;
+      uud->m_3dm_version = ud_header.m_3dm_version;
+      uud->m_3dm_opennurbs_version = ud_header.m_3dm_opennurbs_version;
     }
-    else
-    {
-      delete ud;
-    }    
   }
+  ud->m_userdata_owner = &object; // so reading code can look at owner
+  bool bReadUserData = ReadObjectUserDataAnonymousChunk(
+            length_TCODE_ANONYMOUS_CHUNK,
+            ud_header.m_3dm_version,
+            ud_header.m_3dm_opennurbs_version,
+            ud
+            );
+  ud->m_userdata_owner = 0;
+  if ( !bReadUserData )
+  {
+    delete ud;
+    ud = 0;
+  }
+  return ud;
+}
 
-  return rc;
+ON_3dmDeferredReader* ON_BinaryArchive::DeferredReader() const
+{
+  return m_deferred_reader;
+}
+
+bool ON_BinaryArchive::BeginDeferredRead( 
+          ON__UINT64 offset, 
+          ON__UINT64* position, 
+          ON_SimpleArray<ON_3DM_BIG_CHUNK>& chunk 
+          )
+{
+  if ( !ReadMode() || 0 == offset )
+    return false;
+
+  // Deferred objects can be read while the archive is in the
+  // middle of a chunk, so the chunk stack is saved and the read
+  // starts with an empty stack.
+  *position = CurrentPosition();
+  chunk = m_chunk;
+  m_chunk.SetCount(0);
+  m_bDoChunkCRC = false;
+  if ( !BigSeekFromStart(offset) )
+  {
+    EndDeferredRead(*position,chunk);
+    return false;
+  }
+  return true;
+}
+
+bool ON_BinaryArchive::EndDeferredRead( 
+          ON__UINT64 position, 
+          ON_SimpleArray<ON_3DM_BIG_CHUNK>& chunk 
+          )
+{
+  m_chunk = chunk;
+  const ON_3DM_BIG_CHUNK* c = m_chunk.Last();
+  m_bDoChunkCRC = c && (c->m_do_crc16 || c->m_do_crc32);
+  return BigSeekFromStart(position);
+}
+
+ON_UserData* ON_BinaryArchive::ReadDeferredUserDataHelper( 
+          const ON_DeferredUserData& placeholder, 
+          ON_Object& object 
+          )
+{
+  CUserDataHeaderInfo ud_header;
+  ud_header.m_classid = placeholder.m_deferredclass_uuid;
+  ud_header.m_itemid = placeholder.m_userdata_uuid;
+  ud_header.m_appid = placeholder.m_deferredapp_uuid;
+  ud_header.m_3dm_version = placeholder.m_3dm_version;
+  ud_header.m_3dm_opennurbs_version = placeholder.m_3dm_opennurbs_version;
+  ud_header.m_copycount = placeholder.m_userdata_copycount;
+  ud_header.m_xform = placeholder.m_userdata_xform;
+  return ReadObjectUserDataHelper( ud_header, placeholder.m_length, object );
 }
 
 bool ON_BinaryArchive::Write3dmChunkVersion(
@@ -12268,6 +12366,12 @@ int ON_BinaryArchive::BadCRCCount() const
   return m_bad_CRC_count;
 }
 
+void ON_BinaryArchive::AddBadCRCCount( int bad_crc_count )
+{
+  if ( bad_crc_count > 0 )
+    m_bad_CRC_count += bad_crc_count;
+}
+
 unsigned int ON_BinaryArchive::ErrorMessageMask() const
 {
   return m_error_message_mask;
@@ -12679,6 +12783,130 @@ bool ON_BinaryFile::SeekFromStart( size_t offset )
   return rc;
 }
 
+ON_3dmDeferredReader::ON_3dmDeferredReader( FILE* fp )
+                    : m_bDeferMeshes(false),
+                      m_bDeferUserData(false),
+                      m_archive(ON::read3dm,fp),
+                      m_fp(fp),
+                      m_ref_count(1),
+                      m_lock(0),
+                      m_lock_depth(0),
+                      m_prev_holder(0)
+{
+  m_archive.m_deferred_reader = this;
+}
+
+ON_3dmDeferredReader::~ON_3dmDeferredReader()
+{
+  m_archive.m_deferred_reader = 0;
+  if ( 0 != m_fp )
+  {
+    ON::CloseFile(m_fp);
+    m_fp = 0;
+  }
+}
+
+void ON_3dmDeferredReader::AddRef()
+{
+  ON_ATOMIC_INCREMENT(&m_ref_count);
+}
+
+void ON_3dmDeferredReader::Release()
+{
+  if ( 0 == ON_ATOMIC_DECREMENT(&m_ref_count) )
+    delete this;
+}
+
+ON_BinaryArchive& ON_3dmDeferredReader::Archive()
+{
+  return m_archive;
+}
+
+// Most recent deferred reader whose lock the calling thread holds.
+// The readers a thread holds are linked through m_prev_holder.
+static ON_THREAD_LOCAL ON_3dmDeferredReader* s_deferred_reader_holder = 0;
+
+bool ON_3dmDeferredReader::BeginRead( bool* bDeferMeshes, bool* bDeferUserData )
+{
+  const ON_3dmDeferredReader* holder;
+  for ( holder = s_deferred_reader_holder; 0 != holder; holder = holder->m_prev_holder )
+  {
+    if ( this == holder )
+    {
+      // Reading deferred data used more deferred data from this
+      // reader.  BeginDeferredRead() saves the archive position,
+      // so the nested read can go ahead with the lock held.
+      m_lock_depth++;
+      *bDeferMeshes = m_bDeferMeshes;
+      *bDeferUserData = m_bDeferUserData;
+      return true;
+    }
+  }
+
+  while ( 0 != ON_ATOMIC_COMPARE_AND_SWAP(&m_lock,0,1) )
+  {
+    // spin - another thread is reading deferred data
+  }
+  m_lock_depth = 1;
+  m_prev_holder = s_deferred_reader_holder;
+  s_deferred_reader_holder = this;
+  // Everything in a deferred object is read now so nothing 
+  // needs the lock while it is held.
+  *bDeferMeshes = m_bDeferMeshes;
+  *bDeferUserData = m_bDeferUserData;
+  m_bDeferMeshes = false;
+  m_bDeferUserData = false;
+  return true;
+}
+
+void ON_3dmDeferredReader::EndRead( bool bDeferMeshes, bool bDeferUserData )
+{
+  m_bDeferMeshes = bDeferMeshes;
+  m_bDeferUserData = bDeferUserData;
+  if ( 0 == --m_lock_depth )
+  {
+    s_deferred_reader_holder = m_prev_holder;
+    m_prev_holder = 0;
+    ON_ATOMIC_COMPARE_AND_SWAP(&m_lock,1,0);
+  }
+}
+
+ON_Object* ON_3dmDeferredReader::ReadObject( ON__UINT64 offset )
+{
+  ON_Object* obj = 0;
+  ON__UINT64 position = 0;
+  ON_SimpleArray<ON_3DM_BIG_CHUNK> chunk;
+  bool bDeferMeshes, bDeferUserData;
+  BeginRead(&bDeferMeshes,&bDeferUserData);
+  if ( m_archive.BeginDeferredRead(offset,&position,chunk) )
+  {
+    if ( 1 != m_archive.ReadObject(&obj) && 0 != obj )
+    {
+      delete obj;
+      obj = 0;
+    }
+    m_archive.EndDeferredRead(position,chunk);
+  }
+  EndRead(bDeferMeshes,bDeferUserData);
+  return obj;
+}
+
+ON_UserData* ON_3dmDeferredReader::ReadUserData( const ON_DeferredUserData& placeholder, ON_Object& owner )
+{
+  ON_UserData* ud = 0;
+  ON__UINT64 position = 0;
+  ON_SimpleArray<ON_3DM_BIG_CHUNK> chunk;
+  bool bDeferMeshes, bDeferUserData;
+  BeginRead(&bDeferMeshes,&bDeferUserData);
+  if ( m_archive.BeginDeferredRead(placeholder.m_offset,&position,chunk) )
+  {
+    ud = m_archive.ReadDeferredUserDataHelper(placeholder,owner);
+    m_archive.EndDeferredRead(position,chunk);
+  }
+  EndRead(bDeferMeshes,bDeferUserData);
+  return ud;
+}
+
 ON_3dmGoo::ON_3dmGoo()
         : m_typecode(0),
           m_value(0),
@@ -14135,7 +14363,8 @@ void ON_Write3dmBufferArchive::AllocBuffer( size_t sz )
     if ( sz < 2*m_sizeof_buffer )
     {
       sz = 2*m_sizeof_buffer;
-      if ( sz > m_max_sizeof_buffer )
+      // m_max_sizeof_buffer = 0 means there is no limit
+      if ( m_max_sizeof_buffer > 0 && sz > m_max_sizeof_buffer )
         sz = m_max_sizeof_buffer;
     }
 
@@ -14229,10 +14458,12 @@ size_t ON_Write3dmBufferArchive::Write( size_t sz, const void* buffer )
   if ( m_buffer_position + sz > m_sizeof_buffer )
     return 0;
 
-  memcpy( m_buffer + m_sizeof_buffer, buffer, sz );
-  m_sizeof_buffer += sz;
-  if ( m_sizeof_buffer > m_sizeof_archive )
-    m_sizeof_archive = m_sizeof_buffer;
+  // m_sizeof_buffer is the size of the allocated buffer and
+  // the bytes go at the current position.
+  memcpy( m_buffer + m_buffer_position, buffer, sz );
+  m_buffer_position += sz;
+  if ( m_buffer_position > m_sizeof_archive )
+    m_sizeof_archive = m_buffer_position;
 
   return sz;
 }
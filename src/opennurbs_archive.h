@@ -143,6 +143,10 @@ class ON_3dmObjectAttributes;
 class ON_3dmGoo;
 
 class ON_BinaryArchive;
+class ON_UserData;
+class ON_3dmDeferredReader;
+class ON_DeferredUserData;
+class CUserDataHeaderInfo;
 
 // Used int ON_3dmProperties::Read() to set ON_BinaryArchive.m_3dm_opennurbs_version
 // Do not call directly. 
@@ -209,6 +213,15 @@ public:
 
   int BadCRCCount() const; // number of chunks read with bad CRC 
 
+  /*
+  Description:
+    Adds to BadCRCCount().  Used when chunks from this archive
+    are copied to memory and read by an ON_Read3dmBufferArchive.
+  Parameters:
+    bad_crc_count - [in] value of the buffer archive's BadCRCCount().
+  */
+  void AddBadCRCCount( int bad_crc_count );
+
   bool ReadByte( size_t, void* ); // must fail if mode is not read or readwrite
 
   bool WriteByte( size_t, const void* ); // must fail if mode is not write or readwrite
@@ -1535,6 +1548,17 @@ public:
   */
   bool ReadObjectUserData( ON_Object& object );
 
+  /*
+  Returns:
+    If this archive belongs to an ON_3dmDeferredReader, the 
+    reader is returned.  Otherwise NULL is returned.
+  Remarks:
+    ON_Brep::Read() and ReadObjectUserData() use the reader's
+    settings to decide if meshes and user data are read now or
+    when they are first used.
+  */
+  ON_3dmDeferredReader* DeferredReader() const;
+
   /*
   Description:
     If a 3dm archive is being read or written, then this is the
@@ -1879,6 +1903,19 @@ private:
           const int archive_opennurbs_version,
           class ON_UserData* ud );
 
+  ON_UserData* ReadObjectUserDataHelper(
+          CUserDataHeaderInfo& ud_header,
+          const ON__INT64 length_TCODE_ANONYMOUS_CHUNK,
+          ON_Object& object );
+
+  // Used by ON_3dmDeferredReader to read an object or user data
+  // from a saved position and then return to where it was.
+  friend class ON_3dmDeferredReader;
+  bool BeginDeferredRead( ON__UINT64 offset, ON__UINT64* position, ON_SimpleArray<ON_3DM_BIG_CHUNK>& chunk );
+  bool EndDeferredRead( ON__UINT64 position, ON_SimpleArray<ON_3DM_BIG_CHUNK>& chunk );
+  ON_UserData* ReadDeferredUserDataHelper( const ON_DeferredUserData& placeholder, ON_Object& object );
+  ON_3dmDeferredReader* m_deferred_reader;
+
 public:
   size_t SizeofChunkLength() const;
 
@@ -2018,6 +2055,102 @@ private:
   ON_BinaryFile& operator=( const ON_BinaryFile& ); // no implementation
 };
 
+/*
+Description:
+  Keeps a 3dm file open so brep render and analysis meshes and
+  object user data can be read the first time they are used 
+  instead of when the file is read.  See ONX_Model::m_bDeferMeshes
+  and ONX_Model::m_bDeferUserData.
+Example:
+
+          FILE* fp = ON::OpenFile(filename,"rb");
+          ON_3dmDeferredReader* reader = new ON_3dmDeferredReader(fp);
+          reader->m_bDeferMeshes = true;
+          ... read objects from reader->Archive() ...
+          reader->Release(); // objects keep their own references
+
+Remarks:
+  The reader is reference counted.  Brep faces and user data 
+  that were not read keep a reference, so the file stays open
+  until the last of them is read or destroyed.  Reading deferred
+  data is serialized by a lock.  The lock is recursive, so reading
+  deferred data may use other deferred data from the same reader,
+  for example when user data calls GetUserData() or Mesh() on its
+  owner while it is being read.
+  The lock protects the file, not the objects.  ON_BrepFace::Mesh(),
+  ON_Object::GetUserData() and ON_Object::FirstUserData() change
+  the object when they read deferred data, so they must not be
+  called on an object that another thread is using.  Call 
+  ON_Brep::ReadDeferredMeshes() and ON_Object::FirstUserData()
+  on one thread before sharing an object between threads.
+*/
+class ON_CLASS ON_3dmDeferredReader
+{
+public:
+  /*
+  Parameters:
+    fp - [in] pointer from ON::OpenFile(...,"rb").  The reader
+              closes the file when its last reference is released.
+  Remarks:
+    The new reader has a reference count of 1.
+  */
+  ON_3dmDeferredReader( FILE* fp );
+
+  void AddRef();
+  void Release();
+
+  /*
+  Returns:
+    The archive used to read the file.
+  */
+  ON_BinaryArchive& Archive();
+
+  /*
+  Description:
+    Reads an object whose TCODE_OPENNURBS_CLASS chunk begins 
+    at offset.  The archive position is restored.
+  Returns:
+    The object or NULL.  The caller must delete it.
+  */
+  ON_Object* ReadObject( ON__UINT64 offset );
+
+  /*
+  Description:
+    Reads the user data a placeholder stands for.
+  Parameters:
+    placeholder - [in]
+    owner - [in] object the user data will be attached to.
+  Returns:
+    The user data, not yet attached to owner, or NULL.
+  */
+  ON_UserData* ReadUserData( const ON_DeferredUserData& placeholder, ON_Object& owner );
+
+  // If true, ON_Brep::Read() records where face render and analysis
+  // meshes are and reads them when ON_BrepFace::Mesh() is called.
+  bool m_bDeferMeshes;
+
+  // If true, ON_BinaryArchive::ReadObjectUserData() attaches 
+  // ON_DeferredUserData placeholders that are replaced with the 
+  // real user data the first time they are used.
+  bool m_bDeferUserData;
+
+private:
+  ~ON_3dmDeferredReader();
+  bool BeginRead( bool* bDeferMeshes, bool* bDeferUserData );
+  void EndRead( bool bDeferMeshes, bool bDeferUserData );
+
+  ON_BinaryFile m_archive;
+  FILE* m_fp;
+  int m_ref_count;
+  int m_lock;
+  int m_lock_depth; // number of nested BeginRead() calls by the lock holder
+  ON_3dmDeferredReader* m_prev_holder; // reader the lock holder held before this one
+
+  // prohibit copy construction and operator=
+  ON_3dmDeferredReader( const ON_3dmDeferredReader& ); // no implementation
+  ON_3dmDeferredReader& operator=( const ON_3dmDeferredReader& ); // no implementation
+};
+
 class ON_CLASS ON_Read3dmBufferArchive : public ON_BinaryArchive
 {
 public:
@@ -592,6 +592,168 @@ int ON_UuidPair::Compare(const class ON_UuidPair* a,const class ON_UuidPair* b)
   return i;
 }
 
+ON_UuidHashTable::ON_UuidHashTable()
+: m_slots(0)
+, m_capacity(0)
+, m_used(0)
+, m_bValid(false)
+{
+}
+
+ON_UuidHashTable::~ON_UuidHashTable()
+{
+  Destroy();
+}
+
+ON_UuidHashTable::ON_UuidHashTable(const ON_UuidHashTable&)
+: m_slots(0)
+, m_capacity(0)
+, m_used(0)
+, m_bValid(false)
+{
+}
+
+ON_UuidHashTable& ON_UuidHashTable::operator=(const ON_UuidHashTable& src)
+{
+  if ( this != &src )
+    Invalidate();
+  return *this;
+}
+
+ON__UINT32 ON_UuidHashTable::Hash( const ON_UUID& id )
+{
+  // Mix all 16 bytes.  Sequentially generated ids often 
+  // differ only in Data1 or only in Data4.
+  ON__UINT32 w[4];
+  memcpy( w, &id, sizeof(w) );
+  ON__UINT32 h = w[0] ^ (w[1]*0x85EBCA6BU) ^ (w[2]*0xC2B2AE35U) ^ (w[3]*0x27D4EB2FU);
+  h ^= (h >> 16);
+  h *= 0x85EBCA6BU;
+  h ^= (h >> 13);
+  h *= 0xC2B2AE35U;
+  h ^= (h >> 16);
+  return h;
+}
+
+bool ON_UuidHashTable::IsValid() const
+{
+  return m_bValid;
+}
+
+void ON_UuidHashTable::Invalidate()
+{
+  m_bValid = false;
+  m_used = 0;
+}
+
+void ON_UuidHashTable::Destroy()
+{
+  if ( m_slots )
+  {
+    onfree(m_slots);
+    m_slots = 0;
+  }
+  m_capacity = 0;
+  m_used = 0;
+  m_bValid = false;
+}
+
+bool ON_UuidHashTable::Build( int count, const void* elements, size_t sizeof_element )
+{
+  m_bValid = false;
+  m_used = 0;
+  if ( count < 0 || (count > 0 && (0 == elements || sizeof_element < sizeof(ON_UUID))) )
+    return false;
+
+  // keep the load factor below 1/3 so the table can grow to
+  // 1/2 full before it is rebuilt
+  ON__UINT32 capacity = 32;
+  while ( capacity < 3*((ON__UINT32)count) && capacity < 0x40000000 )
+    capacity *= 2;
+  if ( capacity > m_capacity )
+  {
+    if ( m_slots )
+      onfree(m_slots);
+    m_capacity = 0;
+    m_slots = (ON__UINT32*)onmalloc( 2*capacity*sizeof(m_slots[0]) );
+    if ( 0 == m_slots )
+      return false;
+    m_capacity = capacity;
+  }
+  memset( m_slots, 0, 2*m_capacity*sizeof(m_slots[0]) );
+
+  const ON__UINT32 mask = m_capacity-1;
+  const char* e = (const char*)elements;
+  const ON_UUID* id;
+  ON__UINT32 h, i;
+  int j;
+  for ( j = 0; j < count; j++, e += sizeof_element )
+  {
+    id = (const ON_UUID*)e;
+    if ( ON_max_uuid == *id )
+      continue; // removed element
+    h = Hash(*id);
+    for ( i = h & mask; 0 != m_slots[2*i+1]; i = (i+1) & mask )
+    {
+      // empty loop
+    }
+    m_slots[2*i] = h;
+    m_slots[2*i+1] = (ON__UINT32)(j+1);
+    m_used++;
+  }
+
+  m_bValid = true;
+  return true;
+}
+
+void ON_UuidHashTable::Insert( int index, const void* elements, size_t sizeof_element )
+{
+  if ( !m_bValid || index < 0 )
+    return;
+
+  const ON_UUID* id = (const ON_UUID*)(((const char*)elements) + index*sizeof_element);
+  if ( ON_max_uuid == *id )
+    return;
+
+  if ( 2*(m_used+1) > m_capacity )
+  {
+    // grow
+    m_capacity = 0;
+    Build( index+1, elements, sizeof_element );
+    return;
+  }
+
+  const ON__UINT32 mask = m_capacity-1;
+  const ON__UINT32 h = Hash(*id);
+  ON__UINT32 i;
+  for ( i = h & mask; 0 != m_slots[2*i+1]; i = (i+1) & mask )
+  {
+    // empty loop
+  }
+  m_slots[2*i] = h;
+  m_slots[2*i+1] = (ON__UINT32)(index+1);
+  m_used++;
+}
+
+int ON_UuidHashTable::Find( const ON_UUID& id, const void* elements, size_t sizeof_element ) const
+{
+  if ( !m_bValid || 0 == m_used )
+    return -1;
+
+  // Elements removed after the table was built are set to ON_max_uuid
+  // and no longer match id, so their slots act as tombstones.
+  const ON__UINT32 mask = m_capacity-1;
+  const ON__UINT32 h = Hash(id);
+  const char* e = (const char*)elements;
+  ON__UINT32 i, j;
+  for ( i = h & mask; 0 != (j = m_slots[2*i+1]); i = (i+1) & mask )
+  {
+    if ( h == m_slots[2*i] && 0 == memcmp( &id, e + (j-1)*sizeof_element, sizeof(id) ) )
+      return (int)(j-1);
+  }
+  return -1;
+}
+
 ON_UuidList::ON_UuidList() 
                      : ON_SimpleArray<ON_UUID>(32),
                        m_sorted_count(0),
@@ -626,6 +788,7 @@ ON_UuidList& ON_UuidList::operator=(const ON_UuidList& src)
     ON_SimpleArray<ON_UUID>::operator=(src);
     m_sorted_count = src.m_sorted_count;
     m_removed_count = src.m_removed_count;
+    m_hash.Invalidate();
   }
   return *this;
 }
@@ -637,6 +800,7 @@ bool ON_UuidList::AddUuid(ON_UUID uuid, bool bCheckForDupicates)
   if (rc)
   {
     Append(uuid);
+    m_hash.Insert( m_count-1, m_a, sizeof(m_a[0]) );
   }
   return rc;
 }
@@ -657,6 +821,7 @@ void ON_UuidList::SortHelper()
   {
     // clean up array
     HeapSort(ON_UuidList::CompareUuid);
+    m_hash.Invalidate();
     while ( m_count > 0 && ON_max_uuid == m_a[m_count-1] )
     {
       m_count--;
@@ -682,11 +847,13 @@ void ON_UuidList::Empty()
   m_count = 0;
   m_sorted_count = 0;
   m_removed_count = 0;
+  m_hash.Invalidate();
 }
 
 void ON_UuidList::Destroy()
 {
   ON_SimpleArray<ON_UUID>::Destroy();
+  m_hash.Destroy();
   m_count = 0;
   m_sorted_count = 0;
   m_removed_count = 0;
@@ -732,6 +899,7 @@ bool ON_UuidList::Read( class ON_BinaryArchive& archive )
   m_count = 0;
   m_removed_count = 0;
   m_sorted_count = 0;
+  m_hash.Invalidate();
   int major_version = 0;
   int minor_version = 0;
   bool rc = archive.BeginRead3dmChunk( TCODE_ANONYMOUS_CHUNK, 
@@ -762,6 +930,19 @@ bool ON_UuidList::FindUuid(ON_UUID uuid) const
 
 ON_UUID* ON_UuidList::SearchHelper(const ON_UUID* uuid) const
 {
+  if ( m_count > 8 && ON_max_uuid != *uuid )
+  {
+    // Use the hash table.  (ON_max_uuid is used to mark 
+    // removed elements and is not in the hash table.)
+    if ( !m_hash.IsValid() )
+      const_cast<ON_UuidHashTable*>(&m_hash)->Build( m_count, m_a, sizeof(m_a[0]) );
+    if ( m_hash.IsValid() )
+    {
+      const int i = m_hash.Find( *uuid, m_a, sizeof(m_a[0]) );
+      return (i >= 0) ? (m_a+i) : 0;
+    }
+  }
+
   if ( m_count - m_sorted_count > 8 || m_removed_count > 0 )
   {
     // time to resort the array so that the speedy
@@ -828,6 +1009,7 @@ ON_UuidIndexList& ON_UuidIndexList::operator=(const ON_UuidIndexList& src)
     ON_SimpleArray<ON_UuidIndex>::operator=(src);
     m_sorted_count = src.m_sorted_count;
     m_removed_count = src.m_removed_count;
+    m_hash.Invalidate();
   }
   return *this;
 }
@@ -844,6 +1026,7 @@ bool ON_UuidIndexList::AddUuidIndex(ON_UUID uuid, int index, bool bCheckForDupic
       ON_UuidIndex& ui = AppendNew();
       ui.m_id = uuid;
       ui.m_i = index;
+      m_hash.Insert( m_count-1, m_a, sizeof(m_a[0]) );
     }
   }
   return rc;
@@ -859,6 +1042,7 @@ void ON_UuidIndexList::Empty()
   m_count = 0;
   m_sorted_count = 0;
   m_removed_count = 0;
+  m_hash.Invalidate();
 }
 
 void ON_UuidIndexList::Reserve( int capacity )
@@ -945,6 +1129,7 @@ ON_UuidPairList& ON_UuidPairList::operator=(const ON_UuidPairList& src)
     ON_SimpleArray<ON_UuidPair>::operator=(src);
     m_sorted_count = src.m_sorted_count;
     m_removed_count = src.m_removed_count;
+    m_hash.Invalidate();
   }
   return *this;
 }
@@ -965,6 +1150,7 @@ bool ON_UuidPairList::AddPair(ON_UUID id1, ON_UUID id2, bool bCheckForDupicates)
       ON_UuidPair& ui = AppendNew();
       ui.m_uuid[0] = id1;
       ui.m_uuid[1] = id2;
+      m_hash.Insert( m_count-1, m_a, sizeof(m_a[0]) );
     }
   }
   return rc;
@@ -980,6 +1166,7 @@ void ON_UuidPairList::Empty()
   m_count = 0;
   m_sorted_count = 0;
   m_removed_count = 0;
+  m_hash.Invalidate();
 }
 
 
@@ -1075,6 +1262,7 @@ void ON_UuidPairList::ImproveSearchSpeed()
   if ( ((unsigned int)m_count) > m_sorted_count )
   {
     HeapSort(compar_uuidpair_id1id2);
+    m_hash.Invalidate();
     if ( m_removed_count > 0 )
     {
       // cull removed items.  These get sorted to the
@@ -1095,6 +1283,19 @@ void ON_UuidPairList::ImproveSearchSpeed()
 
 ON_UuidPair* ON_UuidPairList::SearchHelper(const ON_UUID* id1) const
 {
+  if ( m_count > 8 && ON_max_uuid != *id1 )
+  {
+    // Use the hash table.  (ON_max_uuid is used to mark 
+    // removed elements and is not in the hash table.)
+    if ( !m_hash.IsValid() )
+      const_cast<ON_UuidHashTable*>(&m_hash)->Build( m_count, m_a, sizeof(m_a[0]) );
+    if ( m_hash.IsValid() )
+    {
+      const int i = m_hash.Find( *id1, m_a, sizeof(m_a[0]) );
+      return (i >= 0) ? (m_a+i) : 0;
+    }
+  }
+
   if ( m_count - m_sorted_count > 8 || m_removed_count > 0 )
   {
     // time to resort the array so that the speedy
@@ -1163,6 +1364,7 @@ void ON_UuidList::RemapUuids( const ON_SimpleArray<ON_UuidPair>& uuid_remap )
           m_sorted_count--;
         }
       }
+      m_hash.Invalidate();
     }
   }
 }
@@ -1204,6 +1406,7 @@ void ON_UuidIndexList::ImproveSearchSpeed()
   if ( ((unsigned int)m_count) > m_sorted_count )
   {
     HeapSort(compar_uuidindex_uuid);
+    m_hash.Invalidate();
     if ( m_removed_count > 0 )
     {
       // cull removed items.  These get sorted to the
@@ -1224,6 +1427,19 @@ void ON_UuidIndexList::ImproveSearchSpeed()
 
 ON_UuidIndex* ON_UuidIndexList::SearchHelper(const ON_UUID* uuid) const
 {
+  if ( m_count > 8 && ON_max_uuid != *uuid )
+  {
+    // Use the hash table.  (ON_max_uuid is used to mark 
+    // removed elements and is not in the hash table.)
+    if ( !m_hash.IsValid() )
+      const_cast<ON_UuidHashTable*>(&m_hash)->Build( m_count, m_a, sizeof(m_a[0]) );
+    if ( m_hash.IsValid() )
+    {
+      const int i = m_hash.Find( *uuid, m_a, sizeof(m_a[0]) );
+      return (i >= 0) ? (m_a+i) : 0;
+    }
+  }
+
   if ( m_count - m_sorted_count > 8 || m_removed_count > 0 )
   {
     // time to resort the array so that the speedy
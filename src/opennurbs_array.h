@@ -1113,6 +1113,105 @@ ON_DLL_TEMPLATE template class ON_CLASS ON_ClassArray<ON_SimpleArray<int> >;
 #endif
 
 
+/*
+Description:
+  The ON_UuidHashTable class is an open addressing hash
+  index used by ON_UuidList, ON_UuidIndexList and 
+  ON_UuidPairList to find uuids in their element arrays.
+  The table stores element indices, not elements, so the
+  lists keep their elements in the order they were added
+  until something sorts them.  Each element must begin 
+  with its ON_UUID key.  Elements whose key is ON_max_uuid
+  are treated as removed and are not indexed.
+*/
+class ON_CLASS ON_UuidHashTable
+{
+public:
+  ON_UuidHashTable();
+  ~ON_UuidHashTable();
+
+  // The copy constructor and operator= do not copy the
+  // table. The copy is rebuilt when it is needed.
+  ON_UuidHashTable(const ON_UuidHashTable& src);
+  ON_UuidHashTable& operator=(const ON_UuidHashTable& src);
+
+  static
+  ON__UINT32 Hash( const ON_UUID& id );
+
+  /*
+  Returns:
+    True if the table can be used for searching.
+  */
+  bool IsValid() const;
+
+  /*
+  Description:
+    Marks the table as out of date.  Call Invalidate()
+    when the element array is sorted or otherwise reordered.
+  */
+  void Invalidate();
+
+  /*
+  Description:
+    Invalidates the table and frees its memory.
+  */
+  void Destroy();
+
+  /*
+  Description:
+    Index an element array.
+  Parameters:
+    count - [in] number of elements
+    elements - [in] element array
+    sizeof_element - [in] size of an element in bytes
+  Returns:
+    True if successful.
+  */
+  bool Build( 
+    int count, 
+    const void* elements, 
+    size_t sizeof_element 
+    );
+
+  /*
+  Description:
+    Add an element to a valid table.  The table grows as
+    needed.  If the table is not valid, nothing is done.
+  Parameters:
+    index - [in] index of the new element.  Elements with
+      indices < index must already be in the table.
+    elements - [in] element array
+    sizeof_element - [in] size of an element in bytes
+  */
+  void Insert(
+    int index,
+    const void* elements, 
+    size_t sizeof_element 
+    );
+
+  /*
+  Parameters:
+    id - [in] id to search for.
+    elements - [in] element array used to build the table.
+    sizeof_element - [in] size of an element in bytes
+  Returns:
+    Index of the element whose key is id or -1 if
+    there is no such element.
+  */
+  int Find( 
+    const ON_UUID& id, 
+    const void* elements, 
+    size_t sizeof_element 
+    ) const;
+
+private:
+  // m_slots[2*i] = hash, m_slots[2*i+1] = element index + 1 (0 = empty)
+  ON__UINT32* m_slots;
+  ON__UINT32 m_capacity; // number of slots (a power of 2)
+  ON__UINT32 m_used;     // number of occupied slots
+  bool m_bValid;
+};
+
 /*
 Description:
   The ON_UuidList class provides a tool to efficiently 
@@ -1268,6 +1367,7 @@ private:
   ON_UUID* SearchHelper(const ON_UUID*) const;
   int m_sorted_count;
   int m_removed_count;
+  ON_UuidHashTable m_hash;
 };
 
 /*
@@ -1382,6 +1482,10 @@ public:
     a few searches between edits, then excessive calling
     of ImproveSearchSpeed() may actually decrease overall
     program performance.
+  Remarks:
+    Lists with more than 8 elements are searched with an
+    ON_UuidHashTable, so ImproveSearchSpeed() is only useful
+    for culling removed elements.  It sorts the list.
   */
   void ImproveSearchSpeed();
 
@@ -1389,6 +1493,7 @@ private:
   ON_UuidIndex* SearchHelper(const ON_UUID*) const;
   unsigned int m_sorted_count;
   unsigned int m_removed_count;
+  ON_UuidHashTable m_hash;
 };
 
 /*
@@ -1521,6 +1626,10 @@ public:
     a few searches between edits, then excessive calling
     of ImproveSearchSpeed() may actually decrease overall
     program performance.
+  Remarks:
+    Lists with more than 8 elements are searched with an
+    ON_UuidHashTable, so ImproveSearchSpeed() is only useful
+    for culling removed elements.  It sorts the list.
   */
   void ImproveSearchSpeed();
 
@@ -1528,6 +1637,7 @@ private:
   ON_UuidPair* SearchHelper(const ON_UUID*) const;
   unsigned int m_sorted_count;
   unsigned int m_removed_count;
+  ON_UuidHashTable m_hash;
 };
 
 class ON_CLASS ON_2dexMap : private ON_SimpleArray<ON_2dex>
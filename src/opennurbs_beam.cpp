@@ -2616,6 +2616,429 @@ ON_Brep* ON_Extrusion::BrepForm( ON_Brep* brep, bool bSmoothFaces ) const
   return newbrep;
 }
 
+class ON_ExtrusionMeshSampler
+{
+public:
+  // Divides a smooth piece of a 2d profile curve into a polyline.
+  ON_ExtrusionMeshSampler();
+
+  const ON_Curve* m_profile;
+  bool m_bLinear;
+  double m_tolerance;      // maximum distance from polyline to profile (0 = unused)
+  double m_cos_angle;      // minimum cosine of angle between adjacent tangents
+  double m_max_edge_length;
+  double m_min_edge_length;
+  int m_hint;
+
+  ON_SimpleArray<double>* m_t;
+  ON_3dPointArray* m_P;
+  ON_3dVectorArray* m_T;
+
+  bool Sample( double t0, double t1 );
+
+private:
+  void Subdivide( 
+    double ta, const ON_3dPoint& Pa, const ON_3dVector& Ta,
+    double tb, const ON_3dPoint& Pb, const ON_3dVector& Tb,
+    int depth
+    );
+
+  // distance from Q to the chord from Pa to Pa+D
+  static double ChordDistance( const ON_3dPoint& Pa, const ON_3dVector& D, double len, const ON_3dPoint& Q );
+};
+
+double ON_ExtrusionMeshSampler::ChordDistance( const ON_3dPoint& Pa, const ON_3dVector& D, double len, const ON_3dPoint& Q )
+{
+  return ( len > 0.0 )
+    ? fabs(D.x*(Q.y-Pa.y) - D.y*(Q.x-Pa.x))/len
+    : Q.DistanceTo(Pa);
+}
+
+ON_ExtrusionMeshSampler::ON_ExtrusionMeshSampler()
+: m_profile(0)
+, m_bLinear(false)
+, m_tolerance(0.0)
+, m_cos_angle(1.0)
+, m_max_edge_length(0.0)
+, m_min_edge_length(0.0)
+, m_hint(0)
+, m_t(0)
+, m_P(0)
+, m_T(0)
+{}
+
+bool ON_ExtrusionMeshSampler::Sample( double t0, double t1 )
+{
+  ON_3dPoint Pa, Pb;
+  ON_3dVector Ta, Tb;
+  int i;
+
+  if ( !m_profile->EvTangent( t0, Pa, Ta, 1, &m_hint ) )
+    return false;
+  m_t->Append(t0);
+  m_P->Append(Pa);
+  m_T->Append(Ta);
+
+  // Start at the span breaks so each polyline segment is inside a span.
+  const int span_count = m_profile->SpanCount();
+  ON_SimpleArray<double> s(span_count+1);
+  s.SetCount(span_count+1);
+  if ( span_count < 1 || !m_profile->GetSpanVector(s.Array()) )
+    return false;
+  s[span_count] = t1;
+  double ta = t0;
+  for ( i = 1; i <= span_count && ta < t1; i++ )
+  {
+    double tb = s[i];
+    if ( !(tb > ta) )
+      continue;
+    if ( tb > t1 )
+      tb = t1;
+    if ( !m_profile->EvTangent( tb, Pb, Tb, (tb < t1) ? 0 : -1, &m_hint ) )
+      return false;
+    Subdivide( ta, Pa, Ta, tb, Pb, Tb, 0 );
+    ta = tb;
+    Pa = Pb;
+    Ta = Tb;
+  }
+  return ( ta == t1 );
+}
+
+void ON_ExtrusionMeshSampler::Subdivide(
+    double ta, const ON_3dPoint& Pa, const ON_3dVector& Ta,
+    double tb, const ON_3dPoint& Pb, const ON_3dVector& Tb,
+    int depth
+    )
+{
+  const ON_3dVector D = Pb - Pa;
+  const double len = D.Length();
+  bool bSplit = false;
+  bool bHaveMid = false;
+  const double tm = 0.5*(ta+tb);
+  ON_3dPoint Pm;
+  ON_3dVector Tm;
+
+  if ( depth < 16 && ta < tm && tm < tb )
+  {
+    if ( m_max_edge_length > 0.0 && len > m_max_edge_length )
+      bSplit = true;
+    else if ( !m_bLinear && m_profile->EvTangent( tm, Pm, Tm, 0, &m_hint ) )
+    {
+      bHaveMid = true;
+      // Test the angle between tangents and the distance from the middle
+      // point to the chord first.  The quarter points, which catch S 
+      // shaped spans that are symmetric about their midpoint, are only
+      // evaluated when those cheaper tests pass.
+      double dev = ON_ExtrusionMeshSampler::ChordDistance(Pa,D,len,Pm);
+      if ( m_tolerance > 0.0 && dev > m_tolerance )
+        bSplit = true;
+      else if ( Ta*Tm < m_cos_angle || Tm*Tb < m_cos_angle )
+        bSplit = true;
+      else if ( m_tolerance > 0.0 )
+      {
+        double d = ON_ExtrusionMeshSampler::ChordDistance(Pa,D,len,m_profile->PointAt(0.5*(ta+tm)));
+        if ( d > dev )
+          dev = d;
+        if ( dev <= m_tolerance )
+        {
+          d = ON_ExtrusionMeshSampler::ChordDistance(Pa,D,len,m_profile->PointAt(0.5*(tm+tb)));
+          if ( d > dev )
+            dev = d;
+        }
+        bSplit = ( dev > m_tolerance );
+      }
+
+      if ( len < m_min_edge_length && dev < m_min_edge_length )
+        bSplit = false;
+      else if ( 0.0 == len )
+        bSplit = true; // closed span
+    }
+  }
+
+  if ( bSplit && !bHaveMid )
+    bSplit = m_profile->EvTangent( tm, Pm, Tm, 0, &m_hint ) ? true : false;
+
+  if ( bSplit )
+  {
+    Subdivide( ta, Pa, Ta, tm, Pm, Tm, depth+1 );
+    Subdivide( tm, Pm, Tm, tb, Pb, Tb, depth+1 );
+  }
+  else
+  {
+    m_t->Append(tb);
+    m_P->Append(Pb);
+    m_T->Append(Tb);
+  }
+}
+
+ON_Mesh* ON_Extrusion::CreateMesh( const ON_MeshParameters& mp, ON_Mesh* mesh ) const
+{
+  int i, k, r;
+
+  if ( mesh )
+    mesh->Destroy();
+
+  ON_SimpleArray<const ON_Curve*> profile_curves;
+  const int profile_count = GetProfileCurves(profile_curves);
+  if ( profile_count < 1 || profile_count != profile_curves.Count() || 0 == m_profile )
+    return 0;
+
+  const ON_3dVector T = m_path.Tangent();
+  if ( !T.IsUnitVector() )
+    return 0;
+  ON_Xform xform0(1.0), xform1(1.0);
+  if ( !ON_GetEndCapTransformation(m_path.PointAt(m_t.m_t[0]),T,m_up,m_bHaveN[0]?&m_N[0]:0,xform0,0,0) )
+    return 0;
+  if ( !ON_GetEndCapTransformation(m_path.PointAt(m_t.m_t[1]),T,m_up,m_bHaveN[1]?&m_N[1]:0,xform1,0,0) )
+    return 0;
+  const ON_Interval profile_domain = m_profile->Domain();
+
+  // The walls have the orientation of the extrusion surface. 
+  // See the SetIsSolid() call in BrepForm().
+  const bool bFlip = m_bTransposed;
+
+  // meshing tolerances
+  ON_BoundingBox bbox = BoundingBox();
+  double tolerance = (mp.m_tolerance > 0.0) ? mp.m_tolerance : 0.0;
+  if ( mp.m_relative_tolerance > 0.0 && mp.m_relative_tolerance < 1.0 && bbox.IsValid() )
+  {
+    double rel_tol = ON_MeshParameters::Tolerance(mp.m_relative_tolerance,bbox.Diagonal().Length());
+    if ( rel_tol < mp.m_min_tolerance )
+      rel_tol = mp.m_min_tolerance;
+    if ( rel_tol > 0.0 && (0.0 == tolerance || rel_tol < tolerance) )
+      tolerance = rel_tol;
+  }
+  double angle = mp.m_refine_angle;
+  if ( !(angle > 0.0) )
+    angle = mp.m_grid_angle;
+  if ( !(angle > 0.0 && angle < ON_PI) )
+    angle = 20.0*ON_PI/180.0;
+
+  ON_ExtrusionMeshSampler sampler;
+  sampler.m_tolerance = tolerance;
+  sampler.m_cos_angle = cos(angle);
+  sampler.m_max_edge_length = (mp.m_max_edge_length > 0.0) ? mp.m_max_edge_length : 0.0;
+  sampler.m_min_edge_length = (mp.m_min_edge_length > 0.0) ? mp.m_min_edge_length : 0.0;
+
+  // Divide the smooth segments of the profiles into polylines.
+  ON_SimpleArray<double> pt;      // profile parameters
+  ON_3dPointArray pP;             // 2d profile points
+  ON_3dVectorArray pT;            // unit profile tangents
+  ON_SimpleArray<ON_2dex> pieces; // (first sample, sample count) of each smooth segment
+  ON_SimpleArray<int> profile_piece_count(profile_count);
+  sampler.m_t = &pt;
+  sampler.m_P = &pP;
+  sampler.m_T = &pT;
+  for ( int profile_index = 0; profile_index < profile_count; profile_index++ )
+  {
+    const ON_Curve* profile = profile_curves[profile_index];
+    double t0 = ON_UNSET_VALUE;
+    double t1 = ON_UNSET_VALUE;
+    if ( 0 == profile || !profile->GetDomain(&t0,&t1) || !ON_IsValid(t0) || !(t0 < t1) )
+      return 0;
+    sampler.m_profile = profile;
+    sampler.m_bLinear = ( 1 == profile->Degree() );
+    sampler.m_hint = 0;
+    int piece_count = 0;
+    double ta = t0, tb;
+    while ( ta < t1 )
+    {
+      tb = t1;
+      if ( !GetNextProfileSegmentDiscontinuity( profile, ta, t1, &tb ) || !(ta < tb && tb <= t1) )
+        tb = t1;
+      ON_2dex& piece = pieces.AppendNew();
+      piece.i = pt.Count();
+      if ( !sampler.Sample(ta,tb) )
+        return 0;
+      piece.j = pt.Count() - piece.i;
+      if ( piece_count > 0 )
+      {
+        // Use identical locations where smooth pieces meet so the
+        // mesh vertices on either side of a kink match exactly.
+        pP[piece.i] = pP[piece.i-1];
+      }
+      piece_count++;
+      ta = tb;
+    }
+    if ( piece_count > 0 && profile->IsClosed() )
+      pP[pt.Count()-1] = pP[pieces[pieces.Count()-piece_count].i];
+    profile_piece_count.Append(piece_count);
+  }
+
+  // Divide the path when the maximum edge length requires it.
+  const ON_3dVector path_vector = xform1*ON_3dPoint::Origin - xform0*ON_3dPoint::Origin;
+  int path_count = 1;
+  if ( sampler.m_max_edge_length > 0.0 )
+  {
+    const double x = path_vector.Length()/sampler.m_max_edge_length;
+    path_count = ( x < 1024.0 ) ? ((int)ceil(x)) : 1024;
+    if ( path_count < 1 )
+      path_count = 1;
+  }
+
+  int is_capped = IsCapped();
+  if ( is_capped < 0 || is_capped > 3 )
+    is_capped = 0;
+
+  ON_Mesh* newmesh = mesh ? mesh : new ON_Mesh();
+  const int sample_count = pt.Count();
+  const bool bQuads = ( 1 != mp.m_face_type );
+  int vertex_count = sample_count*(path_count+1);
+  int face_count = (sample_count - pieces.Count())*path_count*(bQuads?1:2);
+  if ( is_capped )
+  {
+    vertex_count += 2*sample_count;
+    face_count += 2*sample_count;
+  }
+  newmesh->m_V.Reserve(vertex_count);
+  newmesh->m_N.Reserve(vertex_count);
+  newmesh->m_T.Reserve(vertex_count);
+  newmesh->m_F.Reserve(face_count);
+  ON_3dPointArray dV;
+  if ( mp.m_bDoublePrecision )
+    dV.Reserve(vertex_count);
+
+  // walls
+  ON_MeshFace f;
+  ON_3dPoint P;
+  ON_3dVector N, D, T0, T1;
+  for ( k = 0; k < pieces.Count(); k++ )
+  {
+    const int vi0 = newmesh->m_V.Count();
+    const int s0 = pieces[k].i;
+    const int s1 = s0 + pieces[k].j;
+    for ( i = s0; i < s1; i++ )
+    {
+      const ON_3dPoint B = xform0*pP[i];
+      const ON_3dPoint E = xform1*pP[i];
+      D = E - B;
+      T0 = xform0*pT[i];
+      T1 = xform1*pT[i];
+      const double u = profile_domain.NormalizedParameterAt(pt[i]);
+      for ( r = 0; r <= path_count; r++ )
+      {
+        const double v = ((double)r)/((double)path_count);
+        P = (r == path_count) ? E : B + v*D;
+        N = ON_CrossProduct( (1.0-v)*T0 + v*T1, D );
+        N.Unitize();
+        if ( bFlip )
+          N.Reverse();
+        newmesh->m_V.AppendNew() = P;
+        newmesh->m_N.AppendNew() = N;
+        if ( m_bTransposed )
+          newmesh->m_T.AppendNew().Set( (float)v, (float)u );
+        else
+          newmesh->m_T.AppendNew().Set( (float)u, (float)v );
+        if ( mp.m_bDoublePrecision )
+          dV.Append(P);
+      }
+    }
+    for ( i = 0; i < s1-s0-1; i++ )
+    {
+      for ( r = 0; r < path_count; r++ )
+      {
+        const int v00 = vi0 + i*(path_count+1) + r;
+        const int v01 = v00 + 1;
+        const int v10 = v00 + path_count+1;
+        const int v11 = v10 + 1;
+        f.vi[0] = v00;
+        f.vi[1] = bFlip ? v01 : v10;
+        f.vi[2] = v11;
+        f.vi[3] = bFlip ? v10 : v01;
+        if ( bQuads )
+          newmesh->m_F.Append(f);
+        else
+        {
+          const int vi3 = f.vi[3];
+          f.vi[3] = f.vi[2];
+          newmesh->m_F.Append(f);
+          f.vi[1] = f.vi[2];
+          f.vi[2] = f.vi[3] = vi3;
+          newmesh->m_F.Append(f);
+        }
+      }
+    }
+  }
+
+  // caps
+  if ( 0 != is_capped )
+  {
+    // The cap loops are the profile polylines without the duplicate
+    // points where smooth segments meet.
+    ON_SimpleArray<int> loop_point_count(profile_count);
+    ON_2dPointArray cap_points(sample_count);
+    ON_SimpleArray<ON_3dex> triangles;
+    int piece_index = 0;
+    for ( int profile_index = 0; profile_index < profile_count; profile_index++ )
+    {
+      const int cap_point_count0 = cap_points.Count();
+      for ( k = 0; k < profile_piece_count[profile_index]; k++, piece_index++ )
+      {
+        const ON_2dex& piece = pieces[piece_index];
+        for ( i = piece.i; i < piece.i + piece.j - 1; i++ )
+          cap_points.AppendNew().Set(pP[i].x,pP[i].y);
+      }
+      loop_point_count.Append( cap_points.Count() - cap_point_count0 );
+    }
+    if ( ON_Triangulate2dRegion( profile_count, loop_point_count.Array(), 2, &cap_points[0].x, triangles ) > 0 )
+    {
+      ON_BoundingBox cap_bbox;
+      cap_bbox.Set( 2, false, loop_point_count[0], 2, &cap_points[0].x, false );
+      const ON_Interval cap_x(cap_bbox.m_min.x,cap_bbox.m_max.x);
+      const ON_Interval cap_y(cap_bbox.m_min.y,cap_bbox.m_max.y);
+      for ( int end = 0; end < 2; end++ )
+      {
+        if ( 0 == (is_capped & (1<<end)) )
+          continue;
+        const ON_Xform& xform = end ? xform1 : xform0;
+        N = ON_CrossProduct( xform*ON_3dVector::XAxis, xform*ON_3dVector::YAxis );
+        N.Unitize();
+        // The top cap normal points along the path and the bottom cap normal
+        // points against the path. Both are reversed when the walls are.
+        const bool bReverse = ((0 == end) != bFlip);
+        if ( bReverse )
+          N.Reverse();
+        const int vi0 = newmesh->m_V.Count();
+        for ( i = 0; i < cap_points.Count(); i++ )
+        {
+          P = xform*ON_3dPoint(cap_points[i].x,cap_points[i].y,0.0);
+          newmesh->m_V.AppendNew() = P;
+          newmesh->m_N.AppendNew() = N;
+          newmesh->m_T.AppendNew().Set( (float)cap_x.NormalizedParameterAt(cap_points[i].x),
+                                        (float)cap_y.NormalizedParameterAt(cap_points[i].y) );
+          if ( mp.m_bDoublePrecision )
+            dV.Append(P);
+        }
+        for ( i = 0; i < triangles.Count(); i++ )
+        {
+          f.vi[0] = vi0 + triangles[i].i;
+          f.vi[1] = vi0 + (bReverse ? triangles[i].k : triangles[i].j);
+          f.vi[2] = f.vi[3] = vi0 + (bReverse ? triangles[i].j : triangles[i].k);
+          newmesh->m_F.Append(f);
+        }
+      }
+    }
+    else
+    {
+      // An uncapped mesh of a capped extrusion is not a valid
+      // render mesh.
+      ON_ERROR("ON_Extrusion::CreateMesh - unable to triangulate the caps.");
+      if ( newmesh != mesh )
+        delete newmesh;
+      return 0;
+    }
+  }
+
+  if ( mp.m_bDoublePrecision )
+  {
+    newmesh->DoublePrecisionVertices() = dV;
+    newmesh->SetDoublePrecisionVerticesAsValid();
+    newmesh->SetSinglePrecisionVerticesAsValid();
+  }
+
+  return newmesh;
+}
+
 bool ON_Extrusion::GetBrepFormComponentIndex(
   ON_COMPONENT_INDEX extrusion_ci,
   ON_COMPONENT_INDEX& brep_ci
@@ -133,6 +133,35 @@ public:
     ON_SumSurface* sum_surface 
     ) const;
 
+  /*
+  Description:
+    Create a render mesh of the extrusion without building the
+    brep form.  Each profile is divided into a polyline once and
+    the polyline is swept along the path.  The caps are 
+    triangulated from the profile polylines.
+  Parameters:
+    mp - [in]
+      The tolerance, relative tolerance, refine angle, maximum
+      and minimum edge length and face type settings are used.
+    mesh - [in]
+      If the mesh pointer is not null, then the mesh is 
+      constructed in mesh.  If the mesh pointer is null, then
+      an ON_Mesh is allocated on the heap.
+  Returns:
+    If successful, a pointer to the mesh. If unsuccessful, null.
+  Remarks:
+    The walls of each smooth profile segment and each cap have
+    their own vertices so the mesh normals are sharp at profile
+    kinks and cap edges.  The mesh normals agree with the
+    extrusion's surface normals and the cap normals point away
+    from the walls.  If the caps cannot be triangulated, null
+    is returned rather than a mesh without caps.
+  */
+  ON_Mesh* CreateMesh(
+    const ON_MeshParameters& mp,
+    ON_Mesh* mesh = NULL
+    ) const;
+
   /*
   Description:
     Convert a component index that identifies a part of this extrusion
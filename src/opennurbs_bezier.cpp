@@ -1054,6 +1054,611 @@ bool ON_Mesh::GetTightBoundingBox(
   return (0!=bGrowBox);
 }
 
+/*
+Tight bounding boxes of bezier curves and surfaces.
+
+Every piece is stored as homogeneous (x,y,z,w) control points.
+The end points (corners) of a piece are on the bezier, so they
+are added to the box.  If the convex hull of the control points
+is inside the box, the piece is done.  Otherwise the piece is
+split in half with de Casteljau's algorithm and both halves are
+tested.  The hull converges quadratically, so only the pieces
+near an extreme value are split more than a few times.
+When the hull is within a tolerance of the box, the hull is 
+added to the box, so the result always contains the bezier.
+*/
+
+#define ON_TBB_MAX_DEPTH 40
+
+static void ON_TBB_SetHomogeneousCV( 
+  int dim, 
+  int is_rat, 
+  const double* cv, 
+  const ON_Xform* xform, 
+  double* h 
+  )
+{
+  double x = cv[0];
+  double y = (dim > 1) ? cv[1] : 0.0;
+  double z = (dim > 2) ? cv[2] : 0.0;
+  double w = is_rat ? cv[dim] : 1.0;
+  if ( xform )
+  {
+    const double* m = &xform->m_xform[0][0];
+    h[0] = m[0]*x  + m[1]*y  + m[2]*z  + m[3]*w;
+    h[1] = m[4]*x  + m[5]*y  + m[6]*z  + m[7]*w;
+    h[2] = m[8]*x  + m[9]*y  + m[10]*z + m[11]*w;
+    h[3] = m[12]*x + m[13]*y + m[14]*z + m[15]*w;
+  }
+  else
+  {
+    h[0] = x;
+    h[1] = y;
+    h[2] = z;
+    h[3] = w;
+  }
+}
+
+static void ON_TBB_AddPoint( const double* h, ON_BoundingBox& box )
+{
+  const double w = 1.0/h[3];
+  const double p[3] = {w*h[0],w*h[1],w*h[2]};
+  double* bmin = &box.m_min.x;
+  double* bmax = &box.m_max.x;
+  int k;
+  if ( !(bmin[0] <= bmax[0]) )
+  {
+    for ( k = 0; k < 3; k++ )
+      bmin[k] = bmax[k] = p[k];
+    return;
+  }
+  for ( k = 0; k < 3; k++ )
+  {
+    if ( p[k] < bmin[k] ) 
+      bmin[k] = p[k]; 
+    else if ( p[k] > bmax[k] ) 
+      bmax[k] = p[k];
+  }
+}
+
+static bool ON_TBB_WeightsArePositive( int count, const double* h )
+{
+  for ( int i = 0; i < count; i++, h += 4 )
+  {
+    if ( !(h[3] > 0.0) )
+      return false;
+  }
+  return true;
+}
+
+// Returns how far the convex hull of the count points in h[]
+// sticks out of box.  The hull's box is returned in hull.
+static double ON_TBB_HullExcess( 
+  int count, 
+  const double* h, 
+  const ON_BoundingBox& box, 
+  ON_BoundingBox& hull 
+  )
+{
+  hull.Destroy();
+  for ( int i = 0; i < count; i++, h += 4 )
+    ON_TBB_AddPoint(h,hull);
+  double e = 0.0, d;
+  for ( int k = 0; k < 3; k++ )
+  {
+    d = box.m_min[k] - hull.m_min[k];
+    if ( d > e )
+      e = d;
+    d = hull.m_max[k] - box.m_max[k];
+    if ( d > e )
+      e = d;
+  }
+  return e;
+}
+
+// Splits the bezier at t = 1/2.  The left half replaces h[] and the
+// right half is returned in right[].  stride is the number of doubles
+// between homogeneous control points in both arrays.
+static void ON_TBB_Split( int order, int stride, double* h, double* right )
+{
+  const int n = order-1;
+  double* a;
+  double* b;
+  int i, j;
+  memcpy( right + n*stride, h + n*stride, 4*sizeof(h[0]) );
+  for ( j = 1; j <= n; j++ )
+  {
+    for ( i = n; i >= j; i-- )
+    {
+      a = h + i*stride;
+      b = a - stride;
+      a[0] = 0.5*(a[0]+b[0]);
+      a[1] = 0.5*(a[1]+b[1]);
+      a[2] = 0.5*(a[2]+b[2]);
+      a[3] = 0.5*(a[3]+b[3]);
+    }
+    memcpy( right + (n-j)*stride, h + n*stride, 4*sizeof(h[0]) );
+  }
+}
+
+static void ON_TBB_Curve( 
+  int order, 
+  double* h, 
+  double* ws, 
+  int depth, 
+  double tol, 
+  ON_BoundingBox& box 
+  )
+{
+  ON_BoundingBox hull;
+  const double e = ON_TBB_HullExcess(order,h,box,hull);
+  if ( e <= 0.0 )
+    return;
+  if ( e <= tol || depth >= ON_TBB_MAX_DEPTH )
+  {
+    box.Union(hull);
+    return;
+  }
+  double* right = ws + depth*order*4;
+  ON_TBB_Split(order,4,h,right);
+  ON_TBB_AddPoint(right,box); // point at the split is on the curve
+  ON_TBB_Curve(order,h,ws,depth+1,tol,box);
+  ON_TBB_Curve(order,right,ws,depth+1,tol,box);
+}
+
+// Returns the largest second difference of the control net
+// in direction dir.  The net is split in the direction where
+// it bends the most.
+static double ON_TBB_Bend( const int order[2], const double* h, int dir )
+{
+  const int stride = dir ? 4 : 4*order[1];
+  const int row_stride = dir ? 4*order[1] : 4;
+  const int n = order[dir];
+  const int row_count = order[1-dir];
+  double bend = 0.0, d, wa, wb, wc;
+  const double* a;
+  int i, j, k;
+  for ( j = 0; j < row_count; j++ )
+  {
+    a = h + j*row_stride;
+    for ( i = 2; i < n; i++, a += stride )
+    {
+      wa = 1.0/a[3];
+      wb = 1.0/a[stride+3];
+      wc = 1.0/a[2*stride+3];
+      for ( k = 0; k < 3; k++ )
+      {
+        d = fabs(wa*a[k] - 2.0*wb*a[stride+k] + wc*a[2*stride+k]);
+        if ( d > bend )
+          bend = d;
+      }
+    }
+  }
+  return bend;
+}
+
+static void ON_TBB_Surface( 
+  const int order[2], 
+  double* h, 
+  double* ws, 
+  int depth, 
+  double tol, 
+  ON_BoundingBox& box 
+  )
+{
+  const int cv_count = order[0]*order[1];
+  ON_BoundingBox hull;
+  const double e = ON_TBB_HullExcess(cv_count,h,box,hull);
+  if ( e <= 0.0 )
+    return;
+  if ( e <= tol || depth >= ON_TBB_MAX_DEPTH )
+  {
+    box.Union(hull);
+    return;
+  }
+
+  const double bend0 = ON_TBB_Bend(order,h,0);
+  const double bend1 = ON_TBB_Bend(order,h,1);
+  const int dir = ( bend0 > bend1 || (bend0 == bend1 && 0 == (depth%2)) ) ? 0 : 1;
+  double* right = ws + depth*cv_count*4;
+  int j;
+  if ( 0 == dir )
+  {
+    for ( j = 0; j < order[1]; j++ )
+      ON_TBB_Split(order[0],4*order[1],h+4*j,right+4*j);
+    // corners at the split are on the surface
+    ON_TBB_AddPoint(right,box);
+    ON_TBB_AddPoint(right+4*(order[1]-1),box);
+  }
+  else
+  {
+    for ( j = 0; j < order[0]; j++ )
+      ON_TBB_Split(order[1],4,h+4*j*order[1],right+4*j*order[1]);
+    ON_TBB_AddPoint(right,box);
+    ON_TBB_AddPoint(right+4*(order[0]-1)*order[1],box);
+  }
+  ON_TBB_Surface(order,h,ws,depth+1,tol,box);
+  ON_TBB_Surface(order,right,ws,depth+1,tol,box);
+}
+
+/*
+Parameters:
+  order - [in] order[0] = curve order, or order[0],order[1] = surface orders
+  piece_count - [in]
+  h - [in/out] piece_count*order[0]*order[1]*4 homogeneous control points.
+               The values are destroyed.
+  box - [in/out] input box is grown.
+*/
+static bool ON_TBB_GetBox( 
+  int dir_count,
+  const int order[2],
+  int piece_count,
+  double* h,
+  ON_BoundingBox& box
+  )
+{
+  const int cv_count = (2 == dir_count) ? order[0]*order[1] : order[0];
+  const int count = piece_count*cv_count;
+  if ( piece_count <= 0 || order[0] < 2 || (2 == dir_count && order[1] < 2) )
+    return false;
+  if ( !ON_TBB_WeightsArePositive(count,h) )
+    return false;
+
+  ON_BoundingBox hull;
+  ON_TBB_HullExcess(count,h,box,hull);
+  const double tol = ON_SQRT_EPSILON*hull.Diagonal().MaximumCoordinate();
+
+  // Adding the end points (corners) of every piece first makes
+  // the box big enough that most pieces are accepted right away.
+  int i;
+  double* p;
+  for ( i = 0, p = h; i < piece_count; i++, p += 4*cv_count )
+  {
+    ON_TBB_AddPoint(p,box);
+    if ( 2 == dir_count )
+    {
+      ON_TBB_AddPoint(p + 4*(order[1]-1),box);
+      ON_TBB_AddPoint(p + 4*(order[0]-1)*order[1],box);
+    }
+    ON_TBB_AddPoint(p + 4*(cv_count-1),box);
+  }
+
+  double stack_ws[2560];
+  const int sizeof_ws = ON_TBB_MAX_DEPTH*cv_count*4;
+  double* ws = ( sizeof_ws <= (int)(sizeof(stack_ws)/sizeof(stack_ws[0])) )
+             ? stack_ws
+             : (double*)onmalloc(sizeof_ws*sizeof(ws[0]));
+  if ( 0 == ws )
+    return false;
+
+  for ( i = 0, p = h; i < piece_count; i++, p += 4*cv_count )
+  {
+    if ( 2 == dir_count )
+      ON_TBB_Surface(order,p,ws,0,tol,box);
+    else
+      ON_TBB_Curve(order[0],p,ws,0,tol,box);
+  }
+
+  if ( ws != stack_ws )
+    onfree(ws);
+
+  return box.IsValid();
+}
+
+static void ON_TBB_SetResult( 
+  const ON_BoundingBox& bbox, 
+  ON_BoundingBox& tight_bbox, 
+  int bGrowBox 
+  )
+{
+  if ( bGrowBox )
+    tight_bbox.Union(bbox);
+  else
+    tight_bbox = bbox;
+}
+
+/*
+The cached boxes in ON_NurbsCurve and ON_NurbsSurface are filled 
+by const GetTightBoundingBox() calls, which may run on several 
+threads at once.  The box and its CRC are copied in and out while
+this lock is held so no thread sees a partly written cache.
+*/
+static int g_tbb_cache_lock = 0;
+
+static bool ON_TBB_GetCache( 
+  const ON_BoundingBox& cache_bbox,
+  const ON__UINT32& cache_crc,
+  ON__UINT32 crc,
+  ON_BoundingBox& bbox
+  )
+{
+  bool rc;
+  while ( 0 != ON_ATOMIC_COMPARE_AND_SWAP(&g_tbb_cache_lock,0,1) )
+  {
+    // spin - the lock is only held for a copy
+  }
+  rc = cache_bbox.IsValid() && crc == cache_crc;
+  if ( rc )
+    bbox = cache_bbox;
+  ON_ATOMIC_COMPARE_AND_SWAP(&g_tbb_cache_lock,1,0);
+  return rc;
+}
+
+static void ON_TBB_SetCache( 
+  ON_BoundingBox& cache_bbox,
+  ON__UINT32& cache_crc,
+  ON__UINT32 crc,
+  const ON_BoundingBox& bbox
+  )
+{
+  while ( 0 != ON_ATOMIC_COMPARE_AND_SWAP(&g_tbb_cache_lock,0,1) )
+  {
+    // spin - the lock is only held for a copy
+  }
+  cache_bbox = bbox;
+  cache_crc = crc;
+  ON_ATOMIC_COMPARE_AND_SWAP(&g_tbb_cache_lock,1,0);
+}
+
+bool ON_BezierCurve::GetTightBoundingBox( 
+		ON_BoundingBox& tight_bbox, 
+    int bGrowBox,
+		const ON_Xform* xform
+    ) const
+{
+  if ( bGrowBox && !tight_bbox.IsValid() )
+  {
+    bGrowBox = false;
+  }
+  if ( xform && xform->IsIdentity() )
+  {
+    xform = 0;
+  }
+  if ( m_order < 2 || m_dim < 1 || 0 == m_cv )
+    return false;
+
+  ON_SimpleArray<double> h(4*m_order);
+  h.SetCount(4*m_order);
+  for ( int i = 0; i < m_order; i++ )
+    ON_TBB_SetHomogeneousCV(m_dim,m_is_rat,CV(i),xform,h.Array()+4*i);
+
+  ON_BoundingBox bbox;
+  if ( bGrowBox )
+    bbox = tight_bbox;
+  const int order[2] = {m_order,0};
+  if ( !ON_TBB_GetBox(1,order,1,h.Array(),bbox) )
+    return false;
+  tight_bbox = bbox;
+  return true;
+}
+
+bool ON_BezierSurface::GetTightBoundingBox( 
+		ON_BoundingBox& tight_bbox, 
+    int bGrowBox,
+		const ON_Xform* xform
+    ) const
+{
+  if ( bGrowBox && !tight_bbox.IsValid() )
+  {
+    bGrowBox = false;
+  }
+  if ( xform && xform->IsIdentity() )
+  {
+    xform = 0;
+  }
+  if ( m_order[0] < 2 || m_order[1] < 2 || m_dim < 1 || 0 == m_cv )
+    return false;
+
+  const int cv_count = m_order[0]*m_order[1];
+  ON_SimpleArray<double> h(4*cv_count);
+  h.SetCount(4*cv_count);
+  int i, j;
+  for ( i = 0; i < m_order[0]; i++ )
+  {
+    for ( j = 0; j < m_order[1]; j++ )
+      ON_TBB_SetHomogeneousCV(m_dim,m_is_rat,CV(i,j),xform,h.Array()+4*(i*m_order[1]+j));
+  }
+
+  ON_BoundingBox bbox;
+  if ( bGrowBox )
+    bbox = tight_bbox;
+  if ( !ON_TBB_GetBox(2,m_order,1,h.Array(),bbox) )
+    return false;
+  tight_bbox = bbox;
+  return true;
+}
+
+bool ON_NurbsCurve::GetTightBoundingBox( 
+		ON_BoundingBox& tight_bbox, 
+    int bGrowBox,
+		const ON_Xform* xform
+    ) const
+{
+  if ( bGrowBox && !tight_bbox.IsValid() )
+  {
+    bGrowBox = false;
+  }
+  if ( xform && xform->IsIdentity() )
+  {
+    xform = 0;
+  }
+  if ( m_order < 2 || m_cv_count < m_order || m_dim < 1 || 0 == m_cv || 0 == m_knot )
+    return false;
+
+  ON__UINT32 crc = 0;
+  if ( 0 == xform )
+  {
+    ON_BoundingBox cached_bbox;
+    crc = DataCRC(0);
+    if ( ON_TBB_GetCache(m_tight_bbox,m_tight_bbox_crc,crc,cached_bbox) )
+    {
+      ON_TBB_SetResult(cached_bbox,tight_bbox,bGrowBox);
+      return true;
+    }
+  }
+
+  // convert the spans to homogeneous bezier control points
+  const int span_count = m_cv_count - m_order + 1;
+  ON_SimpleArray<double> h(4*m_order*span_count);
+  int span_index, piece_count = 0, i;
+  for ( span_index = 0; span_index < span_count; span_index++ )
+  {
+    const double* knot = m_knot + span_index;
+    if ( !(knot[m_order-2] < knot[m_order-1]) )
+      continue;
+    double* p = h.Array() + 4*m_order*piece_count;
+    for ( i = 0; i < m_order; i++ )
+      ON_TBB_SetHomogeneousCV(m_dim,m_is_rat,CV(span_index+i),xform,p+4*i);
+    ON_ConvertNurbSpanToBezier(4,m_order,4,p,knot,knot[m_order-2],knot[m_order-1]);
+    piece_count++;
+  }
+  h.SetCount(4*m_order*piece_count);
+
+  ON_BoundingBox bbox;
+  const int order[2] = {m_order,0};
+  if ( !ON_TBB_GetBox(1,order,piece_count,h.Array(),bbox) )
+  {
+    // weights are not positive - use the control polygon
+    return ON_Geometry::GetTightBoundingBox(tight_bbox,bGrowBox,xform);
+  }
+
+  if ( 0 == xform )
+  {
+    // runtime cache - does not change the curve
+    ON_NurbsCurve* p = const_cast<ON_NurbsCurve*>(this);
+    ON_TBB_SetCache(p->m_tight_bbox,p->m_tight_bbox_crc,crc,bbox);
+  }
+  ON_TBB_SetResult(bbox,tight_bbox,bGrowBox);
+  return true;
+}
+
+bool ON_NurbsSurface::GetTightBoundingBox( 
+		ON_BoundingBox& tight_bbox, 
+    int bGrowBox,
+		const ON_Xform* xform
+    ) const
+{
+  if ( bGrowBox && !tight_bbox.IsValid() )
+  {
+    bGrowBox = false;
+  }
+  if ( xform && xform->IsIdentity() )
+  {
+    xform = 0;
+  }
+  if (    m_order[0] < 2 || m_order[1] < 2 
+       || m_cv_count[0] < m_order[0] || m_cv_count[1] < m_order[1]
+       || m_dim < 1 || 0 == m_cv || 0 == m_knot[0] || 0 == m_knot[1] )
+    return false;
+
+  ON__UINT32 crc = 0;
+  if ( 0 == xform )
+  {
+    ON_BoundingBox cached_bbox;
+    crc = DataCRC(0);
+    if ( ON_TBB_GetCache(m_tight_bbox,m_tight_bbox_crc,crc,cached_bbox) )
+    {
+      ON_TBB_SetResult(cached_bbox,tight_bbox,bGrowBox);
+      return true;
+    }
+  }
+
+  // convert the bispans to homogeneous bezier control points
+  const int span_count0 = m_cv_count[0] - m_order[0] + 1;
+  const int span_count1 = m_cv_count[1] - m_order[1] + 1;
+  const int cv_count = m_order[0]*m_order[1];
+  ON_SimpleArray<double> h(4*cv_count*span_count0*span_count1);
+  ON_BezierSurface bez;
+  int span_index0, span_index1, piece_count = 0, i, j;
+  for ( span_index0 = 0; span_index0 < span_count0; span_index0++ )
+  {
+    for ( span_index1 = 0; span_index1 < span_count1; span_index1++ )
+    {
+      if ( !ConvertSpanToBezier(span_index0,span_index1,bez) )
+        continue; // empty span
+      double* p = h.Array() + 4*cv_count*piece_count;
+      for ( i = 0; i < m_order[0]; i++ )
+      {
+        for ( j = 0; j < m_order[1]; j++ )
+          ON_TBB_SetHomogeneousCV(m_dim,m_is_rat,bez.CV(i,j),xform,p+4*(i*m_order[1]+j));
+      }
+      piece_count++;
+    }
+  }
+  h.SetCount(4*cv_count*piece_count);
+
+  ON_BoundingBox bbox;
+  if ( !ON_TBB_GetBox(2,m_order,piece_count,h.Array(),bbox) )
+  {
+    // weights are not positive - use the control net
+    return ON_Geometry::GetTightBoundingBox(tight_bbox,bGrowBox,xform);
+  }
+
+  if ( 0 == xform )
+  {
+    // runtime cache - does not change the surface
+    ON_NurbsSurface* p = const_cast<ON_NurbsSurface*>(this);
+    ON_TBB_SetCache(p->m_tight_bbox,p->m_tight_bbox_crc,crc,bbox);
+  }
+  ON_TBB_SetResult(bbox,tight_bbox,bGrowBox);
+  return true;
+}
+
+bool ON_Curve::GetTightBoundingBox( 
+		ON_BoundingBox& tight_bbox, 
+    int bGrowBox,
+		const ON_Xform* xform
+    ) const
+{
+  // Curves with simple shapes override this function.
+  // Everything else uses the NURBS form.
+  ON_NurbsCurve nurbs_curve;
+  if ( GetNurbForm(nurbs_curve) )
+    return nurbs_curve.GetTightBoundingBox(tight_bbox,bGrowBox,xform);
+  return ON_Geometry::GetTightBoundingBox(tight_bbox,bGrowBox,xform);
+}
+
+bool ON_Surface::GetTightBoundingBox( 
+		ON_BoundingBox& tight_bbox, 
+    int bGrowBox,
+		const ON_Xform* xform
+    ) const
+{
+  ON_NurbsSurface nurbs_surface;
+  if ( GetNurbForm(nurbs_surface) )
+    return nurbs_surface.GetTightBoundingBox(tight_bbox,bGrowBox,xform);
+  return ON_Geometry::GetTightBoundingBox(tight_bbox,bGrowBox,xform);
+}
+
+bool ON_CurveProxy::GetTightBoundingBox( 
+		ON_BoundingBox& tight_bbox, 
+    int bGrowBox,
+		const ON_Xform* xform
+    ) const
+{
+  // Reversing does not change the box, so a proxy for all of 
+  // the real curve can use the real curve's (cached) box.
+  if ( 0 != m_real_curve 
+       && m_real_curve != this 
+       && m_real_curve_domain == m_real_curve->Domain() )
+  {
+    return m_real_curve->GetTightBoundingBox(tight_bbox,bGrowBox,xform);
+  }
+  return ON_Curve::GetTightBoundingBox(tight_bbox,bGrowBox,xform);
+}
+
+bool ON_SurfaceProxy::GetTightBoundingBox( 
+		ON_BoundingBox& tight_bbox, 
+    int bGrowBox,
+		const ON_Xform* xform
+    ) const
+{
+  // Transposing does not change the box.
+  if ( 0 != m_surface && m_surface != this )
+    return m_surface->GetTightBoundingBox(tight_bbox,bGrowBox,xform);
+  return ON_Surface::GetTightBoundingBox(tight_bbox,bGrowBox,xform);
+}
+
 
 
 bool ON_BezierCurve::Transform( 
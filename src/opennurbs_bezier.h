@@ -280,6 +280,34 @@ public:
   //   Axis aligned bounding box.
   ON_BoundingBox BoundingBox() const;
 
+  /*
+	Description:
+    Get tight bounding box of the bezier.
+	Parameters:
+		tight_bbox - [in/out] tight bounding box
+		bGrowBox -[in]	(default=false)			
+      If true and the input tight_bbox is valid, then returned
+      tight_bbox is the union of the input tight_bbox and the 
+      tight bounding box of the bezier curve.
+		xform -[in] (default=NULL)
+      If not NULL, the tight bounding box of the transformed
+      bezier is calculated.  The bezier curve is not modified.
+	Returns:
+    True if the returned tight_bbox is set to a valid 
+    bounding box.  False if the bezier is not valid or
+    has weights that are not positive.
+  Remarks:
+    The bezier is subdivided until the convex hull of every 
+    piece is inside the box or within ON_SQRT_EPSILON*(size
+    of the bezier) of it, so the box always contains the 
+    bezier curve.
+  */
+	bool GetTightBoundingBox( 
+			ON_BoundingBox& tight_bbox, 
+      int bGrowBox = false,
+			const ON_Xform* xform = 0
+      ) const;
+
   // Description:
   //   Transform the bezier.
   // Parameters:
@@ -1240,6 +1268,31 @@ public:
 
   ON_BoundingBox BoundingBox() const;
 
+  /*
+	Description:
+    Get tight bounding box of the bezier surface.
+	Parameters:
+		tight_bbox - [in/out] tight bounding box
+		bGrowBox -[in]	(default=false)			
+      If true and the input tight_bbox is valid, then returned
+      tight_bbox is the union of the input tight_bbox and the 
+      tight bounding box of the bezier surface.
+		xform -[in] (default=NULL)
+      If not NULL, the tight bounding box of the transformed
+      bezier is calculated.  The bezier surface is not modified.
+	Returns:
+    True if the returned tight_bbox is set to a valid 
+    bounding box.  False if the bezier is not valid or
+    has weights that are not positive.
+  See Also:
+    ON_BezierCurve::GetTightBoundingBox
+  */
+	bool GetTightBoundingBox( 
+			ON_BoundingBox& tight_bbox, 
+      int bGrowBox = false,
+			const ON_Xform* xform = 0
+      ) const;
+
   bool Transform( 
          const ON_Xform&
          );
@@ -2074,6 +2127,24 @@ public:
             ON_3dPoint point 
             ) const;
 
+  /*
+  Description:
+    Override of virtual ON_SpaceMorph::MorphPoints.
+    The Bernstein basis values are computed with 
+    precomputed binomial coefficients and the cage is
+    evaluated without any per point memory allocation.
+    It does not change the morph and is safe to call from
+    several threads, so SetThreadCount() can be used to
+    morph long point lists in parallel.
+  Parameters:
+    count - [in] number of points
+    points - [in/out] points to morph
+  */
+  void MorphPoints(
+          int count,
+          ON_3dPoint* points
+          ) const;
+
   /*
   Description:
     Create a Bezier volume.
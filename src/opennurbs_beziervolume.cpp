@@ -1221,6 +1221,125 @@ ON_3dPoint ON_BezierCageMorph::MorphPoint(
   return Q;
 }
 
+static void ON_BernsteinBasisHelper( int degree, const double* binom, double t, double* B )
+{
+  // B[i] = binom[i]*t^i*(1-t)^(degree-i)
+  const double s = 1.0-t;
+  double x = 1.0;
+  int i;
+  for ( i = 0; i <= degree; i++ )
+  {
+    B[i] = binom[i]*x;
+    x *= t;
+  }
+  x = 1.0;
+  for ( i = degree; i >= 0; i-- )
+  {
+    B[i] *= x;
+    x *= s;
+  }
+}
+
+void ON_BezierCageMorph::MorphPoints(
+          int count,
+          ON_3dPoint* points
+          ) const
+{
+  if ( !m_bValid || count <= 0 || 0 == points )
+    return;
+
+  const ON_BezierCage& cage = m_rst2xyz;
+  const int d0 = cage.m_order[0]-1;
+  const int d1 = cage.m_order[1]-1;
+  const int d2 = cage.m_order[2]-1;
+  if (    3 != cage.m_dim 
+       || 0 == cage.m_cv 
+       || d0 < 0 || d1 < 0 || d2 < 0
+       || d0+d1+d2+3 > 64 
+     )
+  {
+    // unusual cages use ON_BezierCage::Evaluate()
+    ON_SpaceMorph::MorphPoints(count,points);
+    return;
+  }
+
+  // The binomial coefficients are computed once for all the points.
+  double binom[64], Barray[64];
+  double* C0 = binom;
+  double* C1 = C0 + (d0+1);
+  double* C2 = C1 + (d1+1);
+  double* B0 = Barray;
+  double* B1 = B0 + (d0+1);
+  double* B2 = B1 + (d1+1);
+  int i, j, k;
+  for ( i = 0; i <= d0; i++ )
+    C0[i] = ON_BinomialCoefficient(d0-i,i);
+  for ( j = 0; j <= d1; j++ )
+    C1[j] = ON_BinomialCoefficient(d1-j,j);
+  for ( k = 0; k <= d2; k++ )
+    C2[k] = ON_BinomialCoefficient(d2-k,k);
+
+  const int cvdim = cage.m_is_rat ? 4 : 3;
+  const int cv_stride0 = cage.m_cv_stride[0];
+  const int cv_stride1 = cage.m_cv_stride[1];
+  const int cv_stride2 = cage.m_cv_stride[2];
+  const double* CVi;
+  const double* CVij;
+  const double* CVijk;
+  double b, x, y, z, w, xi, yi, zi, wi, xij, yij, zij, wij;
+  ON_3dPoint rst;
+
+  while ( count-- )
+  {
+    rst = m_xyz2rst*(*points);
+    ON_BernsteinBasisHelper(d0,C0,rst.x,B0);
+    ON_BernsteinBasisHelper(d1,C1,rst.y,B1);
+    ON_BernsteinBasisHelper(d2,C2,rst.z,B2);
+
+    // Contract one direction at a time.  The short sums
+    // are independent and keep the floating point pipeline full.
+    x = y = z = w = 0.0;
+    for ( i = 0, CVi = cage.m_cv; i <= d0; i++, CVi += cv_stride0 )
+    {
+      xi = yi = zi = wi = 0.0;
+      for ( j = 0, CVij = CVi; j <= d1; j++, CVij += cv_stride1 )
+      {
+        xij = yij = zij = wij = 0.0;
+        for ( k = 0, CVijk = CVij; k <= d2; k++, CVijk += cv_stride2 )
+        {
+          b = B2[k];
+          xij += b*CVijk[0];
+          yij += b*CVijk[1];
+          zij += b*CVijk[2];
+          wij += b*CVijk[cvdim-1]; // weight when the cage is rational
+        }
+        b = B1[j];
+        xi += b*xij;
+        yi += b*yij;
+        zi += b*zij;
+        wi += b*wij;
+      }
+      b = B0[i];
+      x += b*xi;
+      y += b*yi;
+      z += b*zi;
+      w += b*wi;
+    }
+
+    if ( cage.m_is_rat )
+    {
+      w = (0.0 != w) ? 1.0/w : 1.0;
+      x *= w;
+      y *= w;
+      z *= w;
+    }
+    points->x = x;
+    points->y = y;
+    points->z = z;
+    points++;
+  }
+}
+
 bool ON_BezierCageMorph::Create(
     ON_3dPoint P0,
     ON_3dPoint P1,
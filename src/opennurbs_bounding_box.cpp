@@ -1684,6 +1684,17 @@ bool ON_GetPointListBoundingBox(
 
     if ( count > 0 ) 
     {
+      // The SSE2/AVX kernels take care of most of the points
+      // and the loops below finish the list.
+      if ( !xform )
+        i = ON_SIMDGetPointListBoundingBox( wi, is_rat, count, stride, points, &bbox.m_min.x, &bbox.m_max.x );
+      else if ( !is_rat && 3 == dim )
+        i = ON_SIMDTransformPointList( 3, false, count, stride, points, 0, *xform, &bbox.m_min.x, &bbox.m_max.x );
+      else
+        i = 0;
+      count -= i;
+      points += ((size_t)i)*stride;
+
       if ( is_rat )
       {
         // homogeneous rational points
@@ -1830,27 +1841,34 @@ bool ON_GetPointListBoundingBox(
         return false;
     }
 
-    if ( !bGrowBox  )
+    memcpy( &Q.x, points, dim*sizeof(Q.x) );
+    bbox.m_min = Q;
+    if ( is_rat )
     {
-      memcpy( &Q.x, points, dim*sizeof(Q.x) );
-      bbox.m_min = Q;
-      if ( is_rat )
-      {
-        w = 1.0/points[wi];
-        bbox.m_min.x *= w; bbox.m_min.y *= w; bbox.m_min.z *= w;
-      }
-      if ( xform )
-      {
-        bbox.m_min.Transform(*xform);
-      }
-      bbox.m_max = bbox.m_min;
-      points += stride;
-      count--;
-      bGrowBox = true;
+      w = 1.0/points[wi];
+      bbox.m_min.x *= w; bbox.m_min.y *= w; bbox.m_min.z *= w;
+    }
+    if ( xform )
+    {
+      bbox.m_min.Transform(*xform);
     }
+    bbox.m_max = bbox.m_min;
+    points += stride;
+    count--;
 
     if ( count > 0 ) 
     {
+      // The SSE2/AVX kernels take care of most of the points
+      // and the loops below finish the list.
+      if ( !xform )
+        i = ON_SIMDGetPointListBoundingBox( wi, is_rat, count, stride, points, &bbox.m_min.x, &bbox.m_max.x );
+      else if ( !is_rat && 3 == dim )
+        i = ON_SIMDTransformPointList( 3, false, count, stride, points, 0, *xform, &bbox.m_min.x, &bbox.m_max.x );
+      else
+        i = 0;
+      count -= i;
+      points += ((size_t)i)*stride;
+
       if ( is_rat )
       {
         // homogeneous rational points
@@ -2011,6 +2029,12 @@ OUTPUT:
             count--;
             bGrowBox = true;
           }
+          if ( count > 0 && 3 == dim )
+          {
+            j = ON_SIMDGetPointListBoundingBox( dim, true, count, stride, points, boxmin, boxmax );
+            count -= j;
+            points += ((size_t)j)*stride;
+          }
           if ( count > 0 ) 
           {
             for ( /*empty*/; count--; points += stride ) 
@@ -2045,6 +2069,12 @@ OUTPUT:
           count--;
           bGrowBox = true;
         }
+        if ( count > 0 && dim <= 3 )
+        {
+          j = ON_SIMDGetPointListBoundingBox( dim, false, count, stride, points, boxmin, boxmax );
+          count -= j;
+          points += ((size_t)j)*stride;
+        }
         if ( count ) 
         {
           // grow box to contain the rest of the points
@@ -2108,7 +2138,7 @@ OUTPUT:
   // bounding box workhorse
   float x;
   double w;
-  int j;
+  int i, j;
   bool rc = false;
   for ( j = 0; j < dim && bGrowBox; j++ )
   {
@@ -2162,6 +2192,22 @@ OUTPUT:
           count--;
           bGrowBox = true;
         }
+        if ( count > 0 && dim <= 3 )
+        {
+          // float boxes are exact in doubles
+          double dmin[3], dmax[3];
+          for ( j = 0; j < dim; j++ ) {
+            dmin[j] = boxmin[j];
+            dmax[j] = boxmax[j];
+          }
+          i = ON_SIMDGetPointListBoundingBox( dim, false, count, stride, points, dmin, dmax );
+          for ( j = 0; j < dim; j++ ) {
+            boxmin[j] = (float)dmin[j];
+            boxmax[j] = (float)dmax[j];
+          }
+          count -= i;
+          points += ((size_t)i)*stride;
+        }
         for ( /*empty*/; count--; points += stride ) 
         {
           for ( j = 0; j < dim; j++ ) {
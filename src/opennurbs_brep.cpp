@@ -836,10 +836,13 @@ ON_BrepFace::ON_BrepFace() : ON_SurfaceProxy(0),
                 m_render_mesh(0),
                 m_analysis_mesh(0),
                 m_preview_mesh(0),
+                m_deferred_mesh_reader(0),
                 m_brep(0)
 {
   m_face_uuid = ON_nil_uuid;
   memset(&m_face_user,0,sizeof(m_face_user));
+  m_deferred_mesh_offset[0] = 0;
+  m_deferred_mesh_offset[1] = 0;
 }
 
 ON_BrepFace::ON_BrepFace(int face_index) : ON_SurfaceProxy(0),
@@ -850,10 +853,13 @@ ON_BrepFace::ON_BrepFace(int face_index) : ON_SurfaceProxy(0),
                 m_render_mesh(0),
                 m_analysis_mesh(0),
                 m_preview_mesh(0),
+                m_deferred_mesh_reader(0),
                 m_brep(0)
 {
   m_face_uuid = ON_nil_uuid;
   memset(&m_face_user,0,sizeof(m_face_user));
+  m_deferred_mesh_offset[0] = 0;
+  m_deferred_mesh_offset[1] = 0;
 }
 
 
@@ -906,6 +912,9 @@ ON_BrepFace& ON_BrepFace::operator=(const ON_BrepFace& src)
     if ( src.m_preview_mesh ) {
       m_preview_mesh = new ON_Mesh(*src.m_preview_mesh);
     }    
+    // meshes that have not been read yet stay in the file
+    SetDeferredMesh(ON::render_mesh,src.m_deferred_mesh_reader,src.m_deferred_mesh_offset[0]);
+    SetDeferredMesh(ON::analysis_mesh,src.m_deferred_mesh_reader,src.m_deferred_mesh_offset[1]);
     //m_material_index = src.m_material_index;
   }
   return *this;
@@ -1009,9 +1018,83 @@ void ON_BrepFace::SetMaterialIndex(int mi)
 }
 */
 
+bool ON_BrepFace::ReadDeferredMesh( ON::mesh_type mt ) const
+{
+  const int i = (ON::analysis_mesh == mt) ? 1 : 0;
+  if ( ON::render_mesh != mt && ON::analysis_mesh != mt )
+    return false;
+  if ( 0 == m_deferred_mesh_reader || 0 == m_deferred_mesh_offset[i] )
+    return false;
+
+  ON_Object* obj = m_deferred_mesh_reader->ReadObject(m_deferred_mesh_offset[i]);
+  ON_Mesh* mesh = ON_Mesh::Cast(obj);
+  if ( 0 == mesh && 0 != obj )
+    delete obj;
+
+  // The deferred mesh is part of this face's cached state, so 
+  // reading it does not change the face.
+  ON_BrepFace* face = const_cast<ON_BrepFace*>(this);
+  face->SetDeferredMesh(mt,0,0);
+  ON_Mesh*& m = i ? face->m_analysis_mesh : face->m_render_mesh;
+  if ( 0 != mesh )
+  {
+    if ( 0 == m )
+      m = mesh;
+    else
+      delete mesh;
+  }
+  return (0 != mesh);
+}
+
+void ON_BrepFace::SetDeferredMesh( ON::mesh_type mt, ON_3dmDeferredReader* reader, ON__UINT64 offset )
+{
+  const int i = (ON::analysis_mesh == mt) ? 1 : 0;
+  if ( ON::render_mesh != mt && ON::analysis_mesh != mt )
+    return;
+  if ( 0 == reader || 0 == offset )
+  {
+    m_deferred_mesh_offset[i] = 0;
+  }
+  else 
+  {
+    if ( reader != m_deferred_mesh_reader )
+    {
+      // offsets are only meaningful to the reader that set them
+      reader->AddRef();
+      if ( 0 != m_deferred_mesh_reader )
+        m_deferred_mesh_reader->Release();
+      m_deferred_mesh_reader = reader;
+      m_deferred_mesh_offset[0] = 0;
+      m_deferred_mesh_offset[1] = 0;
+    }
+    m_deferred_mesh_offset[i] = offset;
+  }
+  if ( 0 == m_deferred_mesh_offset[0] && 0 == m_deferred_mesh_offset[1] && 0 != m_deferred_mesh_reader )
+  {
+    m_deferred_mesh_reader->Release();
+    m_deferred_mesh_reader = 0;
+  }
+}
+
 const ON_Mesh* ON_BrepFace::Mesh( ON::mesh_type mt ) const
 {
   ON_Mesh* m = 0;
+  if ( 0 != m_deferred_mesh_reader )
+  {
+    // read meshes that were left in the file
+    switch(mt) {
+    case ON::render_mesh:
+    case ON::analysis_mesh:
+      ReadDeferredMesh(mt);
+      break;
+    case ON::preview_mesh:
+      break;
+    default:
+      if ( 0 == m_render_mesh && !ReadDeferredMesh(ON::render_mesh) && 0 == m_analysis_mesh )
+        ReadDeferredMesh(ON::analysis_mesh);
+      break;
+    }
+  }
   switch(mt) {
   case ON::render_mesh:
     m = m_render_mesh;
@@ -1045,6 +1128,7 @@ void ON_BrepFace::DestroyMesh( ON::mesh_type mt, bool bDeleteMesh )
         delete m_render_mesh;
       m_render_mesh = 0;
     }
+    SetDeferredMesh(mt,0,0);
     break;
   case ON::analysis_mesh:
     if (m_analysis_mesh) 
@@ -1053,6 +1137,7 @@ void ON_BrepFace::DestroyMesh( ON::mesh_type mt, bool bDeleteMesh )
         delete m_analysis_mesh;
       m_analysis_mesh = 0;
     }
+    SetDeferredMesh(mt,0,0);
     break;
   case ON::preview_mesh:
     if (m_preview_mesh) 
@@ -1176,6 +1261,7 @@ void ON_Brep::Initialize()
   memset(&m_brep_user,0,sizeof(m_brep_user));
   m_is_solid = 0;
   m_bbox.Destroy();
+  m_shared_geometry = 0;
 }
 
 ON_Brep* ON_Brep::New() 
@@ -1210,7 +1296,9 @@ ON_Brep::ON_Brep(const ON_Brep& src) : ON_Geometry(src)
 ON_Brep::~ON_Brep()
 { 
   DestroyMesh(ON::any_mesh,true);
-  // everything is in array classes that destroy themselves.
+  // shared geometry is released here and
+  // everything else is in array classes that destroy themselves.
+  DestroySharedGeometryHelper();
 }
 
 unsigned int ON_Brep::SizeOf() const
@@ -1303,6 +1391,20 @@ void ON_Brep::DestroyMesh( ON::mesh_type mt, bool bDeleteMesh )
   }
 }
 
+int ON_Brep::ReadDeferredMeshes() const
+{
+  const int fcnt = m_F.Count();
+  int fi, mesh_count = 0;
+  for ( fi = 0; fi < fcnt; fi++ )
+  {
+    if ( m_F[fi].ReadDeferredMesh(ON::render_mesh) )
+      mesh_count++;
+    if ( m_F[fi].ReadDeferredMesh(ON::analysis_mesh) )
+      mesh_count++;
+  }
+  return mesh_count;
+}
+
 int ON_Brep::GetMesh( ON::mesh_type mt, ON_SimpleArray<const ON_Mesh*>& meshes ) const
 {
   int fcnt = m_F.Count();
@@ -1368,6 +1470,9 @@ ON_BOOL32 ON_Brep::Transform( const ON_Xform& xform )
   int i, count;
   ON_BOOL32 rc = true;
   
+  // copy on write - see CopyAndShareGeometry()
+  UnshareGeometry();
+
   DestroyRuntimeCache();
 
   int is_similarity = xform.IsSimilarity();
@@ -1503,6 +1608,10 @@ ON_BOOL32 ON_Brep::Transform( const ON_Xform& xform )
     if ( 0 == srf )
       bEvMesh = false;
 
+    // meshes left in the file must be read before they are transformed
+    face.ReadDeferredMesh(ON::render_mesh);
+    face.ReadDeferredMesh(ON::analysis_mesh);
+
     if ( 0 != face.m_render_mesh )
     {
       if ( bEvMesh && face.m_render_mesh->EvaluateMeshGeometry(*srf) )
@@ -1910,6 +2019,17 @@ ON_Brep::NewSingularTrim(const ON_BrepVertex& vertex,ON_BrepLoop& loop, ON_Surfa
 
 void ON_Brep::Append( const ON_Brep& b )
 {
+  AppendHelper( b, false );
+}
+
+void ON_Brep::AppendAndShareGeometry( const ON_Brep& b )
+{
+  AppendHelper( b, true );
+}
+
+void ON_Brep::AppendHelper( const ON_Brep& b, bool bShareGeometry )
+{
+  ON_MemorySubsystemScope ms(ON_MEMORY_SUBSYSTEM_BREP);
   int i, j, jcnt;
 
   const int vcount0  = m_V.Count();
@@ -1934,35 +2054,50 @@ void ON_Brep::Append( const ON_Brep& b )
   ON_Object* obj;
   ON_Curve* c;
   ON_Surface* s;
-  for ( i = 0; i < scount1; i++ ) {
-    s = b.m_S[i];
-    if ( s ) {
-      obj = s->Duplicate();
-      s = ON_Surface::Cast(obj);
-      if ( !s )
-        delete obj;
-    }
-    m_S.Append(s);
+  if ( bShareGeometry )
+  {
+    m_S.Reserve(scount0+scount1);
+    for ( i = 0; i < scount1; i++ )
+      m_S.Append( ON_Surface::Cast(ShareGeometryHelper(b,2,i,scount0+i)) );
+    m_C2.Reserve(c2count0+c2count1);
+    for ( i = 0; i < c2count1; i++ )
+      m_C2.Append( ON_Curve::Cast(ShareGeometryHelper(b,0,i,c2count0+i)) );
+    m_C3.Reserve(c3count0+c3count1);
+    for ( i = 0; i < c3count1; i++ )
+      m_C3.Append( ON_Curve::Cast(ShareGeometryHelper(b,1,i,c3count0+i)) );
   }
-  for ( i = 0; i < c2count1; i++ ) {
-    c = b.m_C2[i];
-    if ( c ) {
-      obj = c->Duplicate();
-      c = ON_Curve::Cast(obj);
-      if ( !c )
-        delete obj;
+  else
+  {
+    for ( i = 0; i < scount1; i++ ) {
+      s = b.m_S[i];
+      if ( s ) {
+        obj = s->Duplicate();
+        s = ON_Surface::Cast(obj);
+        if ( !s )
+          delete obj;
+      }
+      m_S.Append(s);
     }
-    m_C2.Append(c);
-  }
-  for ( i = 0; i < c3count1; i++ ) {
-    c = b.m_C3[i];
-    if ( c ) {
-      obj = c->Duplicate();
-      c = ON_Curve::Cast(obj);
-      if ( !c )
-        delete obj;
+    for ( i = 0; i < c2count1; i++ ) {
+      c = b.m_C2[i];
+      if ( c ) {
+        obj = c->Duplicate();
+        c = ON_Curve::Cast(obj);
+        if ( !c )
+          delete obj;
+      }
+      m_C2.Append(c);
+    }
+    for ( i = 0; i < c3count1; i++ ) {
+      c = b.m_C3[i];
+      if ( c ) {
+        obj = c->Duplicate();
+        c = ON_Curve::Cast(obj);
+        if ( !c )
+          delete obj;
+      }
+      m_C3.Append(c);
     }
-    m_C3.Append(c);
   }
 
   // copy topology info
@@ -4488,753 +4623,925 @@ bool ON_ValidateEdgeTrims(
   return (bad_point_count>0) ? ON_BrepIsNotValid() : true;
 }
 
-ON_BOOL32
-ON_Brep::IsValid( ON_TextLog* text_log ) const
+bool ON_Brep::IsValidComponent( int type, int i, ON_TextLog* text_log ) const
 {
-  const int curve2d_count = m_C2.Count();
-  const int curve3d_count = m_C3.Count();
-  const int surface_count = m_S.Count();
-  const int vertex_count  = m_V.Count();
-  const int edge_count    = m_E.Count();
-  const int trim_count    = m_T.Count();
-  const int loop_count    = m_L.Count();
-  const int face_count    = m_F.Count();
-
-  int c2i, c3i, si, vi, ei, fi, ti, li;
-
-  if ( 0 == face_count && 0 == edge_count && 0 == vertex_count )
-  {
-    if ( text_log )
-      text_log->Print( "ON_Brep has no faces, edges, or vertices\n");
-    return ON_BrepIsNotValid();
-  }
-
-  if ( 0 != face_count )
+  // type: 0 = m_C2[], 1 = m_C3[], 2 = m_S[], 
+  //       3 = m_V[],  4 = m_E[],  5 = m_F[],
+  //       6 = m_L[],  7 = m_T[],  8 = m_L[] m_pbox
+  switch(type)
   {
-    if ( 0 == edge_count )
-    {
-      if ( text_log )
-        text_log->Print( "ON_Brep has no edges.\n");
-      return ON_BrepIsNotValid();
-    }
-    if ( 0 == loop_count )
+  case 0: // check 2d curve geometry
     {
-      if ( text_log )
-        text_log->Print( "ON_Brep has no loops.\n");
-      return ON_BrepIsNotValid();
+      const ON_Curve* c2 = m_C2[i];
+      if ( !c2 )
+      {
+        // NULL 2d curves are ok if they are not referenced
+        return true;
+      }
+      if ( !c2->IsValid(text_log) )
+      {
+        if ( text_log )
+          text_log->Print("ON_Brep.m_C2[%d] is invalid.\n",i);
+        return false;
+      }
+      int c2_dim = c2->Dimension();
+      if ( c2_dim != 2 )
+      {
+        if ( text_log )
+          text_log->Print("ON_Brep.m_C2[%d]->Dimension() = %d (should be 2).\n", i, c2_dim );
+        return false;
+      }
+      const ON_PolyCurve* polycurve = ON_PolyCurve::Cast(c2);
+      if ( polycurve && polycurve->IsNested() )
+      {
+        if ( text_log )
+          text_log->Print("ON_Brep.m_C2[%d] is a nested polycurve.\n", i );
+        return false;
+      }
     }
-    if ( 0 == surface_count )
+    break;
+
+  case 1: // check 3d curve geometry
     {
-      if ( text_log )
-        text_log->Print( "ON_Brep has no surfaces.\n");
-      return ON_BrepIsNotValid();
+      const ON_Curve* c3 = m_C3[i];
+      if ( !c3 )
+      {
+        // NULL 3d curves are ok if they are not referenced
+        return true;
+      }
+      if ( !c3->IsValid(text_log) )
+      {
+        if ( text_log )
+          text_log->Print("ON_Brep.m_C3[%d] is invalid.\n",i);
+        return false;
+      }
+      int c3_dim = c3->Dimension();
+      if ( c3_dim != 3 )
+      {
+        if ( text_log )
+          text_log->Print("ON_Brep.m_C3[%d]->Dimension() = %d (should be 3).\n", i, c3_dim );
+        return false;
+      }
+      const ON_PolyCurve* polycurve = ON_PolyCurve::Cast(c3);
+      if ( polycurve && polycurve->IsNested() )
+      {
+        if ( text_log )
+          text_log->Print("ON_Brep.m_C3[%d] is a nested polycurve.\n", i );
+        return false;
+      }
     }
-    if ( 0 == trim_count )
+    break;
+
+  case 2: // check 3d surface geometry
     {
-      if ( text_log )
-        text_log->Print( "ON_Brep has no trims.\n");
-      return ON_BrepIsNotValid();
+      const ON_Surface* srf = m_S[i];
+      if ( !srf )
+      {
+        // NULL 3d surfaces are ok if they are not referenced
+        return true;
+      }
+      if ( !srf->IsValid(text_log) )
+      {
+        if ( text_log )
+          text_log->Print("ON_Brep.m_S[%d] is invalid.\n",i);
+        return false;
+      }
+      int dim = srf->Dimension();
+      if ( dim != 3 )
+      {
+        if ( text_log )
+          text_log->Print("ON_Brep.m_S[%d]->Dimension() = %d (should be 3).\n", i, dim );
+        return false;
+      }
     }
-    if ( 0 == curve2d_count )
+    break;
+
+  case 3: // check vertices
+    if ( m_V[i].m_vertex_index == -1 )
+      return true;
+    if ( !IsValidVertex( i, text_log ) ) 
     {
       if ( text_log )
-        text_log->Print( "ON_Brep has no 2d curves.\n");
-      return ON_BrepIsNotValid();
+        text_log->Print("ON_Brep.m_V[%d] is invalid.\n",i);
+      return false;
     }
-  }
+    break;
 
-  if ( 0 != edge_count )
-  {
-    if ( 0 == curve3d_count )
+  case 4: // check edges
+    if ( m_E[i].m_edge_index == -1 )
+      return true;
+    if ( !IsValidEdge( i, text_log ) ) 
     {
       if ( text_log )
-        text_log->Print( "ON_Brep has no 3d curves.\n");
-      return ON_BrepIsNotValid();
+        text_log->Print("ON_Brep.m_E[%d] is invalid.\n",i);
+      return false;
     }
-    if ( 0 == vertex_count )
+    break;
+
+  case 5: // check faces
+    if ( m_F[i].m_face_index == -1 )
+      return true;
+    if ( !IsValidFace( i, text_log ) ) 
     {
       if ( text_log )
-        text_log->Print( "ON_Brep has no vertices.\n");
-      return ON_BrepIsNotValid();
+        text_log->Print("ON_Brep.m_F[%d] is invalid.\n",i);
+      return false;
     }
-  }
+    break;
 
-  // check element indices match array positions
-  for ( vi = 0; vi < vertex_count; vi++ ) 
-  {
-    if ( m_V[vi].m_vertex_index == -1 )
+  case 6: // check loops
+    // This check is necessary at the brep level to make sure 
+    // there are no orphaned loops. ON_Brep::IsValidLoop(), 
+    // which is called by ON_Brep::IsValidFace(), performs 
+    // loop-trim bookkeeping checks on all loops that are 
+    // referenced by a face.
     {
-      const ON_BrepVertex& vertex = m_V[vi];
-      if ( vertex.m_ei.Count() > 0 )
+      const int li = i;
+      int ti;
+      const ON_BrepLoop& loop = m_L[li];
+      if ( m_L[li].m_loop_index == -1 )
+        return true;
+      if ( loop.m_fi < 0 || loop.m_fi >= m_F.Count() )
       {
         if ( text_log )
-          text_log->Print( "ON_Brep.m_V[%d] is deleted (m_vertex_index = -1) but vertex.m_ei.Count() = %d.\n",
-                           vi, vertex.m_ei.Count() );
+          text_log->Print("ON_Brep.m_L[%d].m_fi = %d is not invalid.\n",li,loop.m_fi);
         return ON_BrepIsNotValid();
       }
-    }
-    else if ( m_V[vi].m_vertex_index != vi )
-    {
-      if ( text_log )
-        text_log->Print( "ON_Brep.m_V[%d].m_vertex_index = %d (should be %d)\n",
-                         vi, m_V[vi].m_vertex_index, vi );
-      return ON_BrepIsNotValid();
-    }
-  }
-
-  for ( ei = 0; ei < edge_count; ei++ ) 
-  {
-    if ( m_E[ei].m_edge_index == -1 )
-    {
-      const ON_BrepEdge& edge = m_E[ei];
-      if ( edge.m_ti.Count() > 0 )
+      if ( m_F[loop.m_fi].m_face_index != loop.m_fi )
       {
         if ( text_log )
-          text_log->Print( "ON_Brep.m_E[%d] is deleted (m_edge_index = -1) but edge.m_ei.Count() = %d.\n",
-                           ei, edge.m_ti.Count() );
+          text_log->Print("ON_Brep.m_L[%d].m_fi = %d is a deleted face.\n",li,loop.m_fi);
         return ON_BrepIsNotValid();
       }
-      if ( edge.m_c3i != -1 )
+
+      // This for() loop check is performed in IsValidLoop() which is 
+      // called by IsValidFace() in the "check faces" loop above.  
+      // I think it can be removed.  If anybody every sees this code
+      // find a flaw, please tell Dale Lear.
+      for ( int lti = 0; lti < loop.m_ti.Count(); lti++ )
       {
-        if ( text_log )
-          text_log->Print( "ON_Brep.m_E[%d] is deleted (m_edge_index = -1) but edge.m_c3i=%d (should be -1).\n",
-                           ei, edge.m_c3i );
-        return ON_BrepIsNotValid();
+        ti = loop.m_ti[lti];
+        if ( ti < 0 || ti >= m_T.Count() )
+        {
+          if ( text_log )
+            text_log->Print("ON_Brep.m_L[%d].m_ti[%d] = %d is not invalid.\n",li,lti,ti);
+          return ON_BrepIsNotValid();
+        }
+        if ( m_T[ti].m_trim_index != ti )
+        {
+          if ( text_log )
+            text_log->Print("ON_Brep.m_L[%d].m_ti[%d] = %d is a deleted trim.\n",li,lti,ti);
+          return ON_BrepIsNotValid();
+        }
       }
-      if ( edge.ProxyCurve() )
+    }
+    break;
+
+  case 7: // check trims
+    // This check is necessary at the brep level to make sure 
+    // there are no orphan trims and to test tolerances.  Most 
+    // of these tests are duplicates of ones in 
+    // ON_Brep::IsValidTrim, which is called by 
+    // ON_Brep::IsValidLoop, which is called by 
+    // ON_Brep::IsValidFace.
+    {
+      const int ti = i;
+      const ON_BrepTrim& trim = m_T[ti];
+      if ( trim.m_trim_index == -1 )
+        return true;
+
+      if ( trim.m_vi[0] < 0 || trim.m_vi[0] >= m_V.Count() )
       {
         if ( text_log )
-          text_log->Print( "ON_Brep.m_E[%d] is deleted (m_edge_index = -1) but edge.m_curve is not NULL.\n",
-                           ei );
+          text_log->Print("ON_Brep.m_T[%d].m_vi[0] = %d is not invalid.\n",ti,trim.m_vi[0]);
         return ON_BrepIsNotValid();
       }
-      if ( edge.m_vi[0] != -1 )
+      if ( trim.m_vi[1] < 0 || trim.m_vi[1] >= m_V.Count() )
       {
         if ( text_log )
-          text_log->Print( "ON_Brep.m_E[%d] is deleted (m_edge_index = -1) but edge.m_vi[0]=%d (should be -1).\n",
-                           ei, edge.m_vi[0] );
+          text_log->Print("ON_Brep.m_T[%d].m_vi[1] = %d is not invalid.\n",ti,trim.m_vi[1]);
         return ON_BrepIsNotValid();
       }
-      if ( edge.m_vi[1] != -1 )
+
+      if ( m_V[trim.m_vi[0]].m_vertex_index != trim.m_vi[0] )
       {
         if ( text_log )
-          text_log->Print( "ON_Brep.m_E[%d] is deleted (m_edge_index = -1) but edge.m_vi[1]=%d (should be -1).\n",
-                           ei, edge.m_vi[1] );
+          text_log->Print("ON_Brep.m_T[%d].m_vi[0] is deleted.\n",ti);
         return ON_BrepIsNotValid();
       }
-    }
-    else if ( m_E[ei].m_edge_index != ei )
-    {
-      if ( text_log )
-        text_log->Print( "ON_Brep.m_E[%d].m_edge_index = %d (should be %d)\n",
-                         ei, m_E[ei].m_edge_index, ei );
-      return ON_BrepIsNotValid();
-    }
-  }
-
-  for ( ti = 0; ti < trim_count; ti++ ) 
-  {
-    if ( m_T[ti].m_trim_index == -1 )
-    {
-      const ON_BrepTrim& trim = m_T[ti];
-      if ( trim.m_ei != -1 )
+      if ( m_V[trim.m_vi[1]].m_vertex_index != trim.m_vi[1] )
       {
         if ( text_log )
-          text_log->Print( "ON_Brep.m_T[%d] is deleted (m_trim_index = -1) but trim.m_ei=%d (should be -1).\n",
-                           ti, trim.m_ei );
+          text_log->Print("ON_Brep.m_T[%d].m_vi[1] is deleted.\n",ti);
         return ON_BrepIsNotValid();
       }
-      if ( trim.m_li != -1 )
+
+      if ( trim.m_c2i < 0 || trim.m_c2i >= m_C2.Count() )
       {
         if ( text_log )
-          text_log->Print( "ON_Brep.m_T[%d] is deleted (m_trim_index = -1) but trim.m_li=%d (should be -1).\n",
-                           ti, trim.m_li );
+          text_log->Print("ON_Brep.m_T[%d].m_c2i = %d is not valid.\n",ti,trim.m_c2i);
         return ON_BrepIsNotValid();
       }
-      if ( trim.m_c2i != -1 )
+
+      if ( 0 == m_C2[trim.m_c2i] )
       {
         if ( text_log )
-          text_log->Print( "ON_Brep.m_T[%d] is deleted (m_trim_index = -1) but trim.m_c2i=%d (should be -1).\n",
-                           ti, trim.m_c2i );
+          text_log->Print("ON_Brep.m_T[%d].m_c2i = %d, but m_C2[%d] is NULL.\n",ti,trim.m_c2i,trim.m_c2i);
         return ON_BrepIsNotValid();
       }
-      if ( trim.m_vi[0] != -1 )
+
+      if ( trim.m_li < 0 || trim.m_li >= m_L.Count() )
       {
         if ( text_log )
-          text_log->Print( "ON_Brep.m_T[%d] is deleted (m_trim_index = -1) but trim.m_vi[0]=%d (should be -1).\n",
-                           ti, trim.m_vi[0] );
+          text_log->Print("ON_Brep.m_T[%d].m_li = %d is not valid.\n",ti,trim.m_li);
         return ON_BrepIsNotValid();
       }
-      if ( trim.m_vi[1] != -1 )
+
+      if ( m_L[trim.m_li].m_loop_index != trim.m_li )
       {
         if ( text_log )
-          text_log->Print( "ON_Brep.m_T[%d] is deleted (m_trim_index = -1) but trim.m_vi[1]=%d (should be -1).\n",
-                           ti, trim.m_vi[1] );
+          text_log->Print("ON_Brep.m_T[%d].m_li = %d is a deleted loop.\n",ti,trim.m_li);
         return ON_BrepIsNotValid();
       }
-    }
-    else if ( m_T[ti].m_trim_index != ti  )
-    {
-      if ( text_log )
-        text_log->Print( "ON_Brep.m_T[%d].m_trim_index = %d (should be %d)\n",
-                         ti, m_T[ti].m_trim_index, ti );
-      return ON_BrepIsNotValid();
-    }
-    else if ( !m_T[ti].IsValid( text_log ) )
-    {
-      if ( text_log )
-        text_log->Print( "ON_Brep.m_T[%d] is not valid\n",ti );
-      return ON_BrepIsNotValid();
-    }
-  }
 
-  for ( li = 0; li < loop_count; li++ ) 
-  {
-    if ( m_L[li].m_loop_index == -1 )
-    {
-      const ON_BrepLoop& loop = m_L[li];
-      if ( loop.m_fi != -1 )
+      {
+        const ON_Curve* c2 = m_C2[trim.m_c2i];
+        const ON_Surface* srf = m_S[m_F[m_L[trim.m_li].m_fi].m_si];
+        if ( srf )
+        {
+          ON_Interval PD = trim.ProxyCurveDomain();
+          ON_Surface::ISO iso = srf->IsIsoparametric(*c2, &PD);
+          if ( trim.m_iso != iso )
+          {
+            if ( text_log )
+              text_log->Print("ON_Brep.m_T[%d].m_iso = %d and it should be %d\n",ti,trim.m_iso,iso);
+            return ON_BrepIsNotValid();
+          }
+        }
+      }
+
+      if ( trim.m_type == ON_BrepTrim::singular )
+      {
+        if ( trim.m_ei != -1 )
+        {
+          if ( text_log )
+            text_log->Print("ON_Brep.m_T[%d].m_type = singular, but m_ei = %d (should be -1).\n",ti,trim.m_ei);
+          return ON_BrepIsNotValid();
+        }
+        return true;
+      }
+
+      if ( trim.m_ei < 0 || trim.m_ei >= m_E.Count() )
       {
         if ( text_log )
-          text_log->Print( "ON_Brep.m_L[%d] is deleted (m_loop_index = -1) but loop.m_fi=%d (should be -1).\n",
-                           li, loop.m_fi );
+          text_log->Print("ON_Brep.m_T[%d].m_ei = %d is not invalid.\n",ti,trim.m_ei);
         return ON_BrepIsNotValid();
       }
-      if ( loop.m_ti.Count() > 0 )
+    
+      const ON_BrepEdge& edge = m_E[trim.m_ei];
+      if ( edge.m_edge_index != trim.m_ei )
       {
         if ( text_log )
-          text_log->Print( "ON_Brep.m_L[%d] is deleted (m_loop_index = -1) but loop.m_ti.Count()=%d.\n",
-                           li, loop.m_ti.Count() );
+          text_log->Print("ON_Brep.m_T[%d].m_ei is deleted.\n",ti);
         return ON_BrepIsNotValid();
       }
+
+      const int evi0 = trim.m_bRev3d ? 1 : 0;
+      const int evi1 = trim.m_bRev3d ? 0 : 1;
+      if ( trim.m_vi[0] != edge.m_vi[evi0] )
+      {
+        if ( text_log )
+          text_log->Print("ON_Brep.m_T[%d].m_bRev3d = %d, but m_vi[0] != m_E[m_ei].m_vi[%d].\n",ti,trim.m_bRev3d,evi0);
+        return ON_BrepIsNotValid();
+      }
+      if ( trim.m_vi[1] != edge.m_vi[evi1] )
+      {
+        if ( text_log )
+          text_log->Print("ON_Brep.m_T[%d].m_bRev3d = %d, but m_vi[0] != m_E[m_ei].m_vi[%d].\n",ti,trim.m_bRev3d,evi1);
+        return ON_BrepIsNotValid();
+      }
+
+      // check tolerances and closed curve directions
+      {
+        ON_3dPoint trim_pt0, trim_pt1, srf_pt0, srf_pt1;
+        ON_3dVector trim_der0, trim_der1, srf_du0, srf_dv0, srf_du1, srf_dv1;
+        ON_Interval trim_domain = trim.Domain();
+        // trim_pt0 should be closed to trim_pt1 except when
+        // trim starts and ends on opposite sides of a surface 
+        // seam.  Even when the trim curve is closed, the 
+        // derivatives can be different when there is
+        // a kink at the start/end of a trim.
+        trim.Ev1Der( trim_domain[0], trim_pt0, trim_der0 );
+        trim.Ev1Der( trim_domain[1], trim_pt1, trim_der1 );
+
+        const ON_Surface* trim_srf = m_F[ m_L[trim.m_li].m_fi ].SurfaceOf();
+        trim_srf->Ev1Der( trim_pt0.x, trim_pt0.y, srf_pt0, srf_du0, srf_dv0 );
+        trim_srf->Ev1Der( trim_pt1.x, trim_pt1.y, srf_pt1, srf_du1, srf_dv1 );
+
+        // estimate 3d tolerances from 2d trim tolerances
+        double t0_tol = srf_du0.Length()*trim.m_tolerance[0] + srf_dv0.Length()*trim.m_tolerance[1];
+        double t1_tol = srf_du1.Length()*trim.m_tolerance[0] + srf_dv1.Length()*trim.m_tolerance[1];
+        ON_3dVector trim_tangent0 = trim_der0.x*srf_du0 + trim_der0.y*srf_dv0;
+        trim_tangent0.Unitize();
+        ON_3dVector trim_tangent1 = trim_der1.x*srf_du1 + trim_der1.y*srf_dv1;
+        trim_tangent1.Unitize();
+        ON_3dVector edge_tangent0 = edge.TangentAt( edge.Domain()[trim.m_bRev3d ? 1 : 0] );
+        ON_3dVector edge_tangent1 = edge.TangentAt( edge.Domain()[trim.m_bRev3d ? 0 : 1] );
+        double d0 = trim_tangent0*edge_tangent0;
+        double d1 = trim_tangent1*edge_tangent1;
+        if ( trim.m_bRev3d )
+        {
+          d0 = -d0;
+          d1 = -d1;
+        }
+        if (    trim.m_vi[0] == trim.m_vi[1] 
+             && edge.m_vi[0] == edge.m_vi[1] 
+             && trim.m_vi[0] == edge.m_vi[0] 
+             )
+        {
+          // For high quality models, d0 and d1 should be close to +1.
+          // If both are close to -1, the trim.m_bRev3d flag is most
+          // likely set opposite of what it should be.
+
+          // check start tangent to see if m_bRev3d is set correctly
+          if ( d0 < 0.0 || d1 < 0.0)
+          {
+            if ( text_log )
+            {
+              if ( trim.m_bRev3d )
+                text_log->Print("ON_Brep.m_T[%d].m_bRev3d = true, but closed curve directions are the same.\n",ti);
+              else
+                text_log->Print("ON_Brep.m_T[%d].m_bRev3d = false, but closed curve directions are opposite.\n",ti);
+            }
+            return ON_BrepIsNotValid();
+          }
+        }
+
+        // Make sure edge and tolerances are realistic
+        ON_3dPoint EdgeEnd[2];
+        EdgeEnd[trim.m_bRev3d?1:0] = edge.PointAtStart();
+        EdgeEnd[trim.m_bRev3d?0:1] = edge.PointAtEnd();
+        d0 = EdgeEnd[0].DistanceTo(srf_pt0);
+        d1 = EdgeEnd[1].DistanceTo(srf_pt1);
+        double etol = edge.m_tolerance;
+        double dtol = 10.0*(etol + t0_tol + t1_tol);
+        if ( dtol < 0.01 )
+          dtol = 0.01;
+        if ( d0 > dtol  )
+        {
+          if ( text_log )
+          {
+            text_log->Print("Distance from start of ON_Brep.m_T[%d] to 3d edge is %g.  (edge tol = %g, trim tol ~ %g).\n",
+                            ti, d0, etol,t0_tol);
+          }
+          return ON_BrepIsNotValid();
+        }
+        if ( d1 > dtol )
+        {
+          if ( text_log )
+          {
+            text_log->Print("Distance from end of ON_Brep.m_T[%d] to 3d edge is %g.  (edge tol = %g, trim tol ~ %g).\n",
+                            ti, d1, etol,t1_tol);
+          }
+          return ON_BrepIsNotValid();
+        }
+      }
+
+      // check trim's m_pbox
+      {
+        if ( trim.m_pbox.m_min.z != 0.0 )
+        {
+          if ( text_log )
+             text_log->Print("ON_Brep.m_T[%d].m_pbox.m_min.z = %g (should be zero).\n",ti,trim.m_pbox.m_min.z);
+          return ON_BrepIsNotValid();
+        }
+        if ( trim.m_pbox.m_max.z != 0.0 )
+        {
+          if ( text_log )
+             text_log->Print("ON_Brep.m_T[%d].m_pbox.m_max.z = %g (should be zero).\n",ti,trim.m_pbox.m_max.z);
+          return ON_BrepIsNotValid();
+        }
+      
+        if ( !TestTrimPBox( trim, text_log ) )
+          return ON_BrepIsNotValid();
+
+      }
+
+      if ( ON_BrepTrim::seam == trim.m_type )
+      {
+        // trim must be on a surface edge
+        switch ( trim.m_iso )
+        {
+        case ON_Surface::S_iso:
+          break;
+        case ON_Surface::E_iso:
+          break;
+        case ON_Surface::N_iso:
+          break;
+        case ON_Surface::W_iso:
+          break;
+        default:
+          if ( text_log )
+            text_log->Print("ON_Brep.m_T[%d].m_type = ON_BrepTrim::seam but m_iso is not N/E/W/S_iso.\n",ti);
+          return ON_BrepIsNotValid();
+        }
+      }
     }
-    else if ( m_L[li].m_loop_index != li )
-    {
-      if ( text_log )
-        text_log->Print( "ON_Brep.m_L[%d].m_loop_index = %d (should be %d)\n",
-                         li, m_L[li].m_loop_index, li );
-      return ON_BrepIsNotValid();
-    }
-  }
+    break;
 
-  for ( fi = 0; fi < face_count; fi++ ) 
-  {
-    if ( m_F[fi].m_face_index == -1 )
+  case 8: // check loop m_pboxes
     {
-      const ON_BrepFace& face = m_F[fi];
-      if ( face.m_si != -1 )
+      const int li = i;
+      const ON_BrepLoop& loop = m_L[li];
+      if ( loop.m_loop_index != li )
+        return true;
+      if ( loop.m_pbox.m_min.z != 0.0 )
       {
         if ( text_log )
-          text_log->Print( "ON_Brep.m_F[%d] is deleted (m_face_index = -1) but face.m_si=%d (should be -1).\n",
-                           fi, face.m_si );
+           text_log->Print("ON_Brep.m_L[%d].m_pbox.m_min.z = %g (should be zero).\n",li,loop.m_pbox.m_min.z);
         return ON_BrepIsNotValid();
       }
-      if ( face.ProxySurface() )
+      if ( loop.m_pbox.m_max.z != 0.0 )
       {
         if ( text_log )
-          text_log->Print( "ON_Brep.m_F[%d] is deleted (m_face_index = -1) but face.ProxySurface() is not NULL.\n",
-                           fi );
+           text_log->Print("ON_Brep.m_L[%d].m_pbox.m_max.z = %g (should be zero).\n",li,loop.m_pbox.m_max.z);
         return ON_BrepIsNotValid();
       }
-      if ( face.m_li.Count() > 0 )
+      int first_trim_ti = -4;
+      int first_trim_vi0 = -3;
+      int prev_trim_vi1 = -2;
+      int prev_trim_ti=-9;
+      int lti;
+      for ( lti = 0; lti < loop.m_ti.Count(); lti++ )
       {
+        const ON_BrepTrim& trim = m_T[loop.m_ti[lti]];
+        if ( !loop.m_pbox.IsPointIn(trim.m_pbox.m_min) || !loop.m_pbox.IsPointIn(trim.m_pbox.m_max) )
+        {
+          if ( text_log )
+             text_log->Print("ON_Brep.m_L[%d].m_pbox does not contain m_T[loop.m_ti[%d]].m_pbox.\n",li,lti);
+          return ON_BrepIsNotValid();
+        }
+        if ( 0 == lti )
+        {
+          first_trim_ti = loop.m_ti[lti];
+          first_trim_vi0 = trim.m_vi[0];
+        }
+        else if ( prev_trim_vi1 != trim.m_vi[0] )
+        {
+          // 23 May 2003 Dale Lear
+          //     Added this test to make sure adjacent trims
+          //     in a loop shared vertices.
+          if ( text_log )
+             text_log->Print("ON_Brep.m_L[%d] loop has trim vertex mismatch:\n  m_T[loop.m_ti[%d]=%d].m_vi[1] = %d != m_T[loop.m_ti[%d]=%d].m_vi[0]=%d.\n",li,lti-1,prev_trim_ti,prev_trim_vi1,lti,loop.m_ti[lti],trim.m_vi[0]);
+          return ON_BrepIsNotValid();
+        }
+        prev_trim_ti = loop.m_ti[lti];
+        prev_trim_vi1 = trim.m_vi[1];
+      }
+
+      if ( first_trim_ti >= 0 && first_trim_vi0 != prev_trim_vi1 )
+      {
+        // 23 May 2003 Dale Lear
+        //     Added this test to make sure adjacent trims
+        //     in a loop shared vertices.
         if ( text_log )
-          text_log->Print( "ON_Brep.m_F[%d] is deleted (m_face_index = -1) but face.m_li.Count()=%d.\n",
-                           fi, face.m_li.Count() );
+           text_log->Print("ON_Brep.m_L[%d] loop has trim vertex mismatch:\n  m_T[loop.m_ti[%d]=%d].m_vi[1] = %d != m_T[loop.m_ti[%d]=%d].m_vi[0]=%d.\n",
+                           li,lti-1,prev_trim_ti,prev_trim_vi1,0,first_trim_ti,first_trim_vi0);
         return ON_BrepIsNotValid();
       }
     }
-    else if ( m_F[fi].m_face_index != fi )
-    {
-      if ( text_log )
-        text_log->Print( "ON_Brep.m_F[%d].m_face_index = %d (should be %d)\n",
-                         fi, m_F[fi].m_face_index, fi );
-      return ON_BrepIsNotValid();
-    }
+    break;
   }
 
-  // check 2d curve geometry
-  for ( c2i = 0; c2i < curve2d_count; c2i++ ) {
-    if ( !m_C2[c2i] )
-    {
-      continue;
-      // NULL 2d curves are ok if they are not referenced
-      //if ( text_log )
-      //  text_log->Print("ON_Brep.m_C2[%d] is NULL.\n",c2i);
-      //return ON_BrepIsNotValid();
-    }
-    if ( !m_C2[c2i]->IsValid(text_log) )
-    {
-      if ( text_log )
-        text_log->Print("ON_Brep.m_C2[%d] is invalid.\n",c2i);
-      return ON_BrepIsNotValid();
-    }
-    int c2_dim = m_C2[c2i]->Dimension();
-    if ( c2_dim != 2 )
-    {
-      if ( text_log )
-        text_log->Print("ON_Brep.m_C2[%d]->Dimension() = %d (should be 2).\n", c2i, c2_dim );
-      return ON_BrepIsNotValid();
-    }
-    const ON_PolyCurve* polycurve = ON_PolyCurve::Cast(m_C2[c2i]);
-    if ( polycurve && polycurve->IsNested() )
-    {
-      if ( text_log )
-        text_log->Print("ON_Brep.m_C2[%d] is a nested polycurve.\n", c2i );
-      return ON_BrepIsNotValid();
-    }
-  }
+  return true;
+}
 
-  // check 3d curve geometry
-  for ( c3i = 0; c3i < curve3d_count; c3i++ ) {
-    if ( !m_C3[c3i] )
-    {
-      continue;
-      // NULL 3d curves are ok if they are not referenced
-      //if ( text_log )
-      //  text_log->Print("ON_Brep.m_C3[%d] is NULL.\n",c3i);
-      //return ON_BrepIsNotValid();
-    }
-    if ( !m_C3[c3i]->IsValid(text_log) )
-    {
-      if ( text_log )
-        text_log->Print("ON_Brep.m_C3[%d] is invalid.\n",c3i);
-      return ON_BrepIsNotValid();
-    }
-    int c3_dim = m_C3[c3i]->Dimension();
-    if ( c3_dim != 3 )
-    {
-      if ( text_log )
-        text_log->Print("ON_Brep.m_C3[%d]->Dimension() = %d (should be 3).\n", c3i, c3_dim );
-      return ON_BrepIsNotValid();
-    }
-    const ON_PolyCurve* polycurve = ON_PolyCurve::Cast(m_C3[c3i]);
-    if ( polycurve && polycurve->IsNested() )
-    {
-      if ( text_log )
-        text_log->Print("ON_Brep.m_C3[%d] is a nested polycurve.\n", c3i );
-      return ON_BrepIsNotValid();
-    }
-  }
+struct ON_BrepIsValidJob
+{
+  const ON_Brep* m_brep;
+  int m_type;     // type of the components being checked
+  int m_fail;     // smallest task index that failed
+  bool* m_rc;     // m_rc[task index]
+  ON_wString* m_log; // m_log[task index] or NULL
+};
 
-  // check 3d surface geometry
-  for ( si = 0; si < surface_count; si++ ) {
-    if ( !m_S[si] )
-    {
-      continue;
-      // NULL 3d surfaces are ok if they are not referenced
-      //if ( text_log )
-      //  text_log->Print("ON_Brep.m_S[%d] is NULL.\n",si);
-      //return ON_BrepIsNotValid();
-    }
-    if ( !m_S[si]->IsValid(text_log) )
-    {
-      if ( text_log )
-        text_log->Print("ON_Brep.m_S[%d] is invalid.\n",si);
-      return ON_BrepIsNotValid();
-    }
-    int dim = m_S[si]->Dimension();
-    if ( dim != 3 )
-    {
-      if ( text_log )
-        text_log->Print("ON_Brep.m_S[%d]->Dimension() = %d (should be 3).\n", si, dim );
-      return ON_BrepIsNotValid();
-    }
-  }
+void ON_Brep::IsValidComponentTask( void* context, int k )
+{
+  struct ON_BrepIsValidJob* job = (struct ON_BrepIsValidJob*)context;
+  job->m_rc[k] = true;
 
-  // check vertices
-  for ( vi = 0; vi < vertex_count; vi++ ) {
-    if ( m_V[vi].m_vertex_index == -1 )
-      continue;
-    if ( !IsValidVertex( vi, text_log ) ) {
-      if ( text_log )
-        text_log->Print("ON_Brep.m_V[%d] is invalid.\n",vi);
-      return ON_BrepIsNotValid();
-    }
+  // A serial check stops at the first failure, so tasks after
+  // a failed task do not need to be checked.  m_fail is read 
+  // with a compare and swap that never swaps because other
+  // tasks may be changing it.
+  if ( k > ON_ATOMIC_COMPARE_AND_SWAP(&job->m_fail,-1,-1) )
+    return;
+
+  if ( job->m_log )
+  {
+    ON_TextLog text_log(job->m_log[k]);
+    job->m_rc[k] = job->m_brep->IsValidComponent( job->m_type, k, &text_log );
+  }
+  else
+  {
+    job->m_rc[k] = job->m_brep->IsValidComponent( job->m_type, k, 0 );
   }
 
-  // check edges
-  for ( ei = 0; ei < edge_count; ei++ ) 
+  if ( !job->m_rc[k] )
   {
-    if ( m_E[ei].m_edge_index == -1 )
-      continue;
-    if ( !IsValidEdge( ei, text_log ) ) {
-      if ( text_log )
-        text_log->Print("ON_Brep.m_E[%d] is invalid.\n",ei);
-      return ON_BrepIsNotValid();
+    int fail = job->m_fail;
+    while ( k < fail )
+    {
+      fail = ON_ATOMIC_COMPARE_AND_SWAP(&job->m_fail,fail,k);
     }
   }
+}
 
-  // check faces
-  for ( fi = 0; fi < face_count; fi++ ) 
+static void ON_BrepIsValidAppendLog( ON_TextLog& text_log, const ON_wString& s )
+{
+  // The text is printed one line at a time so text_log indents
+  // it.  Print() treats the text as a format string so '%' 
+  // is doubled.
+  ON_wString line;
+  const wchar_t* p = s.Array();
+  for ( ; p && *p; p++ )
   {
-    if ( m_F[fi].m_face_index == -1 )
-      continue;
-    if ( !IsValidFace( fi, text_log ) ) {
-      if ( text_log )
-        text_log->Print("ON_Brep.m_F[%d] is invalid.\n",fi);
-      return ON_BrepIsNotValid();
+    line += *p;
+    if ( '%' == *p )
+      line += *p;
+    if ( '\n' == *p )
+    {
+      text_log.Print(line.Array());
+      line.Empty();
     }
   }
+  if ( !line.IsEmpty() )
+    text_log.Print(line.Array());
+}
 
-  // Check loops - this check is necessary at the brep level
-  // to make sure there are no orphaned loops.
-  // ON_Brep::IsValidLoop(), which is called by ON_Brep::IsValidFace(),
-  // performs loop-trim bookkeeping checks on all loops that are referenced
-  // by a face.
-  for ( li = 0; li < loop_count; li++ )
-  {
-    const ON_BrepLoop& loop = m_L[li];
-    if ( m_L[li].m_loop_index == -1 )
+bool ON_Brep::IsValidComponents( int type0, ON_TextLog* text_log, int thread_count ) const
+{
+  // Checks the components of types type0, type0+1 and type0+2 in 
+  // the same order as a serial check.  When several threads are used,
+  // each task prints to its own log and the logs are appended to 
+  // text_log in order, so text_log gets the same text from either
+  // kind of check.
+  //
+  // The checks of one type use indices that the checks of the
+  // earlier types validated.  For example, the trim checks use
+  // m_L[].m_fi and the loop m_pbox checks use m_L[].m_ti[].  So
+  // each type is checked in its own parallel stage and the next
+  // stage starts only when every component of that type is valid.
+  ON_SimpleArray<bool> rc;
+  ON_ClassArray<ON_wString> log;
+  int type, k;
+  for ( type = type0; type < type0+3; type++ )
+  {
+    int count = 0;
+    switch(type)
+    {
+    case 0: count = m_C2.Count(); break;
+    case 1: count = m_C3.Count(); break;
+    case 2: count = m_S.Count();  break;
+    case 3: count = m_V.Count();  break;
+    case 4: count = m_E.Count();  break;
+    case 5: count = m_F.Count();  break;
+    case 6: count = m_L.Count();  break;
+    case 7: count = m_T.Count();  break;
+    case 8: count = m_L.Count();  break;
+    }
+
+    if ( 1 == thread_count || count < 2 )
+    {
+      for ( k = 0; k < count; k++ )
+      {
+        if ( !IsValidComponent( type, k, text_log ) )
+          return false;
+      }
       continue;
-    if ( loop.m_fi < 0 || loop.m_fi >= m_F.Count() )
-    {
-      if ( text_log )
-        text_log->Print("ON_Brep.m_L[%d].m_fi = %d is not invalid.\n",li,loop.m_fi);
-      return ON_BrepIsNotValid();
     }
-    if ( m_F[loop.m_fi].m_face_index != loop.m_fi )
+
+    rc.SetCount(0);
+    rc.Reserve(count);
+    rc.SetCount(count);
+    log.Empty();
+    if ( text_log )
     {
-      if ( text_log )
-        text_log->Print("ON_Brep.m_L[%d].m_fi = %d is a deleted face.\n",li,loop.m_fi);
-      return ON_BrepIsNotValid();
+      log.Reserve(count);
+      log.SetCount(count);
     }
 
-    // This for() loop check is performed in IsValidLoop() which is 
-    // called by IsValidFace() in the "check faces" loop above.  
-    // I think it can be removed.  If anybody every sees this code
-    // find a flaw, please tell Dale Lear.
-    for ( int lti = 0; lti < loop.m_ti.Count(); lti++ )
+    struct ON_BrepIsValidJob job;
+    memset(&job,0,sizeof(job));
+    job.m_brep = this;
+    job.m_type = type;
+    job.m_fail = count;
+    job.m_rc = rc.Array();
+    job.m_log = text_log ? log.Array() : 0;
+
+    ON_ParallelFor( thread_count, count, ON_Brep::IsValidComponentTask, &job );
+
+    for ( k = 0; k < count; k++ )
     {
-      ti = loop.m_ti[lti];
-      if ( ti < 0 || ti >= m_T.Count() )
-      {
-        if ( text_log )
-          text_log->Print("ON_Brep.m_L[%d].m_ti[%d] = %d is not invalid.\n",li,lti,ti);
-        return ON_BrepIsNotValid();
-      }
-      if ( m_T[ti].m_trim_index != ti )
-      {
-        if ( text_log )
-          text_log->Print("ON_Brep.m_L[%d].m_ti[%d] = %d is a deleted trim.\n",li,lti,ti);
-        return ON_BrepIsNotValid();
-      }
+      if ( text_log && !log[k].IsEmpty() )
+        ON_BrepIsValidAppendLog( *text_log, log[k] );
+      if ( !rc[k] )
+        return false;
     }
   }
+  return true;
+}
 
-  // check trims - this check is necessary at the brep 
-  // level to make sure there are no orphan trims and 
-  // to test tolerances.  Most of these tests are duplicates 
-  // of ones in ON_Brep::IsValidTrim, which is called by 
-  // ON_Brep::IsValidLoop, which is called by ON_Brep::IsValidFace.
-  int seam_trim_count = 0;
-  for ( ti = 0; ti < trim_count; ti++ )
+ON_BOOL32
+ON_Brep::IsValid( ON_TextLog* text_log ) const
+{
+  return IsValid( text_log, 1 );
+}
+
+bool
+ON_Brep::IsValid( ON_TextLog* text_log, int thread_count ) const
+{
+  const int curve2d_count = m_C2.Count();
+  const int curve3d_count = m_C3.Count();
+  const int surface_count = m_S.Count();
+  const int vertex_count  = m_V.Count();
+  const int edge_count    = m_E.Count();
+  const int trim_count    = m_T.Count();
+  const int loop_count    = m_L.Count();
+  const int face_count    = m_F.Count();
+
+  int vi, ei, fi, ti, li;
+
+  if ( 0 == face_count && 0 == edge_count && 0 == vertex_count )
   {
-    const ON_BrepTrim& trim = m_T[ti];
-    if ( trim.m_trim_index == -1 )
-      continue;
+    if ( text_log )
+      text_log->Print( "ON_Brep has no faces, edges, or vertices\n");
+    return ON_BrepIsNotValid();
+  }
 
-    if ( trim.m_vi[0] < 0 || trim.m_vi[0] >= m_V.Count() )
+  if ( 0 != face_count )
+  {
+    if ( 0 == edge_count )
     {
       if ( text_log )
-        text_log->Print("ON_Brep.m_T[%d].m_vi[0] = %d is not invalid.\n",ti,trim.m_vi[0]);
+        text_log->Print( "ON_Brep has no edges.\n");
       return ON_BrepIsNotValid();
     }
-    if ( trim.m_vi[1] < 0 || trim.m_vi[1] >= m_V.Count() )
+    if ( 0 == loop_count )
     {
       if ( text_log )
-        text_log->Print("ON_Brep.m_T[%d].m_vi[1] = %d is not invalid.\n",ti,trim.m_vi[1]);
+        text_log->Print( "ON_Brep has no loops.\n");
       return ON_BrepIsNotValid();
     }
-
-    if ( m_V[trim.m_vi[0]].m_vertex_index != trim.m_vi[0] )
+    if ( 0 == surface_count )
     {
       if ( text_log )
-        text_log->Print("ON_Brep.m_T[%d].m_vi[0] is deleted.\n",ti);
+        text_log->Print( "ON_Brep has no surfaces.\n");
       return ON_BrepIsNotValid();
     }
-    if ( m_V[trim.m_vi[1]].m_vertex_index != trim.m_vi[1] )
+    if ( 0 == trim_count )
     {
       if ( text_log )
-        text_log->Print("ON_Brep.m_T[%d].m_vi[1] is deleted.\n",ti);
+        text_log->Print( "ON_Brep has no trims.\n");
       return ON_BrepIsNotValid();
     }
-
-    if ( trim.m_c2i < 0 || trim.m_c2i >= m_C2.Count() )
+    if ( 0 == curve2d_count )
     {
       if ( text_log )
-        text_log->Print("ON_Brep.m_T[%d].m_c2i = %d is not valid.\n",ti,trim.m_c2i);
+        text_log->Print( "ON_Brep has no 2d curves.\n");
       return ON_BrepIsNotValid();
     }
+  }
 
-    if ( 0 == m_C2[trim.m_c2i] )
+  if ( 0 != edge_count )
+  {
+    if ( 0 == curve3d_count )
     {
       if ( text_log )
-        text_log->Print("ON_Brep.m_T[%d].m_c2i = %d, but m_C2[%d] is NULL.\n",ti,trim.m_c2i,trim.m_c2i);
+        text_log->Print( "ON_Brep has no 3d curves.\n");
       return ON_BrepIsNotValid();
     }
-
-    if ( trim.m_li < 0 || trim.m_li >= m_L.Count() )
+    if ( 0 == vertex_count )
     {
       if ( text_log )
-        text_log->Print("ON_Brep.m_T[%d].m_li = %d is not valid.\n",ti,trim.m_li);
+        text_log->Print( "ON_Brep has no vertices.\n");
       return ON_BrepIsNotValid();
     }
+  }
 
-    if ( m_L[trim.m_li].m_loop_index != trim.m_li )
+  // check element indices match array positions
+  for ( vi = 0; vi < vertex_count; vi++ ) 
+  {
+    if ( m_V[vi].m_vertex_index == -1 )
+    {
+      const ON_BrepVertex& vertex = m_V[vi];
+      if ( vertex.m_ei.Count() > 0 )
+      {
+        if ( text_log )
+          text_log->Print( "ON_Brep.m_V[%d] is deleted (m_vertex_index = -1) but vertex.m_ei.Count() = %d.\n",
+                           vi, vertex.m_ei.Count() );
+        return ON_BrepIsNotValid();
+      }
+    }
+    else if ( m_V[vi].m_vertex_index != vi )
     {
       if ( text_log )
-        text_log->Print("ON_Brep.m_T[%d].m_li = %d is a deleted loop.\n",ti,trim.m_li);
+        text_log->Print( "ON_Brep.m_V[%d].m_vertex_index = %d (should be %d)\n",
+                         vi, m_V[vi].m_vertex_index, vi );
       return ON_BrepIsNotValid();
     }
+  }
 
+  for ( ei = 0; ei < edge_count; ei++ ) 
+  {
+    if ( m_E[ei].m_edge_index == -1 )
     {
-      const ON_Curve* c2 = m_C2[trim.m_c2i];
-      const ON_Surface* srf = m_S[m_F[m_L[trim.m_li].m_fi].m_si];
-      if ( srf )
+      const ON_BrepEdge& edge = m_E[ei];
+      if ( edge.m_ti.Count() > 0 )
       {
-        ON_Interval PD = trim.ProxyCurveDomain();
-        ON_Surface::ISO iso = srf->IsIsoparametric(*c2, &PD);
-        if ( trim.m_iso != iso )
-        {
-          if ( text_log )
-            text_log->Print("ON_Brep.m_T[%d].m_iso = %d and it should be %d\n",ti,trim.m_iso,iso);
-          return ON_BrepIsNotValid();
-        }
+        if ( text_log )
+          text_log->Print( "ON_Brep.m_E[%d] is deleted (m_edge_index = -1) but edge.m_ei.Count() = %d.\n",
+                           ei, edge.m_ti.Count() );
+        return ON_BrepIsNotValid();
       }
-    }
-
-    if ( trim.m_type == ON_BrepTrim::singular )
-    {
-      if ( trim.m_ei != -1 )
+      if ( edge.m_c3i != -1 )
       {
         if ( text_log )
-          text_log->Print("ON_Brep.m_T[%d].m_type = singular, but m_ei = %d (should be -1).\n",ti,trim.m_ei);
+          text_log->Print( "ON_Brep.m_E[%d] is deleted (m_edge_index = -1) but edge.m_c3i=%d (should be -1).\n",
+                           ei, edge.m_c3i );
+        return ON_BrepIsNotValid();
+      }
+      if ( edge.ProxyCurve() )
+      {
+        if ( text_log )
+          text_log->Print( "ON_Brep.m_E[%d] is deleted (m_edge_index = -1) but edge.m_curve is not NULL.\n",
+                           ei );
+        return ON_BrepIsNotValid();
+      }
+      if ( edge.m_vi[0] != -1 )
+      {
+        if ( text_log )
+          text_log->Print( "ON_Brep.m_E[%d] is deleted (m_edge_index = -1) but edge.m_vi[0]=%d (should be -1).\n",
+                           ei, edge.m_vi[0] );
+        return ON_BrepIsNotValid();
+      }
+      if ( edge.m_vi[1] != -1 )
+      {
+        if ( text_log )
+          text_log->Print( "ON_Brep.m_E[%d] is deleted (m_edge_index = -1) but edge.m_vi[1]=%d (should be -1).\n",
+                           ei, edge.m_vi[1] );
         return ON_BrepIsNotValid();
       }
-      continue;
-    }
-
-    if ( trim.m_ei < 0 || trim.m_ei >= m_E.Count() )
-    {
-      if ( text_log )
-        text_log->Print("ON_Brep.m_T[%d].m_ei = %d is not invalid.\n",ti,trim.m_ei);
-      return ON_BrepIsNotValid();
     }
-    
-    const ON_BrepEdge& edge = m_E[trim.m_ei];
-    if ( edge.m_edge_index != trim.m_ei )
+    else if ( m_E[ei].m_edge_index != ei )
     {
       if ( text_log )
-        text_log->Print("ON_Brep.m_T[%d].m_ei is deleted.\n",ti);
+        text_log->Print( "ON_Brep.m_E[%d].m_edge_index = %d (should be %d)\n",
+                         ei, m_E[ei].m_edge_index, ei );
       return ON_BrepIsNotValid();
     }
+  }
 
-    const int evi0 = trim.m_bRev3d ? 1 : 0;
-    const int evi1 = trim.m_bRev3d ? 0 : 1;
-    if ( trim.m_vi[0] != edge.m_vi[evi0] )
-    {
-      if ( text_log )
-        text_log->Print("ON_Brep.m_T[%d].m_bRev3d = %d, but m_vi[0] != m_E[m_ei].m_vi[%d].\n",ti,trim.m_bRev3d,evi0);
-      return ON_BrepIsNotValid();
-    }
-    if ( trim.m_vi[1] != edge.m_vi[evi1] )
+  for ( ti = 0; ti < trim_count; ti++ ) 
+  {
+    if ( m_T[ti].m_trim_index == -1 )
     {
-      if ( text_log )
-        text_log->Print("ON_Brep.m_T[%d].m_bRev3d = %d, but m_vi[0] != m_E[m_ei].m_vi[%d].\n",ti,trim.m_bRev3d,evi1);
-      return ON_BrepIsNotValid();
-    }
-
-    // check tolerances and closed curve directions
-    {
-      ON_3dPoint trim_pt0, trim_pt1, srf_pt0, srf_pt1;
-      ON_3dVector trim_der0, trim_der1, srf_du0, srf_dv0, srf_du1, srf_dv1;
-      ON_Interval trim_domain = trim.Domain();
-      // trim_pt0 should be closed to trim_pt1 except when
-      // trim starts and ends on opposite sides of a surface 
-      // seam.  Even when the trim curve is closed, the 
-      // derivatives can be different when there is
-      // a kink at the start/end of a trim.
-      trim.Ev1Der( trim_domain[0], trim_pt0, trim_der0 );
-      trim.Ev1Der( trim_domain[1], trim_pt1, trim_der1 );
-
-      const ON_Surface* trim_srf = m_F[ m_L[trim.m_li].m_fi ].SurfaceOf();
-      trim_srf->Ev1Der( trim_pt0.x, trim_pt0.y, srf_pt0, srf_du0, srf_dv0 );
-      trim_srf->Ev1Der( trim_pt1.x, trim_pt1.y, srf_pt1, srf_du1, srf_dv1 );
-
-      // estimate 3d tolerances from 2d trim tolerances
-      double t0_tol = srf_du0.Length()*trim.m_tolerance[0] + srf_dv0.Length()*trim.m_tolerance[1];
-      double t1_tol = srf_du1.Length()*trim.m_tolerance[0] + srf_dv1.Length()*trim.m_tolerance[1];
-      ON_3dVector trim_tangent0 = trim_der0.x*srf_du0 + trim_der0.y*srf_dv0;
-      trim_tangent0.Unitize();
-      ON_3dVector trim_tangent1 = trim_der1.x*srf_du1 + trim_der1.y*srf_dv1;
-      trim_tangent1.Unitize();
-      ON_3dVector edge_tangent0 = edge.TangentAt( edge.Domain()[trim.m_bRev3d ? 1 : 0] );
-      ON_3dVector edge_tangent1 = edge.TangentAt( edge.Domain()[trim.m_bRev3d ? 0 : 1] );
-      double d0 = trim_tangent0*edge_tangent0;
-      double d1 = trim_tangent1*edge_tangent1;
-      if ( trim.m_bRev3d )
-      {
-        d0 = -d0;
-        d1 = -d1;
-      }
-      if (    trim.m_vi[0] == trim.m_vi[1] 
-           && edge.m_vi[0] == edge.m_vi[1] 
-           && trim.m_vi[0] == edge.m_vi[0] 
-           )
-      {
-        // For high quality models, d0 and d1 should be close to +1.
-        // If both are close to -1, the trim.m_bRev3d flag is most
-        // likely set opposite of what it should be.
-
-        // check start tangent to see if m_bRev3d is set correctly
-        if ( d0 < 0.0 || d1 < 0.0)
-        {
-          if ( text_log )
-          {
-            if ( trim.m_bRev3d )
-              text_log->Print("ON_Brep.m_T[%d].m_bRev3d = true, but closed curve directions are the same.\n",ti);
-            else
-              text_log->Print("ON_Brep.m_T[%d].m_bRev3d = false, but closed curve directions are opposite.\n",ti);
-          }
-          return ON_BrepIsNotValid();
-        }
+      const ON_BrepTrim& trim = m_T[ti];
+      if ( trim.m_ei != -1 )
+      {
+        if ( text_log )
+          text_log->Print( "ON_Brep.m_T[%d] is deleted (m_trim_index = -1) but trim.m_ei=%d (should be -1).\n",
+                           ti, trim.m_ei );
+        return ON_BrepIsNotValid();
       }
-
-      // Make sure edge and tolerances are realistic
-      ON_3dPoint EdgeEnd[2];
-      EdgeEnd[trim.m_bRev3d?1:0] = edge.PointAtStart();
-      EdgeEnd[trim.m_bRev3d?0:1] = edge.PointAtEnd();
-      d0 = EdgeEnd[0].DistanceTo(srf_pt0);
-      d1 = EdgeEnd[1].DistanceTo(srf_pt1);
-      double etol = edge.m_tolerance;
-      double dtol = 10.0*(etol + t0_tol + t1_tol);
-      if ( dtol < 0.01 )
-        dtol = 0.01;
-      if ( d0 > dtol  )
+      if ( trim.m_li != -1 )
       {
         if ( text_log )
-        {
-          text_log->Print("Distance from start of ON_Brep.m_T[%d] to 3d edge is %g.  (edge tol = %g, trim tol ~ %g).\n",
-                          ti, d0, etol,t0_tol);
-        }
+          text_log->Print( "ON_Brep.m_T[%d] is deleted (m_trim_index = -1) but trim.m_li=%d (should be -1).\n",
+                           ti, trim.m_li );
         return ON_BrepIsNotValid();
       }
-      if ( d1 > dtol )
+      if ( trim.m_c2i != -1 )
       {
         if ( text_log )
-        {
-          text_log->Print("Distance from end of ON_Brep.m_T[%d] to 3d edge is %g.  (edge tol = %g, trim tol ~ %g).\n",
-                          ti, d1, etol,t1_tol);
-        }
+          text_log->Print( "ON_Brep.m_T[%d] is deleted (m_trim_index = -1) but trim.m_c2i=%d (should be -1).\n",
+                           ti, trim.m_c2i );
         return ON_BrepIsNotValid();
       }
-    }
-
-    // check trim's m_pbox
-    {
-      if ( trim.m_pbox.m_min.z != 0.0 )
+      if ( trim.m_vi[0] != -1 )
       {
         if ( text_log )
-           text_log->Print("ON_Brep.m_T[%d].m_pbox.m_min.z = %g (should be zero).\n",ti,trim.m_pbox.m_min.z);
+          text_log->Print( "ON_Brep.m_T[%d] is deleted (m_trim_index = -1) but trim.m_vi[0]=%d (should be -1).\n",
+                           ti, trim.m_vi[0] );
         return ON_BrepIsNotValid();
       }
-      if ( trim.m_pbox.m_max.z != 0.0 )
+      if ( trim.m_vi[1] != -1 )
       {
         if ( text_log )
-           text_log->Print("ON_Brep.m_T[%d].m_pbox.m_max.z = %g (should be zero).\n",ti,trim.m_pbox.m_max.z);
+          text_log->Print( "ON_Brep.m_T[%d] is deleted (m_trim_index = -1) but trim.m_vi[1]=%d (should be -1).\n",
+                           ti, trim.m_vi[1] );
         return ON_BrepIsNotValid();
       }
-      
-      if ( !TestTrimPBox( trim, text_log ) )
-        return ON_BrepIsNotValid();
-
     }
-
-    if ( ON_BrepTrim::seam == trim.m_type )
+    else if ( m_T[ti].m_trim_index != ti  )
     {
-      // trim must be on a surface edge
-      switch ( trim.m_iso )
-      {
-      case ON_Surface::S_iso:
-        break;
-      case ON_Surface::E_iso:
-        break;
-      case ON_Surface::N_iso:
-        break;
-      case ON_Surface::W_iso:
-        break;
-      default:
-        if ( text_log )
-          text_log->Print("ON_Brep.m_T[%d].m_type = ON_BrepTrim::seam but m_iso is not N/E/W/S_iso.\n",ti);
-        return ON_BrepIsNotValid();
-      }
-      seam_trim_count++;
+      if ( text_log )
+        text_log->Print( "ON_Brep.m_T[%d].m_trim_index = %d (should be %d)\n",
+                         ti, m_T[ti].m_trim_index, ti );
+      return ON_BrepIsNotValid();
+    }
+    else if ( !m_T[ti].IsValid( text_log ) )
+    {
+      if ( text_log )
+        text_log->Print( "ON_Brep.m_T[%d] is not valid\n",ti );
+      return ON_BrepIsNotValid();
     }
   }
 
-  // check loop m_pboxes
-  for ( li = 0; li < loop_count; li++ )
+  for ( li = 0; li < loop_count; li++ ) 
   {
-    const ON_BrepLoop& loop = m_L[li];
-    if ( loop.m_loop_index != li )
-      continue;
-    if ( loop.m_pbox.m_min.z != 0.0 )
+    if ( m_L[li].m_loop_index == -1 )
     {
-      if ( text_log )
-         text_log->Print("ON_Brep.m_L[%d].m_pbox.m_min.z = %g (should be zero).\n",li,loop.m_pbox.m_min.z);
-      return ON_BrepIsNotValid();
+      const ON_BrepLoop& loop = m_L[li];
+      if ( loop.m_fi != -1 )
+      {
+        if ( text_log )
+          text_log->Print( "ON_Brep.m_L[%d] is deleted (m_loop_index = -1) but loop.m_fi=%d (should be -1).\n",
+                           li, loop.m_fi );
+        return ON_BrepIsNotValid();
+      }
+      if ( loop.m_ti.Count() > 0 )
+      {
+        if ( text_log )
+          text_log->Print( "ON_Brep.m_L[%d] is deleted (m_loop_index = -1) but loop.m_ti.Count()=%d.\n",
+                           li, loop.m_ti.Count() );
+        return ON_BrepIsNotValid();
+      }
     }
-    if ( loop.m_pbox.m_max.z != 0.0 )
+    else if ( m_L[li].m_loop_index != li )
     {
       if ( text_log )
-         text_log->Print("ON_Brep.m_L[%d].m_pbox.m_max.z = %g (should be zero).\n",li,loop.m_pbox.m_max.z);
+        text_log->Print( "ON_Brep.m_L[%d].m_loop_index = %d (should be %d)\n",
+                         li, m_L[li].m_loop_index, li );
       return ON_BrepIsNotValid();
     }
-    int first_trim_ti = -4;
-    int first_trim_vi0 = -3;
-    int prev_trim_vi1 = -2;
-    int prev_trim_ti=-9;
-    int lti;
-    for ( lti = 0; lti < loop.m_ti.Count(); lti++ )
+  }
+
+  for ( fi = 0; fi < face_count; fi++ ) 
+  {
+    if ( m_F[fi].m_face_index == -1 )
     {
-      const ON_BrepTrim& trim = m_T[loop.m_ti[lti]];
-      if ( !loop.m_pbox.IsPointIn(trim.m_pbox.m_min) || !loop.m_pbox.IsPointIn(trim.m_pbox.m_max) )
+      const ON_BrepFace& face = m_F[fi];
+      if ( face.m_si != -1 )
       {
         if ( text_log )
-           text_log->Print("ON_Brep.m_L[%d].m_pbox does not contain m_T[loop.m_ti[%d]].m_pbox.\n",li,lti);
+          text_log->Print( "ON_Brep.m_F[%d] is deleted (m_face_index = -1) but face.m_si=%d (should be -1).\n",
+                           fi, face.m_si );
         return ON_BrepIsNotValid();
       }
-      if ( 0 == lti )
+      if ( face.ProxySurface() )
       {
-        first_trim_ti = loop.m_ti[lti];
-        first_trim_vi0 = trim.m_vi[0];
+        if ( text_log )
+          text_log->Print( "ON_Brep.m_F[%d] is deleted (m_face_index = -1) but face.ProxySurface() is not NULL.\n",
+                           fi );
+        return ON_BrepIsNotValid();
       }
-      else if ( prev_trim_vi1 != trim.m_vi[0] )
+      if ( face.m_li.Count() > 0 )
       {
-        // 23 May 2003 Dale Lear
-        //     Added this test to make sure adjacent trims
-        //     in a loop shared vertices.
         if ( text_log )
-           text_log->Print("ON_Brep.m_L[%d] loop has trim vertex mismatch:\n  m_T[loop.m_ti[%d]=%d].m_vi[1] = %d != m_T[loop.m_ti[%d]=%d].m_vi[0]=%d.\n",li,lti-1,prev_trim_ti,prev_trim_vi1,lti,loop.m_ti[lti],trim.m_vi[0]);
+          text_log->Print( "ON_Brep.m_F[%d] is deleted (m_face_index = -1) but face.m_li.Count()=%d.\n",
+                           fi, face.m_li.Count() );
         return ON_BrepIsNotValid();
       }
-      prev_trim_ti = loop.m_ti[lti];
-      prev_trim_vi1 = trim.m_vi[1];
     }
-
-    if ( first_trim_ti >= 0 && first_trim_vi0 != prev_trim_vi1 )
+    else if ( m_F[fi].m_face_index != fi )
     {
-      // 23 May 2003 Dale Lear
-      //     Added this test to make sure adjacent trims
-      //     in a loop shared vertices.
       if ( text_log )
-         text_log->Print("ON_Brep.m_L[%d] loop has trim vertex mismatch:\n  m_T[loop.m_ti[%d]=%d].m_vi[1] = %d != m_T[loop.m_ti[%d]=%d].m_vi[0]=%d.\n",
-                         li,lti-1,prev_trim_ti,prev_trim_vi1,0,first_trim_ti,first_trim_vi0);
+        text_log->Print( "ON_Brep.m_F[%d].m_face_index = %d (should be %d)\n",
+                         fi, m_F[fi].m_face_index, fi );
       return ON_BrepIsNotValid();
     }
   }
 
+  // check 2d curve, 3d curve and surface geometry
+  if ( !IsValidComponents( 0, text_log, thread_count ) )
+    return ON_BrepIsNotValid();
+
+  // check vertices, edges and faces
+  if ( !IsValidComponents( 3, text_log, thread_count ) )
+    return ON_BrepIsNotValid();
+
+  // check loops, trims and loop m_pboxes
+  if ( !IsValidComponents( 6, text_log, thread_count ) )
+    return ON_BrepIsNotValid();
+
+  int seam_trim_count = 0;
+  for ( ti = 0; ti < trim_count; ti++ )
+  {
+    if ( m_T[ti].m_trim_index == ti && ON_BrepTrim::seam == m_T[ti].m_type )
+      seam_trim_count++;
+  }
+
   // 21 October 2003 Dale Lear - fix RR 11980 - check for split seams
   // This block of code assumes the preceding checks have all passed.
   // It looks for boundary trims on seams that should be joined as a seam trim.
@@ -6312,6 +6619,7 @@ ON_Brep::GetBBox(
 ON_BOOL32
 ON_Brep::SwapCoordinates( int i, int j )
 {
+  UnshareGeometry();
   ON_BOOL32 rc = false;
   // swap surface coordinates
   const int srf_count = m_S.Count();
@@ -6782,6 +7090,7 @@ ON_BOOL32 ON_BrepFace::Reverse(int dir)
 {
   if ( dir < 0 || dir > 1 || 0 == m_brep )
     return false;
+  m_brep->UnshareGeometry();
   ON_Surface* srf = const_cast<ON_Surface*>(SurfaceOf());
   if ( !srf )
     return false;
@@ -6830,6 +7139,8 @@ ON_BOOL32 ON_BrepFace::Reverse(int dir)
 
 	// Greg Arden 10 April 2003.  Fix TRR#9624.  
 	// Update analysis and render meshes.
+  ReadDeferredMesh(ON::render_mesh);
+  ReadDeferredMesh(ON::analysis_mesh);
 	if(m_render_mesh)
   {
     m_render_mesh->ReverseSurfaceParameters(dir);
@@ -6849,6 +7160,7 @@ ON_BOOL32 ON_BrepFace::Transpose()
   if ( 0 == m_brep )
     return false;
 
+  m_brep->UnshareGeometry();
   ON_Surface* srf = const_cast<ON_Surface*>(SurfaceOf());
   if ( 0 == srf )
     return false;
@@ -6904,6 +7216,8 @@ ON_BOOL32 ON_BrepFace::Transpose()
 
 	// Update analysis mesh and render mesh.
   // (Greg Arden 10 April 2003.  Fix TRR#9624.)
+  ReadDeferredMesh(ON::render_mesh);
+  ReadDeferredMesh(ON::analysis_mesh);
 	if(m_render_mesh)
   {
 		m_render_mesh->TransposeSurfaceParameters();
@@ -6930,6 +7244,7 @@ bool ON_BrepFace::SetDomain(
   if ( !v_dom.IsIncreasing() )
     return false;
   
+  m_brep->UnshareGeometry();
   ON_Surface* srf = const_cast<ON_Surface*>(SurfaceOf());
   if ( 0 == srf )
     return false;
@@ -7002,6 +7317,8 @@ bool ON_BrepFace::SetDomain(
   if ( !TransformTrim(xform) )
     return false;
 
+  ReadDeferredMesh(ON::render_mesh);
+  ReadDeferredMesh(ON::analysis_mesh);
   ON_Mesh* mesh[3] = {m_analysis_mesh,m_render_mesh,m_preview_mesh};
   for ( int i = 0; i < 3; i++ )
   {
@@ -7043,6 +7360,7 @@ ON_BOOL32 ON_BrepFace::SetDomain(
        || 0 == m_brep )
     return false;
 
+  m_brep->UnshareGeometry();
   ON_Surface* srf = const_cast<ON_Surface*>(SurfaceOf());
   if ( 0 == srf )
     return false;
@@ -7162,6 +7480,8 @@ void
 ON_Brep::FlipFace( ON_BrepFace& face )
 {
   face.m_bRev = (face.m_bRev) ? false : true;
+  face.ReadDeferredMesh(ON::render_mesh);
+  face.ReadDeferredMesh(ON::analysis_mesh);
   if ( face.m_analysis_mesh )
     face.m_analysis_mesh->Flip();
   if ( face.m_render_mesh )
@@ -7780,12 +8100,20 @@ void ON_Brep::Dump( ON_TextLog& dump ) const
     }
     dump.Print(")\n");
     dump.PushIndent();
+    // Dump does not read deferred meshes from the file.  A deferred
+    // mesh is reported so the output does not suggest it is missing.
     if ( face.m_render_mesh ) {
       dump.Print("Render mesh: %d polygons\n",face.m_render_mesh->FaceCount());
     }
+    else if ( 0 != face.m_deferred_mesh_reader && 0 != face.m_deferred_mesh_offset[0] ) {
+      dump.Print("Render mesh: deferred (not read from the file)\n");
+    }
     if ( face.m_analysis_mesh ) {
       dump.Print("Analysis mesh: %d polygons\n",face.m_analysis_mesh->FaceCount());
     }
+    else if ( 0 != face.m_deferred_mesh_reader && 0 != face.m_deferred_mesh_offset[1] ) {
+      dump.Print("Analysis mesh: deferred (not read from the file)\n");
+    }
     if ( FaceIsSurface(fi) ) {
       dump.Print("(Face geometry is the same as underlying surface.)\n");
     }
@@ -8910,6 +9238,8 @@ ON_Brep* ON_Brep::DuplicateFaces( int face_count, const int* face_index, ON_BOOL
         face_copy.m_analysis_mesh = face.m_analysis_mesh->Duplicate();
       if ( face.m_preview_mesh )
         face_copy.m_preview_mesh = face.m_preview_mesh->Duplicate();
+      face_copy.SetDeferredMesh(ON::render_mesh,face.m_deferred_mesh_reader,face.m_deferred_mesh_offset[0]);
+      face_copy.SetDeferredMesh(ON::analysis_mesh,face.m_deferred_mesh_reader,face.m_deferred_mesh_offset[1]);
     }
 
     rc = true;
@@ -8944,6 +9274,8 @@ ON_Brep* ON_Brep::ExtractFace( int face_index )
     face_copy.m_render_mesh = face.m_render_mesh; face.m_render_mesh = 0;
     face_copy.m_analysis_mesh = face.m_analysis_mesh; face.m_analysis_mesh = 0;
     face_copy.m_preview_mesh = face.m_preview_mesh; face.m_preview_mesh = 0;
+    face_copy.SetDeferredMesh(ON::render_mesh,face.m_deferred_mesh_reader,face.m_deferred_mesh_offset[0]);
+    face_copy.SetDeferredMesh(ON::analysis_mesh,face.m_deferred_mesh_reader,face.m_deferred_mesh_offset[1]);
     DeleteFace( face, true );
   }
   return brep_copy;
@@ -8952,7 +9284,10 @@ ON_Brep* ON_Brep::ExtractFace( int face_index )
 void ON_Brep::DeleteSurface(int si)
 {
   if ( si >= 0 && si < m_S.Count() ) {
-    delete m_S[si];
+    if ( SharedGeometryHelper(2,si) )
+      SetSharedGeometryHelper(2,si,0); // release this brep's reference
+    else
+      delete m_S[si];
     m_S[si] = 0;
   }
 }
@@ -8960,7 +9295,10 @@ void ON_Brep::DeleteSurface(int si)
 void ON_Brep::Delete2dCurve(int c2i)
 {
   if ( c2i >= 0 && c2i < m_C2.Count() ) {
-    delete m_C2[c2i];
+    if ( SharedGeometryHelper(0,c2i) )
+      SetSharedGeometryHelper(0,c2i,0); // release this brep's reference
+    else
+      delete m_C2[c2i];
     m_C2[c2i] = 0;
   }
 }
@@ -8968,7 +9306,10 @@ void ON_Brep::Delete2dCurve(int c2i)
 void ON_Brep::Delete3dCurve(int c3i)
 {
   if ( c3i >= 0 && c3i < m_C3.Count() ) {
-    delete m_C3[c3i];
+    if ( SharedGeometryHelper(1,c3i) )
+      SetSharedGeometryHelper(1,c3i,0); // release this brep's reference
+    else
+      delete m_C3[c3i];
     m_C3[c3i] = 0;
   }
 }
@@ -9066,6 +9407,8 @@ bool ON_Brep::CullUnusedSurfaces()
     }
 
     if ( mi == 0 ) {
+      for ( si = 0; si < scount; si++ )
+        DeleteSurface(si);
       m_S.Destroy();
     }
     else if ( mi < scount ) {
@@ -9074,8 +9417,7 @@ bool ON_Brep::CullUnusedSurfaces()
         if ( smap[si] )
           smap[si] = mi++;
         else {
-          delete m_S[si];
-          m_S[si] = 0;
+          DeleteSurface(si);
           smap[si] = -1;
         }
       }
@@ -9090,6 +9432,7 @@ bool ON_Brep::CullUnusedSurfaces()
       for ( si = scount-1; si >= 0; si-- ) {
         if ( smap[si] < 0 ) {
           m_S.Remove(si);
+          RemoveSharedGeometryHelper(2,si);
           scount--;
         }
       }
@@ -9134,6 +9477,8 @@ bool ON_Brep::CullUnused3dCurves()
     }
 
     if ( mi == 0 ) {
+      for ( c3i = 0; c3i < c3count; c3i++ )
+        Delete3dCurve(c3i);
       m_C3.Destroy();
     }
     else if ( mi < c3count ) {
@@ -9142,8 +9487,7 @@ bool ON_Brep::CullUnused3dCurves()
         if ( c3map[c3i] )
           c3map[c3i] = mi++;
         else {
-          delete m_C3[c3i];
-          m_C3[c3i] = 0;
+          Delete3dCurve(c3i);
           c3map[c3i] = -1;
         }
       }
@@ -9158,6 +9502,7 @@ bool ON_Brep::CullUnused3dCurves()
       for ( c3i = c3count-1; c3i >= 0; c3i-- ) {
         if ( c3map[c3i] < 0 ) {
           m_C3.Remove(c3i);
+          RemoveSharedGeometryHelper(1,c3i);
           c3count--;
         }
       }
@@ -9204,6 +9549,8 @@ bool ON_Brep::CullUnused2dCurves()
     }
 
     if ( mi == 0 ) {
+      for ( c2i = 0; c2i < c2count; c2i++ )
+        Delete2dCurve(c2i);
       m_C2.Destroy();
     }
     else if ( mi < c2count ) {
@@ -9212,8 +9559,7 @@ bool ON_Brep::CullUnused2dCurves()
         if ( c2map[c2i] )
           c2map[c2i] = mi++;
         else {
-          delete m_C2[c2i];
-          m_C2[c2i] = 0;
+          Delete2dCurve(c2i);
           c2map[c2i] = -1;
         }
       }
@@ -9228,6 +9574,7 @@ bool ON_Brep::CullUnused2dCurves()
       for ( c2i = c2count-1; c2i >= 0; c2i-- ) {
         if ( c2map[c2i] < 0 ) {
           m_C2.Remove(c2i);
+          RemoveSharedGeometryHelper(0,c2i);
           c2count--;
         }
       }
@@ -9755,10 +10102,304 @@ bool ON_Brep::Compact()
 }
 
 
+////////////////////////////////////////////////////////////////
+//   Geometry shared by several breps
+////////////////////////////////////////////////////////////////
+
+class ON_BrepSharedGeometry
+{
+public:
+  // curve or surface used by m_ref_count breps
+  ON_Object* m_geometry;
+  int m_ref_count;
+};
+
+class ON_BrepSharedGeometryList
+{
+public:
+  // m_shared[0][c2i], m_shared[1][c3i] and m_shared[2][si]
+  // are the references a brep holds.  When m_shared[kind][i]
+  // is not NULL and m_shared[kind][i]->m_geometry is the curve
+  // or surface at index i in the brep, that curve or surface
+  // is shared and the brep does not delete it.
+  ON_SimpleArray<ON_BrepSharedGeometry*> m_shared[3];
+};
+
+static void ON_BrepReleaseSharedGeometry( ON_BrepSharedGeometry* g )
+{
+  if ( g && 0 == ON_ATOMIC_DECREMENT(&g->m_ref_count) )
+  {
+    delete g->m_geometry;
+    delete g;
+  }
+}
+
+static int ON_BrepGeometryCount( const ON_Brep& brep, int kind )
+{
+  switch(kind)
+  {
+  case 0: return brep.m_C2.Count();
+  case 1: return brep.m_C3.Count();
+  case 2: return brep.m_S.Count();
+  }
+  return 0;
+}
+
+static ON_Object* ON_BrepGeometry( const ON_Brep& brep, int kind, int i )
+{
+  switch(kind)
+  {
+  case 0: return brep.m_C2[i];
+  case 1: return brep.m_C3[i];
+  case 2: return brep.m_S[i];
+  }
+  return 0;
+}
+
+static bool ON_BrepSetGeometry( ON_Brep& brep, int kind, int i, ON_Object* geometry )
+{
+  switch(kind)
+  {
+  case 0: 
+    brep.m_C2[i] = ON_Curve::Cast(geometry);
+    return ( brep.m_C2[i] == geometry );
+  case 1:
+    brep.m_C3[i] = ON_Curve::Cast(geometry);
+    return ( brep.m_C3[i] == geometry );
+  case 2:
+    brep.m_S[i] = ON_Surface::Cast(geometry);
+    return ( brep.m_S[i] == geometry );
+  }
+  return false;
+}
+
+ON_BrepSharedGeometry* ON_Brep::SharedGeometryHelper( int kind, int i ) const
+{
+  if ( 0 == m_shared_geometry || i < 0 || i >= m_shared_geometry->m_shared[kind].Count() )
+    return 0;
+  ON_BrepSharedGeometry* g = m_shared_geometry->m_shared[kind][i];
+  if (    0 == g 
+       || i >= ON_BrepGeometryCount(*this,kind) 
+       || g->m_geometry != ON_BrepGeometry(*this,kind,i) 
+     )
+  {
+    return 0;
+  }
+  return g;
+}
+
+void ON_Brep::SetSharedGeometryHelper( int kind, int i, ON_BrepSharedGeometry* g )
+{
+  // g is a reference the caller has already counted.  The 
+  // reference previously held at index i is released.
+  if ( 0 == m_shared_geometry )
+  {
+    if ( 0 == g )
+      return;
+    m_shared_geometry = new ON_BrepSharedGeometryList();
+  }
+  ON_SimpleArray<ON_BrepSharedGeometry*>& a = m_shared_geometry->m_shared[kind];
+  if ( i >= a.Count() )
+  {
+    if ( 0 == g )
+      return;
+    a.Reserve(ON_BrepGeometryCount(*this,kind) > i ? ON_BrepGeometryCount(*this,kind) : i+1);
+    while ( a.Count() <= i )
+      a.Append(0);
+  }
+  ON_BrepSharedGeometry* g0 = a[i];
+  a[i] = g;
+  ON_BrepReleaseSharedGeometry(g0);
+}
+
+ON_Object* ON_Brep::ShareGeometryHelper( const ON_Brep& src, int kind, int src_index, int index )
+{
+  // Returns the curve or surface at src_index in src and
+  // records that this brep uses it at index.
+  ON_Object* geometry = ON_BrepGeometry(src,kind,src_index);
+  if ( 0 == geometry )
+    return 0;
+  ON_BrepSharedGeometry* g = src.SharedGeometryHelper(kind,src_index);
+  if ( 0 == g )
+  {
+    // src owns the geometry.  Make a reference counted
+    // record that src and this brep use.
+    g = new ON_BrepSharedGeometry();
+    g->m_geometry = geometry;
+    g->m_ref_count = 1;
+    const_cast<ON_Brep&>(src).SetSharedGeometryHelper(kind,src_index,g);
+  }
+  ON_ATOMIC_INCREMENT(&g->m_ref_count);
+  SetSharedGeometryHelper(kind,index,g);
+  return geometry;
+}
+
+void ON_Brep::RemoveSharedGeometryHelper( int kind, int i )
+{
+  // Called when element i is removed from m_C2[], m_C3[] or m_S[].
+  if ( 0 != m_shared_geometry && i >= 0 && i < m_shared_geometry->m_shared[kind].Count() )
+  {
+    ON_BrepReleaseSharedGeometry(m_shared_geometry->m_shared[kind][i]);
+    m_shared_geometry->m_shared[kind].Remove(i);
+  }
+}
+
+void ON_Brep::DestroySharedGeometryHelper()
+{
+  if ( 0 == m_shared_geometry )
+    return;
+
+  int kind, i, count;
+  for ( kind = 0; kind < 3; kind++ )
+  {
+    // Remove shared geometry from m_C2[], m_C3[] and m_S[] 
+    // so this brep does not delete it.
+    count = ON_BrepGeometryCount(*this,kind);
+    for ( i = 0; i < count; i++ )
+    {
+      if ( SharedGeometryHelper(kind,i) )
+        ON_BrepSetGeometry(*this,kind,i,0);
+    }
+  }
+
+  for ( kind = 0; kind < 3; kind++ )
+  {
+    ON_SimpleArray<ON_BrepSharedGeometry*>& a = m_shared_geometry->m_shared[kind];
+    count = a.Count();
+    for ( i = 0; i < count; i++ )
+      ON_BrepReleaseSharedGeometry(a[i]);
+  }
+
+  delete m_shared_geometry;
+  m_shared_geometry = 0;
+}
+
+bool ON_Brep::UnshareGeometry()
+{
+  if ( 0 == m_shared_geometry )
+    return true;
+
+  bool rc = true;
+  bool bChanged = false;
+  int kind, i, count;
+  for ( kind = 0; kind < 3; kind++ )
+  {
+    count = ON_BrepGeometryCount(*this,kind);
+    for ( i = 0; i < count; i++ )
+    {
+      ON_BrepSharedGeometry* g = SharedGeometryHelper(kind,i);
+      if ( 0 == g )
+        continue;
+      if ( 1 == g->m_ref_count )
+      {
+        // This brep is the only one left that uses the geometry.
+        g->m_geometry = 0;
+      }
+      else
+      {
+        ON_Object* geometry = g->m_geometry->Duplicate();
+        if ( !ON_BrepSetGeometry(*this,kind,i,geometry) )
+        {
+          ON_ERROR("ON_Brep::UnshareGeometry - unable to duplicate geometry.");
+          delete geometry;
+          rc = false;
+        }
+        bChanged = true;
+      }
+    }
+  }
+
+  DestroySharedGeometryHelper();
+
+  if ( bChanged )
+  {
+    // update proxy information to point at the copies
+    const int c2_count = m_C2.Count();
+    const int c3_count = m_C3.Count();
+    const int s_count = m_S.Count();
+
+    count = m_E.Count();
+    for ( i = 0; i < count; i++ )
+    {
+      ON_BrepEdge& edge = m_E[i];
+      if ( edge.m_c3i < 0 || edge.m_c3i >= c3_count || edge.ProxyCurve() == m_C3[edge.m_c3i] )
+        continue;
+      const ON_Interval proxy_domain = edge.ProxyCurveDomain();
+      const ON_Interval domain = edge.Domain();
+      const bool bReversed = edge.ProxyCurveIsReversed();
+      edge.SetProxyCurve( m_C3[edge.m_c3i], proxy_domain );
+      if ( bReversed )
+        edge.ON_CurveProxy::Reverse();
+      edge.SetDomain( domain );
+    }
+
+    count = m_T.Count();
+    for ( i = 0; i < count; i++ )
+    {
+      ON_BrepTrim& trim = m_T[i];
+      if ( trim.m_c2i < 0 || trim.m_c2i >= c2_count || trim.ProxyCurve() == m_C2[trim.m_c2i] )
+        continue;
+      const ON_Interval proxy_domain = trim.ProxyCurveDomain();
+      const ON_Interval domain = trim.Domain();
+      const bool bReversed = trim.ProxyCurveIsReversed();
+      trim.SetProxyCurve( m_C2[trim.m_c2i], proxy_domain );
+      if ( bReversed )
+        trim.ON_CurveProxy::Reverse();
+      trim.SetDomain( domain );
+    }
+
+    count = m_F.Count();
+    for ( i = 0; i < count; i++ )
+    {
+      ON_BrepFace& face = m_F[i];
+      if ( face.m_si < 0 || face.m_si >= s_count || face.ProxySurface() == m_S[face.m_si] )
+        continue;
+      const ON_BoundingBox bbox = face.m_bbox;
+      const bool bTransposed = face.ProxySurfaceIsTransposed();
+      face.SetProxySurface( m_S[face.m_si] );
+      if ( bTransposed )
+        face.ON_SurfaceProxy::Transpose();
+      face.m_bbox = bbox; // because SetProxySurface destroys it
+    }
+  }
+
+  return rc;
+}
+
+bool ON_Brep::HasSharedGeometry() const
+{
+  if ( 0 == m_shared_geometry )
+    return false;
+  int kind, i, count;
+  for ( kind = 0; kind < 3; kind++ )
+  {
+    count = ON_BrepGeometryCount(*this,kind);
+    for ( i = 0; i < count; i++ )
+    {
+      const ON_BrepSharedGeometry* g = SharedGeometryHelper(kind,i);
+      if ( g && g->m_ref_count > 1 )
+        return true;
+    }
+  }
+  return false;
+}
+
+void ON_Brep::CopyAndShareGeometry( const ON_Brep& src )
+{
+  CopyHelper( src, true );
+}
+
 ON_Brep& ON_Brep::operator=(const ON_Brep& src)
+{
+  CopyHelper( src, false );
+  return *this;
+}
+
+void ON_Brep::CopyHelper( const ON_Brep& src, bool bShareGeometry )
 {
   if ( this != &src ) 
   {
+    ON_MemorySubsystemScope ms(ON_MEMORY_SUBSYSTEM_BREP);
     Destroy();
     ON_Geometry::operator=(src);
 
@@ -9774,11 +10415,30 @@ ON_Brep& ON_Brep::operator=(const ON_Brep& src)
     m_T.SetCount(src.m_T.Count());
     m_L.SetCount(src.m_L.Count());
 
-    src.m_C2.Duplicate( m_C2 );
-    src.m_C3.Duplicate( m_C3 );
-    src.m_S.Duplicate( m_S );
+    int i, count;
+    if ( bShareGeometry )
+    {
+      count = src.m_C2.Count();
+      m_C2.Reserve(count);
+      for ( i = 0; i < count; i++ )
+        m_C2.Append( ON_Curve::Cast(ShareGeometryHelper(src,0,i,i)) );
+      count = src.m_C3.Count();
+      m_C3.Reserve(count);
+      for ( i = 0; i < count; i++ )
+        m_C3.Append( ON_Curve::Cast(ShareGeometryHelper(src,1,i,i)) );
+      count = src.m_S.Count();
+      m_S.Reserve(count);
+      for ( i = 0; i < count; i++ )
+        m_S.Append( ON_Surface::Cast(ShareGeometryHelper(src,2,i,i)) );
+    }
+    else
+    {
+      src.m_C2.Duplicate( m_C2 );
+      src.m_C3.Duplicate( m_C3 );
+      src.m_S.Duplicate( m_S );
+    }
 
-    int i, count = m_V.Count();
+    count = m_V.Count();
     for ( i = 0; i < count; i++ ) 
     {
       m_V[i] = src.m_V[i];
@@ -9842,7 +10502,6 @@ ON_Brep& ON_Brep::operator=(const ON_Brep& src)
     m_bbox = src.m_bbox;
     m_is_solid = src.m_is_solid;
   }
-  return *this;
 }
 
 void ON_Brep::Destroy()
@@ -9853,6 +10512,8 @@ void ON_Brep::Destroy()
   m_T.Empty();
   m_L.Empty();
 
+  DestroySharedGeometryHelper();
+
   int i, count = m_C2.Count();
   for ( i = 0; i < count; i++ ) {
     delete m_C2[i];
@@ -9896,6 +10557,7 @@ void ON_Brep::EmergencyDestroy()
   m_S.EmergencyDestroy();
   m_bbox.Destroy();
   m_is_solid = 0;
+  m_shared_geometry = 0;
 }
 
 bool ON_Brep::CombineCoincidentVertices(ON_BrepVertex& vertex0, ON_BrepVertex& vertex1)
@@ -9980,6 +10642,7 @@ ON_BrepEdge* ON_Brep::CombineContiguousEdges(
   double angle_tolerance_radians
   )
 {
+  UnshareGeometry();
   // Bug fixers:
   //
   // Lots of (fast)testing is done to ensure the brep is
@@ -10335,6 +10998,7 @@ bool ON_Brep::SplitEdge(int eid,
                         bool bSetTrimBoxesAndFlags
                         )
 {
+  UnshareGeometry();
   if ( eid > 0 )
   {
     // adjust eid from possible component index to true edge index
@@ -11497,6 +12161,7 @@ bool ON_Brep::StandardizeEdgeCurve( int edge_index, bool bAdjustEnds )
 
 bool ON_Brep::StandardizeEdgeCurve( int edge_index, bool bAdjustEnds, int EdgeCurveUse )
 {
+  UnshareGeometry();
   bool rc = false;
   ON_BrepEdge* edge = Edge(edge_index);
   if ( 0 != edge && edge->m_edge_index >= 0 )
@@ -11639,6 +12304,7 @@ void ON_Brep::StandardizeEdgeCurves( bool bAdjustEnds)
 
 bool ON_Brep::StandardizeTrimCurve( int trim_index )
 {
+  UnshareGeometry();
   bool rc = false;
   ON_BrepTrim* trim = Trim(trim_index);
   if ( 0 != trim && trim->m_trim_index >= 0 )
@@ -11720,6 +12386,7 @@ void ON_Brep::StandardizeTrimCurves()
 
 bool ON_Brep::StandardizeFaceSurface( int face_index )
 {
+  UnshareGeometry();
   bool rc = false;
   ON_BrepFace* face = Face(face_index);
   if ( 0 != face && face->m_face_index >= 0 )
@@ -11773,6 +12440,7 @@ void ON_Brep::Standardize()
 
 bool ON_Brep::ShrinkSurface( ON_BrepFace& face, int DisableMask )
 {
+  UnshareGeometry();
   ON_Surface* srf = const_cast<ON_Surface*>(face.SurfaceOf());
   if ( !srf )
     return false;
@@ -12599,6 +13267,7 @@ bool ON_Brep::RebuildEdges( ON_BrepFace& face,
                    ON_BOOL32 bRebuildVertices
                    )
 {
+  UnshareGeometry();
   DestroyMesh( ON::any_mesh );
   ON_SimpleArray<unsigned char> bRebuiltEdge( m_E.Count() );
   bRebuiltEdge.SetCount( m_E.Count() );
@@ -1270,6 +1270,17 @@ private:
   ON_Mesh* m_preview_mesh;
   //int m_material_index; // if 0 (default), ON_Brep's object attributes
   //                      // determine material.
+
+  // When a brep is read by an archive with a deferred reader,
+  // the render and analysis meshes are left in the file and
+  // m_deferred_mesh_offset[] records where they are.
+  // [0] = render mesh, [1] = analysis mesh, 0 = no deferred mesh.
+  // These members change the size of ON_BrepFace; code that 
+  // uses ON_BrepFace must be compiled with this header.
+  class ON_3dmDeferredReader* m_deferred_mesh_reader;
+  ON__UINT64 m_deferred_mesh_offset[2];
+  bool ReadDeferredMesh( ON::mesh_type mesh_type ) const;
+  void SetDeferredMesh( ON::mesh_type mesh_type, ON_3dmDeferredReader* reader, ON__UINT64 offset );
 private:
   friend class ON_Brep;
   ON_Brep* m_brep;
@@ -1478,6 +1489,25 @@ public:
   */
   int GetMesh( ON::mesh_type mesh_type, ON_SimpleArray< const ON_Mesh* >& meshes ) const;
 
+  /*
+  Description:
+    Read render and analysis meshes that were left in the file
+    when the brep was read with deferred mesh reading enabled.
+  Returns:
+    Number of meshes read.
+  Remarks:
+    ON_BrepFace::Mesh reads a face's deferred mesh the first time
+    it is asked for, so calling this function is never required.
+    It is useful when all the meshes are needed and the file
+    is about to be closed or modified, and before several 
+    threads use the brep, because ON_BrepFace::Mesh changes
+    the face when it reads a deferred mesh.
+  See Also:
+    ONX_Model::m_bDeferMeshes
+    ON_BrepFace::Mesh
+  */
+  int ReadDeferredMeshes() const;
+
   /*
   Description:
     Create a brep from a surface.  The resulting surface has an outer
@@ -1538,6 +1568,34 @@ public:
   */
   ON_BOOL32 IsValid( ON_TextLog* text_log = NULL ) const;
 
+  /*
+  Description:
+    Tests an object to see if its data members are correctly
+    initialized.  The curves, surfaces, vertices, edges,
+    faces, loops and trims are checked on several threads.
+  Parameters:
+    text_log - [in] if the object is not valid and text_log
+        is not NULL, then a brief englis description of the
+        reason the object is not valid is appened to the log.
+        The text appended to text_log is the same as the text
+        appended by IsValid(text_log).
+    thread_count - [in] 
+        number of threads to use.  If thread_count <= 0, 
+        ON_ProcessorCount() threads are used.  If thread_count
+        is 1, this is the same as IsValid(text_log).
+  Returns:
+    @untitled table
+    true     object is valid
+    false    object is invalid, uninitialized, etc.
+  Remarks:
+    The curves and surfaces are evaluated at the same time
+    on different threads.  If a curve or surface is shared
+    by more than one brep, do not use more than one thread.
+  See Also:
+    ON_ParallelFor
+  */
+  bool IsValid( ON_TextLog* text_log, int thread_count ) const;
+
   /*
   Description:
     Tests the brep to see if its topology information is
@@ -2322,6 +2380,67 @@ public:
     const ON_Brep& // brep
     ); 
 
+  /*
+  Description:
+    Makes this brep a copy of src that shares the 2d curves,
+    3d curves and surfaces in src.m_C2[], src.m_C3[] and src.m_S[]
+    instead of duplicating them.
+  Parameters:
+    src - [in]
+  Remarks:
+    The cost of the copy depends on the number of vertices, edges,
+    trims, loops and faces, not on the size of the curves and 
+    surfaces.  Shared curves and surfaces are reference counted
+    and deleted when the last brep that uses them is destroyed.
+    ON_Brep functions that modify curves or surfaces, like
+    Transform(), Morph() and the Standardize...() functions,
+    call UnshareGeometry() first, so the other breps are not 
+    changed (copy on write).  If you modify a curve or surface
+    in m_C2[], m_C3[] or m_S[] directly, call UnshareGeometry()
+    first.  The copy constructor and operator= duplicate the
+    geometry.
+    src is changed to record that its geometry is shared, so 
+    src may not be used by other threads during the call.
+  See Also:
+    ON_Brep::AppendAndShareGeometry
+    ON_Brep::UnshareGeometry
+  */
+  void CopyAndShareGeometry( const ON_Brep& src );
+
+  /*
+  Description:
+    Appends a copy of brep to this brep that shares the 2d curves,
+    3d curves and surfaces in brep, and updates indices of the 
+    appended brep parts.  Duplicates are not removed.
+  Parameters:
+    brep - [in]
+  Remarks:
+    See ON_Brep::CopyAndShareGeometry for details.
+  See Also:
+    ON_Brep::Append
+  */
+  void AppendAndShareGeometry( const ON_Brep& brep );
+
+  /*
+  Description:
+    Replaces curves and surfaces shared with other breps with
+    copies that are owned by this brep.
+  Returns:
+    true if successful.
+  See Also:
+    ON_Brep::CopyAndShareGeometry
+  */
+  bool UnshareGeometry();
+
+  /*
+  Returns:
+    true if this brep shares some of its curves or surfaces
+    with another brep.
+  See Also:
+    ON_Brep::CopyAndShareGeometry
+  */
+  bool HasSharedGeometry() const;
+
   // This function can be used to compute vertex information for a
   // b-rep when everything but the m_V array is properly filled in.
   // It is intended to be used when creating a ON_Brep from a 
@@ -3798,6 +3917,14 @@ protected:
   // 3 = not solid
   int m_is_solid;
 
+  // Reference counted geometry shared with other breps.
+  // NULL unless CopyAndShareGeometry() or 
+  // AppendAndShareGeometry() were used.
+  // m_shared_geometry is the last data member, so it does not 
+  // move the others, but it changes sizeof(ON_Brep); code that 
+  // uses ON_Brep must be compiled with this header.
+  class ON_BrepSharedGeometryList* m_shared_geometry;
+
   // These are friends so legacy tol values stored in v1 3dm files
   // can be used to set brep edge and trimming tolerances with a call
   // to ON_Brep::SetTolsFromLegacyValues().
@@ -3805,6 +3932,16 @@ protected:
   friend bool ON_BinaryArchive::ReadV1_TCODE_LEGACY_SHL(ON_Object**,ON_3dmObjectAttributes*);
   void Initialize();
 
+  // helpers for shared geometry
+  //   kind: 0 = m_C2[], 1 = m_C3[], 2 = m_S[]
+  void CopyHelper( const ON_Brep&, bool bShareGeometry );
+  void AppendHelper( const ON_Brep&, bool bShareGeometry );
+  class ON_BrepSharedGeometry* SharedGeometryHelper( int kind, int i ) const;
+  void SetSharedGeometryHelper( int kind, int i, class ON_BrepSharedGeometry* );
+  ON_Object* ShareGeometryHelper( const ON_Brep& src, int kind, int src_index, int index );
+  void RemoveSharedGeometryHelper( int kind, int i );
+  void DestroySharedGeometryHelper();
+
   // helpers to set ON_BrepTrim::m_iso flag
   void SetTrimIsoFlag(int,double[6]);
   void SetTrimIsoFlag(int);
@@ -3851,6 +3988,11 @@ protected:
   bool IsValidVertexGeometry(int vertex_index,ON_TextLog* text_log) const;
   bool IsValidVertexTolerancesAndFlags(int vertex_index,ON_TextLog* text_log) const;
 
+  // helpers for IsValid(text_log,thread_count)
+  bool IsValidComponent(int type,int index,ON_TextLog* text_log) const;
+  bool IsValidComponents(int type0,ON_TextLog* text_log,int thread_count) const;
+  static void IsValidComponentTask(void* context,int task_index);
+
   void SetTolsFromLegacyValues();
 
   // read helpers to support various versions
@@ -679,7 +679,7 @@ ON_BOOL32 ON_Brep::Write( ON_BinaryArchive& file ) const
     if ( rc )
     {
       for ( fi = 0; rc && fi < face_count; fi++ ) {
-        const ON_Mesh* mesh = file.Save3dmRenderMeshes() ? brep->m_F[fi].m_render_mesh : 0;
+        const ON_Mesh* mesh = file.Save3dmRenderMeshes() ? brep->m_F[fi].Mesh(ON::render_mesh) : 0;
         b = mesh ? 1 : 0;
         rc = file.WriteChar(b);
         if (rc && mesh) {
@@ -697,7 +697,7 @@ ON_BOOL32 ON_Brep::Write( ON_BinaryArchive& file ) const
     if ( rc )
     {
       for ( fi = 0; rc && fi < face_count; fi++ ) {
-        const ON_Mesh* mesh = file.Save3dmAnalysisMeshes() ? brep->m_F[fi].m_analysis_mesh : 0;
+        const ON_Mesh* mesh = file.Save3dmAnalysisMeshes() ? brep->m_F[fi].Mesh(ON::analysis_mesh) : 0;
         b = mesh ? 1 : 0;
         rc = file.WriteChar(b);
         if (rc && mesh) {
@@ -726,6 +726,27 @@ ON_BOOL32 ON_Brep::Write( ON_BinaryArchive& file ) const
   return rc;
 }
 
+static
+bool SkipDeferredMesh( ON_BinaryArchive& file, ON__UINT64* offset )
+{
+  // Skip the TCODE_OPENNURBS_CLASS chunk that WriteObject() wrote
+  // and return its position so it can be read later.
+  ON__UINT32 tcode = 0;
+  ON__INT64 length = 0;
+  *offset = file.CurrentPosition();
+  bool rc = file.BeginRead3dmBigChunk( &tcode, &length );
+  if ( rc )
+  {
+    if ( TCODE_OPENNURBS_CLASS != tcode )
+      rc = false;
+    if ( !file.EndRead3dmChunk() )
+      rc = false;
+  }
+  if ( !rc )
+    *offset = 0;
+  return rc;
+}
+
 static
 void ReadFillInMissingBoxes( ON_Brep& brep )
 {
@@ -762,6 +783,7 @@ void ReadFillInMissingBoxes( ON_Brep& brep )
 
 ON_BOOL32 ON_Brep::Read( ON_BinaryArchive& file )
 {
+  ON_MemorySubsystemScope ms(ON_MEMORY_SUBSYSTEM_BREP);
   int i;
   int C2_count = 0;
   int C3_count = 0;
@@ -888,6 +910,13 @@ ON_BOOL32 ON_Brep::Read( ON_BinaryArchive& file )
 
       const int face_count = m_F.Count();
 
+      // When the archive has a deferred reader, meshes are skipped
+      // and read the first time ON_BrepFace::Mesh() asks for them.
+      ON_3dmDeferredReader* deferred_reader = file.DeferredReader();
+      ON__UINT64 offset = 0;
+      if ( 0 != deferred_reader && !deferred_reader->m_bDeferMeshes )
+        deferred_reader = 0;
+
       // read render meshes
       tcode = 0;
       length_TCODE_ANONYMOUS_CHUNK = 0;
@@ -901,7 +930,12 @@ ON_BOOL32 ON_Brep::Read( ON_BinaryArchive& file )
           for ( fi = 0; rc && fi < face_count; fi++ ) 
           {
             rc = file.ReadChar(&b);
-            if (rc && b) 
+            if (rc && b && 0 != deferred_reader) 
+            {
+              rc = SkipDeferredMesh(file,&offset);
+              m_F[fi].SetDeferredMesh(ON::render_mesh,deferred_reader,offset);
+            }
+            else if (rc && b) 
             {
               obj = 0;
               rc = file.ReadObject(&obj);
@@ -933,7 +967,12 @@ ON_BOOL32 ON_Brep::Read( ON_BinaryArchive& file )
             for ( fi = 0; rc && fi < face_count; fi++ ) 
             {
               rc = file.ReadChar(&b);
-              if (rc && b) 
+              if (rc && b && 0 != deferred_reader) 
+              {
+                rc = SkipDeferredMesh(file,&offset);
+                m_F[fi].SetDeferredMesh(ON::analysis_mesh,deferred_reader,offset);
+              }
+              else if (rc && b) 
               {
                 rc = file.ReadObject(&obj);
                 m_F[fi].m_analysis_mesh = ON_Mesh::Cast(obj);
@@ -275,6 +275,7 @@ int ON_Brep::SplitEdgeAtParameters(
   const double* edge_t
   )
 {
+  UnshareGeometry();
   // Default kink_tol_radians MUST BE ON_PI/180.0.
   //
   // The default kink tol must be kept in sync with the default for 
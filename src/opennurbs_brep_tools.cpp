@@ -252,12 +252,14 @@ bool ON_BrepFace::SetMesh( ON::mesh_type mt, ON_Mesh* mesh )
     if ( m_render_mesh )
       delete m_render_mesh;
     m_render_mesh = mesh;
+    SetDeferredMesh(mt,0,0);
     break;
 
   case ON::analysis_mesh:
     if ( m_analysis_mesh )
       delete m_analysis_mesh;
     m_analysis_mesh = mesh;
+    SetDeferredMesh(mt,0,0);
     break;
 
   case ON::preview_mesh:
@@ -2066,6 +2068,7 @@ ON_BOOL32 ON_BrepTrim::SetEndPoint(ON_3dPoint end_point)
 
 bool ON_Brep::CloseTrimGap( ON_BrepTrim& trim0, ON_BrepTrim& trim1 )
 {
+  UnshareGeometry();
   // carefully close gap between end of prev_trim and start of next_trim
 
   // make sure trim0 and trim1 are adjacent trims in a trimming loop
@@ -2219,6 +2222,7 @@ bool ON_Brep::CloseTrimGap( ON_BrepTrim& trim0, ON_BrepTrim& trim1 )
 
 bool ON_Brep::CollapseEdge( int edge_index, bool bCloseTrimGap, int vertex_index  )
 {
+  UnshareGeometry();
   ON_BrepEdge* edge = Edge(edge_index);
   if ( 0 == edge )
     return false;
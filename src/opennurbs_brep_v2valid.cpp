@@ -231,6 +231,7 @@ bool ON_Brep::IsDeformable() const
 
 bool ON_Brep::MakeDeformable()
 {
+  UnshareGeometry();
   bool rc = true;
 
   int ei, edge_count = m_E.Count();
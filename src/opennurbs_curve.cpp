@@ -17,10 +17,10 @@
 
 ON_VIRTUAL_OBJECT_IMPLEMENT(ON_Curve,ON_Geometry,"4ED7D4D7-E947-11d3-BFE5-0010830122F0");
 
-ON_Curve::ON_Curve() : m_ctree(0)
+ON_Curve::ON_Curve() : m_ctree(0), m_arclength_table(0), m_arclength_lock(0)
 {}
 
-ON_Curve::ON_Curve(const ON_Curve& src) : ON_Geometry(src), m_ctree(0)
+ON_Curve::ON_Curve(const ON_Curve& src) : ON_Geometry(src), m_ctree(0), m_arclength_table(0), m_arclength_lock(0)
 {}
 
 ON_Curve& ON_Curve::operator=(const ON_Curve& src)
@@ -47,6 +47,11 @@ ON_Curve::~ON_Curve()
 #endif
     m_ctree = 0;
   }
+  if ( m_arclength_table )
+  {
+    delete m_arclength_table;
+    m_arclength_table = 0;
+  }
 }
 
 unsigned int ON_Curve::SizeOf() const
@@ -1312,6 +1317,12 @@ ON_BOOL32 ON_Curve::GetLocalClosestPoint( const ON_3dPoint& test_point,
   return false;
 }
 
+static const ON_CurveArcLengthTable* ON_GetArcLengthTable( 
+  const ON_Curve& curve, 
+  double fractional_tolerance,
+  ON_CurveArcLengthTable& temp 
+  );
+
 ON_BOOL32 ON_Curve::GetLength(
         double* length,               // length returned here
         double fractional_tolerance,  // default = 1.0e-8
@@ -1321,16 +1332,17 @@ ON_BOOL32 ON_Curve::GetLength(
   ON_BOOL32 rc = false;
   if ( length )
     *length = 0.0;
-  if ( !ON_NurbsCurve::Cast(this) )
+  ON_CurveArcLengthTable temp;
+  const ON_CurveArcLengthTable* table = ON_GetArcLengthTable(*this,fractional_tolerance,temp);
+  if ( table )
   {
-    // This works when openNURBS is used in Rhino
-    const ON_Curve* proxy = 0;
-    ON_NurbsCurve nc;
-    if ( GetNurbForm( nc, 0.0, sub_domain ) )
-      proxy = &nc;
-    // MUST call GetLength() via proxy pointer
-    if ( proxy )
-      rc = proxy->GetLength( length, fractional_tolerance, NULL );
+    if ( length )
+    {
+      *length = ( sub_domain )
+              ? fabs(table->LengthAt(sub_domain->Max()) - table->LengthAt(sub_domain->Min()))
+              : table->Length();
+    }
+    rc = true;
   }
   return rc;
 }
@@ -2741,8 +2753,7 @@ ON_BOOL32 ON_Curve::GetNormalizedArcLengthPoint(
         const ON_Interval* sub_domain
         ) const
 {
-  // override when possible
-  return false;
+  return GetNormalizedArcLengthPoints(1,&s,t,0.0,fractional_tolerance,sub_domain);
 }
 
 ON_BOOL32 ON_Curve::GetNormalizedArcLengthPoints(
@@ -2754,8 +2765,27 @@ ON_BOOL32 ON_Curve::GetNormalizedArcLengthPoints(
         const ON_Interval* sub_domain
         ) const
 {
-  // override when possible
-  return false;
+  // Derived classes with exact methods override this function.
+  if ( count < 1 || 0 == s || 0 == t )
+    return false;
+  ON_CurveArcLengthTable temp;
+  const ON_CurveArcLengthTable* table = ON_GetArcLengthTable(*this,fractional_tolerance,temp);
+  if ( 0 == table )
+    return false;
+
+  double s0 = 0.0;
+  double s1 = table->Length();
+  if ( sub_domain )
+  {
+    s0 = table->LengthAt(sub_domain->Min());
+    s1 = table->LengthAt(sub_domain->Max());
+  }
+
+  // s and t may be the same array
+  int i;
+  for ( i = 0; i < count; i++ )
+    t[i] = s0 + s[i]*(s1-s0);
+  return table->ParametersAt(count,t,t);
 }
 
 
@@ -3740,3 +3770,383 @@ bool ON_SortCurves( const ON_SimpleArray<ON_Curve*>& curves, ON_SimpleArray<int>
   return ON_SortCurves( curve_count,curves.Array(),index.Array(),bReverse.Array());
 }
 
+
+ON_CurveArcLengthTable::ON_CurveArcLengthTable()
+: m_fractional_tolerance(0.0)
+{}
+
+ON_CurveArcLengthTable::~ON_CurveArcLengthTable()
+{}
+
+void ON_CurveArcLengthTable::Destroy()
+{
+  m_t.Destroy();
+  m_s.Destroy();
+  m_v.Destroy();
+  m_fractional_tolerance = 0.0;
+}
+
+int ON_CurveArcLengthTable::PieceCount() const
+{
+  return (m_t.Count() > 1) ? (m_t.Count()-1) : 0;
+}
+
+ON_Interval ON_CurveArcLengthTable::Domain() const
+{
+  return (m_t.Count() > 1) 
+         ? ON_Interval(m_t[0],*m_t.Last()) 
+         : ON_Interval(ON_UNSET_VALUE,ON_UNSET_VALUE);
+}
+
+double ON_CurveArcLengthTable::Length() const
+{
+  return (m_s.Count() > 1) ? *m_s.Last() : 0.0;
+}
+
+double ON_CurveArcLengthTable::FractionalTolerance() const
+{
+  return m_fractional_tolerance;
+}
+
+// 8 point Gauss-Legendre abscissae on [-1,1] and weights
+static const double ON_ArcLengthGaussX[4] = 
+{
+  0.18343464249564980494, 0.52553240991632898582,
+  0.79666647741362673959, 0.96028985649753623168
+};
+static const double ON_ArcLengthGaussW[4] = 
+{
+  0.36268378337836198297, 0.31370664587788728734,
+  0.22238103445337447054, 0.10122853629037625915
+};
+
+static bool ON_ArcLengthSpeed( const ON_Curve& curve, double t, int side, int* hint, double* v )
+{
+  ON_3dPoint P;
+  ON_3dVector D;
+  if ( !curve.Ev1Der(t,P,D,side,hint) )
+    return false;
+  *v = D.Length();
+  return true;
+}
+
+static bool ON_ArcLengthGauss( const ON_Curve& curve, double t0, double t1, int* hint, double* length )
+{
+  const double m = 0.5*(t0+t1);
+  const double r = 0.5*(t1-t0);
+  double s = 0.0, v0, v1;
+  int i;
+  for ( i = 0; i < 4; i++ )
+  {
+    if (    !ON_ArcLengthSpeed(curve,m - r*ON_ArcLengthGaussX[i],0,hint,&v0)
+         || !ON_ArcLengthSpeed(curve,m + r*ON_ArcLengthGaussX[i],0,hint,&v1) )
+      return false;
+    s += ON_ArcLengthGaussW[i]*(v0+v1);
+  }
+  *length = r*s;
+  return true;
+}
+
+// Monotone (Fritsch-Carlson) slope of a cubic Hermite piece 
+// that is normalized to go from (0,0) to (1,1).
+static double ON_ArcLengthSlope( double numerator, double denominator )
+{
+  return ( denominator > 0.0 && numerator < 3.0*denominator ) ? (numerator/denominator) : 3.0;
+}
+
+static double ON_ArcLengthHermite( double u, double m0, double m1 )
+{
+  const double u2 = u*u;
+  const double u3 = u2*u;
+  return (3.0*u2 - 2.0*u3) + (u3 - 2.0*u2 + u)*m0 + (u3 - u2)*m1;
+}
+
+bool ON_CurveArcLengthTable::AddPiece( 
+  const ON_Curve& curve, 
+  double t0, double v0, double t1, double v1,
+  double length, 
+  double curve_length,
+  int depth, int* hint 
+  )
+{
+  const double tm = 0.5*(t0+t1);
+  double vm, left, right;
+  if (    !ON_ArcLengthSpeed(curve,tm,0,hint,&vm)
+       || !ON_ArcLengthGauss(curve,t0,tm,hint,&left)
+       || !ON_ArcLengthGauss(curve,tm,t1,hint,&right) )
+    return false;
+
+  const double h = t1-t0;
+  const double s = left+right;
+  // The quadrature errors of the pieces add up, so each piece
+  // gets its share of the tolerance.  The interpolants of s(t)
+  // and t(s) used by LengthAt() and ParameterAt() only have to
+  // be good to the tolerance times the length of the curve.
+  const double etol = m_fractional_tolerance*curve_length;
+  bool bSplit = ( fabs(s - length) > m_fractional_tolerance*s + ON_EPSILON*curve_length );
+  if ( !bSplit && s > 0.0 )
+  {
+    // The interpolants are compared with the curve at the quarter
+    // points as well as the midpoint.  On a piece that is symmetric
+    // about its midpoint, like a span of a circle, the midpoint
+    // values are exact whatever the error elsewhere.
+    const double fm0 = ON_ArcLengthSlope(h*v0,s), fm1 = ON_ArcLengthSlope(h*v1,s);
+    const double im0 = ON_ArcLengthSlope(s,h*v0), im1 = ON_ArcLengthSlope(s,h*v1);
+    double tk, vk, sk, q;
+    int k;
+    for ( k = 1; k <= 3 && !bSplit; k++ )
+    {
+      if ( 2 == k )
+      {
+        tk = tm;
+        vk = vm;
+        sk = left;
+      }
+      else
+      {
+        tk = t0 + 0.25*k*h;
+        if (    !ON_ArcLengthSpeed(curve,tk,0,hint,&vk)
+             || !ON_ArcLengthGauss(curve,(1==k)?t0:tm,tk,hint,&q) )
+          return false;
+        sk = (1==k) ? q : left+q;
+      }
+      const double dt = h*ON_ArcLengthHermite(sk/s,im0,im1) - (tk-t0);
+      bSplit = (    fabs(s*ON_ArcLengthHermite(0.25*k,fm0,fm1) - sk) > etol 
+                 || fabs(vk*dt) > etol );
+    }
+  }
+
+  if ( bSplit && depth < 20 && t0 < tm && tm < t1 )
+  {
+    return    AddPiece(curve,t0,v0,tm,vm,left,curve_length,depth+1,hint)
+           && AddPiece(curve,tm,vm,t1,v1,right,curve_length,depth+1,hint);
+  }
+
+  m_t.Append(t1);
+  m_s.Append(*m_s.Last() + s);
+  m_v.Append(v0);
+  m_v.Append(v1);
+  return true;
+}
+
+bool ON_CurveArcLengthTable::Create( 
+  const ON_Curve& curve, 
+  double fractional_tolerance 
+  )
+{
+  Destroy();
+
+  const ON_Interval domain = curve.Domain();
+  if ( !domain.IsIncreasing() )
+    return false;
+
+  ON_SimpleArray<double> span;
+  const int span_count = curve.SpanCount();
+  if ( span_count > 0 )
+  {
+    span.Reserve(span_count+1);
+    span.SetCount(span_count+1);
+    if ( !curve.GetSpanVector(span.Array()) )
+      span.SetCount(0);
+  }
+  if ( span.Count() < 2 )
+  {
+    span.SetCount(0);
+    span.Append(domain[0]);
+    span.Append(domain[1]);
+  }
+
+  if ( !(fractional_tolerance > 0.0) )
+    fractional_tolerance = 1.0e-8;
+  else if ( fractional_tolerance < 1.0e-14 )
+    fractional_tolerance = 1.0e-14;
+  m_fractional_tolerance = fractional_tolerance;
+
+  // The Gauss-Legendre lengths of the spans estimate the length
+  // of the curve that the tolerances are relative to.
+  int i, hint = 0;
+  ON_SimpleArray<double> span_length(span.Count());
+  double length = 0.0;
+  for ( i = 1; i < span.Count(); i++ )
+  {
+    double s = 0.0;
+    if ( span[i-1] < span[i] && !ON_ArcLengthGauss(curve,span[i-1],span[i],&hint,&s) )
+    {
+      Destroy();
+      return false;
+    }
+    span_length.Append(s);
+    length += s;
+  }
+
+  m_t.Reserve(4*span.Count());
+  m_s.Reserve(4*span.Count());
+  m_v.Reserve(8*span.Count());
+  m_t.Append(span[0]);
+  m_s.Append(0.0);
+  for ( i = 1; i < span.Count(); i++ )
+  {
+    if ( !(span[i-1] < span[i]) )
+      continue;
+    double v0, v1;
+    if (    !ON_ArcLengthSpeed(curve,span[i-1],1,&hint,&v0)
+         || !ON_ArcLengthSpeed(curve,span[i],-1,&hint,&v1)
+         || !AddPiece(curve,span[i-1],v0,span[i],v1,span_length[i-1],length,0,&hint) )
+    {
+      Destroy();
+      return false;
+    }
+  }
+
+  if ( m_t.Count() < 2 )
+  {
+    Destroy();
+    return false;
+  }
+
+  m_fractional_tolerance = fractional_tolerance;
+  return true;
+}
+
+int ON_CurveArcLengthTable::PieceIndex( const ON_SimpleArray<double>& a, double x, int hint ) const
+{
+  // returns i with a[i] <= x <= a[i+1]
+  const int n = a.Count()-1;
+  const double* p = a.Array();
+  if ( hint >= 0 && hint < n && p[hint] <= x )
+  {
+    if ( x <= p[hint+1] )
+      return hint;
+    if ( hint+1 < n && x <= p[hint+2] )
+      return hint+1;
+  }
+  int i0 = 0, i1 = n;
+  while ( i1 - i0 > 1 )
+  {
+    const int i = (i0+i1)/2;
+    if ( x < p[i] )
+      i1 = i;
+    else
+      i0 = i;
+  }
+  return i0;
+}
+
+double ON_CurveArcLengthTable::LengthAt( double t ) const
+{
+  const int n = PieceCount();
+  if ( n <= 0 )
+    return 0.0;
+  if ( !(t > m_t[0]) )
+    return 0.0;
+  if ( !(t < m_t[n]) )
+    return m_s[n];
+  const int i = PieceIndex(m_t,t,-1);
+  const double h = m_t[i+1] - m_t[i];
+  const double s = m_s[i+1] - m_s[i];
+  if ( !(h > 0.0) || !(s > 0.0) )
+    return m_s[i];
+  const double u = ON_ArcLengthHermite( (t - m_t[i])/h,
+                                        ON_ArcLengthSlope(h*m_v[2*i],s), 
+                                        ON_ArcLengthSlope(h*m_v[2*i+1],s) );
+  return m_s[i] + s*u;
+}
+
+static double ON_ArcLengthParameter( const double* t, const double* s, const double* v, int i, double x )
+{
+  const double h = t[i+1] - t[i];
+  const double d = s[i+1] - s[i];
+  if ( !(d > 0.0) )
+    return t[i];
+  const double u = ON_ArcLengthHermite( (x - s[i])/d,
+                                        ON_ArcLengthSlope(d,h*v[2*i]), 
+                                        ON_ArcLengthSlope(d,h*v[2*i+1]) );
+  return t[i] + h*u;
+}
+
+double ON_CurveArcLengthTable::ParameterAt( double s ) const
+{
+  const int n = PieceCount();
+  if ( n <= 0 )
+    return ON_UNSET_VALUE;
+  if ( !(s > 0.0) )
+    return m_t[0];
+  if ( !(s < m_s[n]) )
+    return m_t[n];
+  return ON_ArcLengthParameter( m_t.Array(), m_s.Array(), m_v.Array(), PieceIndex(m_s,s,-1), s );
+}
+
+bool ON_CurveArcLengthTable::ParametersAt( 
+  int count, 
+  const double* s, 
+  double* t 
+  ) const
+{
+  const int n = PieceCount();
+  if ( n <= 0 || count < 0 || (count > 0 && (0 == s || 0 == t)) )
+    return false;
+  const double length = m_s[n];
+  int i, hint = 0;
+  for ( i = 0; i < count; i++ )
+  {
+    const double x = s[i];
+    if ( !(x > 0.0) )
+      t[i] = m_t[0];
+    else if ( !(x < length) )
+      t[i] = m_t[n];
+    else
+    {
+      hint = PieceIndex(m_s,x,hint);
+      t[i] = ON_ArcLengthParameter( m_t.Array(), m_s.Array(), m_v.Array(), hint, x );
+    }
+  }
+  return true;
+}
+
+const ON_CurveArcLengthTable* ON_Curve::ArcLengthTable() const
+{
+  // m_arclength_lock is 0 when there is no table, 1 while a
+  // thread is making the table and 2 after the table is made
+  // (m_arclength_table is null if the curve cannot be evaluated).
+  ON_Curve* curve = const_cast<ON_Curve*>(this);
+  for(;;)
+  {
+    const int lock = ON_ATOMIC_COMPARE_AND_SWAP(&curve->m_arclength_lock,0,1);
+    if ( 2 == lock )
+      return m_arclength_table;
+    if ( 0 == lock )
+      break;
+    // Another thread is making the table.
+  }
+
+  ON_CurveArcLengthTable* table = new ON_CurveArcLengthTable();
+  if ( !table->Create(*this) )
+  {
+    delete table;
+    table = 0;
+  }
+  curve->m_arclength_table = table;
+  ON_ATOMIC_COMPARE_AND_SWAP(&curve->m_arclength_lock,1,2);
+  return table;
+}
+
+/*
+Description:
+  Get the cached arc length table of a curve, or make a 
+  temporary one when the cached table is not precise enough.
+*/
+static const ON_CurveArcLengthTable* ON_GetArcLengthTable( 
+  const ON_Curve& curve, 
+  double fractional_tolerance,
+  ON_CurveArcLengthTable& temp 
+  )
+{
+  const ON_CurveArcLengthTable* table = curve.ArcLengthTable();
+  if (    0 != table 
+       && fractional_tolerance > 0.0 
+       && fractional_tolerance < table->FractionalTolerance() )
+  {
+    table = temp.Create(curve,fractional_tolerance) ? &temp : 0;
+  }
+  return table;
+}
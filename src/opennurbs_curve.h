@@ -27,6 +27,7 @@ class ON_Plane;
 class ON_Arc;
 class ON_NurbsCurve;
 class ON_CurveTree;
+class ON_CurveArcLengthTable;
 
 
 ////////////////////////////////////////////////////////////////
@@ -84,6 +85,130 @@ public:
   double m_reserved4;
 };
 
+/*
+Description:
+  A monotone table of curve parameters and arc lengths that
+  answers length from parameter and parameter from length 
+  queries with a binary search.
+Remarks:
+  The curve domain is divided into pieces that never cross a
+  span boundary.  The length of each piece is computed with 
+  8 point Gauss-Legendre quadrature of the curve's speed and
+  pieces are bisected until the quadrature and a cubic Hermite
+  interpolant of the length through the piece's end points
+  agree with the length of its halves.  The same end point 
+  lengths and speeds give the Hermite interpolant of the 
+  inverse, parameter as a function of length.
+  Use ON_Curve::ArcLengthTable() to get a table that is cached
+  on the curve.
+*/
+class ON_CLASS ON_CurveArcLengthTable
+{
+public:
+  ON_CurveArcLengthTable();
+  ~ON_CurveArcLengthTable();
+
+  /*
+  Description:
+    Create the table.
+  Parameters:
+    curve - [in]
+    fractional_tolerance - [in] desired fractional precision
+       of the lengths in the table.
+  Returns:
+    True if successful.
+  */
+  bool Create( 
+    const ON_Curve& curve, 
+    double fractional_tolerance = 1.0e-8 
+    );
+
+  void Destroy();
+
+  /*
+  Returns:
+    Number of pieces in the table. 0 if the table is empty.
+  */
+  int PieceCount() const;
+
+  /*
+  Returns:
+    Curve domain the table was created from.
+  */
+  ON_Interval Domain() const;
+
+  /*
+  Returns:
+    Length of the curve.
+  */
+  double Length() const;
+
+  /*
+  Returns:
+    The fractional tolerance passed to Create().
+  */
+  double FractionalTolerance() const;
+
+  /*
+  Description:
+    Get the length of the curve from the start of its domain
+    to a parameter.
+  Parameters:
+    t - [in] curve parameter.  Values outside the domain are
+       clamped to the domain.
+  Returns:
+    Arc length from the start of the curve to t.
+  */
+  double LengthAt( double t ) const;
+
+  /*
+  Description:
+    Get the parameter at a length from the start of the curve.
+  Parameters:
+    s - [in] arc length.  Values outside [0,Length()] are 
+       clamped.
+  Returns:
+    Curve parameter.
+  */
+  double ParameterAt( double s ) const;
+
+  /*
+  Description:
+    Get the parameters at a list of lengths from the start of
+    the curve.
+  Parameters:
+    count - [in] number of lengths
+    s - [in] arc lengths
+    t - [out] curve parameters
+  Returns:
+    True if successful.
+  Remarks:
+    Each lookup starts in the piece the previous one ended in,
+    so increasing lengths that are close together cost O(1) 
+    each.
+  */
+  bool ParametersAt( 
+    int count, 
+    const double* s, 
+    double* t 
+    ) const;
+
+private:
+  int PieceIndex( const ON_SimpleArray<double>& a, double x, int hint ) const;
+  bool AddPiece( 
+    const ON_Curve& curve, 
+    double t0, double v0, double t1, double v1, 
+    double length, 
+    double curve_length,
+    int depth, int* hint 
+    );
+
+  ON_SimpleArray<double> m_t;  // m_t[i] = parameter at the start of the i-th piece
+  ON_SimpleArray<double> m_s;  // m_s[i] = length from the start of the curve to m_t[i]
+  ON_SimpleArray<double> m_v;  // m_v[2*i], m_v[2*i+1] = speeds at the ends of the i-th piece
+  double m_fractional_tolerance;
+};
+
 class ON_CLASS ON_Curve : public ON_Geometry
 {
   // pure virtual class for curve objects
@@ -1049,6 +1174,7 @@ public:
     fractional_tolerance to 1.0e-N.  For "nice" curves, 1.0e-8 works
     fine.  For very high degree NURBS and NURBS with bad parameterizations,
     use larger values of fractional_tolerance.
+    Curves without an exact method use ArcLengthTable().
   */
   virtual
   ON_BOOL32 GetLength(
@@ -1165,6 +1291,9 @@ public:
         sub_domain->Min() and a 1.0 s value corresponds to sub_domain->Max().
   Returns:
     true if successful
+  Remarks:
+    Curves without an exact method use ArcLengthTable() and
+    look up all the parameters with one pass through the table.
   */
   virtual
   ON_BOOL32 GetNormalizedArcLengthPoints(
@@ -1384,6 +1513,27 @@ public:
   virtual
   ON_CurveTree* CreateCurveTree() const;
 
+  /*
+  Description:
+    Get the runtime arc length table used by GetLength() and
+    GetNormalizedArcLengthPoint(s)() when the curve type does not
+    have an exact method.
+  Returns:
+    Pointer to the table or NULL if the table cannot be made.
+  Remarks:
+    The table is created the first time it is needed with a 
+    fractional tolerance of 1.0e-8.  It is deleted by 
+    DestroyRuntimeCache(), which DestroyCurveTree() calls when
+    the curve is modified.  If you change a curve's fields
+    directly, call DestroyRuntimeCache().
+    Several threads may call ArcLengthTable(), GetLength() and
+    GetNormalizedArcLengthPoint(s)() on the same curve at once.
+    The first thread makes the table, the others wait for it, 
+    and the finished table is never changed until 
+    DestroyRuntimeCache() is called.
+  */
+  const ON_CurveArcLengthTable* ArcLengthTable() const;
+
   /*
 	Description:
 		Lookup a parameter in the m_t array, optionally using a built in snap tolerance to 
@@ -1418,6 +1568,8 @@ protected:
 private:
   // Runtime only - ignored by Read()/Write()
   volatile ON_CurveTree* m_ctree;
+  ON_CurveArcLengthTable* volatile m_arclength_table;
+  volatile int m_arclength_lock;
 };
 
 #if defined(ON_DLL_TEMPLATE)
@@ -230,6 +230,13 @@ public:
          ON_BOOL32 = false  // true means grow box
          ) const;
 
+  // virtual ON_Geometry::GetTightBoundingBox override
+	bool GetTightBoundingBox( 
+			ON_BoundingBox& tight_bbox, 
+      int bGrowBox = false,
+			const ON_Xform* xform = 0
+      ) const;
+
   ON_BOOL32 Transform( 
          const ON_Xform&
          );
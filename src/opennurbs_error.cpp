@@ -31,6 +31,9 @@ static void ON_DebuggerBreakpoint() {} // <- Good location for a debugger breakp
 //   ON_Error()
 //   ON_Warning()
 //
+//   The counters are incremented atomically and the message buffer
+//   is thread local so errors can be reported from several threads.
+//
 
 static int ON_ERROR_COUNT = 0;
 static int ON_WARNING_COUNT = 0;
@@ -108,7 +111,7 @@ void ON_EnableDebugErrorMessage( int bEnableDebugErrorMessage )
 // is used to do most of the actual formatting.  
 
 #define MAX_MSG_LENGTH 2048
-static char sMessage[MAX_MSG_LENGTH];
+static ON_THREAD_LOCAL char sMessage[MAX_MSG_LENGTH];
 static bool ON_FormatMessage(const char*, va_list );
 
 void ON_MathError( 
@@ -117,7 +120,7 @@ void ON_MathError(
         const char* sFunctionName
         )
 {
-  ON_MATH_ERROR_COUNT++; // <- Good location for a debugger breakpoint.
+  const int math_error_count = ON_ATOMIC_INCREMENT(&ON_MATH_ERROR_COUNT); // <- Good location for a debugger breakpoint.
 
   if ( !sModuleName)
     sModuleName = "";
@@ -128,7 +131,7 @@ void ON_MathError(
 
   ON_Error(__FILE__,__LINE__,
            "Math library or floating point ERROR # %d module=%s type=%s function=%s",
-           ON_MATH_ERROR_COUNT, 
+           math_error_count, 
            sModuleName, // rhino.exe, opennurbs.dll, etc.
            sErrorType,   
            sFunctionName 
@@ -138,13 +141,13 @@ void ON_MathError(
 static void ON_IncrementErrorCount()
 {
   ON_DebuggerBreakpoint();
-  ON_ERROR_COUNT++;
+  ON_ATOMIC_INCREMENT(&ON_ERROR_COUNT);
 }
 
 static void ON_IncrementWarningCount()
 {
   ON_DebuggerBreakpoint();
-  ON_WARNING_COUNT++;
+  ON_ATOMIC_INCREMENT(&ON_WARNING_COUNT);
 }
 
 bool ON_IsNotValid()
@@ -1082,6 +1082,83 @@ bool ON_EvaluateNurbsSpan(
 }
 
 
+bool ON_GetNurbsSpanTaylorCoefficients(
+        int cvdim,
+        int order,
+        const double* knot,
+        int cv_stride,
+        const double* cv,
+        double t0,
+        double* c
+        )
+{
+  int i, k;
+  double f;
+
+  if ( cvdim < 1 || order < 2 || cv_stride < cvdim || 0 == knot || 0 == cv || 0 == c )
+    return false;
+
+  // Homogeneous derivatives at t0; all derivatives above the degree are zero.
+  if ( !ON_EvaluateNurbsSpan( cvdim, false, order, knot, cv_stride, cv, order-1, t0, cvdim, c ) )
+    return false;
+
+  for ( i = 2, f = 1.0; i < order; i++ )
+  {
+    f *= i;
+    for ( k = 0; k < cvdim; k++ )
+      c[i*cvdim+k] /= f;
+  }
+
+  return true;
+}
+
+
+bool ON_EvaluateTaylorPolynomial(
+        int cvdim,
+        int order,
+        int c_stride,
+        const double* c,
+        int der_count,
+        double x,
+        int v_stride,
+        double* v
+        )
+{
+  const int degree = order-1;
+  const double* ci;
+  double f;
+  int d, i, k;
+
+  if ( cvdim < 1 || order < 1 || c_stride < cvdim || der_count < 0 || v_stride < cvdim || 0 == c || 0 == v )
+    return false;
+
+  for ( d = 0; d <= der_count; d++, v += v_stride )
+  {
+    if ( d > degree )
+    {
+      memset( v, 0, cvdim*sizeof(v[0]) );
+      continue;
+    }
+
+    // The d-th derivative of c[i]*x^i is f*c[i]*x^(i-d), f = i!/(i-d)!.
+    for ( f = 1.0, i = degree; i > degree-d; i-- )
+      f *= i;
+    ci = c + degree*c_stride;
+    for ( k = 0; k < cvdim; k++ )
+      v[k] = f*ci[k];
+    for ( i = degree-1; i >= d; i-- )
+    {
+      f = (f*(i+1-d))/(i+1);
+      ci -= c_stride;
+      for ( k = 0; k < cvdim; k++ )
+        v[k] = v[k]*x + f*ci[k];
+    }
+  }
+
+  return true;
+}
+
+
 bool ON_EvaluateNurbsSurfaceSpan(
         int dim,
         ON_BOOL32 is_rat,
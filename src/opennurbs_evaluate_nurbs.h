@@ -377,4 +377,80 @@ void ON_ConvertNurbSpanToBezier(
         double,        // t0, NURBS span parameter of start point
         double         // t1, NURBS span parameter of end point
         );
+/*
+Description:
+  Get the Taylor (power basis) coefficients of a NURBS span.
+Parameters:
+  cvdim - [in]
+    control vertex dimension (dim+1 for rational spans).
+  order - [in]
+    order=degree+1 (order>=2)
+  knot - [in]
+    NURBS knot vector with 2*(order-1) knots, knot[order-2] != knot[order-1]
+  cv_stride - [in]
+  cv - [in]
+    order control vertices.  Rational control vertices are
+    expanded in homogeneous form.
+  t0 - [in]
+    expansion parameter, usually the middle of the span.
+  c - [out]
+    An array of length order*cvdim.  The span is
+
+      c[0] + c[1]*(t-t0) + ... + c[order-1]*(t-t0)^(order-1),
+
+    where c[i] = c[i*cvdim],...,c[i*cvdim+cvdim-1] is the i-th
+    derivative at t0 divided by i!.
+Returns:
+  True if successful.
+See Also:
+  ON_EvaluateTaylorPolynomial
+*/
+ON_DECL
+bool ON_GetNurbsSpanTaylorCoefficients(
+        int cvdim,
+        int order,
+        const double* knot,
+        int cv_stride,
+        const double* cv,
+        double t0,
+        double* c
+        );
+
+/*
+Description:
+  Use Horner's rule to evaluate a polynomial 
+  c[0] + c[1]*x + ... + c[order-1]*x^(order-1) and its derivatives.
+Parameters:
+  cvdim - [in]
+    dimension of the coefficients.
+  order - [in]
+    number of coefficients (order>=1)
+  c_stride - [in] (>=cvdim)
+  c - [in]
+    The i-th coefficient is c[i*c_stride],...,c[i*c_stride+cvdim-1].
+  der_count - [in]
+    number of derivatives to evaluate (>=0)
+  x - [in]
+    evaluation parameter
+  v_stride - [in] (>=cvdim)
+  v - [out]
+    An array of length v_stride*(der_count+1).  The i-th
+    derivative is returned in v[i*v_stride],...,v[i*v_stride+cvdim-1].
+Returns:
+  True if successful.
+See Also:
+  ON_GetNurbsSpanTaylorCoefficients
+*/
+ON_DECL
+bool ON_EvaluateTaylorPolynomial(
+        int cvdim,
+        int order,
+        int c_stride,
+        const double* c,
+        int der_count,
+        double x,
+        int v_stride,
+        double* v
+        );
+
 #endif
@@ -400,7 +400,13 @@ ONX_Model::ONX_Model()
           : m_3dm_file_version(0), 
             m_3dm_opennurbs_version(0),
             m_file_length(0),
-            m_crc_error_count(0)
+            m_crc_error_count(0),
+            m_bUseMemoryPool(false),
+            m_bDeferMeshes(false),
+            m_bDeferUserData(false),
+            m_read_thread_count(1),
+            m__memory_pool(0),
+            m__deferred_reader(0)
 {
   m_sStartSectionComments.Empty();
   m_properties.Default();
@@ -448,6 +454,20 @@ void ONX_Model::Destroy()
   m_crc_error_count = 0;
 
   DestroyCache();
+
+  if ( 0 != m__memory_pool )
+  {
+    // The objects that used the pool were deleted above.
+    ON_DestroyMemoryPool(m__memory_pool);
+    m__memory_pool = 0;
+  }
+
+  if ( 0 != m__deferred_reader )
+  {
+    // Objects copied from this model keep their own reference.
+    m__deferred_reader->Release();
+    m__deferred_reader = 0;
+  }
 }
 
 
@@ -2126,7 +2146,17 @@ bool ONX_Model::Read(
   if ( 0 != filename )
   {
     FILE* fp = ON::OpenFile(filename,"rb");
-    if ( 0 != fp )
+    if ( 0 != fp && (m_bDeferMeshes || m_bDeferUserData) )
+    {
+      // The deferred reader owns fp and closes it when 
+      // the last deferred item is read or destroyed.
+      ON_3dmDeferredReader* reader = new ON_3dmDeferredReader(fp);
+      reader->m_bDeferMeshes = m_bDeferMeshes;
+      reader->m_bDeferUserData = m_bDeferUserData;
+      rc = Read(reader->Archive(),error_log);
+      m__deferred_reader = reader;
+    }
+    else if ( 0 != fp )
     {
       ON_BinaryFile file(ON::read3dm,fp);
       rc = Read(file,error_log);
@@ -2146,7 +2176,17 @@ bool ONX_Model::Read(
   if ( 0 != filename )
   {
     FILE* fp = ON::OpenFile(filename,L"rb");
-    if ( 0 != fp )
+    if ( 0 != fp && (m_bDeferMeshes || m_bDeferUserData) )
+    {
+      // The deferred reader owns fp and closes it when 
+      // the last deferred item is read or destroyed.
+      ON_3dmDeferredReader* reader = new ON_3dmDeferredReader(fp);
+      reader->m_bDeferMeshes = m_bDeferMeshes;
+      reader->m_bDeferUserData = m_bDeferUserData;
+      rc = Read(reader->Archive(),error_log);
+      m__deferred_reader = reader;
+    }
+    else if ( 0 != fp )
     {
       ON_BinaryFile file(ON::read3dm,fp);
       rc = Read(file,error_log);
@@ -2156,6 +2196,130 @@ bool ONX_Model::Read(
   return rc;
 }
 
+/*
+ONX_Model::Read() decodes the object table on several threads by
+copying batches of whole TCODE_OBJECT_RECORD chunks to memory and
+reading each copy with its own ON_Read3dmBufferArchive.
+*/
+class ON__ObjectRecord
+{
+public:
+  ON__ObjectRecord();
+  ~ON__ObjectRecord();
+
+  size_t m_offset;     // offset of the record in the batch buffer
+  size_t m_size;       // size of the record including its chunk header
+  int m_rc;            // ON_BinaryArchive::Read3dmObject() return code
+  int m_bad_crc_count; // BadCRCCount() of the buffer archive
+  ON_Object* m_object;  // deleted unless ONX_Model::Read() takes it
+  ON_3dmObjectAttributes m_attributes;
+
+private:
+  ON__ObjectRecord( const ON__ObjectRecord& ); // no implementation
+  ON__ObjectRecord& operator=( const ON__ObjectRecord& ); // no implementation
+};
+
+ON__ObjectRecord::ON__ObjectRecord()
+                 : m_offset(0),
+                   m_size(0),
+                   m_rc(-1),
+                   m_bad_crc_count(0),
+                   m_object(0)
+{}
+
+ON__ObjectRecord::~ON__ObjectRecord()
+{
+  if ( 0 != m_object )
+    delete m_object;
+}
+
+class ON__ObjectRecordBatch
+{
+public:
+  int m_3dm_version;
+  int m_opennurbs_version;
+  unsigned int m_object_filter;
+  const unsigned char* m_buffer;
+  ON__ObjectRecord* m_record;
+};
+
+static void ON__ReadObjectRecord( void* context, int i )
+{
+  const ON__ObjectRecordBatch* batch = (const ON__ObjectRecordBatch*)context;
+  ON__ObjectRecord& r = batch->m_record[i];
+  ON_MemorySubsystemScope ms(ON_MEMORY_SUBSYSTEM_ARCHIVE);
+  ON_Read3dmBufferArchive record_archive( r.m_size, batch->m_buffer + r.m_offset, false,
+                                          batch->m_3dm_version, batch->m_opennurbs_version );
+  r.m_rc = record_archive.Read3dmObject( &r.m_object, &r.m_attributes, batch->m_object_filter );
+  r.m_bad_crc_count = record_archive.BadCRCCount();
+}
+
+static int ON__ReadObjectRecordBatch( 
+          ON_BinaryArchive& archive,
+          int thread_count,
+          unsigned int object_filter,
+          ON_SimpleArray<unsigned char>& buffer,
+          ON_ClassArray<ON__ObjectRecord>& records
+          )
+{
+  // Copies up to 64MB of object records to buffer and reads
+  // them on thread_count threads.  Returns the number of records.
+  // Anything that is not an object record is left for
+  // ON_BinaryArchive::Read3dmObject() to handle.
+  const size_t max_buffer_size = 64*1024*1024;
+  const int max_record_count = 64*thread_count;
+  const size_t sizeof_header = 4 + archive.SizeofChunkLength();
+  ON__UINT32 tcode;
+  ON__INT64 length;
+  size_t pos, size;
+
+  buffer.SetCount(0);
+  records.Empty();
+  records.Reserve(max_record_count);
+  while ( records.Count() < max_record_count && (size_t)buffer.Count() < max_buffer_size )
+  {
+    tcode = 0;
+    length = 0;
+    if ( !archive.PeekAt3dmBigChunkType(&tcode,&length) || TCODE_OBJECT_RECORD != tcode )
+      break;
+    if ( length <= 0 || (ON__UINT64)length > (ON__UINT64)(0x7FFFFFF0 - sizeof_header - buffer.Count()) )
+      break;
+    pos = archive.CurrentPosition();
+    size = sizeof_header + (size_t)length;
+    if ( (size_t)buffer.Capacity() < buffer.Count() + size )
+    {
+      if ( (size_t)buffer.Capacity() < buffer.Count() + size - buffer.Capacity() )
+        buffer.Reserve( (int)(buffer.Count() + size) );
+      else
+        buffer.Reserve( 2*buffer.Capacity() );
+    }
+    // The object table chunk does not have a CRC, so the record
+    // is copied as is and its CRC is checked when it is read.
+    if ( !archive.ReadByte( size, buffer.Array() + buffer.Count() ) )
+    {
+      archive.SeekFromStart( pos );
+      break;
+    }
+    ON__ObjectRecord& r = records.AppendNew();
+    r.m_offset = buffer.Count();
+    r.m_size = size;
+    buffer.SetCount( (int)(buffer.Count() + size) );
+  }
+
+  if ( records.Count() > 0 )
+  {
+    ON__ObjectRecordBatch batch;
+    batch.m_3dm_version = archive.Archive3dmVersion();
+    batch.m_opennurbs_version = archive.ArchiveOpenNURBSVersion();
+    batch.m_object_filter = object_filter;
+    batch.m_buffer = buffer.Array();
+    batch.m_record = records.Array();
+    ON_ParallelFor( thread_count, records.Count(), ON__ReadObjectRecord, &batch );
+  }
+
+  return records.Count();
+}
+
 bool ONX_Model::Read( 
        ON_BinaryArchive& archive,
        ON_TextLog* error_log
@@ -2168,6 +2332,8 @@ bool ONX_Model::Read(
 
   Destroy(); // get rid of any residual stuff
 
+  ON_MemorySubsystemScope ms(ON_MEMORY_SUBSYSTEM_ARCHIVE);
+
   // STEP 1: REQUIRED - Read start section
   if ( !archive.Read3dmStartSection( &m_3dm_file_version, m_sStartSectionComments ) )
   {
@@ -2760,11 +2926,50 @@ bool ONX_Model::Read(
     // object_filter = ON::point_object | ON::mesh_object;
     int object_filter = 0; 
 
+    if ( m_bUseMemoryPool && 0 == m__memory_pool )
+      m__memory_pool = ON_CreateMemoryPool(0);
+
+    // Object records are decoded on several threads in batches.
+    // record_index is the next record of the current batch.
+    const int thread_count = (m_read_thread_count > 0) ? m_read_thread_count : ON_ProcessorCount();
+    const bool bReadInParallel = thread_count > 1
+                              && archive.Archive3dmVersion() >= 2
+                              && 0 == archive.DeferredReader()
+                              && 0 == m__memory_pool;
+    ON_SimpleArray<unsigned char> record_buffer;
+    ON_ClassArray<ON__ObjectRecord> records;
+    int record_index = 0;
+
     for( count = 0; true; count++ ) 
     {
       ON_Object* pObject = NULL;
       ON_3dmObjectAttributes attributes;
-      rc = archive.Read3dmObject(&pObject,&attributes,object_filter);
+      if ( bReadInParallel && record_index >= records.Count() )
+      {
+        record_index = 0;
+        if ( ON__ReadObjectRecordBatch(archive,thread_count,object_filter,record_buffer,records) > 0 )
+          m_object_table.Reserve( m_object_table.Count() + records.Count() );
+      }
+      if ( record_index < records.Count() )
+      {
+        ON__ObjectRecord& r = records[record_index++];
+        rc = r.m_rc;
+        pObject = r.m_object;
+        r.m_object = 0;
+        attributes = r.m_attributes;
+        archive.AddBadCRCCount(r.m_bad_crc_count);
+      }
+      else if ( 0 != m__memory_pool )
+      {
+        // The object's arrays and strings come from the pool.
+        ON_MEMORY_POOL* pool0 = ON_SetCurrentMemoryPool(m__memory_pool);
+        rc = archive.Read3dmObject(&pObject,&attributes,object_filter);
+        ON_SetCurrentMemoryPool(pool0);
+      }
+      else
+      {
+        rc = archive.Read3dmObject(&pObject,&attributes,object_filter);
+      }
       if ( rc == 0 )
         break; // end of object table
       if ( rc < 0 ) 
@@ -3031,6 +3236,7 @@ bool ONX_Model::Write(
        ON_TextLog* error_log
        )
 {
+  ON_MemorySubsystemScope ms(ON_MEMORY_SUBSYSTEM_ARCHIVE);
   int i;
 
   if ( !IsValid(error_log) )
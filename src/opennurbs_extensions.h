@@ -459,6 +459,40 @@ public:
   // If > 0, then the archive is corrupt.
   int m_crc_error_count;
 
+  // If m_bUseMemoryPool is true, ONX_Model::Read() allocates the
+  // arrays used by the objects and attributes in m_object_table[]
+  // from a memory pool that ONX_Model::Destroy() destroys.  
+  // This makes reading large models faster.  The default is false.
+  // It has no effect unless ON_EnableMemoryPools() was called at
+  // startup.  Objects, attributes and strings that are kept after
+  // the model is destroyed remain valid; their pool memory is 
+  // returned to the heap when they are freed.
+  // See ON_CreateMemoryPool() for details.
+  bool m_bUseMemoryPool;
+
+  // If m_bDeferMeshes is true, ONX_Model::Read(filename) leaves
+  // brep render and analysis meshes in the file and
+  // ON_BrepFace::Mesh() reads them the first time they are asked for.
+  // If m_bDeferUserData is true, object user data is left in the
+  // file and read the first time ON_Object::GetUserData() or
+  // ON_Object::FirstUserData() asks for it.  In both cases the file
+  // stays open until the model and every object that was copied
+  // from it have been destroyed.  The defaults are false.
+  // These settings are ignored by ONX_Model::Read(archive).
+  // See ON_3dmDeferredReader for details.
+  bool m_bDeferMeshes;
+  bool m_bDeferUserData;
+
+  // Number of threads ONX_Model::Read() uses to decode the object
+  // table.  The object records are read from the file on the 
+  // calling thread and decoded on up to m_read_thread_count 
+  // threads.  Objects are added to m_object_table[] in file order.
+  // If m_read_thread_count <= 0, ON_ProcessorCount() threads are 
+  // used.  The default is 1.  Version 1 files, m_bUseMemoryPool, 
+  // m_bDeferMeshes and m_bDeferUserData use one thread.  User data
+  // classes must be safe to read on several threads at once.
+  int m_read_thread_count;
+
   //
   // END model definitions
   //
@@ -776,6 +810,12 @@ private:
 
   // This bounding box contains all objects in the object table.
   ON_BoundingBox m__object_table_bbox;
+
+  // Memory pool used when m_bUseMemoryPool is true.
+  ON_MEMORY_POOL* m__memory_pool;
+
+  // File reader used when m_bDeferMeshes or m_bDeferUserData is true.
+  ON_3dmDeferredReader* m__deferred_reader;
 };
 
 /*
@@ -1358,3 +1358,603 @@ class ON_HatchExtra* ON_Hatch::HatchExtension()
   ON_HatchExtra* pExtra = ON_HatchExtra::Cast( GetUserData( ON_HatchExtra::m_ON_HatchExtra_class_id.Uuid()));
   return pExtra;
 }
+
+/////////////////////////////////////////////////////////////////
+//  Hatch fills
+
+static double ON_HatchChordDistance( const ON_3dPoint& P0, const ON_3dVector& D, double len, const ON_3dPoint& Q )
+{
+  return ( len > 0.0 )
+    ? fabs(D.x*(Q.y-P0.y) - D.y*(Q.x-P0.x))/len
+    : Q.DistanceTo(P0);
+}
+
+// Appends points after P0 up to and including P1.
+static void ON_HatchFlattenSpan( 
+        const ON_Curve* curve, 
+        double t0, const ON_3dPoint& P0, 
+        double t1, const ON_3dPoint& P1,
+        double tolerance,
+        int depth,
+        ON_SimpleArray<ON_2dPoint>& points
+        )
+{
+  const double t = 0.5*(t0+t1);
+  ON_3dPoint M;
+  bool bSplit = false;
+  if ( depth < 16 && t0 < t && t < t1 )
+  {
+    const ON_3dVector D = P1 - P0;
+    const double len = D.Length();
+    M = curve->PointAt(t);
+    if ( 0.0 == len || ON_HatchChordDistance(P0,D,len,M) > tolerance )
+      bSplit = true;
+    else if ( ON_HatchChordDistance(P0,D,len,curve->PointAt(0.5*(t0+t))) > tolerance )
+      bSplit = true;
+    else if ( ON_HatchChordDistance(P0,D,len,curve->PointAt(0.5*(t+t1))) > tolerance )
+      bSplit = true;
+  }
+  if ( bSplit )
+  {
+    ON_HatchFlattenSpan( curve, t0, P0, t, M, tolerance, depth+1, points );
+    ON_HatchFlattenSpan( curve, t, M, t1, P1, tolerance, depth+1, points );
+  }
+  else
+    points.Append( ON_2dPoint(P1.x,P1.y) );
+}
+
+// Appends the points of a polyline approximation of the curve
+// after its start point.
+static bool ON_HatchFlattenCurve( 
+        const ON_Curve* curve, 
+        double tolerance, 
+        ON_SimpleArray<ON_2dPoint>& points 
+        )
+{
+  int i;
+  ON_SimpleArray<ON_3dPoint> pline_points;
+  if ( curve->IsPolyline(&pline_points) >= 2 )
+  {
+    points.Reserve( points.Count() + pline_points.Count() - 1 );
+    for ( i = 1; i < pline_points.Count(); i++ )
+      points.Append( ON_2dPoint(pline_points[i].x,pline_points[i].y) );
+    return true;
+  }
+
+  const ON_ArcCurve* arccurve = ON_ArcCurve::Cast(curve);
+  if ( arccurve && arccurve->m_arc.Radius() > tolerance )
+  {
+    // equal angle segments whose sagitta is at most tolerance
+    const ON_Arc& arc = arccurve->m_arc;
+    const double a = 2.0*acos(1.0 - tolerance/arc.Radius());
+    const double angle = arc.AngleRadians();
+    const int n = ( angle/a < 65536.0 ) ? ((int)ceil(angle/a)) : 65536;
+    const ON_Interval d = arc.DomainRadians();
+    points.Reserve( points.Count() + n );
+    for ( i = 1; i <= n; i++ )
+    {
+      const ON_3dPoint P = arc.PointAt( (i < n) ? d.ParameterAt( ((double)i)/n ) : d[1] );
+      points.Append( ON_2dPoint(P.x,P.y) );
+    }
+    return true;
+  }
+
+  const ON_PolyCurve* polycurve = ON_PolyCurve::Cast(curve);
+  if ( polycurve )
+  {
+    // flatten segments separately so line segments stay exact
+    for ( i = 0; i < polycurve->Count(); i++ )
+    {
+      const ON_Curve* segment = polycurve->SegmentCurve(i);
+      if ( 0 == segment || !ON_HatchFlattenCurve( segment, tolerance, points ) )
+        return false;
+    }
+    return true;
+  }
+
+  const int span_count = curve->SpanCount();
+  if ( span_count < 1 )
+    return false;
+  ON_SimpleArray<double> s(span_count+1);
+  s.SetCount(span_count+1);
+  if ( !curve->GetSpanVector(s.Array()) )
+    return false;
+
+  // Each span is divided into quarters before the adaptive 
+  // subdivision so closed and S shaped spans are not missed.
+  ON_3dPoint P0 = curve->PointAt(s[0]), P1;
+  for ( i = 0; i < span_count; i++ )
+  {
+    if ( !(s[i] < s[i+1]) )
+      continue;
+    for ( int j = 1; j <= 4; j++ )
+    {
+      const double t0 = s[i] + 0.25*(j-1)*(s[i+1]-s[i]);
+      const double t1 = (j < 4) ? (s[i] + 0.25*j*(s[i+1]-s[i])) : s[i+1];
+      P1 = curve->PointAt(t1);
+      ON_HatchFlattenSpan( curve, t0, P0, t1, P1, tolerance, 0, points );
+      P0 = P1;
+    }
+  }
+  return true;
+}
+
+static int ON_HatchGetLoopPolylines( 
+        const ON_Hatch& hatch,
+        double tolerance,
+        ON_SimpleArray<ON_2dPoint>& points,
+        ON_SimpleArray<int>& loop_point_count,
+        ON_SimpleArray<int>* loop_index
+        )
+{
+  int li;
+  const int loop_count = hatch.LoopCount();
+  if ( !(tolerance > 0.0) )
+  {
+    ON_BoundingBox bbox;
+    for ( li = 0; li < loop_count; li++ )
+    {
+      const ON_HatchLoop* loop = hatch.Loop(li);
+      if ( loop && loop->Curve() )
+        loop->Curve()->GetBoundingBox(bbox,true);
+    }
+    if ( !bbox.IsValid() )
+      return 0;
+    tolerance = 0.001*bbox.Diagonal().Length();
+    if ( !(tolerance > 0.0) )
+      return 0;
+  }
+
+  int rc = 0;
+  for ( li = 0; li < loop_count; li++ )
+  {
+    const ON_HatchLoop* loop = hatch.Loop(li);
+    const ON_Curve* curve = loop ? loop->Curve() : 0;
+    if ( 0 == curve )
+      continue;
+    const int point_count0 = points.Count();
+    const ON_3dPoint P = curve->PointAtStart();
+    points.Append( ON_2dPoint(P.x,P.y) );
+    int point_count = 0;
+    if ( ON_HatchFlattenCurve( curve, tolerance, points ) )
+    {
+      point_count = points.Count() - point_count0;
+      if ( point_count > 1 && points[point_count0] == *points.Last() )
+        point_count--; // closing point
+    }
+    if ( point_count < 3 )
+    {
+      points.SetCount(point_count0);
+      continue;
+    }
+    points.SetCount(point_count0 + point_count);
+    loop_point_count.Append(point_count);
+    if ( loop_index )
+      loop_index->Append(li);
+    rc++;
+  }
+  return rc;
+}
+
+int ON_Hatch::GetLoopPolylines( 
+        double tolerance,
+        ON_SimpleArray<ON_2dPoint>& points,
+        ON_SimpleArray<int>& loop_point_count
+        ) const
+{
+  return ON_HatchGetLoopPolylines( *this, tolerance, points, loop_point_count, 0 );
+}
+
+struct ON_HatchEdge
+{
+  double m_v0;   // v at the lower end
+  double m_v1;   // v at the upper end (m_v1 > m_v0)
+  double m_u0;   // u at the lower end
+  double m_dudv; // change in u per unit change in v
+};
+
+static int ON_HatchCompareEdge( const ON_HatchEdge* a, const ON_HatchEdge* b )
+{
+  if ( a->m_v0 < b->m_v0 )
+    return -1;
+  if ( a->m_v0 > b->m_v0 )
+    return 1;
+  return 0;
+}
+
+// Moves a v coordinate that is within round-off of the line
+// v = k*oy onto the line.
+static double ON_HatchSnapToLine( double v, double oy )
+{
+  const double k = floor(v/oy + 0.5);
+  return ( fabs(v - k*oy) <= 1.0e-10*(fabs(v) + oy) ) ? k*oy : v;
+}
+
+bool ON_Hatch::GetPatternLines( 
+        const ON_HatchPattern& pattern,
+        double tolerance,
+        ON_SimpleArray<ON_Line>& lines
+        ) const
+{
+  const int hatch_line_count = pattern.HatchLineCount();
+  if ( hatch_line_count < 1 )
+    return false;
+
+  ON_SimpleArray<ON_2dPoint> points;
+  ON_SimpleArray<int> loop_point_count;
+  if ( ON_HatchGetLoopPolylines( *this, tolerance, points, loop_point_count, 0 ) < 1 )
+    return true; // nothing to fill
+  if ( !(tolerance > 0.0) )
+  {
+    ON_BoundingBox bbox;
+    bbox.Set( 2, false, points.Count(), 2, &points[0].x, false );
+    tolerance = 0.001*bbox.Diagonal().Length();
+  }
+
+  const double scale = ( m_pattern_scale > 0.0 ) ? m_pattern_scale : 1.0;
+  const double cr = cos(m_pattern_rotation);
+  const double sr = sin(m_pattern_rotation);
+  const ON_2dPoint basepoint = BasePoint2d();
+
+  ON_SimpleArray<ON_HatchEdge> edges(points.Count());
+  ON_SimpleArray<int> active;
+  ON_SimpleArray<double> crossings;
+  ON_SimpleArray<double> dashes;
+  ON_SimpleArray<double> dash_start;
+  bool rc = true;
+  int i, j, k;
+
+  for ( int hli = 0; hli < hatch_line_count; hli++ )
+  {
+    const ON_HatchLine* hatch_line = pattern.HatchLine(hli);
+    if ( 0 == hatch_line )
+      continue;
+    double angle;
+    ON_2dPoint base;
+    ON_2dVector offset;
+    hatch_line->GetLineData( angle, base, offset, dashes );
+
+    // The lines are v = k*oy in a (u,v) frame whose origin is the 
+    // line base and whose u axis is the line direction.
+    angle += m_pattern_rotation;
+    const ON_2dVector d( cos(angle), sin(angle) );
+    const ON_2dVector n( -d.y, d.x );
+    const ON_2dPoint B( basepoint.x + scale*(cr*base.x - sr*base.y),
+                        basepoint.y + scale*(sr*base.x + cr*base.y) );
+    double ox = scale*offset.x;
+    double oy = scale*offset.y;
+    if ( oy < 0.0 )
+    {
+      ox = -ox;
+      oy = -oy;
+    }
+    if ( !(oy > ON_ZERO_TOLERANCE) )
+    {
+      rc = false;
+      continue;
+    }
+
+    // scaled dash pattern
+    const int dash_count = dashes.Count();
+    double pattern_length = 0.0;
+    dash_start.SetCount(0);
+    for ( i = 0; i < dash_count; i++ )
+    {
+      dashes[i] *= scale;
+      dash_start.Append(pattern_length);
+      pattern_length += fabs(dashes[i]);
+    }
+    const bool bDashed = ( dash_count > 0 && pattern_length > tolerance );
+
+    // edge table
+    double vmin = ON_DBL_MAX, vmax = -ON_DBL_MAX;
+    edges.SetCount(0);
+    int point_index = 0;
+    for ( i = 0; i < loop_point_count.Count(); i++ )
+    {
+      const int count = loop_point_count[i];
+      const ON_2dPoint* P = points.Array() + point_index;
+      point_index += count;
+      ON_2dVector V = P[count-1] - B;
+      double u0 = V*d, v0 = ON_HatchSnapToLine(V*n,oy);
+      for ( j = 0; j < count; j++ )
+      {
+        V = P[j] - B;
+        const double u1 = V*d, v1 = ON_HatchSnapToLine(V*n,oy);
+        if ( v1 < vmin )
+          vmin = v1;
+        if ( v1 > vmax )
+          vmax = v1;
+        if ( v0 != v1 )
+        {
+          ON_HatchEdge& e = edges.AppendNew();
+          if ( v0 < v1 )
+          {
+            e.m_v0 = v0; e.m_v1 = v1; e.m_u0 = u0;
+          }
+          else
+          {
+            e.m_v0 = v1; e.m_v1 = v0; e.m_u0 = u1;
+          }
+          e.m_dudv = (u1-u0)/(v1-v0);
+        }
+        u0 = u1;
+        v0 = v1;
+      }
+    }
+    if ( (vmax - vmin)/oy > 16777216.0 )
+    {
+      rc = false;
+      continue;
+    }
+    edges.QuickSort( ON_HatchCompareEdge );
+
+    const ON_3dPoint O = m_plane.PointAt(B.x,B.y);
+    const ON_3dVector D = d.x*m_plane.xaxis + d.y*m_plane.yaxis;
+    const ON_3dVector N = n.x*m_plane.xaxis + n.y*m_plane.yaxis;
+    const int k0 = (int)ceil(vmin/oy);
+    const int k1 = (int)floor(vmax/oy);
+    int next_edge = 0;
+    active.SetCount(0);
+    for ( k = k0; k <= k1; k++ )
+    {
+      // Update the active edges and intersect them with the line.
+      // An edge crosses lines with m_v0 <= v < m_v1.
+      const double v = k*oy;
+      while ( next_edge < edges.Count() && edges[next_edge].m_v0 <= v )
+        active.Append(next_edge++);
+      crossings.SetCount(0);
+      int active_count = 0;
+      for ( i = 0; i < active.Count(); i++ )
+      {
+        const ON_HatchEdge& e = edges[active[i]];
+        if ( e.m_v1 <= v )
+          continue;
+        active[active_count++] = active[i];
+        crossings.Append( e.m_u0 + (v - e.m_v0)*e.m_dudv );
+      }
+      active.SetCount(active_count);
+      if ( crossings.Count() < 2 )
+        continue;
+      ON_SortDoubleArray( ON::quick_sort, crossings.Array(), crossings.Count() );
+
+      const ON_3dPoint L = O + v*N;
+      const double u_origin = k*ox;
+      for ( i = 0; i+1 < crossings.Count(); i += 2 )
+      {
+        const double ua = crossings[i];
+        const double ub = crossings[i+1];
+        if ( !bDashed )
+        {
+          if ( ua < ub )
+            lines.Append( ON_Line( L + ua*D, L + ub*D ) );
+          continue;
+        }
+
+        // find the dash at ua
+        const double s = ua - u_origin;
+        const double phase = s - floor(s/pattern_length)*pattern_length;
+        for ( j = 0; j < dash_count-1 && dash_start[j+1] <= phase; j++ )
+        {
+          // empty body
+        }
+        double pos = ua - (phase - dash_start[j]);
+        while ( pos <= ub )
+        {
+          const double len = fabs(dashes[j]);
+          if ( dashes[j] >= 0.0 )
+          {
+            const double a = (pos > ua) ? pos : ua;
+            const double b = (pos+len < ub) ? (pos+len) : ub;
+            if ( (len > 0.0) ? (a < b) : (pos >= ua) )
+              lines.Append( ON_Line( L + a*D, L + b*D ) );
+          }
+          pos += len;
+          if ( ++j == dash_count )
+            j = 0;
+        }
+      }
+    }
+  }
+
+  return rc;
+}
+
+static double ON_HatchLoopArea( int count, const ON_2dPoint* P )
+{
+  double a = 0.0;
+  for ( int i = 0, j = count-1; i < count; j = i++ )
+    a += (P[j].x - P[i].x)*(P[j].y + P[i].y);
+  return 0.5*a;
+}
+
+static bool ON_HatchLoopContains( int count, const ON_2dPoint* P, const ON_2dPoint& Q )
+{
+  // even-odd crossing test
+  bool bInside = false;
+  for ( int i = 0, j = count-1; i < count; j = i++ )
+  {
+    if ( (P[i].y > Q.y) != (P[j].y > Q.y)
+         && Q.x < P[i].x + (Q.y - P[i].y)*(P[j].x - P[i].x)/(P[j].y - P[i].y) )
+      bInside = !bInside;
+  }
+  return bInside;
+}
+
+ON_Mesh* ON_Hatch::CreateFillMesh( double tolerance, ON_Mesh* mesh ) const
+{
+  ON_SimpleArray<ON_2dPoint> points;
+  ON_SimpleArray<int> loop_point_count;
+  ON_SimpleArray<int> loop_index;
+  const int loop_count = ON_HatchGetLoopPolylines( *this, tolerance, points, loop_point_count, &loop_index );
+  if ( loop_count < 1 )
+    return 0;
+
+  int i, j;
+  ON_SimpleArray<int> loop_start(loop_count);
+  ON_SimpleArray<double> loop_area(loop_count);
+  ON_SimpleArray<int> outer_loops;
+  ON_RTree outer_tree;
+  for ( i = 0, j = 0; i < loop_count; j += loop_point_count[i++] )
+  {
+    loop_start.Append(j);
+    loop_area.Append( fabs(ON_HatchLoopArea( loop_point_count[i], points.Array()+j )) );
+    if ( ON_HatchLoop::ltOuter == Loop(loop_index[i])->Type() )
+    {
+      ON_BoundingBox bbox;
+      bbox.Set( 2, false, loop_point_count[i], 2, &points[j].x, false );
+      outer_tree.Insert2d( &bbox.m_min.x, &bbox.m_max.x, outer_loops.Count() );
+      outer_loops.Append(i);
+    }
+  }
+  if ( outer_loops.Count() < 1 )
+    return 0;
+
+  // Put each inner loop in the smallest outer loop that contains it.
+  ON_SimpleArray<int> parent(loop_count);
+  ON_SimpleArray<int> candidates;
+  parent.SetCount(loop_count);
+  for ( i = 0; i < loop_count; i++ )
+  {
+    parent[i] = -1;
+    if ( ON_HatchLoop::ltOuter == Loop(loop_index[i])->Type() )
+      continue;
+    const ON_2dPoint& Q = points[loop_start[i]];
+    candidates.SetCount(0);
+    outer_tree.Search2d( &Q.x, &Q.x, candidates );
+    double area = ON_DBL_MAX;
+    for ( j = 0; j < candidates.Count(); j++ )
+    {
+      const int oi = outer_loops[candidates[j]];
+      if ( loop_area[oi] < area 
+           && ON_HatchLoopContains( loop_point_count[oi], points.Array()+loop_start[oi], Q ) )
+      {
+        parent[i] = oi;
+        area = loop_area[oi];
+      }
+    }
+  }
+
+  ON_Mesh* newmesh = mesh ? mesh : new ON_Mesh();
+  newmesh->m_V.Reserve( newmesh->m_V.Count() + points.Count() );
+  newmesh->m_N.Reserve( newmesh->m_N.Count() + points.Count() );
+  const ON_3fVector normal( m_plane.zaxis );
+  ON_SimpleArray<ON_2dPoint> region_points;
+  ON_SimpleArray<int> region_loop_point_count;
+  ON_SimpleArray<ON_3dex> triangles;
+  for ( int oi = 0; oi < outer_loops.Count(); oi++ )
+  {
+    const int outer = outer_loops[oi];
+    region_points.SetCount(0);
+    region_loop_point_count.SetCount(0);
+    for ( i = -1; i < loop_count; i++ )
+    {
+      const int li = ( i < 0 ) ? outer : i;
+      if ( i >= 0 && parent[i] != outer )
+        continue;
+      region_points.Append( loop_point_count[li], points.Array()+loop_start[li] );
+      region_loop_point_count.Append( loop_point_count[li] );
+    }
+
+    triangles.SetCount(0);
+    if ( ON_Triangulate2dRegion( region_loop_point_count.Count(), region_loop_point_count.Array(),
+                                 2, &region_points[0].x, triangles ) < 1 )
+      continue;
+
+    const int vi0 = newmesh->m_V.Count();
+    for ( i = 0; i < region_points.Count(); i++ )
+    {
+      newmesh->m_V.Append( ON_3fPoint( m_plane.PointAt( region_points[i].x, region_points[i].y ) ) );
+      newmesh->m_N.Append( normal );
+    }
+    newmesh->m_F.Reserve( newmesh->m_F.Count() + triangles.Count() );
+    for ( i = 0; i < triangles.Count(); i++ )
+    {
+      ON_MeshFace& f = newmesh->m_F.AppendNew();
+      f.vi[0] = vi0 + triangles[i].i;
+      f.vi[1] = vi0 + triangles[i].j;
+      f.vi[2] = vi0 + triangles[i].k;
+      f.vi[3] = f.vi[2];
+    }
+  }
+
+  if ( newmesh->m_F.Count() < 1 )
+  {
+    if ( newmesh != mesh )
+      delete newmesh;
+    return 0;
+  }
+  return newmesh;
+}
+
+struct ON_HatchFillJob
+{
+  const ON_Hatch* const* m_hatches;
+  const ON_HatchPattern* const* m_patterns;
+  double m_tolerance;
+  ON_SimpleArray<ON_Line>* m_lines;
+  ON_Mesh** m_meshes;
+  unsigned char* m_rc;
+};
+
+static void ON_HatchFillTask( void* context, int i )
+{
+  ON_HatchFillJob* job = (ON_HatchFillJob*)context;
+  const ON_Hatch* hatch = job->m_hatches[i];
+  const ON_HatchPattern* pattern = job->m_patterns[i];
+  if ( job->m_meshes )
+    job->m_meshes[i] = 0;
+  if ( 0 == hatch || 0 == pattern )
+    return;
+  switch( pattern->FillType() )
+  {
+  case ON_HatchPattern::ftSolid:
+    if ( job->m_meshes )
+    {
+      job->m_meshes[i] = hatch->CreateFillMesh( job->m_tolerance );
+      job->m_rc[i] = job->m_meshes[i] ? 1 : 0;
+    }
+    break;
+  case ON_HatchPattern::ftLines:
+    if ( job->m_lines )
+      job->m_rc[i] = hatch->GetPatternLines( *pattern, job->m_tolerance, job->m_lines[i] ) ? 1 : 0;
+    break;
+  default:
+    break;
+  }
+}
+
+int ON_GetHatchFills(
+        int hatch_count,
+        const ON_Hatch* const* hatches,
+        const ON_HatchPattern* const* patterns,
+        double tolerance,
+        ON_SimpleArray<ON_Line>* lines,
+        ON_Mesh** meshes,
+        int thread_count
+        )
+{
+  if ( hatch_count < 1 || 0 == hatches || 0 == patterns )
+    return 0;
+
+  ON_SimpleArray<unsigned char> task_rc(hatch_count);
+  task_rc.SetCount(hatch_count);
+  task_rc.Zero();
+
+  ON_HatchFillJob job;
+  job.m_hatches = hatches;
+  job.m_patterns = patterns;
+  job.m_tolerance = tolerance;
+  job.m_lines = lines;
+  job.m_meshes = meshes;
+  job.m_rc = task_rc.Array();
+  ON_ParallelFor( thread_count, hatch_count, ON_HatchFillTask, &job );
+
+  int rc = 0;
+  for ( int i = 0; i < hatch_count; i++ )
+  {
+    if ( task_rc[i] )
+      rc++;
+  }
+  return rc;
+}
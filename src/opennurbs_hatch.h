@@ -818,6 +818,92 @@ public:
   */
   bool ReplaceLoops(ON_SimpleArray<const ON_Curve*> loops);
 
+  /*
+  Description:
+    Approximate the hatch loops with closed 2d polylines.
+  Parameters:
+    tolerance - [in] maximum distance between a loop curve and
+        its polyline.  If tolerance <= 0, 0.001 times the diagonal
+        of the loops' bounding box is used.
+    points - [out] polyline points in the hatch's plane (ECS)
+        coordinates are appended to this array, one loop after
+        another.  The closing point of a loop is not repeated.
+    loop_point_count - [out] the number of points in each loop
+        is appended to this array.
+  Returns:
+    Number of loops added.
+  Remarks:
+    Lines and polylines are copied exactly.  Loops with fewer
+    than three points are skipped.
+  */
+  int GetLoopPolylines( 
+        double tolerance,
+        ON_SimpleArray<ON_2dPoint>& points,
+        ON_SimpleArray<int>& loop_point_count
+        ) const;
+
+  /*
+  Description:
+    Get the dashed line segments that draw a hatch with a 
+    line pattern.
+  Parameters:
+    pattern - [in] the hatch's pattern.  The pattern's hatch
+        lines are scaled by PatternScale(), rotated by 
+        PatternRotation() and moved to BasePoint2d().
+    tolerance - [in] tolerance used to flatten the loops.
+        See GetLoopPolylines().
+    lines - [out] world coordinate line segments are appended
+        to this array.  Dots in the dash pattern are returned as
+        lines with identical end points.
+  Returns:
+    True if successful.  False if the pattern has no valid 
+    hatch lines or is so dense that more than 2^24 lines would 
+    cross the hatch.
+  Remarks:
+    Each ON_HatchLine is drawn as a family of parallel lines.  
+    The ON_HatchLine offset is measured in the line's rotated
+    frame: offset.y is the distance between lines and offset.x
+    is the shift of the dash pattern from one line to the next.
+    The loops are flattened once and their edges are sorted 
+    into an edge table that is swept across the lines, so every
+    line only intersects the loop edges that cross it.  The 
+    even-odd rule decides which parts of a line are inside.
+    Every edge is half-open: it crosses the lines from its lower
+    end up to, but not including, its upper end.  A line that 
+    runs along a boundary edge is therefore filled exactly when
+    the region is on the edge's upper side (in the rotated frame).
+    Loop vertices within round-off of a line are moved onto the
+    line first, so the rule holds for every pattern rotation.
+    Dash patterns shorter than the tolerance are drawn as 
+    continuous lines.
+  */
+  bool GetPatternLines( 
+        const ON_HatchPattern& pattern,
+        double tolerance,
+        ON_SimpleArray<ON_Line>& lines
+        ) const;
+
+  /*
+  Description:
+    Create a triangle mesh of the hatch's filled region.
+  Parameters:
+    tolerance - [in] tolerance used to flatten the loops.
+        See GetLoopPolylines().
+    mesh - [in] if not NULL, the triangles are put on this mesh.
+  Returns:
+    A mesh in world coordinates or NULL if the hatch has no
+    outer loops.
+  Remarks:
+    Every inner loop is a hole in the smallest outer loop that
+    contains it.  Each outer loop and its holes are triangulated
+    with ON_Triangulate2dRegion().  The mesh normals are the 
+    hatch plane's z axis.
+  */
+  ON_Mesh* CreateFillMesh(
+        double tolerance,
+        ON_Mesh* mesh = NULL
+        ) const;
+
 protected:
   ON_Plane m_plane;
   double m_pattern_scale;
@@ -830,4 +916,39 @@ protected:
 
 };
 
+/*
+Description:
+  Get the pattern lines or fill meshes for a list of hatches
+  using several threads.
+Parameters:
+  hatch_count - [in] number of hatches
+  hatches - [in] hatches[i] is the i-th hatch.
+  patterns - [in] patterns[i] is the pattern of hatches[i].
+  tolerance - [in] tolerance used to flatten the hatch loops.
+        See ON_Hatch::GetLoopPolylines().
+  lines - [out] If not NULL and patterns[i] has fill type 
+        ON_HatchPattern::ftLines, lines[i] gets the segments
+        from ON_Hatch::GetPatternLines().
+  meshes - [out] If not NULL and patterns[i] has fill type 
+        ON_HatchPattern::ftSolid, meshes[i] is set to the mesh
+        from ON_Hatch::CreateFillMesh().  The caller deletes
+        the meshes.  Hatches that are not solid get a NULL mesh.
+  thread_count - [in] maximum number of threads. 
+        See ON_ParallelFor().
+Returns:
+  Number of hatches that were successfully processed.
+Remarks:
+  Each hatch is an independent task.  Gradient fills are skipped.
+*/
+ON_DECL
+int ON_GetHatchFills(
+        int hatch_count,
+        const ON_Hatch* const* hatches,
+        const ON_HatchPattern* const* patterns,
+        double tolerance,
+        ON_SimpleArray<ON_Line>* lines,
+        ON_Mesh** meshes,
+        int thread_count = 0
+        );
+
 #endif
@@ -201,6 +201,14 @@ int ON_NurbsSpanIndex(
           hint--;
         knot += hint;
         len -= hint;
+
+        // When parameters move monotonically, t is usually in the
+        // hint span or the next one, so the search can be skipped.
+        // (knot[0] <= t and, if t == knot[0], side >= 0.)
+        if ( len > 2 && t < knot[1] )
+          return hint;
+        if ( len > 3 && t < knot[2] && (t > knot[1] || side >= 0) )
+          return hint+1;
       }
     }
   }
@@ -1112,6 +1120,36 @@ bool ON_GetGrevilleKnotVector( // get knots from Greville abcissa
   return rc;
 }
 
+bool ON_GetChordLengthParameters(
+          int dim,
+          int point_count,
+          int point_stride,
+          const double* point,
+          double* t
+          )
+{
+  int i, j;
+  double d, x;
+
+  if ( dim < 1 || point_count < 2 || point_stride < dim || !point || !t )
+    return false;
+
+  t[0] = 0.0;
+  for ( i = 1; i < point_count; i++ )
+  {
+    d = 0.0;
+    for ( j = 0; j < dim; j++ )
+    {
+      x = point[j+point_stride] - point[j];
+      d += x*x;
+    }
+    t[i] = t[i-1] + sqrt(d);
+    point += point_stride;
+  }
+
+  return ( t[point_count-1] > 0.0 && ON_IsValid(t[point_count-1]) );
+}
+
 bool ON_ClampKnotVector(
         int cv_dim,   // dimension of cv's = ( = dim+1 for rational cvs )
         int order, 
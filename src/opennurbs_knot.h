@@ -329,6 +329,35 @@ bool ON_GetGrevilleKnotVector( // get knots from Greville abcissa
           double*        // knot[cv_count+order-2]
           );
 
+/*
+Description:
+  Get chord length parameters for a list of points.
+Parameters:
+  dim - [in] (>=1) point dimension
+  point_count - [in] (>=2) number of points
+  point_stride - [in] (>=dim) stride between points
+  point - [in] array of point coordinates
+  t - [out] t[point_count] array.  t[0] = 0 and
+        t[i] = t[i-1] + |point[i] - point[i-1]|.
+Returns:
+  true if successful.  False if the input is not valid
+  or all the points are coincident.
+Remarks:
+  Coincident consecutive points get equal parameters.  These
+  parameters are the usual input to ON_GetGrevilleKnotVector()
+  when interpolating points.
+See Also:
+  ON_NurbsCurve::CreateInterpolatingCurve
+*/
+ON_DECL
+bool ON_GetChordLengthParameters(
+          int dim,
+          int point_count,
+          int point_stride,
+          const double* point,
+          double* t
+          );
+
 ON_DECL
 bool ON_ClampKnotVector(
         int,       // cv_dim ( = dim+1 for rational cvs )
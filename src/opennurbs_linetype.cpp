@@ -352,9 +352,348 @@ ON_LinetypeSegment ON_Linetype::Segment( int index) const
     return ON_LinetypeSegment();
 }
 
+//////////////////////////////////////////////////////////////////////
+// Dash patterns
+
+// The default tolerance is 0.001 times the diagonal of the
+// curve's bounding box.
+static double ON_LinetypeTolerance( const ON_Curve& curve, double tolerance )
+{
+  if ( !(tolerance > 0.0) )
+  {
+    ON_BoundingBox bbox = curve.BoundingBox();
+    tolerance = bbox.IsValid() ? 0.001*bbox.Diagonal().Length() : 0.0;
+    if ( !(tolerance > 0.0) )
+      tolerance = ON_ZERO_TOLERANCE;
+  }
+  return tolerance;
+}
 
+class ON_LinetypeDashTable
+{
+public:
+  // Flattens the curve into points that are within the tolerance
+  // of the curve.  The points are used for the interiors of the
+  // dash polylines.
+  bool Create( const ON_Curve& curve, double tolerance );
+
+  ON_SimpleArray<double> m_t; // curve parameters
+  ON_3dPointArray m_P;        // curve points
+  double m_tolerance;         // flattening tolerance
+
+private:
+  // Appends points after the start of the curve.  The curve 
+  // parameter u is mapped to t = t0 + (u-u0)*dt.
+  bool AppendCurve( const ON_Curve* curve, double u0, double t0, double dt );
+  void AppendSpan( const ON_Curve* curve, double u0, const ON_3dPoint& P0, double u1, const ON_3dPoint& P1,
+                   double tu0, double t0, double dt, int depth );
+  void AppendPoint( double t, const ON_3dPoint& P );
+};
+
+void ON_LinetypeDashTable::AppendPoint( double t, const ON_3dPoint& P )
+{
+  m_t.Append(t);
+  m_P.Append(P);
+}
 
+bool ON_LinetypeDashTable::Create( const ON_Curve& curve, double tolerance )
+{
+  m_t.SetCount(0);
+  m_P.SetCount(0);
+  ON_Interval domain = curve.Domain();
+  if ( !domain.IsIncreasing() )
+    return false;
+  m_tolerance = ON_LinetypeTolerance( curve, tolerance );
+  m_t.Append(domain[0]);
+  m_P.Append(curve.PointAtStart());
+  return AppendCurve( &curve, domain[0], domain[0], 1.0 );
+}
+
+bool ON_LinetypeDashTable::AppendCurve( const ON_Curve* curve, double u0, double t0, double dt )
+{
+  int i;
+  ON_SimpleArray<ON_3dPoint> pline_points;
+  ON_SimpleArray<double> pline_t;
+  if ( curve->IsPolyline(&pline_points,&pline_t) >= 2 && pline_t.Count() == pline_points.Count() )
+  {
+    for ( i = 1; i < pline_points.Count(); i++ )
+      AppendPoint( t0 + (pline_t[i]-u0)*dt, pline_points[i] );
+    return true;
+  }
+
+  const ON_ArcCurve* arccurve = ON_ArcCurve::Cast(curve);
+  if ( arccurve && arccurve->m_arc.Radius() > m_tolerance )
+  {
+    // equal angle segments whose sagitta is at most the tolerance
+    const ON_Arc& arc = arccurve->m_arc;
+    const double a = 2.0*acos(1.0 - m_tolerance/arc.Radius());
+    const double angle = arc.AngleRadians();
+    const int n = ( angle/a < 65536.0 ) ? ((int)ceil(angle/a)) : 65536;
+    const ON_Interval d = arc.DomainRadians();
+    const ON_Interval u = arccurve->Domain();
+    for ( i = 1; i <= n; i++ )
+    {
+      const double x = ((double)i)/n;
+      AppendPoint( t0 + (((i < n) ? u.ParameterAt(x) : u[1]) - u0)*dt, 
+                   arc.PointAt( (i < n) ? d.ParameterAt(x) : d[1] ) );
+    }
+    return true;
+  }
 
+  const ON_PolyCurve* polycurve = ON_PolyCurve::Cast(curve);
+  if ( polycurve )
+  {
+    // Segments are flattened separately so lines and arcs use the
+    // fast cases above.
+    for ( i = 0; i < polycurve->Count(); i++ )
+    {
+      const ON_Curve* segment = polycurve->SegmentCurve(i);
+      const ON_Interval sd = polycurve->SegmentDomain(i);
+      const ON_Interval cd = segment ? segment->Domain() : ON_Interval();
+      if ( 0 == segment || !sd.IsIncreasing() || !cd.IsIncreasing() )
+        return false;
+      const double s = sd.Length()/cd.Length();
+      if ( !AppendCurve( segment, cd[0], t0 + (sd[0]-u0)*dt, s*dt ) )
+        return false;
+    }
+    return true;
+  }
 
+  const int span_count = curve->SpanCount();
+  if ( span_count < 1 )
+    return false;
+  ON_SimpleArray<double> s(span_count+1);
+  s.SetCount(span_count+1);
+  if ( !curve->GetSpanVector(s.Array()) )
+    return false;
 
+  // Each span is divided into quarters before the adaptive 
+  // subdivision so closed and S shaped spans are not missed.
+  ON_3dPoint P0 = curve->PointAt(s[0]), P1;
+  for ( i = 0; i < span_count; i++ )
+  {
+    if ( !(s[i] < s[i+1]) )
+      continue;
+    for ( int j = 1; j <= 4; j++ )
+    {
+      const double ua = s[i] + 0.25*(j-1)*(s[i+1]-s[i]);
+      const double ub = (j < 4) ? (s[i] + 0.25*j*(s[i+1]-s[i])) : s[i+1];
+      P1 = curve->PointAt(ub);
+      AppendSpan( curve, ua, P0, ub, P1, u0, t0, dt, 0 );
+      P0 = P1;
+    }
+  }
+  return true;
+}
 
+void ON_LinetypeDashTable::AppendSpan( 
+  const ON_Curve* curve, 
+  double ua, const ON_3dPoint& Pa, 
+  double ub, const ON_3dPoint& Pb,
+  double u0, double t0, double dt,
+  int depth 
+  )
+{
+  const double u = 0.5*(ua+ub);
+  ON_3dPoint M;
+  bool bSplit = false;
+  if ( depth < 16 && ua < u && u < ub )
+  {
+    // distance from the middle and quarter points to the chord
+    const ON_Line chord(Pa,Pb);
+    M = curve->PointAt(u);
+    if ( M.DistanceTo(chord.ClosestPointTo(M)) > m_tolerance )
+      bSplit = true;
+    else
+    {
+      const ON_3dPoint Q0 = curve->PointAt(0.5*(ua+u));
+      if ( Q0.DistanceTo(chord.ClosestPointTo(Q0)) > m_tolerance )
+        bSplit = true;
+      else
+      {
+        const ON_3dPoint Q1 = curve->PointAt(0.5*(u+ub));
+        bSplit = ( Q1.DistanceTo(chord.ClosestPointTo(Q1)) > m_tolerance );
+      }
+    }
+  }
+  if ( bSplit )
+  {
+    AppendSpan( curve, ua, Pa, u, M, u0, t0, dt, depth+1 );
+    AppendSpan( curve, u, M, ub, Pb, u0, t0, dt, depth+1 );
+  }
+  else
+    AppendPoint( t0 + (ub-u0)*dt, Pb );
+}
+
+bool ON_Linetype::GetCurveDashes( 
+  const ON_Curve& curve,
+  double pattern_scale,
+  double tolerance,
+  ON_SimpleArray<ON_Interval>* intervals,
+  ON_ClassArray<ON_Polyline>* polylines
+  ) const
+{
+  if ( !(pattern_scale > 0.0) )
+    return false;
+
+  // Dash lengths are measured with the curve's arc length table.
+  // The flattened table is only used for the interior points of
+  // the polylines.
+  const ON_Interval domain = curve.Domain();
+  const ON_CurveArcLengthTable* arc_length = domain.IsIncreasing() ? curve.ArcLengthTable() : 0;
+  if ( 0 == arc_length || !(arc_length->Length() > 0.0) )
+    return false;
+  const double length = arc_length->Length();
+  ON_LinetypeDashTable table;
+  if ( polylines && (!table.Create( curve, tolerance ) || table.m_t.Count() < 2) )
+    return false;
+  tolerance = polylines ? table.m_tolerance : ON_LinetypeTolerance( curve, tolerance );
+
+  // scaled pattern
+  const int seg_count = m_segments.Count();
+  double pattern_length = 0.0;
+  bool bGaps = false;
+  ON_SimpleArray<double> seg_length(seg_count);
+  for ( int i = 0; i < seg_count; i++ )
+  {
+    seg_length.Append( fabs(m_segments[i].m_length)*pattern_scale );
+    pattern_length += seg_length[i];
+    if ( ON_LinetypeSegment::stSpace == m_segments[i].m_seg_type && seg_length[i] > 0.0 )
+      bGaps = true;
+  }
+  const bool bDashed = ( bGaps && pattern_length > tolerance );
+  if ( bDashed && length/pattern_length*seg_count > 16777216.0 )
+    return false;
+
+  // dash_s[2*i] and dash_s[2*i+1] are the lengths at the ends of 
+  // the i-th dash.
+  ON_SimpleArray<double> dash_s;
+  double pos = 0.0;
+  int k = 0; // pattern segment
+  while ( bDashed ? (pos <= length) : (0 == k) )
+  {
+    if ( bDashed )
+    {
+      const double len = seg_length[k];
+      const bool bDash = ( ON_LinetypeSegment::stLine == m_segments[k].m_seg_type && (0.0 == len || pos < length) );
+      if ( bDash )
+      {
+        dash_s.Append( pos );
+        dash_s.Append( ( pos + len < length ) ? (pos + len) : length );
+      }
+      pos += len;
+      if ( ++k == seg_count )
+        k = 0;
+    }
+    else
+    {
+      // one dash for the whole curve
+      dash_s.Append( 0.0 );
+      dash_s.Append( length );
+      k = 1;
+    }
+  }
+
+  const int dash_count = dash_s.Count()/2;
+  ON_SimpleArray<double> dash_t(2*dash_count);
+  dash_t.SetCount(2*dash_count);
+  if ( dash_count > 0 && !arc_length->ParametersAt( 2*dash_count, dash_s.Array(), dash_t.Array() ) )
+    return false;
+
+  const int n = table.m_t.Count();
+  int j = 0; // last table point at or before the start of the dash
+  for ( int i = 0; i < dash_count; i++ )
+  {
+    // The ends of the curve are exact.
+    const double s0 = dash_s[2*i];
+    const double s1 = dash_s[2*i+1];
+    const ON_Interval dash( (s0 > 0.0) ? dash_t[2*i] : domain[0],
+                            (s1 < length) ? dash_t[2*i+1] : domain[1] );
+    if ( intervals )
+      intervals->Append( dash );
+
+    if ( polylines )
+    {
+      // The end points are evaluated so they are on the curve at
+      // the ends of the dash interval.  The table points between
+      // them are the interior points.
+      while ( j < n-1 && table.m_t[j+1] <= dash[0] )
+        j++;
+      int j1 = j;
+      while ( j1 < n-1 && table.m_t[j1+1] < dash[1] )
+        j1++;
+      ON_Polyline& pline = polylines->AppendNew();
+      pline.Reserve( j1 - j + 2 );
+      pline.Append( (dash[0] > table.m_t[j]) ? curve.PointAt(dash[0]) : table.m_P[j] );
+      for ( int m = j+1; m <= j1; m++ )
+        pline.Append( table.m_P[m] );
+      if ( dash[1] > dash[0] )
+        pline.Append( (j1+1 < n && dash[1] == table.m_t[j1+1]) ? table.m_P[j1+1] : curve.PointAt(dash[1]) );
+      else
+        pline.Append( pline[0] );
+    }
+  }
+
+  return true;
+}
+
+struct ON_CurveDashJob
+{
+  const ON_Linetype* m_linetype;
+  const ON_Curve* const* m_curves;
+  double m_pattern_scale;
+  double m_tolerance;
+  ON_SimpleArray<ON_Interval>* m_intervals;
+  ON_ClassArray<ON_Polyline>* m_polylines;
+  unsigned char* m_rc;
+};
+
+static void ON_CurveDashTask( void* context, int i )
+{
+  ON_CurveDashJob* job = (ON_CurveDashJob*)context;
+  const ON_Curve* curve = job->m_curves[i];
+  if ( curve )
+  {
+    job->m_rc[i] = job->m_linetype->GetCurveDashes( *curve, job->m_pattern_scale, job->m_tolerance,
+                                                    job->m_intervals ? &job->m_intervals[i] : 0,
+                                                    job->m_polylines ? &job->m_polylines[i] : 0 )
+                 ? 1 : 0;
+  }
+}
+
+int ON_GetCurveDashes( 
+  const ON_Linetype& linetype,
+  int curve_count,
+  const ON_Curve* const* curves,
+  double pattern_scale,
+  double tolerance,
+  ON_SimpleArray<ON_Interval>* intervals,
+  ON_ClassArray<ON_Polyline>* polylines,
+  int thread_count
+  )
+{
+  if ( curve_count < 1 || 0 == curves )
+    return 0;
+
+  ON_SimpleArray<unsigned char> task_rc(curve_count);
+  task_rc.SetCount(curve_count);
+  task_rc.Zero();
+
+  ON_CurveDashJob job;
+  job.m_linetype = &linetype;
+  job.m_curves = curves;
+  job.m_pattern_scale = pattern_scale;
+  job.m_tolerance = tolerance;
+  job.m_intervals = intervals;
+  job.m_polylines = polylines;
+  job.m_rc = task_rc.Array();
+  ON_ParallelFor( thread_count, curve_count, ON_CurveDashTask, &job );
+
+  int rc = 0;
+  for ( int i = 0; i < curve_count; i++ )
+  {
+    if ( task_rc[i] )
+      rc++;
+  }
+  return rc;
+}
@@ -162,6 +162,50 @@ public:
   ON_SimpleArray<ON_LinetypeSegment>& Segments();
   const ON_SimpleArray<ON_LinetypeSegment>& Segments() const;
 
+  /*
+  Description:
+    Apply the linetype's pattern to a curve.
+  Parameters:
+    curve - [in]
+    pattern_scale - [in] (> 0) segment lengths are multiplied
+        by pattern_scale to get lengths in curve units.
+    tolerance - [in] maximum distance between the curve and the
+        dash polylines.  If tolerance <= 0, 0.001 times the 
+        diagonal of the curve's bounding box is used.
+    intervals - [out] if not NULL, the curve parameter interval
+        of each dash is appended to this array.
+    polylines - [out] if not NULL, a polyline approximation of
+        each dash is appended to this array.
+  Returns:
+    True if successful.  False if the input is not valid or the
+    curve would get more than 2^24 dashes.
+  Remarks:
+    The pattern starts at the start of the curve and repeats
+    until the end of the curve.  stLine segments are dashes and
+    stSpace segments are gaps.  A zero length stLine segment is
+    a dot and is returned as a zero length interval and a two
+    point polyline whose points are equal.  If the pattern has
+    no gaps or its scaled length is less than the tolerance, the
+    entire curve is one dash.
+    Dash lengths are arc lengths from the curve's 
+    ON_Curve::ArcLengthTable(), so dashes do not drift along
+    curved parts of the curve.  All the dash ends are looked up
+    in one pass with ON_CurveArcLengthTable::ParametersAt().  
+    When polylines are wanted, the curve is also flattened once
+    and the dashes take their interior points from that table,
+    so the cost is linear in the number of dashes and the table
+    size.
+  See Also:
+    ON_GetCurveDashes
+  */
+  bool GetCurveDashes( 
+    const ON_Curve& curve,
+    double pattern_scale,
+    double tolerance,
+    ON_SimpleArray<ON_Interval>* intervals,
+    ON_ClassArray<ON_Polyline>* polylines
+    ) const;
+
 public:
   int m_linetype_index;
   ON_UUID m_linetype_id;    // Set by Rhino - unique id of this linetype
@@ -171,5 +215,37 @@ private:
   ON_SimpleArray<ON_LinetypeSegment> m_segments;
 };
 
+/*
+Description:
+  Apply a linetype's pattern to a list of curves using several
+  threads.
+Parameters:
+  linetype - [in]
+  curve_count - [in] number of curves
+  curves - [in] curves[i] is the i-th curve
+  pattern_scale - [in]
+  tolerance - [in]
+    See ON_Linetype::GetCurveDashes().
+  intervals - [out] if not NULL, the dash intervals of curves[i] 
+    are appended to intervals[i].
+  polylines - [out] if not NULL, the dash polylines of curves[i]
+    are appended to polylines[i].
+  thread_count - [in] maximum number of threads. 
+    See ON_ParallelFor().
+Returns:
+  Number of curves that were successfully dashed.
+*/
+ON_DECL
+int ON_GetCurveDashes( 
+  const ON_Linetype& linetype,
+  int curve_count,
+  const ON_Curve* const* curves,
+  double pattern_scale,
+  double tolerance,
+  ON_SimpleArray<ON_Interval>* intervals,
+  ON_ClassArray<ON_Polyline>* polylines,
+  int thread_count = 0
+  );
+
 #endif
 
@@ -30,92 +30,6 @@ static bool IdIsNotZero(const ON_UUID* id)
   return false;
 }
 
-static ON__UINT16 IdCRC(const ON_UUID* id)
-{
-  // This is a private member function and the caller
-  // insures the id pointer is not null.
-  static const ON__UINT16 ON_CRC16_CCITT_TABLE[256] =
-   {0x0000,0x1021,0x2042,0x3063,0x4084,0x50A5,0x60C6,0x70E7,0x8108,0x9129,0xA14A,0xB16B,0xC18C,0xD1AD,0xE1CE,0xF1EF,
-    0x1231,0x0210,0x3273,0x2252,0x52B5,0x4294,0x72F7,0x62D6,0x9339,0x8318,0xB37B,0xA35A,0xD3BD,0xC39C,0xF3FF,0xE3DE,
-    0x2462,0x3443,0x0420,0x1401,0x64E6,0x74C7,0x44A4,0x5485,0xA56A,0xB54B,0x8528,0x9509,0xE5EE,0xF5CF,0xC5AC,0xD58D,
-    0x3653,0x2672,0x1611,0x0630,0x76D7,0x66F6,0x5695,0x46B4,0xB75B,0xA77A,0x9719,0x8738,0xF7DF,0xE7FE,0xD79D,0xC7BC,
-    0x48C4,0x58E5,0x6886,0x78A7,0x0840,0x1861,0x2802,0x3823,0xC9CC,0xD9ED,0xE98E,0xF9AF,0x8948,0x9969,0xA90A,0xB92B,
-    0x5AF5,0x4AD4,0x7AB7,0x6A96,0x1A71,0x0A50,0x3A33,0x2A12,0xDBFD,0xCBDC,0xFBBF,0xEB9E,0x9B79,0x8B58,0xBB3B,0xAB1A,
-    0x6CA6,0x7C87,0x4CE4,0x5CC5,0x2C22,0x3C03,0x0C60,0x1C41,0xEDAE,0xFD8F,0xCDEC,0xDDCD,0xAD2A,0xBD0B,0x8D68,0x9D49,
-    0x7E97,0x6EB6,0x5ED5,0x4EF4,0x3E13,0x2E32,0x1E51,0x0E70,0xFF9F,0xEFBE,0xDFDD,0xCFFC,0xBF1B,0xAF3A,0x9F59,0x8F78,
-    0x9188,0x81A9,0xB1CA,0xA1EB,0xD10C,0xC12D,0xF14E,0xE16F,0x1080,0x00A1,0x30C2,0x20E3,0x5004,0x4025,0x7046,0x6067,
-    0x83B9,0x9398,0xA3FB,0xB3DA,0xC33D,0xD31C,0xE37F,0xF35E,0x02B1,0x1290,0x22F3,0x32D2,0x4235,0x5214,0x6277,0x7256,
-    0xB5EA,0xA5CB,0x95A8,0x8589,0xF56E,0xE54F,0xD52C,0xC50D,0x34E2,0x24C3,0x14A0,0x0481,0x7466,0x6447,0x5424,0x4405,
-    0xA7DB,0xB7FA,0x8799,0x97B8,0xE75F,0xF77E,0xC71D,0xD73C,0x26D3,0x36F2,0x0691,0x16B0,0x6657,0x7676,0x4615,0x5634,
-    0xD94C,0xC96D,0xF90E,0xE92F,0x99C8,0x89E9,0xB98A,0xA9AB,0x5844,0x4865,0x7806,0x6827,0x18C0,0x08E1,0x3882,0x28A3,
-    0xCB7D,0xDB5C,0xEB3F,0xFB1E,0x8BF9,0x9BD8,0xABBB,0xBB9A,0x4A75,0x5A54,0x6A37,0x7A16,0x0AF1,0x1AD0,0x2AB3,0x3A92,
-    0xFD2E,0xED0F,0xDD6C,0xCD4D,0xBDAA,0xAD8B,0x9DE8,0x8DC9,0x7C26,0x6C07,0x5C64,0x4C45,0x3CA2,0x2C83,0x1CE0,0x0CC1,
-    0xEF1F,0xFF3E,0xCF5D,0xDF7C,0xAF9B,0xBFBA,0x8FD9,0x9FF8,0x6E17,0x7E36,0x4E55,0x5E74,0x2E93,0x3EB2,0x0ED1,0x1EF0};
-
-  const unsigned char* b = (const unsigned char*)id;
-  ON__UINT16 current_remainder;
-  ON__UINT16 r1;
-
-  // crc calculation loop unrolled for speed
-
-  //current_remainder=0;
-  //r1 = ON_CRC16_CCITT_TABLE[(current_remainder & ((ON__UINT16)0xff00))>>8];
-  //current_remainder = (current_remainder << 8) ^ (*b++);
-  //current_remainder ^= r1;  
-  //r1 = ON_CRC16_CCITT_TABLE[(current_remainder & ((ON__UINT16)0xff00))>>8];
-  //current_remainder = (current_remainder << 8) ^ (*b++);
-  //current_remainder ^= r1;  
-
-  // The commented out lines above reduce to these two lines.
-  current_remainder = *b++; 
-  current_remainder = (current_remainder << 8) ^ (*b++);
-
-  r1 = ON_CRC16_CCITT_TABLE[(current_remainder & ((ON__UINT16)0xff00))>>8];
-  current_remainder = (current_remainder << 8) ^ (*b++);
-  current_remainder ^= r1;  
-  r1 = ON_CRC16_CCITT_TABLE[(current_remainder & ((ON__UINT16)0xff00))>>8];
-  current_remainder = (current_remainder << 8) ^ (*b++);
-  current_remainder ^= r1;  
-  r1 = ON_CRC16_CCITT_TABLE[(current_remainder & ((ON__UINT16)0xff00))>>8];
-  current_remainder = (current_remainder << 8) ^ (*b++);
-  current_remainder ^= r1;  
-  r1 = ON_CRC16_CCITT_TABLE[(current_remainder & ((ON__UINT16)0xff00))>>8];
-  current_remainder = (current_remainder << 8) ^ (*b++);
-  current_remainder ^= r1;  
-  r1 = ON_CRC16_CCITT_TABLE[(current_remainder & ((ON__UINT16)0xff00))>>8];
-  current_remainder = (current_remainder << 8) ^ (*b++);
-  current_remainder ^= r1;  
-  r1 = ON_CRC16_CCITT_TABLE[(current_remainder & ((ON__UINT16)0xff00))>>8];
-  current_remainder = (current_remainder << 8) ^ (*b++);
-  current_remainder ^= r1;  
-  r1 = ON_CRC16_CCITT_TABLE[(current_remainder & ((ON__UINT16)0xff00))>>8];
-  current_remainder = (current_remainder << 8) ^ (*b++);
-  current_remainder ^= r1;  
-  r1 = ON_CRC16_CCITT_TABLE[(current_remainder & ((ON__UINT16)0xff00))>>8];
-  current_remainder = (current_remainder << 8) ^ (*b++);
-  current_remainder ^= r1;  
-  r1 = ON_CRC16_CCITT_TABLE[(current_remainder & ((ON__UINT16)0xff00))>>8];
-  current_remainder = (current_remainder << 8) ^ (*b++);
-  current_remainder ^= r1;  
-  r1 = ON_CRC16_CCITT_TABLE[(current_remainder & ((ON__UINT16)0xff00))>>8];
-  current_remainder = (current_remainder << 8) ^ (*b++);
-  current_remainder ^= r1;  
-  r1 = ON_CRC16_CCITT_TABLE[(current_remainder & ((ON__UINT16)0xff00))>>8];
-  current_remainder = (current_remainder << 8) ^ (*b++);
-  current_remainder ^= r1;  
-  r1 = ON_CRC16_CCITT_TABLE[(current_remainder & ((ON__UINT16)0xff00))>>8];
-  current_remainder = (current_remainder << 8) ^ (*b++);
-  current_remainder ^= r1;  
-  r1 = ON_CRC16_CCITT_TABLE[(current_remainder & ((ON__UINT16)0xff00))>>8];
-  current_remainder = (current_remainder << 8) ^ (*b++);
-  current_remainder ^= r1;  
-  r1 = ON_CRC16_CCITT_TABLE[(current_remainder & ((ON__UINT16)0xff00))>>8];
-  current_remainder = (current_remainder << 8) ^ (*b);
-  current_remainder ^= r1;  
-
-  return current_remainder;
-}
-
 ON_SerialNumberMap::ON_SerialNumberMap()
 {
   m_maxsn = 0;
@@ -127,10 +41,16 @@ ON_SerialNumberMap::ON_SerialNumberMap()
   m_snblk_list_count = 0;
   m_e_blk = 0;
   m_sn_block0.EmptyBlock();
-  m_bHashTableIsValid = true;
   m_active_id_count = 0;
   memset(&m_inactive_id,0,sizeof(m_inactive_id));
-  memset(m_hash_table,0,sizeof(m_hash_table));
+  m_hash_table = 0;
+  m_hash_capacity = 0;
+  m_hash_used = 0;
+  m_hash_old = 0;
+  m_hash_old_capacity = 0;
+  m_hash_old_i = 0;
+  m_hash_migrate_count = ID_HASH_MIGRATE_COUNT;
+  m_hash_epoch = 1;
 }
 
 ON_SerialNumberMap::~ON_SerialNumberMap()
@@ -156,9 +76,8 @@ void ON_SerialNumberMap::EmptyList()
     m_snblk_list_capacity = 0;
     m_snblk_list_count = 0;
   }
-  m_bHashTableIsValid = true;
   m_active_id_count = 0;
-  memset(m_hash_table,0,sizeof(m_hash_table));
+  DestroyHashTableHelper();
 }
 
 
@@ -286,7 +205,6 @@ void ON_SerialNumberMap::SN_BLOCK::SortBlockHelper()
 }
 
 bool ON_SerialNumberMap::SN_BLOCK::IsValidBlock(ON_TextLog* textlog, 
-                                                struct SN_ELEMENT*const* hash_table,
                                                 size_t* active_id_count) const
 {
   unsigned int sn0, sn;
@@ -360,29 +278,10 @@ bool ON_SerialNumberMap::SN_BLOCK::IsValidBlock(ON_TextLog* textlog,
     else if ( 0 != m_sn[i].m_id_active )
     {
       // The element has active serial number and active id.
-      // It must have a nonzero m_id and be in the hash table.
+      // It must have a nonzero m_id.  IsValidHashTableHelper()
+      // verifies the element is in the hash table.
       aidcnt++;
-      if ( IdIsNotZero(&m_sn[i].m_id) )
-      {
-        const SN_ELEMENT* e;
-        for (e = hash_table[IdCRC(&m_sn[i].m_id) % ID_HASH_TABLE_COUNT]; 0!=e; e = e->m_next)
-        {
-          if ( e == &m_sn[i] )
-          {
-            // found m_sn[i] in the hash table
-            break;
-          }
-        }
-        if ( 0 == e )
-        {
-          // m_sn[i] is not in the hash table but m_id_active indicates
-          // it should be.
-          if (textlog)
-            textlog->Print("SN_BLOCK m_sn[%d].m_id_active != 0 but the element is not in m_hash_table[].\n",i);
-          return false;
-        }
-      }
-      else 
+      if ( !IdIsNotZero(&m_sn[i].m_id) )
       {
         if (textlog)
           textlog->Print("SN_BLOCK m_sn[%d].m_id_active != 0 but m_id = 0.\n",i);
@@ -730,25 +629,12 @@ struct ON_SerialNumberMap::SN_ELEMENT* ON_SerialNumberMap::FindSerialNumber(unsi
 struct ON_SerialNumberMap::SN_ELEMENT* ON_SerialNumberMap::FindId(ON_UUID id) const
 {
   struct SN_ELEMENT* e = 0;
-  size_t i;
 
-  if ( m_active_id_count > 0 )
+  if ( m_active_id_count > 0 && IdIsNotZero(&id) )
   {
-    i = HashIndex(&id);
-    if ( 0 != i || IdIsNotZero(&id) )
-    {
-      if ( !m_bHashTableIsValid )
-      {
-        const_cast<ON_SerialNumberMap*>(this)->BuildHashTableHelper();
-      }
-      e = m_hash_table[i];
-      while(e)
-      {
-        if ( 0 == memcmp(&e->m_id,&id,sizeof(e->m_id)) )
-          break;
-        e = e->m_next;
-      }
-    }
+    struct ID_HASH_SLOT* slot = const_cast<ON_SerialNumberMap*>(this)->FindHashSlotHelper(&id);
+    if ( slot )
+      e = slot->m_e;
   }
   return e;
 }
@@ -941,35 +827,21 @@ size_t ON_SerialNumberMap::GetElements(
 struct ON_SerialNumberMap::SN_ELEMENT* 
 ON_SerialNumberMap::RemoveSerialNumberAndId(unsigned int sn)
 {
+  // MigrateHashTableHelper() may move elements so it is
+  // called before e is found.
+  MigrateHashTableHelper(m_hash_migrate_count);
   struct SN_ELEMENT* e = FindElementHelper(sn);
   if ( e && e->m_sn_active )
   {
     if ( e->m_id_active )
     {
-      if ( m_bHashTableIsValid )
+      // Remove the element from the hash table.  This
+      // does not move any elements so e and m_e_blk
+      // remain valid.
+      if ( !RemoveFromHashTableHelper(e) )
       {
-        // Hash table is valid - remove the element from the table
-        size_t i = HashIndex(&e->m_id);
-        struct SN_ELEMENT* prev = 0;
-        struct SN_ELEMENT* h;
-        for ( h = m_hash_table[i]; h; h = h->m_next )
-        {
-          if (h == e)
-          {
-            if ( prev )
-            {
-              prev->m_next = e->m_next;
-            }
-            else
-            {
-              m_hash_table[i] = e->m_next;
-            }
-            break;
-          }
-          prev = h;
-        }
+        ON_ERROR("ON_SerialNumberMap - id hash table corruption");
       }
-      e->m_next = 0;
       e->m_id_active = 0;
       if ( m_active_id_count > 0 )
       {
@@ -1027,56 +899,44 @@ struct ON_SerialNumberMap::SN_ELEMENT*
 ON_SerialNumberMap::RemoveId(unsigned int sn, ON_UUID id)
 {
   struct SN_ELEMENT* e=0;
-  struct SN_ELEMENT* prev;
-  size_t i;
-  if ( m_active_id_count > 0 )
+  if ( m_active_id_count > 0 && IdIsNotZero(&id) )
   {
-    i = HashIndex(&id);
-    if ( i != 0 || IdIsNotZero(&id) )
+    if ( sn > 0 )
     {
-      if ( !m_bHashTableIsValid && sn > 0 )
+      // Use the serial number to find the element.  The
+      // hash table slot can be found without comparing ids.
+      e = FindSerialNumber(sn);
+      if ( e )
       {
-        // We can avoid rebuilding the hash table.
-        // Use the serial number to find the element.
-        e = FindSerialNumber(sn);
-        if (e)
+        if (    e->m_id_active 
+             && 0 == memcmp(&e->m_id,&id,sizeof(e->m_id)) 
+             && RemoveFromHashTableHelper(e) )
         {
-          if (e->m_id_active && 0 == memcmp(&e->m_id,&id,sizeof(e->m_id)) )
-          {
-            e->m_next = 0;
-            e->m_id_active = 0;
-            m_active_id_count--;
-            m_inactive_id = e->m_id;
-          }
-          else
-          {
-            // id is not active
-            e = 0;
-          }
+          e->m_id_active = 0;
+          m_active_id_count--;
+          m_inactive_id = e->m_id;
         }
-      }
-      else
-      {
-        BuildHashTableHelper();
-        prev = 0;
-        for( e = m_hash_table[i]; e; e = e->m_next )
+        else
         {
-          if ( 0 == memcmp(&e->m_id,&id,sizeof(e->m_id)) )
-          {
-            if ( prev )
-              prev->m_next = e->m_next;
-            else
-              m_hash_table[i] = e->m_next;
-            e->m_next = 0;
-            e->m_id_active = 0;
-            m_active_id_count--;
-            m_inactive_id = e->m_id;
-            break;
-          }
-          prev = e;
+          e = 0;
         }
       }
     }
+
+    if ( 0 == e )
+    {
+      struct ID_HASH_SLOT* slot = FindHashSlotHelper(&id);
+      if ( slot )
+      {
+        // mark the slot as removed
+        slot->m_sn = 0;
+        slot->m_tag = 1;
+        e = slot->m_e;
+        e->m_id_active = 0;
+        m_active_id_count--;
+        m_inactive_id = e->m_id;
+      }
+    }
   }
   return e;
 }
@@ -1120,9 +980,7 @@ bool ON_SerialNumberMap::IsValid(ON_TextLog* textlog) const
 
   aic = 0;
 
-  const_cast<ON_SerialNumberMap*>(this)->BuildHashTableHelper();
-
-  if ( !m_sn_block0.IsValidBlock(textlog,m_hash_table,&aic) )
+  if ( !m_sn_block0.IsValidBlock(textlog,&aic) )
   {
     if ( textlog )
       textlog->Print("m_sn_block0 is not valid\n");
@@ -1146,7 +1004,7 @@ bool ON_SerialNumberMap::IsValid(ON_TextLog* textlog) const
         textlog->Print("m_snblk_list[%d] is not sorted\n",i);
       return false;
     }
-    if ( !m_snblk_list[i]->IsValidBlock(textlog,m_hash_table,&aic) )
+    if ( !m_snblk_list[i]->IsValidBlock(textlog,&aic) )
     {
       if ( textlog )
         textlog->Print("m_snblk_list[%d] is not valid\n",i);
@@ -1190,20 +1048,10 @@ bool ON_SerialNumberMap::IsValid(ON_TextLog* textlog) const
     return false;
   }
 
-  c = 0;
-  for ( i = 0; i < ID_HASH_TABLE_COUNT; i++ )
-  {
-    const SN_ELEMENT* e;
-    for (e = m_hash_table[i]; e && c <= m_active_id_count; e = e->m_next)
-    {
-      c++;
-    }
-  }
-
-  if ( c > m_active_id_count )
+  if ( !IsValidHashTableHelper(textlog) )
   {
     if ( textlog )
-      textlog->Print("m_hash_table[] linked lists have too many elements.\n");
+      textlog->Print("id hash table is not valid\n");
     return false;
   }
 
@@ -1531,7 +1379,6 @@ struct ON_SerialNumberMap::SN_ELEMENT* ON_SerialNumberMap::AddSerialNumber(unsig
 struct ON_SerialNumberMap::SN_ELEMENT* ON_SerialNumberMap::AddSerialNumberAndId(unsigned int sn,ON_UUID id)
 {
   struct SN_ELEMENT* e = AddSerialNumber(sn);
-  size_t i;
 
   if ( 0 != e && 0 == e->m_id_active )
   {
@@ -1542,16 +1389,17 @@ struct ON_SerialNumberMap::SN_ELEMENT* ON_SerialNumberMap::AddSerialNumberAndId(
          )
       {
         // Need to determine if id is already in use.
-        BuildHashTableHelper();
-        i = HashIndex(&id);
-        for(const struct SN_ELEMENT* h = m_hash_table[i];h;h = h->m_next)
+        const ON__UINT16 epoch = m_hash_epoch;
+        if ( 0 != FindHashSlotHelper(&id) )
         {
-          if ( 0 == memcmp(&h->m_id,&id,sizeof(h->m_id)) )
-          {
-            // This id is already in use. Create a new id.
-            ON_CreateUuid(id);
-            break;
-          }
+          // This id is already in use. Create a new id.
+          ON_CreateUuid(id);
+        }
+        if ( epoch != m_hash_epoch )
+        {
+          // Searching the hash table sorted m_sn_block0
+          // and e may have moved.
+          e = FindElementHelper(sn);
         }
       }        
     }
@@ -1564,183 +1412,387 @@ struct ON_SerialNumberMap::SN_ELEMENT* ON_SerialNumberMap::AddSerialNumberAndId(
     // Add id to the hash table
     e->m_id = id;
     e->m_id_active = 1;
-    if ( m_bHashTableIsValid )
-    {
-      // the table isn't dirty - go ahead
-      // and add the element.  If the table
-      // is dirty, it will get rebuilt before
-      // it needs to be used and this element
-      // will be included at that time.
-      i = HashIndex(&id);
-      e->m_next = m_hash_table[i];
-      m_hash_table[i] = e;
-    }
     m_active_id_count++;
     memset(&m_inactive_id,0,sizeof(m_inactive_id));
+    const ON__UINT16 epoch = m_hash_epoch;
+    struct ID_HASH_SLOT* slot = AddToHashTableHelper(sn,&id);
+    if ( epoch != m_hash_epoch )
+    {
+      // Growing the hash table moved elements.
+      e = FindElementHelper(sn);
+    }
+    if ( slot )
+    {
+      slot->m_e = e;
+      slot->m_epoch = m_hash_epoch;
+    }
   }
 
   return e;
 }
 
-size_t ON_SerialNumberMap::HashIndex(const ON_UUID* id) const
+void ON_SerialNumberMap::InvalidateHashTableHelper()
 {
-  // this is a private member function and the caller
-  // insures the id pointer is not null.
-  return (IdCRC(id) % ID_HASH_TABLE_COUNT);
+  // This helper function is called when the memory
+  // locations of SN_ELEMENTs are going to change
+  // and the element pointers cached in the hash table
+  // may become invalid.  The serial numbers saved in
+  // the hash table are still valid and are used to
+  // refresh the pointers when the slots are visited.
+  if ( 0 == ++m_hash_epoch )
+  {
+    // The epoch wrapped around. Mark every cached pointer
+    // as stale so an old slot cannot match the new epoch.
+    size_t i;
+    for ( i = 0; i < m_hash_capacity; i++ )
+      m_hash_table[i].m_epoch = 0;
+    for ( i = 0; i < m_hash_old_capacity; i++ )
+      m_hash_old[i].m_epoch = 0;
+    m_hash_epoch = 1;
+  }
 }
 
-void ON_SerialNumberMap::InvalidateHashTableHelper()
+struct ON_SerialNumberMap::SN_ELEMENT* ON_SerialNumberMap::HashSlotElementHelper(struct ON_SerialNumberMap::ID_HASH_SLOT* slot)
 {
-  // This helper function is called when the memory
-  // locations of SN_ELEMENTs are going to change.
-  // and the pointers saved in m_hash_table[] and
-  // SN_ELEMENT::next may become invalid. When a
-  // valid m_hash_table[] is needed at a later time,
-  // BuildHashTableHelper() will restore it.
-  if ( m_bHashTableIsValid )
+  if ( slot->m_epoch != m_hash_epoch )
   {
-    m_bHashTableIsValid = false;
-    memset(m_hash_table,0,sizeof(m_hash_table));
+    // The element may have moved since the pointer was cached.
+    struct SN_ELEMENT* e = FindElementHelper(slot->m_sn);
+    if ( 0 == e || 0 == e->m_sn_active || 0 == e->m_id_active )
+    {
+      ON_ERROR("ON_SerialNumberMap - id hash table corruption");
+      return 0;
+    }
+    slot->m_e = e;
+    slot->m_epoch = m_hash_epoch;
   }
+  return slot->m_e;
 }
 
-bool ON_SerialNumberMap::RemoveBlockFromHashTableHelper(const struct ON_SerialNumberMap::SN_BLOCK* blk)
+struct ON_SerialNumberMap::ID_HASH_SLOT* ON_SerialNumberMap::FindHashSlotHelper(const ON_UUID* id)
 {
-  // quickly remove every id in the block from the hash table.
-  // This is done when the block is small compared to the
-  // size of the hash table and removing the elements from
-  // the hash table, rearranging the block, and then adding
-  // the elements back into the hash table is faster than
-  // simply rebuilding the hash table.
-  //
-  // The 128 multiplier is determined as follows:
-  // - C = average number of elements with the same hash index
-  //     = m_active_id_count/ID_HASH_TABLE_COUNT.
-  // - D = cost of destroying hash table = time to memset the table
-  //       to zero.
-  // - H = cost of calculating the hash table index of an id.
-  // - A = The cost of adding an element to the hash table is
-  //       H + two pointer assignments with is essentially H.
-  // - F = The average cost of finding an element in the hash
-  //       table is H plus going through half the linked list
-  //       of elements at that hash index (C/2 pointer dereferences).
-  // - B = number of elements in a block.
-  // - I = (number times a valid hash table is destroyed)/
-  //       (number of times the hash table is rebuilt).
-  // - R = rebuild cost = A*m_active_id_count.
-  // - Keeping the the has table up to date only makes sense if
-  //   R > I*(A+F)*active_id_count
-  //   it is needed often enough to justify ...
-  bool rc = false;
-  if ( m_bHashTableIsValid && m_active_id_count > 128*blk->m_count )
-  {
-    const SN_ELEMENT* e;
-    SN_ELEMENT* h;
-    SN_ELEMENT* prev;
-    size_t i, hash_i;
-    rc = true;
-    for (e = blk->m_sn, i = blk->m_count; i--; e++)
+  // This is a private member function and the caller
+  // insures the id pointer is not null.
+  MigrateHashTableHelper(m_hash_migrate_count);
+
+  const ON__UINT32 h = ON_UuidHashTable::Hash(*id);
+  const ON__UINT16 tag = (ON__UINT16)(h >> 16);
+  struct ID_HASH_SLOT* table = m_hash_table;
+  size_t capacity = m_hash_capacity;
+  struct ID_HASH_SLOT* slot;
+  struct SN_ELEMENT* e;
+  size_t i, mask;
+  int pass;
+
+  // Search m_hash_table[] and then the slots in m_hash_old[]
+  // that have not been moved yet.
+  for ( pass = 0; pass < 2; pass++ )
+  {
+    if ( capacity > 0 )
     {
-      if ( e->m_id_active )
+      mask = capacity-1;
+      for ( i = (h & mask); true; i = ((i+1) & mask) )
       {
-        prev = 0;
-        hash_i = HashIndex(&e->m_id);
-        for (h = m_hash_table[hash_i];h;h=h->m_next)
+        slot = table + i;
+        if ( 0 == slot->m_sn )
         {
-          if (h == e)
-          {
-            // Do not change value of SN_ELEMENT's m_id_active.
-            // This value is needed by AddBlockToHashTableHelper()
-            // when it add the element back in.
-            m_active_id_count--;
-            if (prev)
-              prev->m_next = h->m_next;
-            else
-              m_hash_table[hash_i] = h->m_next;
-            break;
-          }
-          prev = h;
+          if ( 0 == slot->m_tag )
+            break; // empty slot ends the probe sequence
+        }
+        else if ( tag == slot->m_tag )
+        {
+          e = HashSlotElementHelper(slot);
+          if ( e && 0 == memcmp(&e->m_id,id,sizeof(e->m_id)) )
+            return slot;
         }
       }
     }
+    table = m_hash_old;
+    capacity = m_hash_old_capacity;
   }
-  return rc;
+
+  return 0;
 }
 
-void ON_SerialNumberMap::AddBlockToHashTableHelper(struct ON_SerialNumberMap::SN_BLOCK* blk)
+struct ON_SerialNumberMap::ID_HASH_SLOT* ON_SerialNumberMap::AddToHashTableHelper(unsigned int sn, const ON_UUID* id)
 {
-  if ( m_bHashTableIsValid )
+  // The caller insures id is not in the table.  This 
+  // function may move elements.  The returned slot's 
+  // cached element pointer is stale and the caller 
+  // sets it.
+  MigrateHashTableHelper(m_hash_migrate_count);
+  if ( 4*(m_hash_used+1) > 3*m_hash_capacity )
   {
-    SN_ELEMENT* e;
-    size_t i, hash_i;
-    for (e = blk->m_sn, i = blk->m_count; i--; e++)
+    GrowHashTableHelper();
+    if ( 4*(m_hash_used+1) > 3*m_hash_capacity )
+      return 0; // out of memory
+  }
+
+  const ON__UINT32 h = ON_UuidHashTable::Hash(*id);
+  const size_t mask = m_hash_capacity-1;
+  size_t i = (h & mask);
+  while ( 0 != m_hash_table[i].m_sn )
+    i = ((i+1) & mask);
+
+  struct ID_HASH_SLOT* slot = m_hash_table + i;
+  if ( 0 == slot->m_tag )
+    m_hash_used++; // empty slot - removed slots are reused
+  slot->m_e = 0;
+  slot->m_sn = sn;
+  slot->m_tag = (ON__UINT16)(h >> 16);
+  slot->m_epoch = 0;
+  return slot;
+}
+
+bool ON_SerialNumberMap::RemoveFromHashTableHelper(const struct ON_SerialNumberMap::SN_ELEMENT* e)
+{
+  // Slots are matched using the serial number so no
+  // elements are looked up or moved.
+  const ON__UINT32 h = ON_UuidHashTable::Hash(e->m_id);
+  const ON__UINT16 tag = (ON__UINT16)(h >> 16);
+  const unsigned int sn = e->m_sn;
+  struct ID_HASH_SLOT* table = m_hash_table;
+  size_t capacity = m_hash_capacity;
+  struct ID_HASH_SLOT* slot;
+  size_t i, mask;
+  int pass;
+
+  for ( pass = 0; pass < 2; pass++ )
+  {
+    if ( capacity > 0 )
     {
-      if ( e->m_id_active )
+      mask = capacity-1;
+      for ( i = (h & mask); true; i = ((i+1) & mask) )
       {
-        hash_i = HashIndex(&e->m_id);
-        e->m_next = m_hash_table[hash_i];
-        m_hash_table[hash_i] = e;
+        slot = table + i;
+        if ( sn == slot->m_sn && tag == slot->m_tag )
+        {
+          // mark the slot as removed
+          slot->m_sn = 0;
+          slot->m_tag = 1;
+          return true;
+        }
+        if ( 0 == slot->m_sn && 0 == slot->m_tag )
+          break; // empty slot ends the probe sequence
       }
     }
+    table = m_hash_old;
+    capacity = m_hash_old_capacity;
   }
+
+  return false;
 }
 
+void ON_SerialNumberMap::GrowHashTableHelper()
+{
+  if ( m_hash_old )
+  {
+    // m_hash_migrate_count is set so this does not happen,
+    // but m_hash_old[] must be empty before it is replaced.
+    MigrateHashTableHelper(m_hash_old_capacity);
+  }
+
+  // The new capacity is at least three times the number of
+  // active ids.  When most ids have been removed, the table
+  // shrinks by at most a factor of 4 so the remaining slots 
+  // in m_hash_old[] can be moved in a few operations.
+  size_t capacity = ID_HASH_TABLE_MIN_CAPACITY;
+  while ( capacity < 3*(m_active_id_count+1) || 4*capacity < m_hash_capacity )
+    capacity *= 2;
+
+  struct ID_HASH_SLOT* table = (struct ID_HASH_SLOT*)oncalloc(capacity,sizeof(table[0]));
+  if ( 0 == table )
+  {
+    ON_ERROR("ON_SerialNumberMap - out of memory");
+    return;
+  }
+
+  if ( m_hash_used > 0 )
+  {
+    // The slots in the current table are moved to the new table
+    // a few at a time by later operations.  Every slot must be
+    // moved before the new table fills up.  The new table can 
+    // accept at least "room" additions before it needs to grow.
+    const size_t room = (3*capacity)/4 - m_active_id_count;
+    m_hash_old = m_hash_table;
+    m_hash_old_capacity = m_hash_capacity;
+    m_hash_old_i = 0;
+    m_hash_migrate_count = m_hash_old_capacity/room + 1;
+    if ( m_hash_migrate_count < ID_HASH_MIGRATE_COUNT )
+      m_hash_migrate_count = ID_HASH_MIGRATE_COUNT;
+  }
+  else if ( m_hash_table )
+  {
+    onfree(m_hash_table);
+  }
+
+  m_hash_table = table;
+  m_hash_capacity = capacity;
+  m_hash_used = 0;
+}
 
-void ON_SerialNumberMap::BuildHashTableHelper()
+void ON_SerialNumberMap::MigrateHashTableHelper(size_t slot_count)
 {
-  // This function is called when code requires
-  // m_hash_table[] to be valid so an id can be looked up.
-  if ( !m_bHashTableIsValid )
-  {
-    // The hash table is dirty because elements
-    // have moved in memory.  Rebuild it putting
-    // the newest elements first.
-    m_bHashTableIsValid = true;
-    if (m_active_id_count > 0)
+  // Moves slot_count slots from m_hash_old[] to m_hash_table[].
+  // The id hash is not saved in the slots, so this may need to
+  // look up elements and can move elements.
+  if ( 0 == m_hash_old )
+    return;
+
+  size_t i1 = m_hash_old_i + slot_count;
+  if ( i1 > m_hash_old_capacity )
+    i1 = m_hash_old_capacity;
+
+  const size_t mask = m_hash_capacity-1;
+  struct ID_HASH_SLOT* slot;
+  const struct SN_ELEMENT* e;
+  ON__UINT32 h;
+  size_t i, j;
+  for ( i = m_hash_old_i; i < i1; i++ )
+  {
+    slot = m_hash_old + i;
+    if ( 0 == slot->m_sn )
+      continue;
+    e = HashSlotElementHelper(slot);
+    if ( e )
     {
-      struct SN_BLOCK* blk;
-      struct SN_ELEMENT* e;
-      size_t snblk_i, j, hash_i;
-      for ( snblk_i = 0; snblk_i < m_snblk_list_count; snblk_i++ )
+      h = ON_UuidHashTable::Hash(e->m_id);
+      j = (h & mask);
+      while ( 0 != m_hash_table[j].m_sn )
+        j = ((j+1) & mask);
+      if ( 0 == m_hash_table[j].m_tag )
+        m_hash_used++;
+      m_hash_table[j] = *slot;
+    }
+    // Mark the old slot as removed so searches of the
+    // remaining slots in m_hash_old[] are still correct.
+    slot->m_sn = 0;
+    slot->m_tag = 1;
+  }
+  m_hash_old_i = i1;
+
+  if ( m_hash_old_i >= m_hash_old_capacity )
+  {
+    onfree(m_hash_old);
+    m_hash_old = 0;
+    m_hash_old_capacity = 0;
+    m_hash_old_i = 0;
+    m_hash_migrate_count = ID_HASH_MIGRATE_COUNT;
+  }
+}
+
+void ON_SerialNumberMap::DestroyHashTableHelper()
+{
+  if ( m_hash_table )
+    onfree(m_hash_table);
+  if ( m_hash_old )
+    onfree(m_hash_old);
+  m_hash_table = 0;
+  m_hash_capacity = 0;
+  m_hash_used = 0;
+  m_hash_old = 0;
+  m_hash_old_capacity = 0;
+  m_hash_old_i = 0;
+  m_hash_migrate_count = ID_HASH_MIGRATE_COUNT;
+  m_hash_epoch = 1;
+}
+
+bool ON_SerialNumberMap::IsValidHashTableHelper(ON_TextLog* textlog) const
+{
+  if (    0 != (m_hash_capacity & (m_hash_capacity-1)) 
+       || 4*m_hash_used > 3*m_hash_capacity 
+       || 0 != (m_hash_old_capacity & (m_hash_old_capacity-1))
+       || m_hash_old_i > m_hash_old_capacity
+     )
+  {
+    if ( textlog )
+      textlog->Print("id hash table capacity or counts are not valid.\n");
+    return false;
+  }
+
+  const struct ID_HASH_SLOT* table = m_hash_table;
+  size_t capacity = m_hash_capacity;
+  size_t i, j, used_count = 0, id_count = 0;
+  ON__UINT32 h;
+  int pass;
+  for ( pass = 0; pass < 2; pass++ )
+  {
+    for ( i = 0; i < capacity; i++ )
+    {
+      const struct ID_HASH_SLOT* slot = table + i;
+      if ( 0 == slot->m_sn )
       {
-        blk = m_snblk_list[snblk_i];
-        if ( blk->m_purged < blk->m_count )
+        if ( slot->m_tag > 1 )
         {
-          e = &blk->m_sn[0];
-          for(j = blk->m_count; j--; e++ )
-          {
-            if ( e->m_id_active )
-            {
-              hash_i = HashIndex(&e->m_id);
-              e->m_next = m_hash_table[hash_i];
-              m_hash_table[hash_i] = e;
-            }
-            else
-            {
-              e->m_next = 0;
-            }
-          }
+          if ( textlog )
+            textlog->Print("id hash table slot %d is empty but m_tag = %d.\n",i,slot->m_tag);
+          return false;
         }
+        if ( 0 == pass && 1 == slot->m_tag )
+          used_count++; // removed slot
+        continue;
+      }
+
+      if ( 1 == pass && i < m_hash_old_i )
+      {
+        if ( textlog )
+          textlog->Print("m_hash_old[%d] should have been moved.\n",i);
+        return false;
       }
+      if ( 0 == pass )
+        used_count++;
+      id_count++;
 
-      blk = &m_sn_block0;
-      if ( blk->m_purged < blk->m_count )
+      const struct SN_ELEMENT* e = FindSerialNumber(slot->m_sn);
+      if ( 0 == e || 0 == e->m_id_active )
+      {
+        if ( textlog )
+          textlog->Print("id hash table slot %d serial number %u does not have an active id.\n",i,slot->m_sn);
+        return false;
+      }
+      if ( slot->m_epoch == m_hash_epoch && slot->m_e != e )
+      {
+        if ( textlog )
+          textlog->Print("id hash table slot %d has a bad element pointer.\n",i);
+        return false;
+      }
+      h = ON_UuidHashTable::Hash(e->m_id);
+      if ( slot->m_tag != (ON__UINT16)(h >> 16) )
       {
-        e = &blk->m_sn[0];
-        for(j = blk->m_count; j--; e++ )
+        if ( textlog )
+          textlog->Print("id hash table slot %d has the wrong m_tag.\n",i);
+        return false;
+      }
+
+      // Every slot from the id's home slot to slot i must be used
+      // or removed. Otherwise searches for the id stop too soon.
+      for ( j = (h & (capacity-1)); j != i; j = ((j+1) & (capacity-1)) )
+      {
+        if ( 0 == table[j].m_sn && 0 == table[j].m_tag )
         {
-          if ( e->m_id_active )
-          {
-            hash_i = HashIndex(&e->m_id);
-            e->m_next = m_hash_table[hash_i];
-            m_hash_table[hash_i] = e;
-          }
-          else
-          {
-            e->m_next = 0;
-          }
+          if ( textlog )
+            textlog->Print("id hash table slot %d cannot be reached.\n",i);
+          return false;
         }
       }
     }
+    table = m_hash_old;
+    capacity = m_hash_old_capacity;
   }
+
+  if ( used_count != m_hash_used )
+  {
+    if ( textlog )
+      textlog->Print("m_hash_used=%d (should be %d) is not correct\n",m_hash_used,used_count);
+    return false;
+  }
+
+  if ( id_count != m_active_id_count )
+  {
+    if ( textlog )
+      textlog->Print("id hash table has %d ids (should be %d)\n",id_count,m_active_id_count);
+    return false;
+  }
+
+  return true;
 }
@@ -26,6 +26,8 @@ Description:
   restrictions on what order numbers are added and removed.
   The minimum memory footprint is less than 150KB and doesn't
   increase until you have more than 8000 serial numbers.
+  The id index grows with the number of active ids, so
+  finding an id takes constant time for any map size.
   It is possible to have an active serial number and an
   inactive id.
 */
@@ -53,7 +55,11 @@ public:
     // ID
     //
     ON_UUID m_id;
-    struct SN_ELEMENT* m_next; // id hash table linked list
+
+    // Reserved.  The id hash table no longer links elements
+    // with this pointer, but it is kept so the size and layout
+    // of SN_ELEMENT do not change.  It is always NULL.
+    struct SN_ELEMENT* m_next;
 
     ////////////////////////////////////////////////////////////
     //
@@ -344,7 +350,10 @@ private:
     // 10 million entries.
     SN_BLOCK_CAPACITY = 8192,
     SN_PURGE_RATIO = 16,
-    ID_HASH_TABLE_COUNT = 8192
+
+    // Id hash table sizes.
+    ID_HASH_TABLE_MIN_CAPACITY = 64, // power of 2
+    ID_HASH_MIGRATE_COUNT = 32       // minimum slots moved per operation
   };
 
   struct SN_BLOCK
@@ -358,7 +367,7 @@ private:
     void EmptyBlock();
     void CullBlockHelper();
     void SortBlockHelper();
-    bool IsValidBlock(ON_TextLog* textlog,struct SN_ELEMENT*const* hash_table,size_t* active_id_count) const;
+    bool IsValidBlock(ON_TextLog* textlog,size_t* active_id_count) const;
     struct SN_ELEMENT* BinarySearchBlockHelper(unsigned int sn);
     static int CompareMaxSN(const void*,const void*);
     size_t ActiveElementEstimate(unsigned int sn0, unsigned int sn1) const;
@@ -372,7 +381,6 @@ private:
   size_t m_sn_purged;  // total number of purged elements
 
   // ID hash table counts (all ids in the hash table are active)
-  bool m_bHashTableIsValid; // true if m_hash_table[] is valid
   size_t m_active_id_count; // number of active ids in the hash table
   ON_UUID m_inactive_id;    // frequently and id is removed and
                             // then added back.  m_inactive_id
@@ -409,16 +417,48 @@ private:
   void GarbageCollectHelper();
   size_t GarbageCollectMoveHelper(SN_BLOCK* dst,SN_BLOCK* src);
 
-  // When m_bHashTableIsValid is true, then m_hash_table[i] is 
-  // a linked list of elements whose id satisfies 
-  // i = HashIndex(&e->m_id).  When m_bHashTableIsValid is false,
-  // m_hash_table[] is identically zero.
-  struct SN_ELEMENT* m_hash_table[ID_HASH_TABLE_COUNT];
-  size_t HashIndex(const ON_UUID*) const;
-  void InvalidateHashTableHelper(); // marks table as dirty
-  bool RemoveBlockFromHashTableHelper(const struct SN_BLOCK* blk);
-  void AddBlockToHashTableHelper(struct SN_BLOCK* blk);
-  void BuildHashTableHelper();      // prepares table for use
+  // The id hash table is an open addressing table with linear
+  // probing.  A used slot saves the serial number of an element
+  // with an active id and a cached pointer to that element.
+  // Serial numbers never change, so the table stays valid when
+  // elements move in memory.  When elements move,
+  // InvalidateHashTableHelper() increments m_hash_epoch and
+  // the cached pointer in a slot is used only when the slot's
+  // m_epoch equals m_hash_epoch.  Stale pointers are refreshed
+  // from the serial number the next time the slot is visited.
+  //
+  // The table capacity is a power of 2 and grows with the number
+  // of active ids.  When the table grows, the previous table is
+  // kept in m_hash_old[] and its slots are moved into the new
+  // table ID_HASH_MIGRATE_COUNT at a time by later table
+  // operations so there is never a long pause to rebuild the
+  // entire table.
+  struct ID_HASH_SLOT
+  {
+    struct SN_ELEMENT* m_e; // valid when m_epoch = m_hash_epoch
+    unsigned int m_sn;      // 0 = empty (m_tag=0) or removed (m_tag=1)
+    ON__UINT16 m_tag;       // high 16 bits of the id hash
+    ON__UINT16 m_epoch;
+  };
+  struct ID_HASH_SLOT* m_hash_table;
+  size_t m_hash_capacity;      // m_hash_table[] capacity
+  size_t m_hash_used;          // used and removed slots in m_hash_table[]
+  struct ID_HASH_SLOT* m_hash_old;
+  size_t m_hash_old_capacity;  // m_hash_old[] capacity
+  size_t m_hash_old_i;         // m_hash_old[] slots before m_hash_old_i
+                               // have been moved to m_hash_table[]
+  size_t m_hash_migrate_count; // m_hash_old[] slots moved per operation
+  ON__UINT16 m_hash_epoch;
+
+  void InvalidateHashTableHelper(); // elements are going to move
+  struct ID_HASH_SLOT* FindHashSlotHelper(const ON_UUID* id);
+  struct SN_ELEMENT* HashSlotElementHelper(struct ID_HASH_SLOT* slot);
+  struct ID_HASH_SLOT* AddToHashTableHelper(unsigned int sn, const ON_UUID* id);
+  bool RemoveFromHashTableHelper(const struct SN_ELEMENT* e);
+  void GrowHashTableHelper();
+  void MigrateHashTableHelper(size_t slot_count);
+  void DestroyHashTableHelper();
+  bool IsValidHashTableHelper(ON_TextLog* textlog) const;
 };
 
 
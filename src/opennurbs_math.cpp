@@ -1276,6 +1276,7 @@ ON_TransformPointList(
 {
   bool rc = true;
   double x, y, z, w;
+  int i;
 
   if ( !ON_IsValidPointList( dim, is_rat, count, stride, point ) )
     return false;
@@ -1284,6 +1285,12 @@ ON_TransformPointList(
   if (count == 0)
     return true;
 
+  // The SSE2/AVX kernels take care of most 3d point lists 
+  // and the loops below finish the list.
+  i = ON_SIMDTransformPointList( dim, is_rat, count, stride, point, point, xform, 0, 0 );
+  count -= i;
+  point += ((size_t)i)*stride;
+
   if (is_rat) {
     switch(dim) {
     case 1:
@@ -1377,6 +1384,7 @@ ON_TransformPointList(
 {
   bool rc = true;
   double x, y, z, w;
+  int i;
 
   if ( !ON_IsValidPointList( dim, is_rat, count, stride, point ) )
     return false;
@@ -1385,6 +1393,12 @@ ON_TransformPointList(
   if (count == 0)
     return true;
 
+  // The SSE2/AVX kernels take care of most 3d point lists 
+  // and the loops below finish the list.
+  i = ON_SIMDTransformPointList( dim, is_rat, count, stride, point, point, xform, 0, 0 );
+  count -= i;
+  point += ((size_t)i)*stride;
+
   if (is_rat) {
     switch(dim) {
     case 1:
@@ -1469,6 +1483,72 @@ ON_TransformPointList(
 }
 
 
+template <class T>
+static bool ON_TransformPointListHelper(
+                  int dim, int is_rat, int count, 
+                  int stride, T* point,
+                  const ON_Xform& xform,
+                  ON_BoundingBox& bbox,
+                  bool bGrowBox
+                  )
+{
+  if ( bGrowBox && !bbox.IsValid() )
+    bGrowBox = false;
+  if ( !bGrowBox )
+    bbox.Destroy();
+  if ( !ON_IsValidPointList( dim, is_rat, count, stride, point ) )
+    return false;
+  if ( 0 == count )
+    return true;
+
+  // transform the points and get their box in one pass
+  ON_BoundingBox box;
+  box.m_min.Set(ON_DBL_PINF,ON_DBL_PINF,ON_DBL_PINF);
+  box.m_max.Set(-ON_DBL_PINF,-ON_DBL_PINF,-ON_DBL_PINF);
+  const int i = ON_SIMDTransformPointList( dim, is_rat, count, stride, point, point, xform, 
+                                           &box.m_min.x, &box.m_max.x );
+  if ( i <= 0 || !box.IsValid() )
+    box.Destroy();
+
+  bool rc = true;
+  if ( i < count )
+  {
+    // finish the list in two passes
+    count -= i;
+    point += ((size_t)i)*stride;
+    if ( !ON_TransformPointList( dim, is_rat, count, stride, point, xform ) )
+      rc = false;
+    if ( !ON_GetPointListBoundingBox( dim, is_rat, count, stride, point, box, box.IsValid(), 0 ) )
+      rc = false;
+  }
+
+  bbox.Union(box);
+  return rc;
+}
+
+bool ON_TransformPointList(
+                  int dim, ON_BOOL32 is_rat, int count, 
+                  int stride, float* point,
+                  const ON_Xform& xform,
+                  ON_BoundingBox& bbox,
+                  bool bGrowBox
+                  )
+{
+  return ON_TransformPointListHelper(dim,is_rat?1:0,count,stride,point,xform,bbox,bGrowBox);
+}
+
+bool ON_TransformPointList(
+                  int dim, ON_BOOL32 is_rat, int count, 
+                  int stride, double* point,
+                  const ON_Xform& xform,
+                  ON_BoundingBox& bbox,
+                  bool bGrowBox
+                  )
+{
+  return ON_TransformPointListHelper(dim,is_rat?1:0,count,stride,point,xform,bbox,bGrowBox);
+}
+
+
 ON_BOOL32 
 ON_TransformPointGrid(
                   int dim, int is_rat, 
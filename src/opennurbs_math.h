@@ -672,6 +672,55 @@ bool ON_TransformPointList(
         const ON_Xform&
         );
 
+/*
+Description:
+  Transforms a list of points and gets the bounding box of
+  the transformed points in a single pass over the points.
+Parameters:
+  dim - [in] >= 1
+  is_rat - [in] true for homogeneous rational points
+  count - [in] number of points
+  stride - [in] >= (is_rat) ? dim+1 : dim
+  point - [in/out] points to transform
+  xform - [in]
+  bbox - [in/out]
+  bGrowBox - [in]
+    If true and the input bbox is valid, the input bbox is
+    enlarged to contain the transformed points.
+Returns:
+  True if successful. The points and the box are the same as
+  the ones from calling ON_TransformPointList() and then
+  ON_GetPointListBoundingBox().
+Remarks:
+  3d point lists use the kernels in opennurbs_simd.h, which
+  makes transforming a large mesh or point cloud and updating
+  its cached box about as fast as reading and writing the 
+  points once.
+*/
+ON_DECL
+bool ON_TransformPointList(
+        int dim,
+        ON_BOOL32 is_rat,
+        int count,
+        int stride,
+        float* point,
+        const ON_Xform& xform,
+        ON_BoundingBox& bbox,
+        bool bGrowBox
+        );
+
+ON_DECL
+bool ON_TransformPointList(
+        int dim,
+        ON_BOOL32 is_rat,
+        int count,
+        int stride,
+        double* point,
+        const ON_Xform& xform,
+        ON_BoundingBox& bbox,
+        bool bGrowBox
+        );
+
 ON_DECL
 ON_BOOL32 ON_TransformPointGrid(
         int,      // dim
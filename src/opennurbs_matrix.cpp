@@ -964,6 +964,285 @@ int ON_Matrix::IsSquare() const
   return ( m_row_count > 0 && m_col_count == m_row_count ) ? m_row_count : 0;
 }
 
+// Number of columns in a block of the cache blocked factorizations.
+#define ON_MATRIX_BLOCK_SIZE 64
+
+bool ON_Matrix::LUFactor( double zero_tolerance, int* row_pivots )
+{
+  const int n = m_row_count;
+  double** this_m = ThisM();
+  if ( n < 1 || n != m_col_count || 0 == this_m || 0 == row_pivots )
+    return false;
+  if ( !(zero_tolerance >= 0.0) )
+    zero_tolerance = 0.0;
+
+  double *Mi, *Mk, x, a;
+  int k0, k1, k, i, j, j0, j1, p;
+  for ( k0 = 0; k0 < n; k0 = k1 )
+  {
+    k1 = (k0 + ON_MATRIX_BLOCK_SIZE < n) ? k0 + ON_MATRIX_BLOCK_SIZE : n;
+
+    // eliminate in columns k0,...,k1-1 of the rows below the
+    // diagonal, but only update columns k0,...,k1-1
+    for ( k = k0; k < k1; k++ )
+    {
+      p = k;
+      x = fabs(this_m[k][k]);
+      for ( i = k+1; i < n; i++ )
+      {
+        if ( fabs(this_m[i][k]) > x )
+        {
+          x = fabs(this_m[i][k]);
+          p = i;
+        }
+      }
+      row_pivots[k] = p;
+      if ( !(x > zero_tolerance) )
+        return false;
+      if ( p != k )
+      {
+        Mk = this_m[k]; this_m[k] = this_m[p]; this_m[p] = Mk;
+      }
+      Mk = this_m[k];
+      x = 1.0/Mk[k];
+      for ( i = k+1; i < n; i++ )
+      {
+        Mi = this_m[i];
+        a = (Mi[k] *= x);
+        if ( 0.0 != a )
+        {
+          for ( j = k+1; j < k1; j++ )
+            Mi[j] -= a*Mk[j];
+        }
+      }
+    }
+
+    if ( k1 >= n )
+      break;
+
+    // rows k0,...,k1-1 of U to the right of the block
+    for ( k = k0; k < k1; k++ )
+    {
+      Mk = this_m[k];
+      for ( i = k+1; i < k1; i++ )
+      {
+        Mi = this_m[i];
+        a = Mi[k];
+        if ( 0.0 != a )
+        {
+          for ( j = k1; j < n; j++ )
+            Mi[j] -= a*Mk[j];
+        }
+      }
+    }
+
+    // subtract L21*U12 from the rest of the matrix, a strip of
+    // columns at a time so the rows of U12 stay in cache
+    for ( j0 = k1; j0 < n; j0 = j1 )
+    {
+      j1 = (j0 + 4*ON_MATRIX_BLOCK_SIZE < n) ? j0 + 4*ON_MATRIX_BLOCK_SIZE : n;
+      for ( i = k1; i < n; i++ )
+      {
+        Mi = this_m[i];
+        for ( k = k0; k < k1; k++ )
+        {
+          a = Mi[k];
+          if ( 0.0 != a )
+          {
+            Mk = this_m[k];
+            for ( j = j0; j < j1; j++ )
+              Mi[j] -= a*Mk[j];
+          }
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+bool ON_Matrix::LUSolve( const int* row_pivots, int pt_dim, int pt_stride, double* pt ) const
+{
+  const int n = m_row_count;
+  double const * const * this_m = ThisM();
+  if ( n < 1 || n != m_col_count || 0 == this_m || 0 == row_pivots 
+       || pt_dim < 1 || pt_stride < pt_dim || 0 == pt )
+    return false;
+
+  const double* Mi;
+  double *Pi, *Pk, a;
+  int i, k, d;
+
+  for ( k = 0; k < n; k++ )
+  {
+    i = row_pivots[k];
+    if ( i < k || i >= n )
+      return false;
+    if ( i != k )
+    {
+      Pi = pt + ((size_t)i)*pt_stride;
+      Pk = pt + ((size_t)k)*pt_stride;
+      for ( d = 0; d < pt_dim; d++ )
+      {
+        a = Pi[d]; Pi[d] = Pk[d]; Pk[d] = a;
+      }
+    }
+  }
+
+  // L has a unit diagonal
+  for ( i = 1; i < n; i++ )
+  {
+    Mi = this_m[i];
+    Pi = pt + ((size_t)i)*pt_stride;
+    for ( k = 0; k < i; k++ )
+    {
+      a = Mi[k];
+      if ( 0.0 != a )
+      {
+        Pk = pt + ((size_t)k)*pt_stride;
+        for ( d = 0; d < pt_dim; d++ )
+          Pi[d] -= a*Pk[d];
+      }
+    }
+  }
+
+  for ( i = n-1; i >= 0; i-- )
+  {
+    Mi = this_m[i];
+    Pi = pt + ((size_t)i)*pt_stride;
+    for ( k = i+1; k < n; k++ )
+    {
+      a = Mi[k];
+      if ( 0.0 != a )
+      {
+        Pk = pt + ((size_t)k)*pt_stride;
+        for ( d = 0; d < pt_dim; d++ )
+          Pi[d] -= a*Pk[d];
+      }
+    }
+    a = 1.0/Mi[i];
+    for ( d = 0; d < pt_dim; d++ )
+      Pi[d] *= a;
+  }
+
+  return true;
+}
+
+bool ON_Matrix::CholeskyFactor()
+{
+  const int n = m_row_count;
+  double** this_m = ThisM();
+  if ( n < 1 || n != m_col_count || 0 == this_m )
+    return false;
+
+  double *Mi, *Mj, x, y;
+  int k0, k1, i, j, k, j0, j1, jmax;
+  for ( k0 = 0; k0 < n; k0 = k1 )
+  {
+    k1 = (k0 + ON_MATRIX_BLOCK_SIZE < n) ? k0 + ON_MATRIX_BLOCK_SIZE : n;
+
+    // columns k0,...,k1-1 of L. The earlier blocks have already
+    // been subtracted from these columns.
+    for ( j = k0; j < k1; j++ )
+    {
+      Mj = this_m[j];
+      x = Mj[j];
+      for ( k = k0; k < j; k++ )
+        x -= Mj[k]*Mj[k];
+      if ( !(x > 0.0) )
+        return false;
+      x = sqrt(x);
+      Mj[j] = x;
+      x = 1.0/x;
+      for ( i = j+1; i < n; i++ )
+      {
+        Mi = this_m[i];
+        y = Mi[j];
+        for ( k = k0; k < j; k++ )
+          y -= Mi[k]*Mj[k];
+        Mi[j] = y*x;
+      }
+    }
+
+    // subtract L21*Transpose(L21) from the lower half of the
+    // rest of the matrix, a block of columns at a time
+    for ( j0 = k1; j0 < n; j0 = j1 )
+    {
+      j1 = (j0 + ON_MATRIX_BLOCK_SIZE < n) ? j0 + ON_MATRIX_BLOCK_SIZE : n;
+      for ( i = j0; i < n; i++ )
+      {
+        Mi = this_m[i];
+        jmax = (i < j1) ? i+1 : j1;
+        for ( j = j0; j < jmax; j++ )
+        {
+          Mj = this_m[j];
+          y = 0.0;
+          for ( k = k0; k < k1; k++ )
+            y += Mi[k]*Mj[k];
+          Mi[j] -= y;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+bool ON_Matrix::CholeskySolve( int pt_dim, int pt_stride, double* pt ) const
+{
+  const int n = m_row_count;
+  double const * const * this_m = ThisM();
+  if ( n < 1 || n != m_col_count || 0 == this_m 
+       || pt_dim < 1 || pt_stride < pt_dim || 0 == pt )
+    return false;
+
+  const double* Mi;
+  double *Pi, *Pk, a;
+  int i, k, d;
+
+  // solve L*Y = B
+  for ( i = 0; i < n; i++ )
+  {
+    Mi = this_m[i];
+    Pi = pt + ((size_t)i)*pt_stride;
+    for ( k = 0; k < i; k++ )
+    {
+      a = Mi[k];
+      if ( 0.0 != a )
+      {
+        Pk = pt + ((size_t)k)*pt_stride;
+        for ( d = 0; d < pt_dim; d++ )
+          Pi[d] -= a*Pk[d];
+      }
+    }
+    a = 1.0/Mi[i];
+    for ( d = 0; d < pt_dim; d++ )
+      Pi[d] *= a;
+  }
+
+  // solve Transpose(L)*X = Y a row of L at a time
+  for ( i = n-1; i >= 0; i-- )
+  {
+    Mi = this_m[i];
+    Pi = pt + ((size_t)i)*pt_stride;
+    a = 1.0/Mi[i];
+    for ( d = 0; d < pt_dim; d++ )
+      Pi[d] *= a;
+    for ( k = 0; k < i; k++ )
+    {
+      a = Mi[k];
+      if ( 0.0 != a )
+      {
+        Pk = pt + ((size_t)k)*pt_stride;
+        for ( d = 0; d < pt_dim; d++ )
+          Pk[d] -= a*Pi[d];
+      }
+    }
+  }
+
+  return true;
+}
+
 bool ON_Matrix::IsRowOrthoganal() const
 {
   double d0, d1, d;
@@ -1425,3 +1704,154 @@ bool ON_SolveSVD(
 
   return true;
 }
+
+bool ON_SolveBandedSystem(
+          int n,
+          int lower_bandwidth,
+          int upper_bandwidth,
+          double* band,
+          int pt_dim,
+          int pt_stride,
+          double* pt
+          )
+{
+  if ( n < 1 || lower_bandwidth < 0 || upper_bandwidth < 0 || 0 == band 
+       || pt_dim < 1 || pt_stride < pt_dim || 0 == pt )
+    return false;
+
+  // A[i][j] = Ai[j-i], where Ai = band + i*w + lower_bandwidth
+  const int w = lower_bandwidth + 1 + upper_bandwidth;
+  double *Ai, *Ak, *Pi, *Pk, a;
+  int i, j, k, d, imax, jmax;
+
+  // elimination without pivoting keeps the fill inside the band
+  for ( k = 0; k < n; k++ )
+  {
+    Ak = band + ((size_t)k)*w + lower_bandwidth;
+    if ( 0.0 == Ak[0] || !ON_IsValid(Ak[0]) )
+      return false;
+    Pk = pt + ((size_t)k)*pt_stride;
+    imax = (k + lower_bandwidth < n) ? k + lower_bandwidth : n-1;
+    jmax = (k + upper_bandwidth < n) ? k + upper_bandwidth : n-1;
+    for ( i = k+1; i <= imax; i++ )
+    {
+      Ai = band + ((size_t)i)*w + lower_bandwidth;
+      a = Ai[k-i]/Ak[0];
+      Ai[k-i] = a;
+      if ( 0.0 == a )
+        continue;
+      for ( j = k+1; j <= jmax; j++ )
+        Ai[j-i] -= a*Ak[j-k];
+      Pi = pt + ((size_t)i)*pt_stride;
+      for ( d = 0; d < pt_dim; d++ )
+        Pi[d] -= a*Pk[d];
+    }
+  }
+
+  for ( i = n-1; i >= 0; i-- )
+  {
+    Ai = band + ((size_t)i)*w + lower_bandwidth;
+    Pi = pt + ((size_t)i)*pt_stride;
+    jmax = (i + upper_bandwidth < n) ? i + upper_bandwidth : n-1;
+    for ( j = i+1; j <= jmax; j++ )
+    {
+      a = Ai[j-i];
+      if ( 0.0 != a )
+      {
+        Pk = pt + ((size_t)j)*pt_stride;
+        for ( d = 0; d < pt_dim; d++ )
+          Pi[d] -= a*Pk[d];
+      }
+    }
+    a = 1.0/Ai[0];
+    for ( d = 0; d < pt_dim; d++ )
+      Pi[d] *= a;
+  }
+
+  return true;
+}
+
+bool ON_SolveBandedSymmetricSystem(
+          int n,
+          int bandwidth,
+          double* band,
+          int pt_dim,
+          int pt_stride,
+          double* pt
+          )
+{
+  if ( n < 1 || bandwidth < 0 || 0 == band 
+       || pt_dim < 1 || pt_stride < pt_dim || 0 == pt )
+    return false;
+
+  // A[i][j] = Ai[j-i], where Ai = band + i*w + bandwidth
+  const int w = bandwidth + 1;
+  double *Ai, *Aj, *Pi, *Pk, x;
+  int i, j, k, k0, d;
+
+  // Cholesky factor, a row at a time
+  for ( i = 0; i < n; i++ )
+  {
+    Ai = band + ((size_t)i)*w + bandwidth;
+    k0 = (i > bandwidth) ? i - bandwidth : 0;
+    for ( j = k0; j <= i; j++ )
+    {
+      Aj = band + ((size_t)j)*w + bandwidth;
+      x = Ai[j-i];
+      for ( k = k0; k < j; k++ )
+        x -= Ai[k-i]*Aj[k-j];
+      if ( j < i )
+        Ai[j-i] = x/Aj[0];
+      else
+      {
+        if ( !(x > 0.0) )
+          return false;
+        Ai[0] = sqrt(x);
+      }
+    }
+  }
+
+  // solve L*Y = B
+  for ( i = 0; i < n; i++ )
+  {
+    Ai = band + ((size_t)i)*w + bandwidth;
+    Pi = pt + ((size_t)i)*pt_stride;
+    k0 = (i > bandwidth) ? i - bandwidth : 0;
+    for ( k = k0; k < i; k++ )
+    {
+      x = Ai[k-i];
+      if ( 0.0 != x )
+      {
+        Pk = pt + ((size_t)k)*pt_stride;
+        for ( d = 0; d < pt_dim; d++ )
+          Pi[d] -= x*Pk[d];
+      }
+    }
+    x = 1.0/Ai[0];
+    for ( d = 0; d < pt_dim; d++ )
+      Pi[d] *= x;
+  }
+
+  // solve Transpose(L)*X = Y a row of L at a time
+  for ( i = n-1; i >= 0; i-- )
+  {
+    Ai = band + ((size_t)i)*w + bandwidth;
+    Pi = pt + ((size_t)i)*pt_stride;
+    x = 1.0/Ai[0];
+    for ( d = 0; d < pt_dim; d++ )
+      Pi[d] *= x;
+    k0 = (i > bandwidth) ? i - bandwidth : 0;
+    for ( k = k0; k < i; k++ )
+    {
+      x = Ai[k-i];
+      if ( 0.0 != x )
+      {
+        Pk = pt + ((size_t)k)*pt_stride;
+        for ( d = 0; d < pt_dim; d++ )
+          Pk[d] -= x*Pi[d];
+      }
+    }
+  }
+
+  return true;
+}
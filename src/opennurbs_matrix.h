@@ -367,6 +367,91 @@ public:
     double*       // Xpt
       ) const;
 
+  /*
+  Description:
+    Factor a square matrix as P*M = L*U using partial pivoting.
+    The elimination is done in blocks of columns so the work 
+    stays in cache for large matrices.
+  Parameters:
+    zero_tolerance - [in] (>=0.0) 
+      If the absolute value of a pivot is <= zero_tolerance,
+      then the matrix is treated as singular.
+    row_pivots - [out] 
+      An array of RowCount() ints. Row k was swapped with 
+      row row_pivots[k] >= k at step k of the elimination.
+  Returns:
+    True if the matrix is square and not singular.
+  Remarks:
+    The matrix is replaced by L and U. L has a unit diagonal
+    and is below the diagonal. U is on and above the diagonal.
+    Rows are swapped by swapping row pointers, so m[i] is 
+    row i of the factored matrix.
+  See Also:
+    ON_Matrix::LUSolve
+  */
+  bool LUFactor(
+    double zero_tolerance,
+    int* row_pivots
+    );
+
+  /*
+  Description:
+    Solve M*X=B after LUFactor() has factored M.
+  Parameters:
+    row_pivots - [in] row pivots from LUFactor()
+    pt_dim - [in] dimension of the points in B
+    pt_stride - [in] (>=pt_dim) stride between points in B
+    pt - [in/out] 
+      Input is the RowCount() points in B. Output is the 
+      solution X.
+  Returns:
+    True if successful.
+  See Also:
+    ON_Matrix::LUFactor
+  */
+  bool LUSolve(
+    const int* row_pivots,
+    int pt_dim,
+    int pt_stride,
+    double* pt
+    ) const;
+
+  /*
+  Description:
+    Factor a symmetric positive definite matrix as 
+    M = L*Transpose(L). The factorization is done in blocks
+    so the work stays in cache for large matrices.
+  Returns:
+    True if the matrix is square and positive definite.
+  Remarks:
+    Only the values on and below the diagonal are used and
+    they are replaced by L. The values above the diagonal 
+    are not changed.
+  See Also:
+    ON_Matrix::CholeskySolve
+  */
+  bool CholeskyFactor();
+
+  /*
+  Description:
+    Solve M*X=B after CholeskyFactor() has factored M.
+  Parameters:
+    pt_dim - [in] dimension of the points in B
+    pt_stride - [in] (>=pt_dim) stride between points in B
+    pt - [in/out] 
+      Input is the RowCount() points in B. Output is the 
+      solution X.
+  Returns:
+    True if successful.
+  See Also:
+    ON_Matrix::CholeskyFactor
+  */
+  bool CholeskySolve(
+    int pt_dim,
+    int pt_stride,
+    double* pt
+    ) const;
+
   bool IsRowOrthoganal() const;
   bool IsRowOrthoNormal() const;
 
@@ -603,4 +688,77 @@ int ON_RowReduce(
           double pivots[2] 
           );
 
+/*
+Description:
+  Solve A*X = B when A is a banded matrix. Gaussian elimination
+  without pivoting is used, which is stable for diagonally 
+  dominant matrices and for B-spline collocation matrices.
+  The work is O(n*lower_bandwidth*upper_bandwidth).
+Parameters:
+  n - [in] number of rows and columns in A
+  lower_bandwidth - [in] (>=0) number of diagonals below the
+    main diagonal that may have non-zero values.
+  upper_bandwidth - [in] (>=0) number of diagonals above the
+    main diagonal that may have non-zero values.
+  band - [in/out]
+    Array of n*(lower_bandwidth+1+upper_bandwidth) doubles. 
+    If -lower_bandwidth <= j-i <= upper_bandwidth, then A[i][j] is 
+      band[i*(lower_bandwidth+1+upper_bandwidth) + j-i+lower_bandwidth].
+    Values that are outside of A are ignored. The band is 
+    replaced by its LU factors.
+  pt_dim - [in] dimension of the points in B
+  pt_stride - [in] (>=pt_dim) stride between points in B
+  pt - [in/out]
+    Input is the n points in B. Output is the solution X.
+Returns:
+  True if successful. False if a zero pivot was found.
+See Also:
+  ON_SolveBandedSymmetricSystem
+*/
+ON_DECL
+bool ON_SolveBandedSystem(
+          int n,
+          int lower_bandwidth,
+          int upper_bandwidth,
+          double* band,
+          int pt_dim,
+          int pt_stride,
+          double* pt
+          );
+
+/*
+Description:
+  Solve A*X = B when A is a banded symmetric positive definite
+  matrix, like the normal equations of a B-spline least squares
+  fit. A banded Cholesky factorization is used. The work is
+  O(n*bandwidth*bandwidth).
+Parameters:
+  n - [in] number of rows and columns in A
+  bandwidth - [in] (>=0) number of diagonals below the main
+    diagonal that may have non-zero values.
+  band - [in/out]
+    Array of n*(bandwidth+1) doubles holding the lower half of A.
+    If i-bandwidth <= j <= i, then A[i][j] is 
+      band[i*(bandwidth+1) + j-i+bandwidth].
+    Values that are outside of A are ignored. The band is 
+    replaced by its Cholesky factor.
+  pt_dim - [in] dimension of the points in B
+  pt_stride - [in] (>=pt_dim) stride between points in B
+  pt - [in/out]
+    Input is the n points in B. Output is the solution X.
+Returns:
+  True if successful. False if A is not positive definite.
+See Also:
+  ON_SolveBandedSystem
+*/
+ON_DECL
+bool ON_SolveBandedSymmetricSystem(
+          int n,
+          int bandwidth,
+          double* band,
+          int pt_dim,
+          int pt_stride,
+          double* pt
+          );
+
 #endif
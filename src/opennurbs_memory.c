@@ -44,39 +44,37 @@
 #endif
 
 
-void* onmalloc( size_t sz )
-{
-  return (sz > 0) ? malloc(sz) : 0;
-}
+/*
+/////////////////////////////////////////////////////////////
+//
+// Allocator table
+//
+// Every block of memory the on*() functions get from the heap,
+// including the chunks of memory pools, comes from g_allocator.
+// The default table uses the C runtime.  ON_SetMemoryAllocator() 
+// can replace it before the first allocation.
+//
+*/
 
-void* oncalloc( size_t num, size_t sz )
+static void* ON_SystemMalloc( void* context, size_t sz )
 {
-  return (num > 0 && sz > 0) ? calloc(num,sz) : 0;
+  (void)context;
+  return malloc(sz);
 }
 
-void onfree( void* memblock )
+static void* ON_SystemCalloc( void* context, size_t num, size_t sz )
 {
-  if ( memblock )
-    free( memblock );
+  (void)context;
+  return calloc(num,sz);
 }
 
-void* onrealloc( void* memblock, size_t sz )
+static void* ON_SystemRealloc( void* context, void* memblock, size_t sz )
 {
-  if ( 0 == memblock )
-  {
-    return onmalloc(sz);
-  }
-
-  if ( 0 == sz )
-  {
-    onfree(memblock);
-    return 0;
-  }
-
 #if defined(ON_REALLOC_BROKEN)
   /* use malloc() and memcpy() instead of buggy realloc() */
   void* p;
   const size_t memblocksz = _msize(memblock);
+  (void)context;
   if ( sz <= memblocksz ) {
     /* shrink */
     if ( memblocksz <= 28 || 8*sz >= 7*memblocksz ) 
@@ -94,7 +92,7 @@ void* onrealloc( void* memblock, size_t sz )
       }
     }
   }
-  else if ( sz > memblocksz ) {
+  else {
     /* grow */
     p = malloc(sz);
     if ( p ) {
@@ -104,22 +102,609 @@ void* onrealloc( void* memblock, size_t sz )
   }
   return p;
 #else
+  (void)context;
   return realloc( memblock, sz );
 #endif
 }
 
-size_t onmsize( const void* memblock )
+static void ON_SystemFree( void* context, void* memblock )
 {
-  size_t sz =
+  (void)context;
+  free(memblock);
+}
+
+static size_t ON_SystemMsize( void* context, const void* memblock )
+{
+  (void)context;
 #if defined(ON_OS_WINDOWS)
-  (0 != memblock) ? _msize((void*)memblock) : 0
+  return _msize((void*)memblock);
 #else
   // OS doesn't support _msize().
-  0
+  (void)memblock;
+  return 0;
 #endif
-  ;
-  
-  return sz;
+}
+
+static ON_MEMORY_ALLOCATOR g_allocator =
+{
+  ON_SystemMalloc,
+  ON_SystemCalloc,
+  ON_SystemRealloc,
+  ON_SystemFree,
+  ON_SystemMsize,
+  0
+};
+
+/* set when the first block is allocated from g_allocator */
+static int g_allocator_used = 0;
+
+/*
+Once g_allocator_used is set it is only read, so threads that
+allocate at the same time do not write the same cache line.
+*/
+#define ON_SET_ALLOCATOR_USED() if ( !g_allocator_used ) ON_ATOMIC_COMPARE_AND_SWAP(&g_allocator_used,0,1)
+
+int ON_SetMemoryAllocator( const ON_MEMORY_ALLOCATOR* allocator )
+{
+  if ( g_allocator_used )
+    return 0;
+  if ( 0 == allocator )
+  {
+    g_allocator.m_malloc = ON_SystemMalloc;
+    g_allocator.m_calloc = ON_SystemCalloc;
+    g_allocator.m_realloc = ON_SystemRealloc;
+    g_allocator.m_free = ON_SystemFree;
+    g_allocator.m_msize = ON_SystemMsize;
+    g_allocator.m_context = 0;
+    return 1;
+  }
+  if ( 0 == allocator->m_malloc || 0 == allocator->m_realloc || 0 == allocator->m_free )
+    return 0;
+  g_allocator = *allocator;
+  return 1;
+}
+
+void ON_GetMemoryAllocator( ON_MEMORY_ALLOCATOR* allocator )
+{
+  if ( allocator )
+    *allocator = g_allocator;
+}
+
+/*
+/////////////////////////////////////////////////////////////
+//
+// Statistics
+//
+// When statistics are enabled, every heap block gets a header
+// that stores its size and the subsystem that allocated it,
+// so onfree() and onrealloc() can charge the right subsystem.
+// Pool chunks are charged to ON_MEMORY_SUBSYSTEM_POOL.  The 
+// last element of g_stats[] holds the totals.
+//
+*/
+
+#define ON_HEAP_HEADER_SIZE 16
+
+/*
+Requests larger than this fail.  The limit is far more than any
+machine has and leaves room for the rounding, headers and the
+4*n test in ON_PoolMalloc() without overflowing a size_t.
+*/
+#define ON_MAX_ALLOCATION_SIZE (((size_t)-1)/8)
+
+/*
+Pool blocks have a header with the same layout and m_tag set
+to ON_POOL_TAG.  Heap blocks have a header when statistics or 
+pools are enabled, so onfree() can tell the two apart by 
+looking at the header.
+*/
+struct ON_HEAP_HEADER
+{
+  size_t m_size;
+  int m_subsystem;
+  int m_tag;  /* 0 */
+};
+
+static int g_stats_enabled = 0;
+static int g_pools_enabled = 0;
+static int g_stats_lock = 0;
+static ON_MEMORY_STATISTICS g_stats[ON_MEMORY_SUBSYSTEM_COUNT+1];
+static ON_THREAD_LOCAL int g_current_subsystem = ON_MEMORY_SUBSYSTEM_OTHER;
+
+static void ON_StatsLock(void)
+{
+  while ( 0 != ON_ATOMIC_COMPARE_AND_SWAP(&g_stats_lock,0,1) )
+  {
+    /* spin - the lock is only held to update a few counters */
+  }
+}
+
+static void ON_StatsUnlock(void)
+{
+  ON_ATOMIC_COMPARE_AND_SWAP(&g_stats_lock,1,0);
+}
+
+static void ON_StatsUpdateHelper( ON_MEMORY_STATISTICS* s, int call, size_t sz0, size_t sz1 )
+{
+  /* call: 0 = malloc, 1 = realloc, 2 = free */
+  switch(call)
+  {
+  case 0: s->m_malloc_count++; break;
+  case 1: s->m_realloc_count++; break;
+  case 2: s->m_free_count++; break;
+  }
+  if ( sz1 > sz0 )
+    s->m_bytes_allocated += (sz1 - sz0);
+  s->m_bytes_in_use = s->m_bytes_in_use + sz1 - sz0;
+  if ( s->m_bytes_in_use > s->m_peak_bytes_in_use )
+    s->m_peak_bytes_in_use = s->m_bytes_in_use;
+}
+
+static void ON_StatsUpdate( int subsystem, int call, size_t sz0, size_t sz1 )
+{
+  ON_StatsLock();
+  ON_StatsUpdateHelper( &g_stats[subsystem], call, sz0, sz1 );
+  ON_StatsUpdateHelper( &g_stats[ON_MEMORY_SUBSYSTEM_COUNT], call, sz0, sz1 );
+  ON_StatsUnlock();
+}
+
+int ON_EnableMemoryStatistics(void)
+{
+  if ( !g_stats_enabled )
+  {
+    if ( g_allocator_used )
+      return 0;
+    memset(g_stats,0,sizeof(g_stats));
+    g_stats_enabled = 1;
+  }
+  return 1;
+}
+
+int ON_MemoryStatisticsEnabled(void)
+{
+  return g_stats_enabled;
+}
+
+int ON_SetMemorySubsystem( int subsystem )
+{
+  const int subsystem0 = g_current_subsystem;
+  if ( subsystem >= 0 && subsystem < ON_MEMORY_SUBSYSTEM_COUNT )
+    g_current_subsystem = subsystem;
+  return subsystem0;
+}
+
+int ON_GetMemoryStatistics( int subsystem, ON_MEMORY_STATISTICS* stats )
+{
+  if ( 0 == stats )
+    return 0;
+  memset(stats,0,sizeof(*stats));
+  if ( !g_stats_enabled )
+    return 0;
+  if ( -1 == subsystem )
+    subsystem = ON_MEMORY_SUBSYSTEM_COUNT;
+  else if ( subsystem < 0 || subsystem >= ON_MEMORY_SUBSYSTEM_COUNT )
+    return 0;
+  ON_StatsLock();
+  *stats = g_stats[subsystem];
+  ON_StatsUnlock();
+  return 1;
+}
+
+void ON_ResetMemoryStatistics(void)
+{
+  int i;
+  ON_StatsLock();
+  for ( i = 0; i <= ON_MEMORY_SUBSYSTEM_COUNT; i++ )
+  {
+    g_stats[i].m_malloc_count = 0;
+    g_stats[i].m_realloc_count = 0;
+    g_stats[i].m_free_count = 0;
+    g_stats[i].m_bytes_allocated = 0;
+    g_stats[i].m_peak_bytes_in_use = g_stats[i].m_bytes_in_use;
+  }
+  ON_StatsUnlock();
+}
+
+/*
+/////////////////////////////////////////////////////////////
+//
+// Heap blocks
+//
+*/
+
+static void* ON_HeapMalloc( size_t num, size_t sz, int bZero )
+{
+  struct ON_HEAP_HEADER* h;
+  char* p;
+  size_t n;
+
+  if ( 0 != sz && num > ON_MAX_ALLOCATION_SIZE/sz )
+    return 0; /* num*sz overflows */
+  n = num*sz;
+
+  ON_SET_ALLOCATOR_USED();
+  if ( !g_stats_enabled && !g_pools_enabled )
+  {
+    if ( !bZero )
+      return g_allocator.m_malloc( g_allocator.m_context, n );
+    if ( g_allocator.m_calloc )
+      return g_allocator.m_calloc( g_allocator.m_context, num, sz );
+    p = (char*)g_allocator.m_malloc( g_allocator.m_context, n );
+    if ( p )
+      memset(p,0,n);
+    return p;
+  }
+
+  p = (char*)g_allocator.m_malloc( g_allocator.m_context, ON_HEAP_HEADER_SIZE + n );
+  if ( 0 == p )
+    return 0;
+  if ( bZero )
+    memset( p + ON_HEAP_HEADER_SIZE, 0, n );
+  h = (struct ON_HEAP_HEADER*)p;
+  h->m_size = n;
+  h->m_subsystem = g_current_subsystem;
+  h->m_tag = 0;
+  if ( g_stats_enabled )
+    ON_StatsUpdate( h->m_subsystem, 0, 0, n );
+  return p + ON_HEAP_HEADER_SIZE;
+}
+
+static void ON_HeapFree( void* memblock )
+{
+  struct ON_HEAP_HEADER* h;
+  if ( !g_stats_enabled && !g_pools_enabled )
+  {
+    g_allocator.m_free( g_allocator.m_context, memblock );
+    return;
+  }
+  h = (struct ON_HEAP_HEADER*)(((char*)memblock) - ON_HEAP_HEADER_SIZE);
+  if ( g_stats_enabled )
+    ON_StatsUpdate( h->m_subsystem, 2, h->m_size, 0 );
+  g_allocator.m_free( g_allocator.m_context, h );
+}
+
+static void* ON_HeapRealloc( void* memblock, size_t sz )
+{
+  struct ON_HEAP_HEADER* h;
+  size_t sz0;
+  if ( !g_stats_enabled && !g_pools_enabled )
+    return g_allocator.m_realloc( g_allocator.m_context, memblock, sz );
+  if ( sz > ON_MAX_ALLOCATION_SIZE )
+    return 0;
+  h = (struct ON_HEAP_HEADER*)(((char*)memblock) - ON_HEAP_HEADER_SIZE);
+  sz0 = h->m_size;
+  h = (struct ON_HEAP_HEADER*)g_allocator.m_realloc( g_allocator.m_context, h, ON_HEAP_HEADER_SIZE + sz );
+  if ( 0 == h )
+    return 0;
+  h->m_size = sz;
+  if ( g_stats_enabled )
+    ON_StatsUpdate( h->m_subsystem, 1, sz0, sz );
+  return ((char*)h) + ON_HEAP_HEADER_SIZE;
+}
+
+static size_t ON_HeapMsize( const void* memblock )
+{
+  if ( g_stats_enabled || g_pools_enabled )
+    return ((const struct ON_HEAP_HEADER*)(((const char*)memblock) - ON_HEAP_HEADER_SIZE))->m_size;
+  return g_allocator.m_msize ? g_allocator.m_msize( g_allocator.m_context, memblock ) : 0;
+}
+
+/*
+/////////////////////////////////////////////////////////////
+//
+// Memory pools
+//
+// A pool hands out memory from large chunks.  Every block has
+// a header with ON_POOL_TAG and the offset of the block in its 
+// chunk, so onfree(), onrealloc() and onmsize() recognize pool
+// blocks without a lookup or a lock.  A chunk has a reference 
+// count: one for each block in use plus one for the pool.
+// onfree() of a pool block only decrements the count, unless
+// the block is the most recent allocation from the calling 
+// thread's current pool, in which case the memory is reused.
+// ON_DestroyMemoryPool() releases the pool's references.  
+// Chunks that nothing else uses are freed at once and chunks
+// with blocks that are still in use are freed when their last
+// block is freed.
+//
+*/
+
+#define ON_POOL_TAG 0x4C4F4F50
+#define ON_POOL_CHUNK_HEADER_SIZE 32
+#define ON_POOL_DEFAULT_CHUNK_SIZE 1048576
+#define ON_POOL_MAX_CHUNK_SIZE 1073741824
+
+struct ON_POOL_HEADER
+{
+  size_t m_size;
+  unsigned int m_chunk_offset; /* block header - chunk */
+  int m_tag; /* ON_POOL_TAG */
+};
+
+struct ON_MEMORY_POOL_CHUNK
+{
+  struct ON_MEMORY_POOL_CHUNK* m_next;
+  size_t m_size;
+  int m_ref_count;
+};
+
+struct tagON_MEMORY_POOL
+{
+  size_t m_chunk_size;
+  size_t m_size;  /* number of bytes in the chunks */
+  struct ON_MEMORY_POOL_CHUNK* m_chunk_list;
+  struct ON_MEMORY_POOL_CHUNK* m_chunk; /* current chunk */
+  char* m_next;   /* next free byte in the current chunk */
+  char* m_end;    /* end of the current chunk */
+  char* m_last;   /* header of the most recent block in the current chunk */
+};
+
+static ON_THREAD_LOCAL ON_MEMORY_POOL* g_current_pool = 0;
+
+static struct ON_POOL_HEADER* ON_PoolHeader( const void* p )
+{
+  /* returns the pool header of p or NULL if p is a heap block */
+  struct ON_POOL_HEADER* h;
+  if ( !g_pools_enabled )
+    return 0;
+  h = (struct ON_POOL_HEADER*)(((char*)p) - ON_HEAP_HEADER_SIZE);
+  return ( ON_POOL_TAG == h->m_tag ) ? h : 0;
+}
+
+static void ON_PoolReleaseChunk( struct ON_MEMORY_POOL_CHUNK* c )
+{
+  if ( 0 == ON_ATOMIC_DECREMENT(&c->m_ref_count) )
+  {
+    if ( g_stats_enabled )
+      ON_StatsUpdate( ON_MEMORY_SUBSYSTEM_POOL, 2, c->m_size, 0 );
+    g_allocator.m_free(g_allocator.m_context,c);
+  }
+}
+
+static struct ON_MEMORY_POOL_CHUNK* ON_PoolNewChunk( ON_MEMORY_POOL* pool, size_t sz )
+{
+  struct ON_MEMORY_POOL_CHUNK* c;
+
+  ON_SET_ALLOCATOR_USED();
+  c = (struct ON_MEMORY_POOL_CHUNK*)g_allocator.m_malloc(g_allocator.m_context,sz);
+  if ( 0 == c )
+    return 0;
+  c->m_next = pool->m_chunk_list;
+  c->m_size = sz;
+  c->m_ref_count = 1; /* the pool's reference */
+  pool->m_chunk_list = c;
+  pool->m_size += sz;
+  if ( g_stats_enabled )
+    ON_StatsUpdate( ON_MEMORY_SUBSYSTEM_POOL, 0, 0, sz );
+  return c;
+}
+
+static void* ON_PoolMalloc( ON_MEMORY_POOL* pool, size_t sz )
+{
+  const size_t n = ON_HEAP_HEADER_SIZE + ((sz + 15) & ~((size_t)15));
+  struct ON_MEMORY_POOL_CHUNK* c;
+  struct ON_POOL_HEADER* h;
+
+  if ( sz > ON_MAX_ALLOCATION_SIZE )
+    return 0;
+  if ( n > (size_t)(pool->m_end - pool->m_next) )
+  {
+    if ( 4*n > pool->m_chunk_size )
+    {
+      /* large blocks get their own chunk */
+      c = ON_PoolNewChunk(pool,ON_POOL_CHUNK_HEADER_SIZE + n);
+      if ( 0 == c )
+        return 0;
+      ON_ATOMIC_INCREMENT(&c->m_ref_count);
+      h = (struct ON_POOL_HEADER*)(((char*)c) + ON_POOL_CHUNK_HEADER_SIZE);
+      h->m_size = sz;
+      h->m_chunk_offset = ON_POOL_CHUNK_HEADER_SIZE;
+      h->m_tag = ON_POOL_TAG;
+      return ((char*)h) + ON_HEAP_HEADER_SIZE;
+    }
+    c = ON_PoolNewChunk(pool,pool->m_chunk_size);
+    if ( 0 == c )
+      return 0;
+    pool->m_chunk = c;
+    pool->m_next = ((char*)c) + ON_POOL_CHUNK_HEADER_SIZE;
+    pool->m_end = ((char*)c) + pool->m_chunk_size;
+    pool->m_last = 0;
+  }
+
+  c = pool->m_chunk;
+  ON_ATOMIC_INCREMENT(&c->m_ref_count);
+  h = (struct ON_POOL_HEADER*)pool->m_next;
+  h->m_size = sz;
+  h->m_chunk_offset = (unsigned int)(pool->m_next - (char*)c);
+  h->m_tag = ON_POOL_TAG;
+  pool->m_last = pool->m_next;
+  pool->m_next += n;
+  return ((char*)h) + ON_HEAP_HEADER_SIZE;
+}
+
+static void ON_PoolFree( struct ON_POOL_HEADER* h )
+{
+  ON_MEMORY_POOL* pool = g_current_pool;
+  struct ON_MEMORY_POOL_CHUNK* c = (struct ON_MEMORY_POOL_CHUNK*)(((char*)h) - h->m_chunk_offset);
+  if ( pool && pool->m_last == (char*)h )
+  {
+    /* reuse the most recent block in the calling thread's pool */
+    pool->m_next = pool->m_last;
+    pool->m_last = 0;
+  }
+  h->m_tag = 0;
+  ON_PoolReleaseChunk(c);
+}
+
+int ON_EnableMemoryPools(void)
+{
+  if ( !g_pools_enabled )
+  {
+    if ( g_allocator_used )
+      return 0;
+    g_pools_enabled = 1;
+  }
+  return 1;
+}
+
+int ON_MemoryPoolsEnabled(void)
+{
+  return g_pools_enabled;
+}
+
+ON_MEMORY_POOL* ON_CreateMemoryPool( size_t chunk_size )
+{
+  ON_MEMORY_POOL* pool;
+  if ( !g_pools_enabled )
+    return 0;
+  /* The pool is allocated from the heap so it is not in another pool. */
+  pool = (ON_MEMORY_POOL*)calloc(1,sizeof(*pool));
+  if ( pool )
+  {
+    if ( chunk_size < 4096 )
+      chunk_size = ON_POOL_DEFAULT_CHUNK_SIZE;
+    else if ( chunk_size > ON_POOL_MAX_CHUNK_SIZE )
+      chunk_size = ON_POOL_MAX_CHUNK_SIZE;
+    pool->m_chunk_size = chunk_size;
+  }
+  return pool;
+}
+
+void ON_DestroyMemoryPool( ON_MEMORY_POOL* pool )
+{
+  struct ON_MEMORY_POOL_CHUNK* c;
+  struct ON_MEMORY_POOL_CHUNK* next;
+  if ( 0 == pool )
+    return;
+  if ( g_current_pool == pool )
+    g_current_pool = 0;
+  for ( c = pool->m_chunk_list; c; c = next )
+  {
+    next = c->m_next;
+    ON_PoolReleaseChunk(c);
+  }
+  free(pool);
+}
+
+ON_MEMORY_POOL* ON_SetCurrentMemoryPool( ON_MEMORY_POOL* pool )
+{
+  ON_MEMORY_POOL* pool0 = g_current_pool;
+  g_current_pool = pool;
+  return pool0;
+}
+
+ON_MEMORY_POOL* ON_CurrentMemoryPool(void)
+{
+  return g_current_pool;
+}
+
+size_t ON_MemoryPoolSize( const ON_MEMORY_POOL* pool )
+{
+  return pool ? pool->m_size : 0;
+}
+
+void* onmalloc_from_pool( ON_MEMORY_POOL* pool, size_t sz )
+{
+  if ( 0 == sz )
+    return 0;
+  return (0 != pool) ? ON_PoolMalloc(pool,sz) : ON_HeapMalloc(1,sz,0);
+}
+
+void* oncalloc_from_pool( ON_MEMORY_POOL* pool, size_t num, size_t sz )
+{
+  void* p;
+  if ( 0 == num || 0 == sz )
+    return 0;
+  if ( num > ON_MAX_ALLOCATION_SIZE/sz )
+    return 0; /* num*sz overflows */
+  if ( 0 == pool )
+    return ON_HeapMalloc(num,sz,1);
+  p = ON_PoolMalloc(pool,num*sz);
+  if ( p )
+    memset(p,0,num*sz);
+  return p;
+}
+
+void* onmalloc( size_t sz )
+{
+  return onmalloc_from_pool( g_current_pool, sz );
+}
+
+void* oncalloc( size_t num, size_t sz )
+{
+  return oncalloc_from_pool( g_current_pool, num, sz );
+}
+
+void onfree( void* memblock )
+{
+  struct ON_POOL_HEADER* h;
+  if ( memblock )
+  {
+    if ( 0 != (h = ON_PoolHeader(memblock)) )
+      ON_PoolFree(h);
+    else
+      ON_HeapFree( memblock );
+  }
+}
+
+void* onrealloc( void* memblock, size_t sz )
+{
+  ON_MEMORY_POOL* pool;
+  struct ON_POOL_HEADER* h;
+  size_t sz0, n;
+  void* p;
+
+  if ( 0 == memblock )
+  {
+    return onmalloc(sz);
+  }
+
+  if ( 0 == sz )
+  {
+    onfree(memblock);
+    return 0;
+  }
+
+  if ( sz > ON_MAX_ALLOCATION_SIZE )
+    return 0;
+
+  if ( 0 != (h = ON_PoolHeader(memblock)) )
+  {
+    sz0 = h->m_size;
+    n = ON_HEAP_HEADER_SIZE + ((sz + 15) & ~((size_t)15));
+    pool = g_current_pool;
+    if (    pool
+         && pool->m_last == (char*)h
+         && n <= (size_t)(pool->m_end - pool->m_last)
+       )
+    {
+      /* grow or shrink the most recent block in place */
+      h->m_size = sz;
+      pool->m_next = pool->m_last + n;
+      return memblock;
+    }
+    if ( sz <= sz0 )
+      return memblock;
+    p = onmalloc(sz);
+    if ( p )
+    {
+      memcpy( p, memblock, sz0 );
+      onfree(memblock);
+    }
+    return p;
+  }
+
+  return ON_HeapRealloc( memblock, sz );
+}
+
+size_t onmsize( const void* memblock )
+{
+  const struct ON_POOL_HEADER* h;
+  if ( 0 == memblock )
+    return 0;
+  if ( 0 != (h = ON_PoolHeader(memblock)) )
+    return h->m_size;
+  return ON_HeapMsize(memblock);
 }
 
 void ON_MemoryManagerBegin(void)
@@ -130,4 +715,3 @@ void ON_MemoryManagerBegin(void)
 void ON_MemoryManagerEnd(void)
 {
 }
-
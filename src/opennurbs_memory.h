@@ -42,7 +42,7 @@ void ON_MemoryManagerEnd(void);
 // and onfree() are defined in opennurbs_memory_new.cpp.
 //
 // You may OPTIONALLY provide your own memory managment functions.  See
-// opennurbs_memory.c for details.
+// ON_SetMemoryAllocator() for details.
 //
 /////////////////////////////////////////////////////////////////////////////
 //
@@ -155,13 +155,14 @@ void ON_MemoryManagerEnd(void);
 //        If ON_memory_error_handler() returns 1, the query is
 //        attempted again;
 //
-// These functions allow you to direct a memory request to a specific pool.  If
-// you have not implemented custom memory pool management, these behave exactly
-// like onmalloc(), oncalloc(), and onfree().
+// These functions allow you to direct a memory request to a specific pool.
+// If the pool is NULL, the memory comes from the heap.
 // 
 //   void* onmalloc_from_pool( ON_MEMORY_POOL*, site_t sz );
 //   void* oncalloc_from_pool( ON_MEMORY_POOL*, size_t num, size_t sz );
-//   void* onrealloc_from_pool( ON_MEMORY_POOL*, void* p, size_t sz );
+//
+// Memory from a pool is freed with onfree() and resized with onrealloc()
+// like any other block.  See ON_CreateMemoryPool() for details.
 */
 
 /* ^^^ see comments above for details ^^^ */
@@ -230,6 +231,256 @@ wchar_t* onwcsdup( const wchar_t* );
 ON_DECL
 unsigned char* onmbsdup( const unsigned char* );
 
+/*
+/////////////////////////////////////////////////////////////
+//
+// Memory pools
+//
+*/
+
+typedef struct tagON_MEMORY_POOL ON_MEMORY_POOL;
+
+/*
+Description:
+  Turns on memory pools.
+Returns:
+  1 if pools are enabled.
+  0 if memory has already been allocated.
+Remarks:
+  Like ON_EnableMemoryStatistics(), this must be called at 
+  startup, before anything calls onmalloc().  Pools cannot be
+  turned off.  Each heap block has a 16 byte header so onfree()
+  can tell heap blocks from pool blocks without a lookup.
+*/
+ON_DECL
+int ON_EnableMemoryPools(void);
+
+/*
+Returns:
+  1 if ON_EnableMemoryPools() was successfully called.
+*/
+ON_DECL
+int ON_MemoryPoolsEnabled(void);
+
+/*
+Description:
+  Creates a memory pool.  A pool hands out memory from large
+  chunks, which is much faster than getting many small blocks
+  from the heap.
+Parameters:
+  chunk_size - [in] size of the chunks in bytes.  If 0, 
+     a default of 1MB is used.  Values above 1GB are 
+     reduced to 1GB.
+Returns:
+  A pool that must be destroyed with ON_DestroyMemoryPool() or
+  NULL if ON_EnableMemoryPools() has not been called.
+Remarks:
+  While a pool is the current pool of a thread, see
+  ON_SetCurrentMemoryPool(), onmalloc(), oncalloc() and 
+  onrealloc() calls made by that thread get memory from the pool.
+  onfree() of memory from a pool does not return it to the 
+  heap; a chunk goes back to the heap when the pool has been 
+  destroyed and every block in the chunk has been freed.  
+  A pool may be the current pool of one thread at a time.
+  ON_String and ON_wString buffers always come from the heap
+  because they are shared by reference counting.
+*/
+ON_DECL
+ON_MEMORY_POOL* ON_CreateMemoryPool( size_t chunk_size );
+
+/*
+Description:
+  Destroys a pool.  Chunks with no blocks in use are returned 
+  to the heap now.  Blocks that are still in use remain valid
+  and their chunk is returned to the heap when the last of 
+  them is freed with onfree().
+Parameters:
+  pool - [in]
+*/
+ON_DECL
+void ON_DestroyMemoryPool( ON_MEMORY_POOL* pool );
+
+/*
+Description:
+  Sets the pool that onmalloc(), oncalloc() and onrealloc() 
+  use in the calling thread.
+Parameters:
+  pool - [in] NULL means use the heap.
+Returns:
+  The previous current pool.  Restore it when you are done.
+Example:
+          ON_MEMORY_POOL* pool0 = ON_SetCurrentMemoryPool(pool);
+          ... 
+          ON_SetCurrentMemoryPool(pool0);
+*/
+ON_DECL
+ON_MEMORY_POOL* ON_SetCurrentMemoryPool( ON_MEMORY_POOL* pool );
+
+/*
+Returns:
+  The calling thread's current pool or NULL if memory
+  comes from the heap.
+*/
+ON_DECL
+ON_MEMORY_POOL* ON_CurrentMemoryPool(void);
+
+/*
+Returns:
+  Number of bytes the pool has allocated from the heap.
+*/
+ON_DECL
+size_t ON_MemoryPoolSize( const ON_MEMORY_POOL* pool );
+
+ON_DECL
+void* onmalloc_from_pool( ON_MEMORY_POOL*, size_t );
+
+ON_DECL
+void* oncalloc_from_pool( ON_MEMORY_POOL*, size_t, size_t );
+
+/*
+/////////////////////////////////////////////////////////////
+//
+// Custom allocators
+//
+*/
+
+/*
+Description:
+  Table of functions the on*() functions use to get memory
+  from the heap.  m_context is passed to every function.
+  m_malloc, m_realloc and m_free are required.  If m_calloc
+  is NULL, m_malloc and memset are used.  If m_msize is NULL,
+  onmsize() returns 0 for heap blocks.
+*/
+typedef struct tagON_MEMORY_ALLOCATOR
+{
+  void*  (*m_malloc)( void* context, size_t sz );
+  void*  (*m_calloc)( void* context, size_t num, size_t sz );
+  void*  (*m_realloc)( void* context, void* memblock, size_t sz );
+  void   (*m_free)( void* context, void* memblock );
+  size_t (*m_msize)( void* context, const void* memblock );
+  void* m_context;
+} ON_MEMORY_ALLOCATOR;
+
+/*
+Description:
+  Replaces the functions onmalloc(), oncalloc(), onrealloc(),
+  onfree() and memory pools use to get memory from the heap.
+  This lets an application plug in a thread caching allocator
+  or compare allocators without rebuilding openNURBS.
+Parameters:
+  allocator - [in] The table is copied.  NULL restores the 
+     C runtime malloc(), calloc(), realloc() and free().
+Returns:
+  1 if the allocator was set.
+  0 if a required function is NULL or memory has already
+  been allocated.
+Remarks:
+  Call ON_SetMemoryAllocator() at startup, before anything 
+  calls onmalloc().  Blocks must be freed by the allocator
+  that allocated them, so the allocator cannot be changed 
+  once it is in use.
+*/
+ON_DECL
+int ON_SetMemoryAllocator( const ON_MEMORY_ALLOCATOR* allocator );
+
+/*
+Parameters:
+  allocator - [out] current allocator table.
+*/
+ON_DECL
+void ON_GetMemoryAllocator( ON_MEMORY_ALLOCATOR* allocator );
+
+/*
+/////////////////////////////////////////////////////////////
+//
+// Memory statistics
+//
+*/
+
+/* Subsystems that allocations are charged to */
+#define ON_MEMORY_SUBSYSTEM_OTHER     0
+#define ON_MEMORY_SUBSYSTEM_ARCHIVE   1
+#define ON_MEMORY_SUBSYSTEM_MESH      2
+#define ON_MEMORY_SUBSYSTEM_BREP      3
+#define ON_MEMORY_SUBSYSTEM_STRING    4
+#define ON_MEMORY_SUBSYSTEM_WORKSPACE 5
+#define ON_MEMORY_SUBSYSTEM_POOL      6
+#define ON_MEMORY_SUBSYSTEM_COUNT     7
+
+typedef struct tagON_MEMORY_STATISTICS
+{
+  size_t m_malloc_count;      /* onmalloc() and oncalloc() calls */
+  size_t m_realloc_count;     /* onrealloc() calls */
+  size_t m_free_count;        /* onfree() calls */
+  size_t m_bytes_allocated;   /* total bytes allocated */
+  size_t m_bytes_in_use;      /* bytes currently allocated */
+  size_t m_peak_bytes_in_use; /* largest value of m_bytes_in_use */
+} ON_MEMORY_STATISTICS;
+
+/*
+Description:
+  Turns on the counting of heap allocations by subsystem.
+Returns:
+  1 if statistics are enabled.
+  0 if memory has already been allocated.
+Remarks:
+  Like ON_SetMemoryAllocator(), this must be called at startup,
+  before anything calls onmalloc().  Statistics cannot be
+  turned off.  Each heap block has a 16 byte header that 
+  records its size and subsystem.
+*/
+ON_DECL
+int ON_EnableMemoryStatistics(void);
+
+/*
+Returns:
+  1 if ON_EnableMemoryStatistics() was successfully called.
+*/
+ON_DECL
+int ON_MemoryStatisticsEnabled(void);
+
+/*
+Description:
+  Sets the subsystem that heap allocations made by the calling
+  thread are charged to.  Memory is charged to the subsystem
+  that allocated it when it is resized or freed.
+Parameters:
+  subsystem - [in] ON_MEMORY_SUBSYSTEM_* value.
+Returns:
+  The previous subsystem.  Restore it when you are done.
+Example:
+          const int ms0 = ON_SetMemorySubsystem(ON_MEMORY_SUBSYSTEM_MESH);
+          ... 
+          ON_SetMemorySubsystem(ms0);
+*/
+ON_DECL
+int ON_SetMemorySubsystem( int subsystem );
+
+/*
+Parameters:
+  subsystem - [in] ON_MEMORY_SUBSYSTEM_* value or -1 for 
+     the totals of all subsystems.
+  stats - [out]
+Returns:
+  1 if stats were returned.  0 if statistics are not 
+  enabled or subsystem is not valid.
+Remarks:
+  Memory pools are charged to ON_MEMORY_SUBSYSTEM_POOL
+  when they get chunks from the heap.  Blocks allocated from
+  a pool are not counted.
+*/
+ON_DECL
+int ON_GetMemoryStatistics( int subsystem, ON_MEMORY_STATISTICS* stats );
+
+/*
+Description:
+  Sets the counters and total bytes allocated to zero and 
+  the peak bytes in use to the current bytes in use.
+*/
+ON_DECL
+void ON_ResetMemoryStatistics(void);
+
 /* define to handle _TCHAR* ontcsdup( const _TCHAR* ) */
 #if defined(_UNICODE)
 #define ontcsdup onwcsdup
@@ -241,6 +492,35 @@ unsigned char* onmbsdup( const unsigned char* );
 
 #if defined (cplusplus) || defined(_cplusplus) || defined(__cplusplus)
 }
+
+/*
+Description:
+  Charges heap allocations made by the calling thread to a
+  subsystem until the scope ends.
+Example:
+          {
+            ON_MemorySubsystemScope ms(ON_MEMORY_SUBSYSTEM_MESH);
+            ...
+          }
+See Also:
+  ON_SetMemorySubsystem
+*/
+class ON_MemorySubsystemScope
+{
+public:
+  ON_MemorySubsystemScope( int subsystem ) 
+    : m_subsystem0(ON_SetMemorySubsystem(subsystem)) 
+  {}
+  ~ON_MemorySubsystemScope() 
+  {
+    ON_SetMemorySubsystem(m_subsystem0);
+  }
+private:
+  const int m_subsystem0;
+  // prohibit copy construction and operator=
+  ON_MemorySubsystemScope( const ON_MemorySubsystemScope& );
+  ON_MemorySubsystemScope& operator=( const ON_MemorySubsystemScope& );
+};
 #endif
 
 #endif
@@ -917,6 +917,7 @@ ON_Mesh::ON_Mesh()
 , m_mesh_is_oriented(0)
 , m_mesh_is_solid(0)
 , m_mtree(0)
+, m_lod(0)
 {
   m_top.m_mesh = this;
   m_srf_scale[0] = 0.0;
@@ -952,6 +953,7 @@ ON_Mesh::ON_Mesh(
 , m_mesh_is_oriented(0)
 , m_mesh_is_solid(0)
 , m_mtree(0)
+, m_lod(0)
 {
   m_top.m_mesh = this;
   m_srf_scale[0] = 0.0;
@@ -977,6 +979,7 @@ ON_Mesh::ON_Mesh( const ON_Mesh& src )
 , m_mesh_is_oriented(0)
 , m_mesh_is_solid(0)
 , m_mtree(0)
+, m_lod(0)
 {
   m_top.m_mesh = this;
   m_srf_scale[0] = 0.0;
@@ -1008,6 +1011,8 @@ unsigned int ON_Mesh::SizeOf() const
   sz += m_top.m_topv.SizeOfArray();
   sz += m_top.m_tope.SizeOfArray();
   sz += m_top.m_topf.SizeOfArray();
+  if ( m_lod )
+    sz += m_lod->SizeOf();
   return sz;
 }
 
@@ -1025,6 +1030,7 @@ ON_Mesh& ON_Mesh::operator=( const ON_Mesh& src )
 {
   if ( this != &src ) 
   {
+    ON_MemorySubsystemScope ms(ON_MEMORY_SUBSYSTEM_MESH);
     Destroy();
     ON_Geometry::operator=(src);
 
@@ -1087,6 +1093,9 @@ ON_Mesh& ON_Mesh::operator=( const ON_Mesh& src )
       }
     }
 
+    if ( src.m_lod )
+      m_lod = new ON_MeshLevelOfDetail(*src.m_lod);
+
     // do not copy m_mtree
     // do not copy m_top
   }
@@ -1109,6 +1118,7 @@ void ON_Mesh::Destroy()
 {
   PurgeUserData();
   DestroyRuntimeCache( true );
+  DestroyLevelsOfDetail();
   m_Ttag.Default();
   m_Ctag.Default();
   m_V.Destroy();
@@ -1125,6 +1135,7 @@ void ON_Mesh::Destroy()
 void ON_Mesh::EmergencyDestroy()
 {
   DestroyRuntimeCache( false );
+  m_lod = 0;
   m_V.EmergencyDestroy();
   m_F.EmergencyDestroy();
   m_N.EmergencyDestroy();
@@ -1300,6 +1311,14 @@ void ON_Mesh::Dump( ON_TextLog& dump ) const
   dump.Print("tex coords:       %s\n",HasTextureCoordinates()?"true":"false");
   dump.Print("vertex kappa:     %s\n",HasPrincipalCurvatures()?"true":"false");
   dump.Print("vertex colors:    %s\n",HasVertexColors()?"true":"false");
+  if ( m_lod )
+  {
+    dump.Print("levels of detail: %d\n",m_lod->LevelCount());
+    dump.PushIndent();
+    for ( i = 0; i < m_lod->LevelCount(); i++ )
+      dump.Print("level %d: facet count = %d error = %g\n",i,m_lod->FaceCount(i),m_lod->Error(i));
+    dump.PopIndent();
+  }
   dump.Print("m_Ctag:\n"); dump.PushIndent(); m_Ctag.Dump(dump); dump.PopIndent();
   dump.Print("m_packed_tex_rotate: %s\n",m_packed_tex_rotate?"true":"false");
   dump.Print("m_packed_tex_domain: (%g,%g)x(%g,%g)\n",
@@ -1762,7 +1781,7 @@ ON_BOOL32 ON_Mesh::Write( ON_BinaryArchive& file ) const
   //const int major_version = 1; // uncompressed
   //const int major_version = 2; // beta format (never used)
   const int major_version = 3; // compressed
-  bool rc = file.Write3dmChunkVersion(major_version,5);
+  bool rc = file.Write3dmChunkVersion(major_version,6);
 
   const int vcount = VertexCount();
   const int fcount = FaceCount();
@@ -1864,6 +1883,19 @@ ON_BOOL32 ON_Mesh::Write( ON_BinaryArchive& file ) const
   if (rc) rc = file.WriteChar( m_mesh_is_oriented );
   if (rc) rc = file.WriteChar( m_mesh_is_solid );
 
+  // added for minor version 3.6
+  b = ( m_lod && m_lod->LevelCount() > 0 ) ? 1 : 0;
+  if (rc) rc = file.WriteChar(b);
+  if (rc && b)
+  {
+    rc = file.BeginWrite3dmChunk( TCODE_ANONYMOUS_CHUNK, 0 );
+    if (rc)
+    {
+      rc = m_lod->Write(file);
+      if ( !file.EndWrite3dmChunk() )
+        rc = false;
+    }
+  }
 
   return rc;
 }
@@ -2023,8 +2055,106 @@ void GetSurfaceParametersHelper( const ON_Mesh& mesh,
 
 ON_BOOL32 ON_Mesh::Read( ON_BinaryArchive& file )
 {
+  return ReadHelper( file, false, -1 );
+}
+
+bool ON_Mesh::ReadLevelsOfDetail( ON_BinaryArchive& file, int max_level_count )
+{
+  bool rc = ReadHelper( file, true, max_level_count );
+  if ( rc && 0 == m_lod )
+  {
+    // Old file or a mesh without levels of detail.
+    // Use ON_Mesh::Read() to get the mesh.
+    rc = false;
+  }
+  return rc;
+}
+
+// Reads sz bytes without saving them.  The bytes are read instead
+// of skipped with a seek so they are added to the CRC of the 
+// current chunk.
+static bool ON_ReadThroughBytes( ON_BinaryArchive& file, size_t sz )
+{
+  unsigned char buffer[1024];
+  bool rc = true;
+  while ( rc && sz > 0 )
+  {
+    const size_t count = (sz < sizeof(buffer)) ? sz : sizeof(buffer);
+    rc = file.ReadByte(count,buffer);
+    sz -= count;
+  }
+  return rc;
+}
+
+// Reads data written by ON_BinaryArchive::WriteCompressedBuffer()
+// without uncompressing it.  Uncompressed data is part of the 
+// current chunk.  Compressed data is in an anonymous chunk that is
+// read up to its 32 bit CRC so EndRead3dmChunk() checks the CRC.
+static bool ON_SkipCompressedBuffer( ON_BinaryArchive& file )
+{
+  size_t sz = 0;
+  if ( !file.ReadCompressedBufferSize(&sz) )
+    return false;
+  if ( 0 == sz )
+    return true;
+
+  unsigned int buffer_crc = 0;
+  char method = 0;
+  if ( !file.ReadInt(&buffer_crc) )
+    return false;
+  if ( !file.ReadChar(&method) )
+    return false;
+
+  bool rc = false;
+  switch(method)
+  {
+  case 0: // uncompressed
+    rc = ON_ReadThroughBytes(file,sz);
+    break;
+
+  case 1: // compressed data is in an anonymous chunk
+    {
+      ON__UINT32 tcode = 0;
+      ON__INT64 big_value = 0;
+      rc = file.BeginRead3dmBigChunk(&tcode,&big_value);
+      if (rc)
+      {
+        // big_value is the length of the compressed data and the CRC
+        if ( TCODE_ANONYMOUS_CHUNK != tcode || big_value < 4 )
+          rc = false;
+        else
+          rc = ON_ReadThroughBytes(file,(size_t)(big_value-4));
+        if ( !file.EndRead3dmChunk() )
+          rc = false;
+      }
+    }
+    break;
+  }
+
+  return rc;
+}
+
+static bool ON_SkipFaceArray( int fcount, ON_BinaryArchive& file )
+{
+  // See ON_Mesh::ReadFaceArray()
+  int i_size = 0;
+  bool rc = file.ReadInt( &i_size );
+  if ( rc && 1 != i_size && 2 != i_size && 4 != i_size )
+    rc = false;
+  if ( rc && fcount > 0 )
+    rc = ON_ReadThroughBytes( file, ((size_t)fcount)*4*i_size );
+  return rc;
+}
+
+bool ON_Mesh::ReadHelper( ON_BinaryArchive& file, bool bSkipFullResolution, int max_level_count )
+{
+  // If bSkipFullResolution is true, the faces and vertex 
+  // arrays of major version 3 meshes are read through without
+  // being saved.  See ON_Mesh::ReadLevelsOfDetail().
   Destroy();
 
+  ON_MemorySubsystemScope ms(ON_MEMORY_SUBSYSTEM_MESH);
+
   int major_version = 0;
   int minor_version = 0;
   int i;
@@ -2111,12 +2241,25 @@ ON_BOOL32 ON_Mesh::Read( ON_BinaryArchive& file )
       }
     }
 
-    if (rc) rc = ReadFaceArray( vcount, fcount, file );
+    if ( 3 != major_version )
+      bSkipFullResolution = false;
+
+    if (rc) 
+    {
+      rc = bSkipFullResolution
+         ? ON_SkipFaceArray( fcount, file )
+         : ReadFaceArray( vcount, fcount, file );
+    }
 
     if (rc) {
       if ( major_version==1) {
         rc = Read_1(file);
       }
+      else if ( bSkipFullResolution ) {
+        // m_V[], m_N[], m_T[], m_K[] and m_C[] buffers
+        for ( i = 0; rc && vcount > 0 && i < 5; i++ )
+          rc = ON_SkipCompressedBuffer(file);
+      }
       else if ( major_version == 3 ) {
         rc = Read_2(vcount,file);
       }
@@ -2139,7 +2282,11 @@ ON_BOOL32 ON_Mesh::Read( ON_BinaryArchive& file )
         if (rc) rc = file.ReadUuid( m_Ttag.m_mapping_id );
 
         // compressed m_S[]
-        if ( rc && vcount > 0 ) 
+        if ( rc && vcount > 0 && bSkipFullResolution )
+        {
+          rc = ON_SkipCompressedBuffer(file);
+        }
+        else if ( rc && vcount > 0 ) 
         {
           size_t sz = 0;
           ON_BOOL32 bFailedCRC=false;
@@ -2191,6 +2338,33 @@ ON_BOOL32 ON_Mesh::Read( ON_BinaryArchive& file )
             if (rc) rc = file.ReadChar( &m_mesh_is_manifold );
             if (rc) rc = file.ReadChar( &m_mesh_is_oriented );
             if (rc) rc = file.ReadChar( &m_mesh_is_solid );
+            if ( minor_version >= 6 )
+            {
+              // levels of detail are in an anonymous chunk
+              b = 0;
+              if (rc) rc = file.ReadChar(&b);
+              if (rc && b)
+              {
+                tcode = 0;
+                big_value = 0;
+                rc = file.BeginRead3dmBigChunk( &tcode, &big_value );
+                if (rc)
+                {
+                  if ( TCODE_ANONYMOUS_CHUNK == tcode )
+                  {
+                    m_lod = new ON_MeshLevelOfDetail();
+                    rc = m_lod->Read( file, max_level_count );
+                    if ( 0 == m_lod->LevelCount() )
+                      DestroyLevelsOfDetail();
+                  }
+                  else
+                    rc = false;
+                  // Levels that were not read are skipped.
+                  if ( !file.EndRead3dmChunk(true) )
+                    rc = false;
+                }
+              }
+            }
           }
         }
       }
@@ -2229,6 +2403,229 @@ ON_BOOL32 ON_Mesh::Read( ON_BinaryArchive& file )
   return rc;
 }
 
+const ON_MeshLevelOfDetail* ON_Mesh::LevelsOfDetail() const
+{
+  return m_lod;
+}
+
+void ON_Mesh::DestroyLevelsOfDetail()
+{
+  if ( m_lod )
+  {
+    delete m_lod;
+    m_lod = 0;
+  }
+}
+
+ON_MeshLevelOfDetail::ON_MeshLevelOfDetail()
+{
+}
+
+ON_MeshLevelOfDetail::~ON_MeshLevelOfDetail()
+{
+  Destroy();
+}
+
+ON_MeshLevelOfDetail::ON_MeshLevelOfDetail( const ON_MeshLevelOfDetail& src )
+{
+  *this = src;
+}
+
+ON_MeshLevelOfDetail& ON_MeshLevelOfDetail::operator=( const ON_MeshLevelOfDetail& src )
+{
+  if ( this != &src )
+  {
+    Destroy();
+    const int level_count = src.m_mesh.Count();
+    m_mesh.Reserve(level_count);
+    for ( int i = 0; i < level_count; i++ )
+      m_mesh.Append( src.m_mesh[i] ? new ON_Mesh(*src.m_mesh[i]) : 0 );
+    m_face_count = src.m_face_count;
+    m_error = src.m_error;
+  }
+  return *this;
+}
+
+void ON_MeshLevelOfDetail::Destroy()
+{
+  for ( int i = 0; i < m_mesh.Count(); i++ )
+  {
+    if ( m_mesh[i] )
+      delete m_mesh[i];
+  }
+  m_mesh.Destroy();
+  m_face_count.Destroy();
+  m_error.Destroy();
+}
+
+void ON_MeshLevelOfDetail::AddCoarserLevel( ON_Mesh* mesh, double error )
+{
+  if ( 0 == mesh )
+    return;
+  m_mesh.Insert(0,mesh);
+  m_face_count.Insert(0,mesh->FaceCount());
+  m_error.Insert(0,error);
+}
+
+int ON_MeshLevelOfDetail::LevelCount() const
+{
+  return m_mesh.Count();
+}
+
+const ON_Mesh* ON_MeshLevelOfDetail::Mesh( int level ) const
+{
+  return ( level >= 0 && level < m_mesh.Count() ) ? m_mesh[level] : 0;
+}
+
+int ON_MeshLevelOfDetail::FaceCount( int level ) const
+{
+  return ( level >= 0 && level < m_face_count.Count() ) ? m_face_count[level] : 0;
+}
+
+double ON_MeshLevelOfDetail::Error( int level ) const
+{
+  return ( level >= 0 && level < m_error.Count() ) ? m_error[level] : ON_UNSET_VALUE;
+}
+
+int ON_MeshLevelOfDetail::LevelFromError( double max_error ) const
+{
+  // errors decrease from the coarsest level to the finest
+  for ( int i = 0; i < m_error.Count(); i++ )
+  {
+    if ( m_error[i] <= max_error )
+      return i;
+  }
+  return -1;
+}
+
+bool ON_MeshLevelOfDetail::Transform( const ON_Xform& xform )
+{
+  bool rc = true;
+  for ( int i = 0; i < m_mesh.Count(); i++ )
+  {
+    if ( m_mesh[i] && !m_mesh[i]->Transform(xform) )
+      rc = false;
+  }
+
+  // The errors are lengths.  Scale them by the average 
+  // scale factor of the transformation.
+  const double s = pow( fabs(xform.Determinant()), 1.0/3.0 );
+  if ( s > 0.0 && ON_IsValid(s) )
+  {
+    for ( int i = 0; i < m_error.Count(); i++ )
+      m_error[i] *= s;
+  }
+  return rc;
+}
+
+unsigned int ON_MeshLevelOfDetail::SizeOf() const
+{
+  unsigned int sz = sizeof(*this);
+  sz += m_mesh.SizeOfArray();
+  sz += m_face_count.SizeOfArray();
+  sz += m_error.SizeOfArray();
+  for ( int i = 0; i < m_mesh.Count(); i++ )
+  {
+    if ( m_mesh[i] )
+      sz += m_mesh[i]->SizeOf();
+  }
+  return sz;
+}
+
+bool ON_MeshLevelOfDetail::Write( ON_BinaryArchive& file ) const
+{
+  // Levels that were not read cannot be written.  The finer
+  // levels after them are not written either.
+  int level_count = 0;
+  while ( level_count < m_mesh.Count() && 0 != m_mesh[level_count] )
+    level_count++;
+
+  bool rc = file.Write3dmChunkVersion(1,0);
+  if (rc) rc = file.WriteInt( level_count );
+
+  // table of face counts and errors
+  int i;
+  for ( i = 0; rc && i < level_count; i++ )
+  {
+    rc = file.WriteInt( m_face_count[i] );
+    if (rc) rc = file.WriteDouble( m_error[i] );
+  }
+
+  // each level is in its own chunk, coarsest first
+  for ( i = 0; rc && i < level_count; i++ )
+  {
+    rc = file.BeginWrite3dmChunk( TCODE_ANONYMOUS_CHUNK, 0 );
+    if (rc)
+    {
+      rc = m_mesh[i]->Write(file) ? true : false;
+      if ( !file.EndWrite3dmChunk() )
+        rc = false;
+    }
+  }
+
+  return rc;
+}
+
+bool ON_MeshLevelOfDetail::Read( ON_BinaryArchive& file, int max_level_count )
+{
+  Destroy();
+
+  int major_version = 0;
+  int minor_version = 0;
+  bool rc = file.Read3dmChunkVersion(&major_version,&minor_version);
+  if ( rc && 1 == major_version )
+  {
+    int level_count = 0;
+    int i;
+    rc = file.ReadInt( &level_count );
+    if ( rc && level_count < 0 )
+      rc = false;
+    if (rc)
+    {
+      m_face_count.Reserve(level_count);
+      m_error.Reserve(level_count);
+      m_mesh.Reserve(level_count);
+    }
+    for ( i = 0; rc && i < level_count; i++ )
+    {
+      int face_count = 0;
+      double error = 0.0;
+      rc = file.ReadInt( &face_count );
+      if (rc) rc = file.ReadDouble( &error );
+      if (rc)
+      {
+        m_face_count.Append(face_count);
+        m_error.Append(error);
+        m_mesh.Append(0);
+      }
+    }
+
+    if ( max_level_count >= 0 && max_level_count < level_count )
+      level_count = max_level_count;
+
+    for ( i = 0; rc && i < level_count; i++ )
+    {
+      ON__UINT32 tcode = 0;
+      ON__INT64 big_value = 0;
+      rc = file.BeginRead3dmBigChunk( &tcode, &big_value );
+      if (rc)
+      {
+        if ( TCODE_ANONYMOUS_CHUNK == tcode )
+        {
+          m_mesh[i] = new ON_Mesh();
+          rc = m_mesh[i]->Read(file) ? true : false;
+        }
+        else
+          rc = false;
+        if ( !file.EndRead3dmChunk() )
+          rc = false;
+      }
+    }
+  }
+
+  return rc;
+}
+
 ON::object_type ON_Mesh::ObjectType() const
 {
   return ON::mesh_object;
@@ -2340,6 +2737,7 @@ ON_BOOL32 ON_Mesh::Transform(
   double d = xform.Determinant();
   const int vertex_count = VertexCount();
   bool rc = false;
+  ON_BoundingBox vbox;
   if ( bSyncheddV )
   {
     // transforming the double precision vertices is the 
@@ -2349,7 +2747,8 @@ ON_BOOL32 ON_Mesh::Transform(
   }
   else
   {
-    rc = ON_TransformPointList( 3, false, vertex_count, 3, &m_V[0][0], xform );
+    // the new vertex box comes for free while transforming
+    rc = ON_TransformPointList( 3, false, vertex_count, 3, &m_V[0][0], xform, vbox, false );
   }
 
   if ( rc )
@@ -2448,6 +2847,15 @@ ON_BOOL32 ON_Mesh::Transform(
   }
 
   InvalidateVertexBoundingBox();
+  if ( rc && vbox.IsValid() )
+  {
+    m_vbox[0][0] = (float)vbox.m_min.x;
+    m_vbox[0][1] = (float)vbox.m_min.y;
+    m_vbox[0][2] = (float)vbox.m_min.z;
+    m_vbox[1][0] = (float)vbox.m_max.x;
+    m_vbox[1][1] = (float)vbox.m_max.y;
+    m_vbox[1][2] = (float)vbox.m_max.z;
+  }
   InvalidateVertexNormalBoundingBox();
   if ( fabs(d) <= ON_ZERO_TOLERANCE )
     DestroyTopology(); // transform may not be one-to-one on vertices
@@ -2457,6 +2865,9 @@ ON_BOOL32 ON_Mesh::Transform(
   if ( bIsValid_dV )
     SetDoublePrecisionVerticesAsValid();
 
+  if ( rc && m_lod )
+    rc = m_lod->Transform(xform);
+
   return rc;
 }
 
@@ -3870,27 +4281,149 @@ ON_Mesh::ComputeFaceNormal( int fi )
   return rc;
 }
 
+static void ON_Mesh_GetFaceNormalsHelper(
+        int fcount,
+        const ON_MeshFace* F,
+        const ON_3fPoint* fV,
+        const ON_3dPoint* dV,
+        ON_3fVector* FN
+        )
+{
+  // Computes unit face normals in a single pass over the face list.
+  // When dV is not null, the double precision vertex locations
+  // are used.  The loops operate on plain arrays and do not
+  // call any ON_3dVector member functions so compilers can
+  // keep everything in registers.
+  double ax, ay, az, bx, by, bz, nx, ny, nz, d;
+  const int* vi;
+  int fi;
+  for ( fi = 0; fi < fcount; fi++ )
+  {
+    vi = F[fi].vi;
+    if ( dV )
+    {
+      ax = dV[vi[2]].x - dV[vi[0]].x;
+      ay = dV[vi[2]].y - dV[vi[0]].y;
+      az = dV[vi[2]].z - dV[vi[0]].z;
+      bx = dV[vi[3]].x - dV[vi[1]].x;
+      by = dV[vi[3]].y - dV[vi[1]].y;
+      bz = dV[vi[3]].z - dV[vi[1]].z;
+    }
+    else
+    {
+      ax = (double)fV[vi[2]].x - (double)fV[vi[0]].x;
+      ay = (double)fV[vi[2]].y - (double)fV[vi[0]].y;
+      az = (double)fV[vi[2]].z - (double)fV[vi[0]].z;
+      bx = (double)fV[vi[3]].x - (double)fV[vi[1]].x;
+      by = (double)fV[vi[3]].y - (double)fV[vi[1]].y;
+      bz = (double)fV[vi[3]].z - (double)fV[vi[1]].z;
+    }
+
+    // works for triangles, quads, and nonplanar quads
+    nx = ay*bz - az*by;
+    ny = az*bx - ax*bz;
+    nz = ax*by - ay*bx;
+    d = sqrt(nx*nx + ny*ny + nz*nz);
+    if ( d > ON_DBL_MIN )
+    {
+      d = 1.0/d;
+      nx *= d;
+      ny *= d;
+      nz *= d;
+    }
+    else
+    {
+      nx = ny = nz = 0.0;
+    }
+    FN[fi].x = (float)nx;
+    FN[fi].y = (float)ny;
+    FN[fi].z = (float)nz;
+  }
+}
+
+static int ON_MeshNormalTaskCount( int& thread_count, int count )
+{
+  // Ranges are at least 4096 faces or vertices long so the 
+  // thread start up cost is small compared to the work.
+  if ( thread_count <= 0 )
+    thread_count = ON_ProcessorCount();
+  int task_count = count/4096;
+  if ( task_count > 4*thread_count )
+    task_count = 4*thread_count;
+  return ( thread_count < 2 || task_count < 2 ) ? 1 : task_count;
+}
+
+struct ON_MeshNormalJob
+{
+  int m_count;       // number of faces or vertices
+  int m_range_count; // faces or vertices per task
+  const ON_MeshFace* m_F;
+  const ON_3fPoint* m_fV;
+  const ON_3dPoint* m_dV;
+  ON_3fVector* m_FN;
+
+  // The faces that use vertex vi are m_vf[m_vf0[vi]], ..., 
+  // m_vf[m_vf0[vi+1]-1] in increasing order.
+  const int* m_vf0;
+  const int* m_vf;
+  ON_3fVector* m_N;
+};
+
+static void ON_MeshFaceNormalTask( void* context, int i )
+{
+  const ON_MeshNormalJob* job = (const ON_MeshNormalJob*)context;
+  const int i0 = i*job->m_range_count;
+  int n = job->m_count - i0;
+  if ( n > job->m_range_count )
+    n = job->m_range_count;
+  ON_Mesh_GetFaceNormalsHelper( n, job->m_F + i0, job->m_fV, job->m_dV, job->m_FN + i0 );
+}
+
 bool
 ON_Mesh::ComputeFaceNormals()
+{
+  return ComputeFaceNormals(1);
+}
+
+bool
+ON_Mesh::ComputeFaceNormals( int thread_count )
 {
   bool rc = false;
   const int fcount = FaceCount();
-  if ( fcount > 0 ) {
-    ON_3fVector a, b, n;
-    int fi;
-    const int* vi;
+  if ( fcount > 0 ) 
+  {
+    // Use the double precision vertices when they are present
+    // and in sync with m_V[].
+    const ON_3dPoint* dV = 0;
+    if (    HasDoublePrecisionVertices()
+         && SinglePrecisionVerticesAreValid() 
+         && DoublePrecisionVerticesAreValid() 
+       )
+    {
+      const ON_3dPointArray& dva = DoublePrecisionVertices();
+      if ( dva.Count() == m_V.Count() )
+        dV = dva.Array();
+    }
+
     if ( m_FN.Capacity() < fcount )
       m_FN.SetCapacity(fcount);
-    m_FN.SetCount(0);
-    rc = true;
-    for ( fi = 0; fi < fcount; fi++ ) {
-      vi = m_F[fi].vi;
-      a = m_V[vi[2]] - m_V[vi[0]];
-      b = m_V[vi[3]] - m_V[vi[1]];
-      n = ON_CrossProduct( a, b ); // works for triangles, quads, and nonplanar quads
-      n.Unitize();
-      m_FN.Append(n);
+    m_FN.SetCount(fcount);
+    const int task_count = ON_MeshNormalTaskCount( thread_count, fcount );
+    if ( task_count > 1 )
+    {
+      ON_MeshNormalJob job;
+      memset(&job,0,sizeof(job));
+      job.m_count = fcount;
+      job.m_range_count = (fcount + task_count - 1)/task_count;
+      job.m_F = m_F.Array();
+      job.m_fV = m_V.Array();
+      job.m_dV = dV;
+      job.m_FN = m_FN.Array();
+      ON_ParallelFor( thread_count, task_count, ON_MeshFaceNormalTask, &job );
     }
+    else
+      ON_Mesh_GetFaceNormalsHelper( fcount, m_F.Array(), m_V.Array(), dV, m_FN.Array() );
+    rc = true;
   }
   else {
     m_FN.Destroy();
@@ -4260,6 +4793,7 @@ void ON_Mesh::Append( const ON_Mesh& m )
   int* vi;
   int j;
 
+  ON_MemorySubsystemScope ms(ON_MEMORY_SUBSYSTEM_MESH);
   m_top.Destroy();
 
   // The calls to Has*() must happen before the m_V[] and m_F[] arrays get enlarged
@@ -5588,79 +6122,147 @@ bool ON_Mesh::CountQuads()
   return true;
 }
 
+static void ON_Mesh_SetVertexNormalHelper( double x, double y, double z, ON_3fVector& N )
+{
+  double d = sqrt(x*x + y*y + z*z);
+  if ( d > ON_DBL_MIN ) {
+    d = 1.0/d;
+    N.x = (float)(x*d);
+    N.y = (float)(y*d);
+    N.z = (float)(z*d);
+  }
+  else {
+    // this vertex is not used by a face or the face normals cancel out.
+    // set a unit z normal and press on.
+    N.Set(0,0,1);
+  }
+}
+
+static void ON_MeshVertexNormalTask( void* context, int i )
+{
+  // Each vertex normal is summed by one task, in the same face 
+  // order as the single threaded loop in ComputeVertexNormals().
+  const ON_MeshNormalJob* job = (const ON_MeshNormalJob*)context;
+  const int vi0 = i*job->m_range_count;
+  int vi1 = vi0 + job->m_range_count;
+  if ( vi1 > job->m_count )
+    vi1 = job->m_count;
+  const ON_3fVector* FN = job->m_FN;
+  const int* vf0 = job->m_vf0;
+  const int* vf = job->m_vf;
+  double x, y, z;
+  int vi, j;
+  for ( vi = vi0; vi < vi1; vi++ )
+  {
+    x = y = z = 0.0;
+    for ( j = vf0[vi]; j < vf0[vi+1]; j++ )
+    {
+      x += FN[vf[j]].x;
+      y += FN[vf[j]].y;
+      z += FN[vf[j]].z;
+    }
+    ON_Mesh_SetVertexNormalHelper( x, y, z, job->m_N[vi] );
+  }
+}
+
 bool ON_Mesh::ComputeVertexNormals()
+{
+  return ComputeVertexNormals(1);
+}
+
+bool ON_Mesh::ComputeVertexNormals( int thread_count )
 {
   bool rc = false;
   const int fcount = FaceCount();
   const int vcount = VertexCount();
-  int vi, fi, j;
-  ON_3fVector n;
+  int vi, fi;
 
   if ( fcount > 0 && vcount > 0 ) {
     rc = HasFaceNormals();
     if ( !rc )
-      rc = ComputeFaceNormals();
+      rc = ComputeFaceNormals(thread_count);
     if ( rc ) {
+      if ( m_N.Capacity() < vcount )
+        m_N.SetCapacity(vcount);
+      m_N.SetCount(vcount);
+      ON_3fVector* N = m_N.Array();
+      const ON_MeshFace* F = m_F.Array();
+      const ON_3fVector* FN = m_FN.Array();
+      const int* fvi;
       ON_Workspace ws;
-      //double* face_area = ws.GetDoubleMemory(fcount);
-      int* vfcount = ws.GetIntMemory( vcount );
-      memset ( vfcount, 0, vcount*sizeof(*vfcount) );
-
-      // count number of faces that use each vertex
-      for ( fi = 0; fi < fcount; fi++ ) {
-        ON_MeshFace& f = m_F[fi];
-        if ( f.IsValid(vcount) ) {
-          vfcount[f.vi[0]]++;
-          vfcount[f.vi[1]]++;
-          vfcount[f.vi[2]]++;
-          if ( f.IsQuad() )
-            vfcount[f.vi[3]]++;
-        }
-      }
 
-      // set vfi[vi][] = array of face indices that use vertex vi
-      int** vfi = (int**)ws.GetMemory( vcount*sizeof(vfi[0] ) );
+      const int task_count = ON_MeshNormalTaskCount( thread_count, vcount );
+      if ( task_count > 1 )
       {
-        int scratch_sz = 0;
-        for ( vi = 0; vi < vcount; vi++ ) {
-          scratch_sz += vfcount[vi];
+        // Build a vertex-to-face map so each thread sums the normals
+        // of its own vertices and nothing is scattered.
+        int* vf0 = ws.GetIntMemory( ((size_t)vcount)+1 );
+        memset( vf0, 0, (((size_t)vcount)+1)*sizeof(vf0[0]) );
+        for ( fi = 0; fi < fcount; fi++ ) {
+          if ( !F[fi].IsValid(vcount) )
+            continue;
+          fvi = F[fi].vi;
+          vf0[fvi[0]+1]++;
+          vf0[fvi[1]+1]++;
+          vf0[fvi[2]+1]++;
+          if ( F[fi].IsQuad() )
+            vf0[fvi[3]+1]++;
         }
-        int* scratch = ws.GetIntMemory(scratch_sz);
-        for ( vi = 0; vi < vcount; vi++ ) {
-          if ( vfcount[vi] ) {
-            vfi[vi] = scratch;
-            scratch += vfcount[vi];
-          }
-          vfcount[vi] = 0;
+        for ( vi = 0; vi < vcount; vi++ )
+          vf0[vi+1] += vf0[vi];
+        int* vf = ws.GetIntMemory( vf0[vcount] > 0 ? vf0[vcount] : 1 );
+        int* vf1 = ws.GetIntMemory( vcount );
+        memcpy( vf1, vf0, vcount*sizeof(vf1[0]) );
+        for ( fi = 0; fi < fcount; fi++ ) {
+          if ( !F[fi].IsValid(vcount) )
+            continue;
+          fvi = F[fi].vi;
+          vf[vf1[fvi[0]]++] = fi;
+          vf[vf1[fvi[1]]++] = fi;
+          vf[vf1[fvi[2]]++] = fi;
+          if ( F[fi].IsQuad() )
+            vf[vf1[fvi[3]]++] = fi;
         }
-      }
+
+        ON_MeshNormalJob job;
+        memset(&job,0,sizeof(job));
+        job.m_count = vcount;
+        job.m_range_count = (vcount + task_count - 1)/task_count;
+        job.m_FN = m_FN.Array();
+        job.m_vf0 = vf0;
+        job.m_vf = vf;
+        job.m_N = N;
+        ON_ParallelFor( thread_count, task_count, ON_MeshVertexNormalTask, &job );
+        return rc;
+      }
+
+      // Sum the unit normals of the faces that use each vertex
+      // into a double precision accumulator.  This visits each
+      // face once and does not build a vertex-to-face map.
+      double* vn = ws.GetDoubleMemory( 3*((size_t)vcount) );
+      memset( vn, 0, 3*((size_t)vcount)*sizeof(vn[0]) );
+
+      double* n;
+      double x, y, z;
       for ( fi = 0; fi < fcount; fi++ ) {
-        ON_MeshFace& f = m_F[fi];
-        if ( f.IsValid(vcount) ) {
-          vi = f.vi[0]; vfi[vi][vfcount[vi]++] = fi;
-          vi = f.vi[1]; vfi[vi][vfcount[vi]++] = fi;
-          vi = f.vi[2]; vfi[vi][vfcount[vi]++] = fi;
-          if ( f.IsQuad() ) {
-            vi = f.vi[3]; vfi[vi][vfcount[vi]++] = fi;
-          }
+        if ( !F[fi].IsValid(vcount) )
+          continue;
+        fvi = F[fi].vi;
+        x = FN[fi].x;
+        y = FN[fi].y;
+        z = FN[fi].z;
+        n = vn + 3*fvi[0]; n[0] += x; n[1] += y; n[2] += z;
+        n = vn + 3*fvi[1]; n[0] += x; n[1] += y; n[2] += z;
+        n = vn + 3*fvi[2]; n[0] += x; n[1] += y; n[2] += z;
+        if ( F[fi].IsQuad() ) {
+          n = vn + 3*fvi[3]; n[0] += x; n[1] += y; n[2] += z;
         }
       }
 
-      // average face normals to get an estimate for a vertex normal
-      m_N.SetCapacity(vcount);
-      m_N.SetCount(0);
+      // unitize the sums and store them in m_N[]
       for ( vi = 0; vi < vcount; vi++ ) {
-        n.Zero();
-        for ( j = vfcount[vi]-1; j >= 0; j-- ) {
-          n += m_FN[vfi[vi][j]];
-        }
-        if ( !n.Unitize() )
-        {
-          // this vertex is not used by a face or the face normals cancel out.
-          // set a unit z normal and press on.
-          n.Set(0,0,1);
-        }
-        m_N.Append(n);
+        n = vn + 3*vi;
+        ON_Mesh_SetVertexNormalHelper( n[0], n[1], n[2], N[vi] );
       }
     }
   }
@@ -9987,3 +10589,528 @@ bool ON_Mesh::IsSolid() const
 {
   return ( IsClosed() && IsManifold() && IsOriented() );
 }
+
+static double ON_Triangulate2dArea( const ON_2dPoint& A, const ON_2dPoint& B, const ON_2dPoint& C )
+{
+  // twice the signed area of the triangle ABC
+  return (B.x-A.x)*(C.y-A.y) - (B.y-A.y)*(C.x-A.x);
+}
+
+static bool ON_Triangulate2dContains( const ON_2dPoint& A, const ON_2dPoint& B, const ON_2dPoint& C, const ON_2dPoint& P )
+{
+  // ABC is counter-clockwise and points on the boundary are inside
+  return (    ON_Triangulate2dArea(A,B,P) >= 0.0 
+           && ON_Triangulate2dArea(B,C,P) >= 0.0 
+           && ON_Triangulate2dArea(C,A,P) >= 0.0 );
+}
+
+struct ON_Triangulate2dHole
+{
+  double m_x;    // largest x coordinate of the hole
+  int m_start;   // first hole vertex in the loop index array
+  int m_count;   // number of hole vertices
+  int m_right;   // loop index array position of the rightmost vertex
+};
+
+struct ON_Triangulate2dNode
+{
+  int m_pi;   // point index
+  int m_prev; // previous node in the polygon
+  int m_next; // next node in the polygon
+};
+
+static int ON_Triangulate2dGridCell( double x, double x0, double s, int grid_size )
+{
+  const double c = (x - x0)*s;
+  if ( !(c > 0.0) )
+    return 0;
+  return ( c < grid_size ) ? ((int)c) : (grid_size-1);
+}
+
+static int ON_Triangulate2dCompareHole( const ON_Triangulate2dHole* a, const ON_Triangulate2dHole* b )
+{
+  if ( a->m_x > b->m_x )
+    return -1;
+  if ( a->m_x < b->m_x )
+    return 1;
+  return 0;
+}
+
+static bool ON_Triangulate2dInCone( 
+  const ON_2dPointArray& P, 
+  const ON_SimpleArray<ON_Triangulate2dNode>& node, 
+  int i, 
+  const ON_2dPoint& M 
+  )
+{
+  // true if the direction from node i to M is inside the polygon's
+  // interior angle at node i.
+  const ON_2dPoint& A = P[node[node[i].m_prev].m_pi];
+  const ON_2dPoint& B = P[node[i].m_pi];
+  const ON_2dPoint& C = P[node[node[i].m_next].m_pi];
+  if ( ON_Triangulate2dArea(A,B,C) >= 0.0 )
+    return ( ON_Triangulate2dArea(A,B,M) > 0.0 && ON_Triangulate2dArea(B,C,M) > 0.0 );
+  return ( ON_Triangulate2dArea(A,B,M) > 0.0 || ON_Triangulate2dArea(B,C,M) > 0.0 );
+}
+
+static void ON_Triangulate2dInsertEdge(
+  const ON_2dPointArray& P, 
+  const ON_SimpleArray<ON_Triangulate2dNode>& node, 
+  int i,
+  ON_RTree* edge_tree
+  )
+{
+  const ON_2dPoint& A = P[node[i].m_pi];
+  const ON_2dPoint& B = P[node[node[i].m_next].m_pi];
+  const double bmin[2] = { (A.x < B.x) ? A.x : B.x, (A.y < B.y) ? A.y : B.y };
+  const double bmax[2] = { (A.x < B.x) ? B.x : A.x, (A.y < B.y) ? B.y : A.y };
+  edge_tree->Insert2d( bmin, bmax, i );
+}
+
+// Sets candidate to the nodes whose edge to the next node may 
+// overlap the box and returns the number of candidates.  Without
+// an edge tree every node is a candidate and candidate is NULL.
+static int ON_Triangulate2dCandidates(
+  const ON_SimpleArray<ON_Triangulate2dNode>& node, 
+  const ON_RTree* edge_tree,
+  double x0, double y0, double x1, double y1,
+  ON_SimpleArray<int>& buffer,
+  const int*& candidate
+  )
+{
+  if ( 0 == edge_tree )
+  {
+    candidate = 0;
+    return node.Count();
+  }
+  const double bmin[2] = {x0,y0};
+  const double bmax[2] = {x1,y1};
+  buffer.SetCount(0);
+  edge_tree->Search2d( bmin, bmax, buffer );
+  candidate = buffer.Array();
+  return buffer.Count();
+}
+
+static bool ON_Triangulate2dBridgeHole(
+  const ON_2dPointArray& P, 
+  const ON_SimpleArray<int>& loop_index,
+  const ON_Triangulate2dHole& hole,
+  double xmax,
+  ON_SimpleArray<ON_Triangulate2dNode>& node,
+  ON_RTree* edge_tree
+  )
+{
+  // Join the hole to the polygon with a pair of bridge edges from the 
+  // hole's rightmost vertex M to a polygon vertex that is visible from M.
+  // (D. Eberly, "Triangulation by Ear Clipping".)
+  // Splicing never changes the geometry of existing edges, so the 
+  // edge tree only grows.
+  const ON_2dPoint M = P[loop_index[hole.m_right]];
+  ON_SimpleArray<int> buffer;
+  const int* candidate;
+  int c, candidate_count, i, vi = -1;
+  double x, best_x = ON_DBL_MAX;
+
+  // Find the closest point I on the polygon that is on the ray from M
+  // in the +x direction.  With an edge tree, the search starts with a 
+  // short piece of the ray and doubles its length until a hit is found.
+  double x1 = xmax;
+  double dx = ( edge_tree && xmax > M.x ) ? (xmax - M.x)/256.0 : 0.0;
+  if ( dx > 0.0 )
+    x1 = M.x + dx;
+  for (;;)
+  {
+    candidate_count = ON_Triangulate2dCandidates( node, edge_tree, M.x, M.y, x1, M.y, buffer, candidate );
+    for ( c = 0; c < candidate_count; c++ )
+    {
+      i = candidate ? candidate[c] : c;
+      const int j = node[i].m_next;
+      const ON_2dPoint& A = P[node[i].m_pi];
+      const ON_2dPoint& B = P[node[j].m_pi];
+      if ( (A.y > M.y && B.y > M.y) || (A.y < M.y && B.y < M.y) )
+        continue;
+      if ( A.y == B.y )
+      {
+        // edge is on the ray
+        x = (A.x < B.x) ? A.x : B.x;
+        if ( x < M.x )
+          x = (A.x < B.x) ? B.x : A.x;
+        if ( x >= M.x && x < best_x )
+        {
+          best_x = x;
+          vi = ( x == A.x ) ? i : j;
+        }
+        continue;
+      }
+      x = A.x + (M.y-A.y)*(B.x-A.x)/(B.y-A.y);
+      if ( x >= M.x && x < best_x )
+      {
+        best_x = x;
+        if ( A.y == M.y )
+          vi = i;
+        else if ( B.y == M.y )
+          vi = j;
+        else
+          vi = (A.x > B.x) ? i : j;
+      }
+    }
+    if ( best_x <= x1 || !(x1 < xmax) )
+      break;
+    dx *= 2.0;
+    x1 = ( M.x + dx < xmax ) ? (M.x + dx) : xmax;
+  }
+  if ( vi < 0 )
+    return false; // hole is not inside the outer loop
+
+  const ON_2dPoint I(best_x,M.y);
+  ON_2dPoint V = P[node[vi].m_pi];
+  if ( V != I )
+  {
+    // If polygon vertices are inside the triangle M,I,V, then the 
+    // one that makes the smallest angle with the ray is visible from M.
+    const bool bCCW = ( ON_Triangulate2dArea(M,I,V) >= 0.0 );
+    double t, d, best_t = ON_DBL_MAX, best_d = ON_DBL_MAX;
+    int best_i = vi;
+    candidate_count = ON_Triangulate2dCandidates( node, edge_tree, 
+                        M.x, (V.y < M.y) ? V.y : M.y, (V.x > I.x) ? V.x : I.x, (V.y > M.y) ? V.y : M.y,
+                        buffer, candidate );
+    for ( c = 0; c < candidate_count; c++ )
+    {
+      i = candidate ? candidate[c] : c;
+      const ON_2dPoint& R = P[node[i].m_pi];
+      if ( R == V || !(R.x > M.x) )
+        continue;
+      if ( bCCW ? !ON_Triangulate2dContains(M,I,V,R) : !ON_Triangulate2dContains(M,V,I,R) )
+        continue;
+      t = fabs(R.y-M.y)/(R.x-M.x);
+      d = (R.x-M.x)*(R.x-M.x) + (R.y-M.y)*(R.y-M.y);
+      if ( t < best_t || (t == best_t && d < best_d) )
+      {
+        best_t = t;
+        best_d = d;
+        best_i = i;
+      }
+    }
+    vi = best_i;
+    V = P[node[vi].m_pi];
+  }
+
+  // Vertices used by earlier bridges appear more than once in the
+  // polygon.  Use the copy whose interior angle contains M.
+  if ( !ON_Triangulate2dInCone(P,node,vi,M) )
+  {
+    candidate_count = ON_Triangulate2dCandidates( node, edge_tree, V.x, V.y, V.x, V.y, buffer, candidate );
+    for ( c = 0; c < candidate_count; c++ )
+    {
+      i = candidate ? candidate[c] : c;
+      if ( i != vi && P[node[i].m_pi] == V && ON_Triangulate2dInCone(P,node,i,M) )
+      {
+        vi = i;
+        break;
+      }
+    }
+  }
+
+  // ..., Vprev, V', M, (hole vertices), M', V, ...
+  const int v2 = node.Count();
+  const int h0 = v2+1;
+  const int k0 = hole.m_right - hole.m_start;
+  node.Reserve( node.Count() + hole.m_count + 2 );
+  ON_Triangulate2dNode& nv2 = node.AppendNew();
+  nv2.m_pi = node[vi].m_pi;
+  nv2.m_prev = node[vi].m_prev;
+  nv2.m_next = h0;
+  node[nv2.m_prev].m_next = v2;
+  for ( i = 0; i <= hole.m_count; i++ )
+  {
+    ON_Triangulate2dNode& h = node.AppendNew();
+    h.m_pi = loop_index[hole.m_start + (k0+i)%hole.m_count];
+    h.m_prev = h0+i-1;
+    h.m_next = h0+i+1;
+  }
+  node[h0].m_prev = v2;
+  node[h0+hole.m_count].m_next = vi;
+  node[vi].m_prev = h0+hole.m_count;
+  if ( edge_tree )
+  {
+    for ( i = v2; i <= h0+hole.m_count; i++ )
+      ON_Triangulate2dInsertEdge( P, node, i, edge_tree );
+  }
+  return true;
+}
+
+int ON_Triangulate2dRegion(
+            int loop_count,
+            const int* loop_point_count,
+            int point_stride,
+            const double* point,
+            ON_SimpleArray<ON_3dex>& triangles
+            )
+{
+  int li, i, k, n, point_count;
+
+  if ( loop_count < 1 || 0 == loop_point_count || point_stride < 2 || 0 == point )
+    return 0;
+  for ( li = 0, point_count = 0; li < loop_count; li++ )
+  {
+    if ( loop_point_count[li] < 0 )
+      return 0;
+    point_count += loop_point_count[li];
+  }
+
+  ON_2dPointArray P(point_count);
+  for ( i = 0; i < point_count; i++ )
+    P.AppendNew().Set( point[i*point_stride], point[i*point_stride+1] );
+
+  // Remove duplicate end points and orient the outer loop 
+  // counter-clockwise and the holes clockwise.
+  ON_SimpleArray<int> loop_index(point_count);
+  ON_SimpleArray<ON_Triangulate2dHole> holes(loop_count);
+  ON_SimpleArray<ON_Triangulate2dNode> node;
+  int first = 0;
+  for ( li = 0; li < loop_count; li++ )
+  {
+    n = loop_point_count[li];
+    const int loop_first = first;
+    first += n;
+    if ( n >= 2 && P[loop_first] == P[loop_first+n-1] )
+      n--;
+    double area = 0.0;
+    for ( i = 0; i < n; i++ )
+    {
+      const ON_2dPoint& A = P[loop_first+i];
+      const ON_2dPoint& B = P[loop_first+(i+1)%n];
+      area += (A.x-B.x)*(A.y+B.y);
+    }
+    if ( n < 3 || !(0.0 != area) )
+    {
+      if ( 0 == li )
+        return 0;
+      continue; // ignore degenerate holes
+    }
+    const bool bReverse = (0 == li) ? (area < 0.0) : (area > 0.0);
+    const int start = loop_index.Count();
+    for ( i = 0; i < n; i++ )
+      loop_index.Append( bReverse ? loop_first+n-1-i : loop_first+i );
+    if ( 0 == li )
+    {
+      node.Reserve( point_count + 2*loop_count );
+      for ( i = 0; i < n; i++ )
+      {
+        ON_Triangulate2dNode& v = node.AppendNew();
+        v.m_pi = loop_index[i];
+        v.m_prev = (i+n-1)%n;
+        v.m_next = (i+1)%n;
+      }
+      continue;
+    }
+    ON_Triangulate2dHole& hole = holes.AppendNew();
+    hole.m_start = start;
+    hole.m_count = n;
+    hole.m_right = start;
+    hole.m_x = P[loop_index[start]].x;
+    for ( i = start+1; i < start+n; i++ )
+    {
+      if ( P[loop_index[i]].x > hole.m_x )
+      {
+        hole.m_x = P[loop_index[i]].x;
+        hole.m_right = i;
+      }
+    }
+  }
+
+  // Bridge the holes from right to left so a bridge never crosses
+  // a hole that has not been joined yet.
+  // When there are more than a few holes, an R-tree of the polygon
+  // edges limits the search for bridge vertices to nearby edges.
+  ON_BoundingBox bbox;
+  bbox.Set( 2, false, P.Count(), 2, &P[0].x, false );
+  holes.QuickSort( ON_Triangulate2dCompareHole );
+  ON_RTree* edge_tree = 0;
+  if ( holes.Count() >= 8 )
+  {
+    edge_tree = new ON_RTree();
+    for ( i = 0; i < node.Count(); i++ )
+      ON_Triangulate2dInsertEdge( P, node, i, edge_tree );
+  }
+  for ( i = 0; i < holes.Count(); i++ )
+    ON_Triangulate2dBridgeHole( P, loop_index, holes[i], bbox.m_max.x, node, edge_tree );
+  if ( edge_tree )
+    delete edge_tree;
+
+  n = node.Count();
+  ON_SimpleArray<int> poly(n);
+  for ( i = 0, k = 0; i < n; i++, k = node[k].m_next )
+    poly.Append( node[k].m_pi );
+  node.Destroy();
+
+  // Ear clipping.  The reflex vertices are sorted into a uniform 
+  // grid so an ear candidate only tests the reflex vertices near it.
+  const int triangle_count0 = triangles.Count();
+  triangles.Reserve( triangle_count0 + n - 2 );
+  ON_SimpleArray<int> prev(n), next(n);
+  ON_SimpleArray<unsigned char> status(n); // 0 = convex, 1 = reflex, 2 = clipped
+  prev.SetCount(n);
+  next.SetCount(n);
+  status.SetCount(n);
+  int reflex_count = 0;
+  for ( i = 0; i < n; i++ )
+  {
+    prev[i] = (i+n-1)%n;
+    next[i] = (i+1)%n;
+  }
+  for ( i = 0; i < n; i++ )
+  {
+    status[i] = ( ON_Triangulate2dArea(P[poly[prev[i]]],P[poly[i]],P[poly[next[i]]]) <= 0.0 ) ? 1 : 0;
+    reflex_count += status[i];
+  }
+
+  int grid_size = (int)ceil(sqrt((double)reflex_count));
+  if ( grid_size < 1 )
+    grid_size = 1;
+  else if ( grid_size > 1024 )
+    grid_size = 1024;
+  const double grid_x = bbox.m_min.x;
+  const double grid_y = bbox.m_min.y;
+  const double grid_sx = ( bbox.m_max.x > bbox.m_min.x ) ? grid_size/(bbox.m_max.x - bbox.m_min.x) : 0.0;
+  const double grid_sy = ( bbox.m_max.y > bbox.m_min.y ) ? grid_size/(bbox.m_max.y - bbox.m_min.y) : 0.0;
+  ON_SimpleArray<int> cell_start(grid_size*grid_size+1);
+  ON_SimpleArray<int> cell_reflex(reflex_count);
+  ON_SimpleArray<int> extra_reflex; // vertices that become reflex while clipping
+  cell_start.SetCount(grid_size*grid_size+1);
+  cell_start.Zero();
+  cell_reflex.SetCount(reflex_count);
+  for ( i = 0; i < n; i++ )
+  {
+    if ( status[i] )
+    {
+      const ON_2dPoint& R = P[poly[i]];
+      const int cx = ON_Triangulate2dGridCell(R.x,grid_x,grid_sx,grid_size);
+      const int cy = ON_Triangulate2dGridCell(R.y,grid_y,grid_sy,grid_size);
+      cell_start[cy*grid_size+cx+1]++;
+    }
+  }
+  for ( k = 1; k <= grid_size*grid_size; k++ )
+    cell_start[k] += cell_start[k-1];
+  for ( i = 0; i < n; i++ )
+  {
+    if ( status[i] )
+    {
+      const ON_2dPoint& R = P[poly[i]];
+      const int cx = ON_Triangulate2dGridCell(R.x,grid_x,grid_sx,grid_size);
+      const int cy = ON_Triangulate2dGridCell(R.y,grid_y,grid_sy,grid_size);
+      cell_reflex[cell_start[cy*grid_size+cx]++] = i;
+    }
+  }
+  for ( k = grid_size*grid_size; k > 0; k-- )
+    cell_start[k] = cell_start[k-1];
+  cell_start[0] = 0;
+
+  int remaining = n;
+  int guard = 0;
+  i = 0;
+  while ( remaining > 3 )
+  {
+    const int a = prev[i];
+    const int b = next[i];
+    const ON_2dPoint& A = P[poly[a]];
+    const ON_2dPoint& B = P[poly[i]];
+    const ON_2dPoint& C = P[poly[b]];
+    bool bEar = ( ON_Triangulate2dArea(A,B,C) > 0.0 );
+    if ( bEar && reflex_count > 0 )
+    {
+      // Only reflex vertices can be inside an ear candidate.
+      const double x0 = (A.x < B.x) ? ((A.x < C.x) ? A.x : C.x) : ((B.x < C.x) ? B.x : C.x);
+      const double x1 = (A.x > B.x) ? ((A.x > C.x) ? A.x : C.x) : ((B.x > C.x) ? B.x : C.x);
+      const double y0 = (A.y < B.y) ? ((A.y < C.y) ? A.y : C.y) : ((B.y < C.y) ? B.y : C.y);
+      const double y1 = (A.y > B.y) ? ((A.y > C.y) ? A.y : C.y) : ((B.y > C.y) ? B.y : C.y);
+      const int cx0 = ON_Triangulate2dGridCell(x0,grid_x,grid_sx,grid_size);
+      const int cx1 = ON_Triangulate2dGridCell(x1,grid_x,grid_sx,grid_size);
+      const int cy0 = ON_Triangulate2dGridCell(y0,grid_y,grid_sy,grid_size);
+      const int cy1 = ON_Triangulate2dGridCell(y1,grid_y,grid_sy,grid_size);
+      for ( int cy = cy0; bEar && cy <= cy1; cy++ ) for ( int cx = cx0; bEar && cx <= cx1; cx++ )
+      {
+        const int cell = cy*grid_size + cx;
+        for ( k = cell_start[cell]; k < cell_start[cell+1]; k++ )
+        {
+          const int r = cell_reflex[k];
+          if ( 1 != status[r] )
+            continue;
+          const ON_2dPoint& R = P[poly[r]];
+          if ( R.x < x0 || R.x > x1 || R.y < y0 || R.y > y1 )
+            continue;
+          if ( r == a || r == i || r == b || R == A || R == B || R == C )
+            continue;
+          if ( ON_Triangulate2dContains(A,B,C,R) )
+          {
+            bEar = false;
+            break;
+          }
+        }
+      }
+      for ( k = 0; bEar && k < extra_reflex.Count(); k++ )
+      {
+        const int r = extra_reflex[k];
+        const ON_2dPoint& R = P[poly[r]];
+        if ( 1 == status[r] && r != a && r != i && r != b 
+             && R != A && R != B && R != C && ON_Triangulate2dContains(A,B,C,R) )
+          bEar = false;
+      }
+    }
+
+    if ( !bEar && ++guard <= remaining )
+    {
+      i = b;
+      continue;
+    }
+
+    // When guard > remaining, the polygon is degenerate or self 
+    // intersecting and the vertex is clipped to force progress.
+    if ( ON_Triangulate2dArea(A,B,C) > 0.0 )
+    {
+      ON_3dex& t = triangles.AppendNew();
+      t.i = poly[a];
+      t.j = poly[i];
+      t.k = poly[b];
+    }
+    if ( 1 == status[i] )
+      reflex_count--;
+    status[i] = 2;
+    next[a] = b;
+    prev[b] = a;
+    remaining--;
+    guard = 0;
+
+    // update the reflex status of the neighbors
+    for ( k = 0; k < 2; k++ )
+    {
+      const int j = k ? b : a;
+      const unsigned char s = ( ON_Triangulate2dArea(P[poly[prev[j]]],P[poly[j]],P[poly[next[j]]]) <= 0.0 ) ? 1 : 0;
+      if ( s && !status[j] )
+      {
+        // only happens with degenerate input
+        extra_reflex.Append(j);
+        reflex_count++;
+      }
+      else if ( !s && status[j] )
+        reflex_count--;
+      status[j] = s;
+    }
+    i = b;
+  }
+
+  if ( 3 == remaining )
+  {
+    const int a = prev[i];
+    const int b = next[i];
+    if ( ON_Triangulate2dArea(P[poly[a]],P[poly[i]],P[poly[b]]) > 0.0 )
+    {
+      ON_3dex& t = triangles.AppendNew();
+      t.i = poly[a];
+      t.j = poly[i];
+      t.k = poly[b];
+    }
+  }
+
+  return triangles.Count() - triangle_count0;
+}
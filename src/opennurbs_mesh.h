@@ -20,6 +20,7 @@ class ON_Mesh;
 class ON_MeshVertexRef;
 class ON_MeshEdgeRef;
 class ON_MeshFaceRef;
+class ON_MeshLevelOfDetail;
 #if defined(OPENNURBS_PLUS)
 class ON_MMX_POINT;
 class ON_MESH_POINT;
@@ -1133,6 +1134,23 @@ public:
   bool ComputeFaceNormals();   // compute face normals for all faces
   bool ComputeFaceNormal(int); // computes face normal of indexed face
 
+  /*
+  Description:
+    Compute face normals for all faces using several threads.
+  Parameters:
+    thread_count - [in] maximum number of threads.
+      See ON_ParallelFor().
+  Returns:
+    True if successful.
+  Remarks:
+    ComputeFaceNormals() calls this function with 
+    thread_count = 1.  The faces are split into ranges and the
+    normals do not depend on the number of threads.  The 
+    vertices are read through the face indices, so the point
+    list kernels in opennurbs_simd.h are not used.
+  */
+  bool ComputeFaceNormals( int thread_count );
+
   int CullDegenerateFaces(); // returns number of degenerate faces
   int CullUnusedVertices(); // returns number of culled vertices
 
@@ -1142,6 +1160,26 @@ public:
   bool Compact();
 
   bool ComputeVertexNormals();    // uses face normals to cook up a vertex normal
+
+  /*
+  Description:
+    Compute vertex normals using several threads.
+  Parameters:
+    thread_count - [in] maximum number of threads.
+      See ON_ParallelFor().
+  Returns:
+    True if successful.
+  Remarks:
+    ComputeVertexNormals() calls this function with 
+    thread_count = 1.  When several threads are used, a map
+    from each vertex to the faces that use it is built and 
+    each vertex normal is summed by one thread in the same
+    face order as the single threaded loop, so the normals 
+    do not depend on the number of threads.  Face normals 
+    are computed with ComputeFaceNormals(thread_count) when 
+    the mesh does not have them.
+  */
+  bool ComputeVertexNormals( int thread_count );
   
   //////////
   // Scales textures so the texture domains are [0,1] and
@@ -1630,6 +1668,43 @@ public:
   */
   bool CollapseEdge( int topei );
 
+  /*
+  Description:
+    Reduce the number of faces by collapsing the edges that
+    change the shape of the mesh the least.
+  Parameters:
+    target_face_count - [in]
+      Edges are collapsed until the mesh has this many faces.
+      Pass 0 to use only max_error.
+    max_error - [in]
+      If > 0, no edge is collapsed whose quadric error is larger
+      than max_error.  The quadric error is the square root of the
+      sum of the squared distances from the new vertex to the
+      planes of the original faces around the removed vertices.
+    thread_count - [in]
+      Maximum number of threads to use. If thread_count <= 0,
+      ON_ProcessorCount() threads are used.  Large meshes are split
+      into slabs that are decimated at the same time and the faces
+      between slabs are decimated when the threads have finished.
+  Returns:
+    true if successful.
+  Remarks:
+    The decimated mesh is made of triangles.  Vertices that are on
+    boundaries, texture seams and nonmanifold edges are only removed
+    by collapsing them along one of these edges, so boundaries and
+    seams keep their shape.  Vertex normals, texture coordinates,
+    surface parameters and colors are interpolated.  Curvatures,
+    hidden vertices, double precision vertices and levels of 
+    detail are removed.
+  See Also:
+    ON_Mesh::CollapseEdge
+  */
+  bool Decimate( 
+    int target_face_count, 
+    double max_error = 0.0, 
+    int thread_count = 0 
+    );
+
   /*
   Description:
     Tests a mesh edge to see if it is valid as input to
@@ -1752,6 +1827,84 @@ public:
   bool TopologyExists() const;
 
 
+  ///////////////////////////////////////////////////////////////////////
+  //
+  // levels of detail
+  //
+  // A mesh can carry a chain of coarser versions of itself that 
+  // viewers can draw while the full resolution mesh is loading or
+  // when the mesh is far away.  The levels are saved in 3dm archives
+  // and are not changed when m_V[] or m_F[] are changed.  If you
+  // edit the mesh, call DestroyLevelsOfDetail() or 
+  // CreateLevelsOfDetail().
+  //
+
+  /*
+  Description:
+    Create levels of detail by decimating this mesh.
+  Parameters:
+    level_count - [in]
+      maximum number of levels to create.
+    reduction - [in]
+      0 < reduction < 1.  Each level has about reduction times
+      as many faces as the next finer level.
+    thread_count - [in]
+      Maximum number of threads to use. If thread_count <= 0,
+      ON_ProcessorCount() threads are used.
+  Returns:
+    true if at least one level was created.
+  Remarks:
+    The levels are made in one pass of quadric error edge
+    collapses.  Each level continues from the collapses and 
+    quadrics of the finer level, so the whole chain costs about
+    the same as decimating the mesh once.  Fewer than level_count
+    levels are made when the mesh cannot be reduced any more.
+  See Also:
+    ON_Mesh::Decimate
+  */
+  bool CreateLevelsOfDetail(
+    int level_count,
+    double reduction = 0.25,
+    int thread_count = 0
+    );
+
+  /*
+  Returns:
+    The levels of detail or NULL if the mesh does not have any.
+  */
+  const ON_MeshLevelOfDetail* LevelsOfDetail() const;
+
+  void DestroyLevelsOfDetail();
+
+  /*
+  Description:
+    Read the levels of detail of a mesh saved by ON_Mesh::Write()
+    without reading the full resolution mesh.
+  Parameters:
+    file - [in]
+      positioned where ON_Mesh::Read() would begin reading.
+    max_level_count - [in]
+      If >= 0, only the max_level_count coarsest levels are read.
+  Returns:
+    true if the archive was read and the mesh had levels of detail.
+    When true is returned, LevelsOfDetail() has the levels and
+    m_V[] and m_F[] are empty.
+  Remarks:
+    The levels are saved at the end of the mesh chunk, after the
+    full resolution faces and vertices, so older versions of
+    ON_Mesh::Read() can read meshes with levels.  The full 
+    resolution data is read through so the archive's CRCs are 
+    still checked, but it is not uncompressed or saved.  This 
+    saves the time and memory to make the full resolution mesh, 
+    not the time to read its bytes.  The levels are saved coarsest
+    first, so a viewer can show the coarsest levels and then read
+    the mesh again with ON_Mesh::Read() to get the finer ones.
+  */
+  bool ReadLevelsOfDetail( 
+    ON_BinaryArchive& file,
+    int max_level_count = 1
+    );
+
   ///////////////////////////////////////////////////////////////////////
   //
   // mesh partitions
@@ -2183,7 +2336,11 @@ protected:
 
   class ON_MeshTree* m_mtree;
 
+  // optional levels of detail - saved in 3dm archives
+  ON_MeshLevelOfDetail* m_lod;
+
 private:
+  bool ReadHelper( ON_BinaryArchive&, bool, int );
   bool Write_1( ON_BinaryArchive& ) const; // uncompressed 1.x format
   bool Write_2( int, ON_BinaryArchive& ) const; // compressed 2.x format
   bool Read_1( ON_BinaryArchive& );
@@ -2193,6 +2350,98 @@ private:
   bool SwapEdge_Helper( int, bool );
 };
 
+#if defined(ON_DLL_TEMPLATE)
+#pragma warning( push )
+#pragma warning( disable : 4231 )
+ON_DLL_TEMPLATE template class ON_CLASS ON_SimpleArray<ON_Mesh*>;
+#pragma warning( pop )
+#endif
+
+/*
+Description:
+  Progressively coarser versions of a mesh made by 
+  ON_Mesh::CreateLevelsOfDetail().  Level 0 is the coarsest.
+Remarks:
+  In 3dm archives the levels are saved coarsest first in their
+  own chunks after a table of face counts and errors, so readers
+  can stop after the levels they need.  When Read() is called
+  with max_level_count >= 0, LevelCount(), FaceCount() and Error()
+  report every level in the archive but Mesh() returns NULL for
+  the levels that were not read.
+*/
+class ON_CLASS ON_MeshLevelOfDetail
+{
+public:
+  ON_MeshLevelOfDetail();
+  ~ON_MeshLevelOfDetail();
+  ON_MeshLevelOfDetail( const ON_MeshLevelOfDetail& src );
+  ON_MeshLevelOfDetail& operator=( const ON_MeshLevelOfDetail& src );
+
+  void Destroy();
+
+  /*
+  Description:
+    Add a level that is coarser than the levels already added.
+  Parameters:
+    mesh - [in] 
+      mesh allocated with new.  This class will delete it.
+    error - [in] 
+      error of the level.  See Error().
+  */
+  void AddCoarserLevel( ON_Mesh* mesh, double error );
+
+  int LevelCount() const;
+
+  /*
+  Parameters:
+    level - [in] 0 <= level < LevelCount(). 0 is the coarsest.
+  Returns:
+    The mesh or NULL if the level was not read.
+  */
+  const ON_Mesh* Mesh( int level ) const;
+
+  int FaceCount( int level ) const;
+
+  /*
+  Returns:
+    The largest quadric error, see ON_Mesh::Decimate(), of the
+    edge collapses used to make the level.  It is at least as 
+    large as the distance from each new vertex to the planes of 
+    the full resolution faces it replaced, and coarser levels 
+    have larger errors.
+  */
+  double Error( int level ) const;
+
+  /*
+  Parameters:
+    max_error - [in]
+  Returns:
+    The coarsest level with Error(level) <= max_error or
+    -1 if the full resolution mesh should be used.
+  */
+  int LevelFromError( double max_error ) const;
+
+  bool Transform( const ON_Xform& xform );
+
+  unsigned int SizeOf() const;
+
+  bool Write( ON_BinaryArchive& file ) const;
+
+  /*
+  Parameters:
+    file - [in]
+    max_level_count - [in]
+      If >= 0, only the max_level_count coarsest levels are read.
+  */
+  bool Read( ON_BinaryArchive& file, int max_level_count = -1 );
+
+private:
+  // coarsest level first
+  ON_SimpleArray<ON_Mesh*> m_mesh;
+  ON_SimpleArray<int> m_face_count;
+  ON_SimpleArray<double> m_error;
+};
+
 class ON_CLASS ON_MeshVertexRef : public ON_Geometry
 {
   ON_OBJECT_DECLARE(ON_MeshVertexRef)
@@ -2442,6 +2691,44 @@ ON_Mesh* ON_MeshSurface(
             ON_Mesh* mesh = 0
             );
 
+/*
+Description:
+  Triangulate a planar region bounded by an outer loop and
+  zero or more inner loops (holes).
+Parameters:
+  loop_count - [in] (>=1) number of loops
+  loop_point_count - [in] loop_point_count[i] is the number of 
+        points in the i-th loop. If the last point of a loop is
+        equal to its first point, the last point is ignored.
+  point_stride - [in] (>=2) stride between points
+  point - [in] 2d points of the loops listed one loop after
+        another. The first loop is the outer boundary and the 
+        remaining loops are holes inside the outer boundary.
+        The loops may have either orientation.
+  triangles - [out] triangles are appended to this array.  The
+        ON_3dex values are indices into point[] and the
+        triangles are counter-clockwise in the xy plane.
+Returns:
+  Number of triangles appended to triangles[].  Zero if the
+  input is not valid.
+Remarks:
+  Each hole is joined to the outer loop by a pair of bridge edges.
+  The resulting simple polygon is ear clipped.  Only nearby reflex 
+  vertices are tested in the ear test, so polygons with few 
+  concave corners are triangulated in nearly linear time.  When
+  there are many holes, an R-tree of the polygon edges is used to
+  find the bridge edges.
+  Loops that cross each other give unpredictable results.
+*/
+ON_DECL
+int ON_Triangulate2dRegion(
+            int loop_count,
+            const int* loop_point_count,
+            int point_stride,
+            const double* point,
+            ON_SimpleArray<ON_3dex>& triangles
+            );
+
 /*
 Description:
   Finds the barycentric coordinates of the point on a 
@@ -948,3 +948,1181 @@ ON_Mesh* ON_ControlPolygonMesh(
 
   return mesh;
 }
+
+/////////////////////////////////////////////////////////////////////////////
+// Quadric error mesh decimation
+//
+
+// A candidate collapse of topological vertex m_v into m_u. 
+struct ON_MeshDecimatorCollapse
+{
+  double m_cost;
+  double m_X[3]; // new location of m_u
+  int m_u;
+  int m_v;
+  unsigned int m_u_stamp;
+  unsigned int m_v_stamp;
+};
+
+static void ON_MeshDecimatorHeapPush( ON_SimpleArray<ON_MeshDecimatorCollapse>& heap, const ON_MeshDecimatorCollapse& c )
+{
+  int i = heap.Count();
+  heap.Append(c);
+  ON_MeshDecimatorCollapse* h = heap.Array();
+  while ( i > 0 )
+  {
+    const int j = (i-1)/2;
+    if ( h[j].m_cost <= c.m_cost )
+      break;
+    h[i] = h[j];
+    i = j;
+  }
+  h[i] = c;
+}
+
+static bool ON_MeshDecimatorHeapPop( ON_SimpleArray<ON_MeshDecimatorCollapse>& heap, ON_MeshDecimatorCollapse& c )
+{
+  const int count = heap.Count()-1;
+  if ( count < 0 )
+    return false;
+  ON_MeshDecimatorCollapse* h = heap.Array();
+  c = h[0];
+  const ON_MeshDecimatorCollapse last = h[count];
+  int i = 0;
+  for(;;)
+  {
+    int j = 2*i+1;
+    if ( j >= count )
+      break;
+    if ( j+1 < count && h[j+1].m_cost < h[j].m_cost )
+      j++;
+    if ( last.m_cost <= h[j].m_cost )
+      break;
+    h[i] = h[j];
+    i = j;
+  }
+  h[i] = last;
+  heap.SetCount(count);
+  return true;
+}
+
+// q[] = symmetric 4x4 matrix a2,ab,ac,ad,b2,bc,bd,c2,cd,d2
+static void ON_QuadricAddPlane( double* q, double a, double b, double c, double d )
+{
+  q[0] += a*a; q[1] += a*b; q[2] += a*c; q[3] += a*d;
+  q[4] += b*b; q[5] += b*c; q[6] += b*d;
+  q[7] += c*c; q[8] += c*d;
+  q[9] += d*d;
+}
+
+static double ON_QuadricValue( const double* q, const double* X )
+{
+  const double x = X[0], y = X[1], z = X[2];
+  const double e = x*(q[0]*x + 2.0*(q[1]*y + q[2]*z + q[3]))
+                 + y*(q[4]*y + 2.0*(q[5]*z + q[6]))
+                 + z*(q[7]*z + 2.0*q[8])
+                 + q[9];
+  return (e > 0.0) ? e : 0.0;
+}
+
+static bool ON_QuadricMinimum( const double* q, double* X )
+{
+  // solve [q0 q1 q2; q1 q4 q5; q2 q5 q7] X = -[q3 q6 q8]
+  const double c0 = q[4]*q[7] - q[5]*q[5];
+  const double c1 = q[2]*q[5] - q[1]*q[7];
+  const double c2 = q[1]*q[5] - q[2]*q[4];
+  const double det = q[0]*c0 + q[1]*c1 + q[2]*c2;
+  const double trace = q[0] + q[4] + q[7];
+  if ( !(fabs(det) > 1.0e-8*trace*trace*trace) )
+    return false;
+  const double c4 = q[0]*q[7] - q[2]*q[2];
+  const double c5 = q[1]*q[2] - q[0]*q[5];
+  const double c8 = q[0]*q[4] - q[1]*q[1];
+  const double r = -1.0/det;
+  X[0] = r*(c0*q[3] + c1*q[6] + c2*q[8]);
+  X[1] = r*(c1*q[3] + c4*q[6] + c5*q[8]);
+  X[2] = r*(c2*q[3] + c5*q[6] + c8*q[8]);
+  return true;
+}
+
+// Returns true if moving corner A of triangle ABC to Anew flips
+// or degenerates the triangle.
+static bool ON_MeshDecimatorFlips( const double* A, const double* B, const double* C, const double* Anew )
+{
+  const ON_3dVector n0 = ON_CrossProduct( ON_3dVector(B[0]-A[0],B[1]-A[1],B[2]-A[2]), 
+                                          ON_3dVector(C[0]-A[0],C[1]-A[1],C[2]-A[2]) );
+  const ON_3dVector n1 = ON_CrossProduct( ON_3dVector(B[0]-Anew[0],B[1]-Anew[1],B[2]-Anew[2]), 
+                                          ON_3dVector(C[0]-Anew[0],C[1]-Anew[1],C[2]-Anew[2]) );
+  const double l0 = n0.Length();
+  const double l1 = n1.Length();
+  if ( !(l1 > ON_EPSILON*l0) )
+    return true;
+  return ( n0*n1 <= 0.1*l0*l1 );
+}
+
+#define ON_DECIMATE_FEATURE_VERTEX 1 // vertex is on a boundary, seam or nonmanifold edge
+#define ON_DECIMATE_LOCKED_VERTEX  2 // vertex cannot be removed
+#define ON_DECIMATE_DELETED_VERTEX 4
+
+/*
+Description:
+  Quadric error edge collapse engine used by ON_Mesh::Decimate().
+Remarks:
+  Works on the topological vertices of the mesh so vertices that
+  are duplicated along texture seams move together.  Faces are
+  triangles and each vertex has a linked list of the face corners
+  that use it.  The lists are updated as edges are collapsed so
+  the mesh topology never has to be rebuilt.
+  
+  Collapses are restricted so boundaries, seams and nonmanifold
+  edges are preserved:
+   - A locked vertex (a feature vertex that does not have exactly
+     two feature edges, or a vertex with a nonmanifold fan) is
+     never removed.
+   - A feature vertex is only removed by collapsing it along one
+     of its feature edges into the vertex at the other end.
+   - Only edges between two interior vertices move the surviving
+     vertex to the quadric minimum; the other collapses keep the
+     position and attributes of the surviving vertex.
+*/
+class ON_MeshDecimator
+{
+public:
+  ON_MeshDecimator();
+
+  bool Create( const ON_Mesh& mesh );
+
+  /*
+  Description:
+    Collapse edges until the mesh has target_face_count faces
+    or the cheapest collapse costs more than max_cost.
+  */
+  bool Run( int target_face_count, double max_cost, int thread_count );
+
+  bool GetMesh( ON_Mesh& mesh ) const;
+
+  int FaceCount() const;
+
+  // largest cost of a collapse made so far
+  double MaxCost() const;
+
+  // used by ON_MeshDecimatorTask()
+  int RunPartition( int partition, int face_count, int target_face_count, double max_cost, double* collapse_cost );
+
+private:
+  bool Allowed( int tv, int partition ) const;
+  int FaceCorner( int fi, int tv ) const;
+  void GetRing( int tv, ON_SimpleArray<int>& corners );
+  void CleanRing( int tv );
+  int SharedFaces( int a, int b, int* fi ) const;
+  bool IsFeatureEdge( int a, int b ) const;
+  bool GetCollapse( int a, int b, ON_MeshDecimatorCollapse& c ) const;
+  void GetNeighbors( const ON_SimpleArray<int>& corners, int tv, ON_SimpleArray<int>& neighbors ) const;
+  void PushCollapses( int tv, int partition, int min_tv, ON_SimpleArray<int>& corners, ON_SimpleArray<int>& neighbors, ON_SimpleArray<ON_MeshDecimatorCollapse>& heap );
+  int Collapse( const ON_MeshDecimatorCollapse& c, int partition, ON_SimpleArray<int>* scratch, ON_SimpleArray<ON_MeshDecimatorCollapse>& heap );
+  int CreatePartitions( int partition_count, int* partition_face_count );
+  void LerpAttributes( int vi0, int vi1, double s );
+
+  ON_3dVector m_center;    // m_P[] is relative to m_center
+  int m_V_count;           // number of mesh vertices
+  int m_face_count;        // number of live faces
+  double m_max_cost;
+
+  // topological vertices
+  ON_SimpleArray<ON_3dPoint> m_P;
+  ON_SimpleArray<double> m_Q;          // 10 quadric coefficients per vertex
+  ON_SimpleArray<int> m_vhead;         // first corner in the vertex corner list
+  ON_SimpleArray<unsigned char> m_vflags;
+  ON_SimpleArray<unsigned int> m_stamp;// changes when a vertex changes
+  ON_SimpleArray<int> m_part;          // partition index or -1
+
+  // face corners, corner 3*fi+k is the k-th corner of face fi
+  ON_SimpleArray<int> m_ftv;           // topological vertex, m_ftv[3*fi] = -1 for deleted faces
+  ON_SimpleArray<int> m_fvi;           // mesh vertex
+  ON_SimpleArray<int> m_cnext;         // next corner in the vertex corner list
+
+  // mesh vertices
+  ON_SimpleArray<int> m_topv_map;
+  bool m_bFaceNormals;
+  ON_3fVectorArray m_N;
+  ON_2fPointArray m_T;
+  ON_2dPointArray m_S;
+  ON_SimpleArray<ON_Color> m_C;
+  ON_ClassArray<ON_TextureCoordinates> m_TC;
+};
+
+ON_MeshDecimator::ON_MeshDecimator()
+: m_center(0.0,0.0,0.0)
+, m_V_count(0)
+, m_face_count(0)
+, m_max_cost(0.0)
+, m_bFaceNormals(false)
+{}
+
+int ON_MeshDecimator::FaceCount() const
+{
+  return m_face_count;
+}
+
+double ON_MeshDecimator::MaxCost() const
+{
+  return m_max_cost;
+}
+
+bool ON_MeshDecimator::Allowed( int tv, int partition ) const
+{
+  return ( partition < 0 ) 
+         ? (0 == (m_vflags[tv] & ON_DECIMATE_DELETED_VERTEX))
+         : (partition == m_part[tv]);
+}
+
+int ON_MeshDecimator::FaceCorner( int fi, int tv ) const
+{
+  const int* ftv = m_ftv.Array() + 3*fi;
+  return (ftv[0] == tv) ? 0 : ((ftv[1] == tv) ? 1 : ((ftv[2] == tv) ? 2 : -1));
+}
+
+void ON_MeshDecimator::GetRing( int tv, ON_SimpleArray<int>& corners )
+{
+  // gets the corners of live faces and removes deleted faces from the list
+  corners.SetCount(0);
+  int* cnext = m_cnext.Array();
+  int prev = -1;
+  for ( int c = m_vhead[tv]; c >= 0; c = cnext[c] )
+  {
+    if ( m_ftv[3*(c/3)] < 0 )
+    {
+      if ( prev < 0 )
+        m_vhead[tv] = cnext[c];
+      else
+        cnext[prev] = cnext[c];
+      continue;
+    }
+    corners.Append(c);
+    prev = c;
+  }
+}
+
+void ON_MeshDecimator::CleanRing( int tv )
+{
+  int* cnext = m_cnext.Array();
+  int prev = -1;
+  for ( int c = m_vhead[tv]; c >= 0; c = cnext[c] )
+  {
+    if ( m_ftv[3*(c/3)] < 0 )
+    {
+      if ( prev < 0 )
+        m_vhead[tv] = cnext[c];
+      else
+        cnext[prev] = cnext[c];
+    }
+    else
+      prev = c;
+  }
+}
+
+int ON_MeshDecimator::SharedFaces( int a, int b, int* fi ) const
+{
+  // fi[] gets up to 3 faces that use vertices a and b
+  int count = 0;
+  const int* cnext = m_cnext.Array();
+  for ( int c = m_vhead[a]; c >= 0; c = cnext[c] )
+  {
+    const int f = c/3;
+    const int* ftv = m_ftv.Array() + 3*f;
+    if ( ftv[0] < 0 )
+      continue;
+    if ( ftv[0] == b || ftv[1] == b || ftv[2] == b )
+    {
+      if ( count < 3 )
+        fi[count] = f;
+      count++;
+    }
+  }
+  return count;
+}
+
+bool ON_MeshDecimator::IsFeatureEdge( int a, int b ) const
+{
+  int fi[3];
+  if ( 2 != SharedFaces(a,b,fi) )
+    return true;
+  // seam if the faces use different mesh vertices at a or b
+  return (    m_fvi[3*fi[0] + FaceCorner(fi[0],a)] != m_fvi[3*fi[1] + FaceCorner(fi[1],a)]
+           || m_fvi[3*fi[0] + FaceCorner(fi[0],b)] != m_fvi[3*fi[1] + FaceCorner(fi[1],b)] );
+}
+
+bool ON_MeshDecimator::GetCollapse( int a, int b, ON_MeshDecimatorCollapse& c ) const
+{
+  const unsigned char fa = m_vflags[a];
+  const unsigned char fb = m_vflags[b];
+  if ( 0 != ((fa|fb) & ON_DECIMATE_DELETED_VERTEX) )
+    return false;
+
+  double q[10];
+  const double* qa = m_Q.Array() + 10*a;
+  const double* qb = m_Q.Array() + 10*b;
+  for ( int i = 0; i < 10; i++ )
+    q[i] = qa[i] + qb[i];
+
+  const ON_3dPoint& A = m_P[a];
+  const ON_3dPoint& B = m_P[b];
+  c.m_cost = ON_DBL_MAX;
+
+  if ( 0 == fa && 0 == fb )
+  {
+    // two interior vertices - move a to the quadric minimum
+    c.m_u = a;
+    c.m_v = b;
+    const ON_3dPoint M = 0.5*(A+B);
+    double X[3];
+    if (    ON_QuadricMinimum(q,X) 
+         && M.DistanceTo(ON_3dPoint(X)) <= 0.5*A.DistanceTo(B) )
+    {
+      c.m_cost = ON_QuadricValue(q,X);
+      c.m_X[0] = X[0]; c.m_X[1] = X[1]; c.m_X[2] = X[2];
+      return true;
+    }
+
+    // The quadric is nearly singular or its minimum is far from
+    // the edge. Use the minimum on the edge.
+    const double e0 = ON_QuadricValue(q,&A.x);
+    const double e1 = ON_QuadricValue(q,&B.x);
+    const double em = ON_QuadricValue(q,&M.x);
+    const double a2 = 2.0*(e0 + e1) - 4.0*em;
+    const double a1 = 4.0*em - 3.0*e0 - e1;
+    double s = (a2 > 0.0) ? -0.5*a1/a2 : ((e1 < e0) ? 1.0 : 0.0);
+    if ( s < 0.0 ) s = 0.0; else if ( s > 1.0 ) s = 1.0;
+    const ON_3dPoint P = A + s*(B-A);
+    c.m_cost = ON_QuadricValue(q,&P.x);
+    c.m_X[0] = P.x; c.m_X[1] = P.y; c.m_X[2] = P.z;
+    return true;
+  }
+
+  // Remove b into a or a into b without moving the vertex that is kept.
+  const bool bFeatureEdge = ( 0 != (fa & ON_DECIMATE_FEATURE_VERTEX) && 0 != (fb & ON_DECIMATE_FEATURE_VERTEX) )
+                          ? IsFeatureEdge(a,b)
+                          : false;
+  bool rc = false;
+  for ( int pass = 0; pass < 2; pass++ )
+  {
+    const int u = pass ? b : a;
+    const int v = pass ? a : b;
+    const unsigned char fv = pass ? fa : fb;
+    const unsigned char fu = pass ? fb : fa;
+    if ( 0 != (fv & ON_DECIMATE_LOCKED_VERTEX) )
+      continue;
+    if ( 0 != (fv & ON_DECIMATE_FEATURE_VERTEX) && (!bFeatureEdge || 0 == (fu & ON_DECIMATE_FEATURE_VERTEX)) )
+      continue;
+    const ON_3dPoint& U = m_P[u];
+    const double e = ON_QuadricValue(q,&U.x);
+    if ( e < c.m_cost )
+    {
+      c.m_cost = e;
+      c.m_u = u;
+      c.m_v = v;
+      c.m_X[0] = U.x; c.m_X[1] = U.y; c.m_X[2] = U.z;
+      rc = true;
+    }
+  }
+  return rc;
+}
+
+void ON_MeshDecimator::GetNeighbors( const ON_SimpleArray<int>& corners, int tv, ON_SimpleArray<int>& neighbors ) const
+{
+  // Vertices are collected with a linear search instead of marks so
+  // partitions can be decimated at the same time.
+  neighbors.SetCount(0);
+  for ( int i = 0; i < corners.Count(); i++ )
+  {
+    const int* ftv = m_ftv.Array() + 3*(corners[i]/3);
+    for ( int k = 0; k < 3; k++ )
+    {
+      const int w = ftv[k];
+      if ( w == tv )
+        continue;
+      int j;
+      for ( j = 0; j < neighbors.Count(); j++ )
+      {
+        if ( neighbors[j] == w )
+          break;
+      }
+      if ( j == neighbors.Count() )
+        neighbors.Append(w);
+    }
+  }
+}
+
+void ON_MeshDecimator::PushCollapses( 
+  int tv,
+  int partition,
+  int min_tv,
+  ON_SimpleArray<int>& corners,
+  ON_SimpleArray<int>& neighbors,
+  ON_SimpleArray<ON_MeshDecimatorCollapse>& heap
+  )
+{
+  // push collapses for the edges from tv to allowed vertices > min_tv
+  ON_MeshDecimatorCollapse c;
+  GetRing(tv,corners);
+  GetNeighbors(corners,tv,neighbors);
+  for ( int i = 0; i < neighbors.Count(); i++ )
+  {
+    const int w = neighbors[i];
+    if ( w <= min_tv || !Allowed(w,partition) )
+      continue;
+    if ( GetCollapse(tv,w,c) )
+    {
+      c.m_u_stamp = m_stamp[c.m_u];
+      c.m_v_stamp = m_stamp[c.m_v];
+      ON_MeshDecimatorHeapPush(heap,c);
+    }
+  }
+}
+
+void ON_MeshDecimator::LerpAttributes( int vi0, int vi1, double s )
+{
+  // attributes of mesh vertex vi0 = (1-s)*vi0 + s*vi1
+  const double r = 1.0-s;
+  if ( m_N.Count() == m_V_count )
+  {
+    ON_3fVector N = r*m_N[vi0] + s*m_N[vi1];
+    if ( N.Unitize() )
+      m_N[vi0] = N;
+  }
+  if ( m_T.Count() == m_V_count )
+    m_T[vi0] = r*m_T[vi0] + s*m_T[vi1];
+  if ( m_S.Count() == m_V_count )
+    m_S[vi0] = r*m_S[vi0] + s*m_S[vi1];
+  if ( m_C.Count() == m_V_count )
+  {
+    const ON_Color c0 = m_C[vi0];
+    const ON_Color c1 = m_C[vi1];
+    m_C[vi0].SetRGB( (int)floor(r*c0.Red() + s*c1.Red() + 0.5),
+                     (int)floor(r*c0.Green() + s*c1.Green() + 0.5),
+                     (int)floor(r*c0.Blue() + s*c1.Blue() + 0.5) );
+  }
+  for ( int i = 0; i < m_TC.Count(); i++ )
+  {
+    ON_SimpleArray<ON_3fPoint>& T = m_TC[i].m_T;
+    if ( T.Count() == m_V_count )
+      T[vi0] = r*T[vi0] + s*T[vi1];
+  }
+}
+
+int ON_MeshDecimator::Collapse( 
+  const ON_MeshDecimatorCollapse& c,
+  int partition,
+  ON_SimpleArray<int>* scratch,
+  ON_SimpleArray<ON_MeshDecimatorCollapse>& heap
+  )
+{
+  const int u = c.m_u;
+  const int v = c.m_v;
+  int i, k, shared_count = 0, shared_fi[2], opposite[2];
+  ON_SimpleArray<int>& ucorners = scratch[0];
+  ON_SimpleArray<int>& vcorners = scratch[1];
+  ON_SimpleArray<int>& uneighbors = scratch[2];
+  ON_SimpleArray<int>& vneighbors = scratch[3];
+  int* ftv = m_ftv.Array();
+  int* fvi = m_fvi.Array();
+
+  GetRing(u,ucorners);
+  GetRing(v,vcorners);
+  for ( i = 0; i < vcorners.Count(); i++ )
+  {
+    const int f = vcorners[i]/3;
+    if ( FaceCorner(f,u) >= 0 )
+    {
+      if ( shared_count >= 2 )
+        return 0;
+      shared_fi[shared_count++] = f;
+    }
+  }
+  if ( shared_count < 1 || ucorners.Count() <= shared_count )
+    return 0;
+
+  // Link condition: the only vertices next to both u and v are the
+  // vertices opposite the edge in the shared faces.
+  GetNeighbors(ucorners,u,uneighbors);
+  GetNeighbors(vcorners,v,vneighbors);
+  int common_count = 0;
+  for ( i = 0; i < vneighbors.Count(); i++ )
+  {
+    for ( k = 0; k < uneighbors.Count(); k++ )
+    {
+      if ( vneighbors[i] == uneighbors[k] )
+      {
+        common_count++;
+        break;
+      }
+    }
+  }
+  for ( i = 0; i < shared_count; i++ )
+  {
+    const int* t = ftv + 3*shared_fi[i];
+    opposite[i] = (t[0] != u && t[0] != v) ? t[0] : ((t[1] != u && t[1] != v) ? t[1] : t[2]);
+  }
+  if ( common_count != shared_count || (2 == shared_count && opposite[0] == opposite[1]) )
+    return 0;
+
+  // Mesh vertex of u that replaces each mesh vertex of v.  
+  int vvi[2], uvi[2], map_count = 0;
+  for ( i = 0; i < shared_count; i++ )
+  {
+    const int f = shared_fi[i];
+    const int a = fvi[3*f + FaceCorner(f,v)];
+    const int b = fvi[3*f + FaceCorner(f,u)];
+    for ( k = 0; k < map_count; k++ )
+    {
+      if ( vvi[k] == a )
+        break;
+    }
+    if ( k < map_count )
+    {
+      if ( uvi[k] != b )
+        return 0;
+    }
+    else
+    {
+      vvi[map_count] = a;
+      uvi[map_count] = b;
+      map_count++;
+    }
+  }
+  for ( i = 0; i < vcorners.Count(); i++ )
+  {
+    const int vi = fvi[vcorners[i]];
+    for ( k = 0; k < map_count; k++ )
+    {
+      if ( vvi[k] == vi )
+        break;
+    }
+    if ( k == map_count )
+      return 0;
+  }
+
+  // Make sure no faces flip.
+  const ON_3dPoint X(c.m_X[0],c.m_X[1],c.m_X[2]);
+  const bool bMoveU = ( X != m_P[u] );
+  for ( int pass = 0; pass < (bMoveU ? 2 : 1); pass++ )
+  {
+    const ON_SimpleArray<int>& corners = pass ? ucorners : vcorners;
+    const int moving = pass ? u : v;
+    const int other = pass ? v : u;
+    for ( i = 0; i < corners.Count(); i++ )
+    {
+      const int f = corners[i]/3;
+      const int* t = ftv + 3*f;
+      if ( t[0] == other || t[1] == other || t[2] == other )
+        continue;
+      const int j = corners[i] - 3*f;
+      if ( ON_MeshDecimatorFlips( &m_P[moving].x, &m_P[t[(j+1)%3]].x, &m_P[t[(j+2)%3]].x, &X.x ) )
+        return 0;
+    }
+  }
+
+  // Collapse v into u.
+  for ( i = 0; i < shared_count; i++ )
+    ftv[3*shared_fi[i]] = -1;
+  for ( i = 0; i < vcorners.Count(); i++ )
+  {
+    const int corner = vcorners[i];
+    if ( ftv[3*(corner/3)] < 0 )
+      continue;
+    ftv[corner] = u;
+    for ( k = 0; k < map_count; k++ )
+    {
+      if ( vvi[k] == fvi[corner] )
+      {
+        fvi[corner] = uvi[k];
+        break;
+      }
+    }
+  }
+
+  if ( bMoveU )
+  {
+    // u and v are interior vertices with one mesh vertex each
+    const ON_3dVector D = m_P[v] - m_P[u];
+    const double dd = D*D;
+    double s = (dd > 0.0) ? ((X - m_P[u])*D)/dd : 0.5;
+    if ( s < 0.0 ) s = 0.0; else if ( s > 1.0 ) s = 1.0;
+    LerpAttributes( uvi[0], vvi[0], s );
+  }
+
+  // Join the corner lists of u and v.
+  int* cnext = m_cnext.Array();
+  int head = -1;
+  for ( int pass = 0; pass < 2; pass++ )
+  {
+    const ON_SimpleArray<int>& corners = pass ? ucorners : vcorners;
+    for ( i = 0; i < corners.Count(); i++ )
+    {
+      const int corner = corners[i];
+      if ( ftv[3*(corner/3)] < 0 )
+        continue;
+      cnext[corner] = head;
+      head = corner;
+    }
+  }
+  m_vhead[u] = head;
+  m_vhead[v] = -1;
+  for ( i = 0; i < shared_count; i++ )
+  {
+    // vertices on a partition boundary are shared with other partitions
+    if ( Allowed(opposite[i],partition) )
+      CleanRing(opposite[i]);
+  }
+
+  m_P[u] = X;
+  double* qu = m_Q.Array() + 10*u;
+  const double* qv = m_Q.Array() + 10*v;
+  for ( k = 0; k < 10; k++ )
+    qu[k] += qv[k];
+  m_vflags[v] |= ON_DECIMATE_DELETED_VERTEX;
+  m_stamp[u]++;
+  m_stamp[v]++;
+
+  PushCollapses( u, partition, -1, ucorners, uneighbors, heap );
+  return shared_count;
+}
+
+bool ON_MeshDecimator::Create( const ON_Mesh& mesh )
+{
+  const ON_MeshTopology& top = mesh.Topology();
+  const int tv_count = top.m_topv.Count();
+  const int F_count = mesh.m_F.Count();
+  m_V_count = mesh.m_V.Count();
+  if ( tv_count < 3 || F_count < 1 || top.m_topv_map.Count() != m_V_count )
+    return false;
+
+  m_topv_map = top.m_topv_map;
+  m_bFaceNormals = mesh.HasFaceNormals();
+  if ( mesh.HasVertexNormals() )
+    m_N = mesh.m_N;
+  if ( mesh.HasTextureCoordinates() )
+    m_T = mesh.m_T;
+  if ( mesh.HasSurfaceParameters() )
+    m_S = mesh.m_S;
+  if ( mesh.HasVertexColors() )
+    m_C = mesh.m_C;
+  m_TC = mesh.m_TC;
+
+  const bool bDoubles = mesh.HasDoublePrecisionVertices() && mesh.DoublePrecisionVerticesAreValid();
+  const ON_3dPoint* dV = bDoubles ? mesh.DoublePrecisionVertices().Array() : 0;
+  ON_BoundingBox bbox = mesh.BoundingBox();
+  m_center = bbox.IsValid() ? ON_3dVector(bbox.Center()) : ON_3dVector(0.0,0.0,0.0);
+  int i, k, fi;
+  m_P.Reserve(tv_count);
+  for ( i = 0; i < tv_count; i++ )
+  {
+    const int vi = top.m_topv[i].m_vi[0];
+    m_P.Append( (dV ? dV[vi] : ON_3dPoint(mesh.m_V[vi])) - m_center );
+  }
+
+  // triangles
+  m_ftv.Reserve(6*F_count);
+  m_fvi.Reserve(6*F_count);
+  for ( fi = 0; fi < F_count; fi++ )
+  {
+    const ON_MeshFace& f = mesh.m_F[fi];
+    if ( !f.IsValid(m_V_count) )
+      continue;
+    int tri[6] = {f.vi[0],f.vi[1],f.vi[2],f.vi[2],f.vi[3],f.vi[0]};
+    int tri_count = 1;
+    if ( f.IsQuad() )
+    {
+      tri_count = 2;
+      if ( m_P[m_topv_map[f.vi[0]]].DistanceTo(m_P[m_topv_map[f.vi[2]]]) 
+           > m_P[m_topv_map[f.vi[1]]].DistanceTo(m_P[m_topv_map[f.vi[3]]]) )
+      {
+        tri[0] = f.vi[1]; tri[1] = f.vi[2]; tri[2] = f.vi[3];
+        tri[3] = f.vi[3]; tri[4] = f.vi[0]; tri[5] = f.vi[1];
+      }
+    }
+    for ( i = 0; i < tri_count; i++ )
+    {
+      const int* t = tri + 3*i;
+      const int t0 = m_topv_map[t[0]], t1 = m_topv_map[t[1]], t2 = m_topv_map[t[2]];
+      if ( t0 == t1 || t1 == t2 || t2 == t0 )
+        continue;
+      m_ftv.Append(t0); m_ftv.Append(t1); m_ftv.Append(t2);
+      m_fvi.Append(t[0]); m_fvi.Append(t[1]); m_fvi.Append(t[2]);
+    }
+  }
+  m_face_count = m_ftv.Count()/3;
+  if ( m_face_count < 1 )
+    return false;
+
+  // vertex corner lists
+  m_vhead.Reserve(tv_count);
+  m_vhead.SetCount(tv_count);
+  m_vhead.MemSet(0xFF);
+  m_cnext.Reserve(3*m_face_count);
+  m_cnext.SetCount(3*m_face_count);
+  for ( i = 3*m_face_count-1; i >= 0; i-- )
+  {
+    m_cnext[i] = m_vhead[m_ftv[i]];
+    m_vhead[m_ftv[i]] = i;
+  }
+
+  // face plane quadrics
+  m_Q.Reserve(10*tv_count);
+  m_Q.SetCount(10*tv_count);
+  m_Q.Zero();
+  for ( fi = 0; fi < m_face_count; fi++ )
+  {
+    const int* t = m_ftv.Array() + 3*fi;
+    ON_3dVector n = ON_CrossProduct( m_P[t[1]] - m_P[t[0]], m_P[t[2]] - m_P[t[0]] );
+    if ( !n.Unitize() )
+      continue;
+    const double d = -(n.x*m_P[t[0]].x + n.y*m_P[t[0]].y + n.z*m_P[t[0]].z);
+    for ( k = 0; k < 3; k++ )
+      ON_QuadricAddPlane( m_Q.Array() + 10*t[k], n.x, n.y, n.z, d );
+  }
+
+  // Classify vertices.  Feature edges get the plane through the
+  // edge that is perpendicular to each face on the edge.
+  m_vflags.Reserve(tv_count);
+  m_vflags.SetCount(tv_count);
+  m_vflags.Zero();
+  m_stamp.Reserve(tv_count);
+  m_stamp.SetCount(tv_count);
+  m_stamp.Zero();
+  ON_SimpleArray<int> corners, neighbors;
+  for ( i = 0; i < tv_count; i++ )
+  {
+    int feature_count = 0;
+    bool bLocked = false;
+    bool bSeveralVertices = false;
+    GetRing(i,corners);
+    GetNeighbors(corners,i,neighbors);
+    for ( k = 1; k < corners.Count() && !bSeveralVertices; k++ )
+      bSeveralVertices = ( m_fvi[corners[k]] != m_fvi[corners[0]] );
+    const int face_count = corners.Count();
+    const int neighbor_count = neighbors.Count();
+    for ( k = 0; k < neighbor_count; k++ )
+    {
+      const int w = neighbors[k];
+      int shared_fi[3];
+      const int shared_count = SharedFaces(i,w,shared_fi);
+      if ( shared_count > 2 )
+        bLocked = true;
+      if ( !IsFeatureEdge(i,w) )
+        continue;
+      feature_count++;
+      if ( i < w && shared_count <= 2 )
+      {
+        for ( int j = 0; j < shared_count; j++ )
+        {
+          const int* s = m_ftv.Array() + 3*shared_fi[j];
+          const ON_3dVector n = ON_CrossProduct( m_P[s[1]] - m_P[s[0]], m_P[s[2]] - m_P[s[0]] );
+          ON_3dVector m = ON_CrossProduct( m_P[w] - m_P[i], n );
+          if ( !m.Unitize() )
+            continue;
+          const double d = -(m*m_P[i]);
+          ON_QuadricAddPlane( m_Q.Array() + 10*i, m.x, m.y, m.z, d );
+          ON_QuadricAddPlane( m_Q.Array() + 10*w, m.x, m.y, m.z, d );
+        }
+      }
+    }
+    unsigned char flags = 0;
+    if ( face_count < 1 )
+      bLocked = true;
+    else if ( feature_count > 0 )
+    {
+      // A boundary vertex has an open fan and a seam vertex has
+      // a closed fan that is split into two mesh vertices.
+      flags = ON_DECIMATE_FEATURE_VERTEX;
+      if ( 2 != feature_count || (neighbor_count != face_count+1 && neighbor_count != face_count) )
+        bLocked = true;
+    }
+    else if ( neighbor_count != face_count || bSeveralVertices )
+      bLocked = true; // nonmanifold fan
+    if ( bLocked )
+      flags |= (ON_DECIMATE_FEATURE_VERTEX|ON_DECIMATE_LOCKED_VERTEX);
+    m_vflags[i] = flags;
+  }
+
+  m_part.Reserve(tv_count);
+  m_part.SetCount(tv_count);
+  return true;
+}
+
+int ON_MeshDecimator::CreatePartitions( int partition_count, int* partition_face_count )
+{
+  // Split the vertices into slabs with the same number of vertices
+  // along the longest side of the bounding box.  A vertex is in a
+  // partition when every face around it is inside the slab, so
+  // partitions can be decimated at the same time.
+  const int tv_count = m_P.Count();
+  int i, k;
+  ON_BoundingBox bbox;
+  for ( i = 0; i < tv_count; i++ )
+  {
+    if ( m_vhead[i] >= 0 )
+      bbox.Set(m_P[i],bbox.IsValid());
+  }
+  if ( !bbox.IsValid() )
+    return 0;
+  const ON_3dVector D = bbox.Diagonal();
+  const int axis = (D.x >= D.y && D.x >= D.z) ? 0 : ((D.y >= D.z) ? 1 : 2);
+
+  ON_SimpleArray<double> x(tv_count);
+  for ( i = 0; i < tv_count; i++ )
+  {
+    if ( m_vhead[i] >= 0 )
+      x.Append(m_P[i][axis]);
+  }
+  x.QuickSort( ON_CompareIncreasing<double> );
+  ON_SimpleArray<double> split(partition_count);
+  for ( k = 1; k < partition_count; k++ )
+    split.Append( x[(int)(((ON__INT64)k*x.Count())/partition_count)] );
+
+  int* slab = m_part.Array();
+  for ( i = 0; i < tv_count; i++ )
+  {
+    const double t = m_P[i][axis];
+    for ( k = 0; k < split.Count() && t >= split[k]; k++ )
+    {
+      // empty loop
+    }
+    slab[i] = k;
+  }
+
+  ON_SimpleArray<char> bFree(tv_count);
+  bFree.SetCount(tv_count);
+  bFree.MemSet(1);
+  for ( k = 0; k < partition_count; k++ )
+    partition_face_count[k] = 0;
+  const int F_count = m_ftv.Count()/3;
+  for ( int fi = 0; fi < F_count; fi++ )
+  {
+    const int* t = m_ftv.Array() + 3*fi;
+    if ( t[0] < 0 )
+      continue;
+    if ( slab[t[0]] == slab[t[1]] && slab[t[0]] == slab[t[2]] )
+      partition_face_count[slab[t[0]]]++;
+    else
+      bFree[t[0]] = bFree[t[1]] = bFree[t[2]] = 0;
+  }
+  for ( i = 0; i < tv_count; i++ )
+  {
+    if ( !bFree[i] || m_vhead[i] < 0 || 0 != (m_vflags[i] & ON_DECIMATE_DELETED_VERTEX) )
+      slab[i] = -1;
+  }
+  return partition_count;
+}
+
+int ON_MeshDecimator::RunPartition( 
+  int partition, 
+  int face_count, 
+  int target_face_count,
+  double max_cost,
+  double* collapse_cost
+  )
+{
+  const int tv_count = m_P.Count();
+  ON_SimpleArray<int> scratch[4];
+  ON_SimpleArray<ON_MeshDecimatorCollapse> heap;
+  ON_MeshDecimatorCollapse c;
+  int tv;
+
+  for ( tv = 0; tv < tv_count; tv++ )
+  {
+    if ( Allowed(tv,partition) )
+      PushCollapses( tv, partition, tv, scratch[0], scratch[1], heap );
+  }
+
+  const int face_count0 = face_count;
+  while ( face_count > target_face_count && ON_MeshDecimatorHeapPop(heap,c) )
+  {
+    if ( c.m_cost > max_cost )
+      break;
+    if ( c.m_u_stamp != m_stamp[c.m_u] || c.m_v_stamp != m_stamp[c.m_v] )
+      continue;
+    if ( 0 != ((m_vflags[c.m_u] | m_vflags[c.m_v]) & ON_DECIMATE_DELETED_VERTEX) )
+      continue;
+    const int removed_count = Collapse( c, partition, scratch, heap );
+    if ( removed_count > 0 )
+    {
+      face_count -= removed_count;
+      if ( c.m_cost > *collapse_cost )
+        *collapse_cost = c.m_cost;
+    }
+  }
+
+  return face_count0 - face_count;
+}
+
+struct ON_MeshDecimatorJob
+{
+  ON_MeshDecimator* m_decimator;
+  const int* m_face_count;
+  const int* m_target_face_count;
+  double m_max_cost;
+  int* m_removed_count;
+  double* m_collapse_cost;
+};
+
+static void ON_MeshDecimatorTask( void* context, int i )
+{
+  ON_MeshDecimatorJob* job = (ON_MeshDecimatorJob*)context;
+  job->m_removed_count[i] = job->m_decimator->RunPartition( 
+                                      i, 
+                                      job->m_face_count[i], 
+                                      job->m_target_face_count[i], 
+                                      job->m_max_cost, 
+                                      &job->m_collapse_cost[i] 
+                                      );
+}
+
+bool ON_MeshDecimator::Run( int target_face_count, double max_cost, int thread_count )
+{
+  if ( m_face_count <= 0 )
+    return false;
+  if ( target_face_count < 0 )
+    target_face_count = 0;
+  if ( thread_count <= 0 )
+    thread_count = ON_ProcessorCount();
+
+  if ( thread_count > 1 && m_face_count >= 2048*thread_count && m_face_count > target_face_count )
+  {
+    // Decimate the inside of each partition in its own thread and
+    // leave the faces between partitions for the serial pass.
+    const int partition_count = thread_count;
+    ON_SimpleArray<int> face_count(partition_count);
+    ON_SimpleArray<int> target(partition_count);
+    ON_SimpleArray<int> removed_count(partition_count);
+    ON_SimpleArray<double> collapse_cost(partition_count);
+    face_count.SetCount(partition_count);
+    target.SetCount(partition_count);
+    removed_count.SetCount(partition_count);
+    removed_count.Zero();
+    collapse_cost.SetCount(partition_count);
+    collapse_cost.Zero();
+    if ( partition_count == CreatePartitions( partition_count, face_count.Array() ) )
+    {
+      // Partitions stop at twice their share of the target so the
+      // last collapses are picked in global cost order.
+      const double r = ((double)target_face_count)/((double)m_face_count);
+      for ( int i = 0; i < partition_count; i++ )
+        target[i] = (int)ceil(2.0*r*face_count[i]);
+
+      ON_MeshDecimatorJob job;
+      job.m_decimator = this;
+      job.m_face_count = face_count.Array();
+      job.m_target_face_count = target.Array();
+      job.m_max_cost = max_cost;
+      job.m_removed_count = removed_count.Array();
+      job.m_collapse_cost = collapse_cost.Array();
+      ON_ParallelFor( thread_count, partition_count, ON_MeshDecimatorTask, &job );
+
+      for ( int i = 0; i < partition_count; i++ )
+      {
+        m_face_count -= removed_count[i];
+        if ( collapse_cost[i] > m_max_cost )
+          m_max_cost = collapse_cost[i];
+      }
+    }
+  }
+
+  const int tv_count = m_P.Count();
+  ON_SimpleArray<int> scratch[4];
+  ON_SimpleArray<ON_MeshDecimatorCollapse> heap;
+  ON_MeshDecimatorCollapse c;
+  int tv;
+  for ( tv = 0; tv < tv_count && m_face_count > target_face_count; tv++ )
+  {
+    if ( Allowed(tv,-1) )
+      PushCollapses( tv, -1, tv, scratch[0], scratch[1], heap );
+  }
+
+  while ( m_face_count > target_face_count && ON_MeshDecimatorHeapPop(heap,c) )
+  {
+    if ( c.m_cost > max_cost )
+      break;
+    if ( c.m_u_stamp != m_stamp[c.m_u] || c.m_v_stamp != m_stamp[c.m_v] )
+      continue;
+    if ( 0 != ((m_vflags[c.m_u] | m_vflags[c.m_v]) & ON_DECIMATE_DELETED_VERTEX) )
+      continue;
+    const int removed_count = Collapse( c, -1, scratch, heap );
+    if ( removed_count > 0 )
+    {
+      m_face_count -= removed_count;
+      if ( c.m_cost > m_max_cost )
+        m_max_cost = c.m_cost;
+    }
+  }
+
+  return true;
+}
+
+bool ON_MeshDecimator::GetMesh( ON_Mesh& mesh ) const
+{
+  const int F_count = m_ftv.Count()/3;
+  if ( m_face_count < 1 )
+    return false;
+
+  ON_SimpleArray<int> vmap(m_V_count);
+  vmap.SetCount(m_V_count);
+  vmap.MemSet(0xFF);
+  ON_SimpleArray<int> vi_list(m_V_count);
+  ON_SimpleArray<int> tv_list(m_V_count);
+
+  mesh.DestroyTopology();
+  mesh.DestroyPartition();
+  mesh.DestroyTree();
+  mesh.DestroyHiddenVertexArray();
+  mesh.DestroyDoublePrecisionVertices();
+  mesh.m_K.Destroy();
+  mesh.m_FN.Destroy();
+  mesh.m_F.Destroy();
+  mesh.m_F.Reserve(m_face_count);
+
+  int fi, k;
+  for ( fi = 0; fi < F_count; fi++ )
+  {
+    const int* ftv = m_ftv.Array() + 3*fi;
+    if ( ftv[0] < 0 )
+      continue;
+    const int* fvi = m_fvi.Array() + 3*fi;
+    ON_MeshFace& f = mesh.m_F.AppendNew();
+    for ( k = 0; k < 3; k++ )
+    {
+      int& vi = vmap[fvi[k]];
+      if ( vi < 0 )
+      {
+        vi = vi_list.Count();
+        vi_list.Append(fvi[k]);
+        tv_list.Append(ftv[k]);
+      }
+      f.vi[k] = vi;
+    }
+    f.vi[3] = f.vi[2];
+  }
+
+  const int V_count = vi_list.Count();
+  mesh.m_V.SetCount(0);
+  mesh.m_V.Reserve(V_count);
+  for ( k = 0; k < V_count; k++ )
+    mesh.m_V.Append( ON_3fPoint(m_P[tv_list[k]] + m_center) );
+
+  mesh.m_N.SetCount(0);
+  if ( m_N.Count() == m_V_count )
+  {
+    mesh.m_N.Reserve(V_count);
+    for ( k = 0; k < V_count; k++ )
+      mesh.m_N.Append(m_N[vi_list[k]]);
+  }
+  mesh.m_T.SetCount(0);
+  if ( m_T.Count() == m_V_count )
+  {
+    mesh.m_T.Reserve(V_count);
+    for ( k = 0; k < V_count; k++ )
+      mesh.m_T.Append(m_T[vi_list[k]]);
+  }
+  mesh.m_S.SetCount(0);
+  if ( m_S.Count() == m_V_count )
+  {
+    mesh.m_S.Reserve(V_count);
+    for ( k = 0; k < V_count; k++ )
+      mesh.m_S.Append(m_S[vi_list[k]]);
+  }
+  mesh.m_C.SetCount(0);
+  if ( m_C.Count() == m_V_count )
+  {
+    mesh.m_C.Reserve(V_count);
+    for ( k = 0; k < V_count; k++ )
+      mesh.m_C.Append(m_C[vi_list[k]]);
+  }
+  mesh.m_TC = m_TC;
+  for ( int i = 0; i < m_TC.Count(); i++ )
+  {
+    const ON_SimpleArray<ON_3fPoint>& T = m_TC[i].m_T;
+    ON_SimpleArray<ON_3fPoint>& meshT = mesh.m_TC[i].m_T;
+    meshT.SetCount(0);
+    if ( T.Count() == m_V_count )
+    {
+      meshT.Reserve(V_count);
+      for ( k = 0; k < V_count; k++ )
+        meshT.Append(T[vi_list[k]]);
+    }
+  }
+
+  if ( m_bFaceNormals )
+    mesh.ComputeFaceNormals();
+  mesh.InvalidateBoundingBoxes();
+  mesh.SetClosed(-1);
+  return true;
+}
+
+bool ON_Mesh::Decimate( int target_face_count, double max_error, int thread_count )
+{
+  const bool bErrorBound = ( max_error > 0.0 && ON_IsValid(max_error) );
+  if ( target_face_count < 0 )
+    target_face_count = 0;
+  if ( 0 == target_face_count && !bErrorBound )
+    return false;
+  if ( FaceCount() <= target_face_count )
+    return true;
+
+  ON_MeshDecimator decimator;
+  if ( !decimator.Create(*this) )
+    return false;
+  decimator.Run( target_face_count, bErrorBound ? max_error*max_error : ON_DBL_MAX, thread_count );
+  // The levels of detail were made from the mesh before decimation.
+  DestroyLevelsOfDetail();
+  return decimator.GetMesh(*this);
+}
+
+bool ON_Mesh::CreateLevelsOfDetail( int level_count, double reduction, int thread_count )
+{
+  DestroyLevelsOfDetail();
+  if ( level_count < 1 || !(reduction > 0.0 && reduction < 1.0) )
+    return false;
+
+  ON_MeshDecimator decimator;
+  if ( !decimator.Create(*this) )
+    return false;
+
+  ON_MeshLevelOfDetail* lod = new ON_MeshLevelOfDetail();
+  for ( int level = 0; level < level_count; level++ )
+  {
+    // Each level continues decimating the previous one so the
+    // quadrics and collapses are shared by all the levels.
+    const int face_count = decimator.FaceCount();
+    const int target_face_count = (int)floor(reduction*face_count);
+    if ( target_face_count < 1 )
+      break;
+    decimator.Run( target_face_count, ON_DBL_MAX, thread_count );
+    if ( decimator.FaceCount() >= face_count )
+      break;
+
+    ON_Mesh* mesh = new ON_Mesh();
+    mesh->m_Ttag = m_Ttag;
+    mesh->m_Ctag = m_Ctag;
+    mesh->m_packed_tex_domain[0] = m_packed_tex_domain[0];
+    mesh->m_packed_tex_domain[1] = m_packed_tex_domain[1];
+    mesh->m_packed_tex_rotate = m_packed_tex_rotate;
+    mesh->m_srf_domain[0] = m_srf_domain[0];
+    mesh->m_srf_domain[1] = m_srf_domain[1];
+    mesh->m_srf_scale[0] = m_srf_scale[0];
+    mesh->m_srf_scale[1] = m_srf_scale[1];
+    if ( !decimator.GetMesh(*mesh) )
+    {
+      delete mesh;
+      break;
+    }
+    lod->AddCoarserLevel( mesh, sqrt(decimator.MaxCost()) );
+  }
+
+  if ( lod->LevelCount() < 1 )
+  {
+    delete lod;
+    return false;
+  }
+  m_lod = lod;
+  return true;
+}
@@ -430,6 +430,7 @@ ON_SpaceMorph::ON_SpaceMorph()
   m_tolerance = 0.0;
   m_bQuickPreview = false;
   m_bPreserveStructure = false;
+  m_thread_count = 1;
 }
 
 ON_SpaceMorph::~ON_SpaceMorph()
@@ -456,6 +457,21 @@ ON_4dPoint ON_SpaceMorph::MorphPoint(
   return q;
 }
 
+void ON_SpaceMorph::MorphPoints(
+          int count,
+          ON_3dPoint* points
+          ) const
+{
+  if ( count > 0 && 0 != points )
+  {
+    while ( count-- )
+    {
+      *points = MorphPoint(*points);
+      points++;
+    }
+  }
+}
+
 bool ON_SpaceMorph::Ev1Der(
           ON_3dPoint rst,
           ON_3dPoint& xyz,
@@ -517,60 +533,162 @@ void ON_SpaceMorph::SetPreserveStructure( bool bPreserveStructure )
   m_bPreserveStructure = bPreserveStructure ? true : false;
 }
 
-void ON_SpaceMorph::MorphPointList(
+int ON_SpaceMorph::ThreadCount() const
+{
+  return m_thread_count;
+}
+
+void ON_SpaceMorph::SetThreadCount( int thread_count )
+{
+  m_thread_count = thread_count;
+}
+
+// Morphs count points in the calling thread.
+template <class T>
+static void ON_MorphPointListHelper(
+        const ON_SpaceMorph& morph,
         int dim, 
         int is_rat,
         int count, 
         int stride,
-        double* point
-        ) const
+        T* point
+        )
 {
-  if ( dim > 0 && stride >= (dim+(is_rat)?1:0) && count > 0 && point != 0 )
+  int i;
+  if ( is_rat )
   {
-    int i;
-    if ( is_rat )
+    ON_4dPoint p(0.0,0.0,0.0,1.0), q;
+    for ( i = 0; i < count; i++ )
     {
-      ON_4dPoint p(0.0,0.0,0.0,1.0), q;
-      for ( i = 0; i < count; i++ )
-      {
-        p.x = point[0];
-        if ( dim > 1 )
-          p.y = point[1];
-        if ( dim > 2 )
-          p.z = point[2];
-        p.w = point[dim];
-        q = MorphPoint(p);
-        point[0] = q.x;
-        if ( dim > 1 )
-          point[1] = q.y;
-        if ( dim > 2 )
-          point[2] = q.z;
-        point[dim] = q.w;
-        point += stride;
-      }
+      p.x = point[0];
+      if ( dim > 1 )
+        p.y = point[1];
+      if ( dim > 2 )
+        p.z = point[2];
+      p.w = point[dim];
+      q = morph.MorphPoint(p);
+      point[0] = (T)q.x;
+      if ( dim > 1 )
+        point[1] = (T)q.y;
+      if ( dim > 2 )
+        point[2] = (T)q.z;
+      point[dim] = (T)q.w;
+      point += stride;
     }
-    else
+  }
+  else
+  {
+    // The points are morphed in blocks so MorphPoints()
+    // overrides can evaluate many points at once and
+    // blocks the morph does not move are skipped.
+    ON_3dPoint P[64];
+    ON_BoundingBox bbox;
+    T* p;
+    int j, n;
+    for ( i = 0; i < count; i += n )
     {
-      ON_3dPoint p(0.0,0.0,0.0), q;
-      for ( i = 0; i < count; i++ )
+      n = count-i;
+      if ( n > 64 )
+        n = 64;
+      for ( j = 0, p = point; j < n; j++, p += stride )
+      {
+        P[j].x = p[0];
+        P[j].y = (dim > 1) ? p[1] : 0.0;
+        P[j].z = (dim > 2) ? p[2] : 0.0;
+      }
+      bbox.Set(3,0,n,3,&P[0].x,false);
+      if ( !morph.IsIdentity(bbox) )
       {
-        p.x = point[0];
-        if ( dim > 1 )
-          p.y = point[1];
-        if ( dim > 2 )
-          p.z = point[2];
-        q = MorphPoint(p);
-        point[0] = q.x;
-        if ( dim > 1 )
-          point[1] = q.y;
-        if ( dim > 2 )
-          point[2] = q.z;
-        point += stride;
+        morph.MorphPoints(n,P);
+        for ( j = 0, p = point; j < n; j++, p += stride )
+        {
+          p[0] = (T)P[j].x;
+          if ( dim > 1 )
+            p[1] = (T)P[j].y;
+          if ( dim > 2 )
+            p[2] = (T)P[j].z;
+        }
       }
+      point += n*stride;
     }
   }
 }
 
+template <class T>
+struct ON_MorphPointListJob
+{
+  const ON_SpaceMorph* m_morph;
+  int m_dim;
+  int m_is_rat;
+  int m_count;
+  int m_stride;
+  int m_range_count; // points per task
+  T* m_point;
+};
+
+template <class T>
+static void ON_MorphPointListTask( void* context, int i )
+{
+  const ON_MorphPointListJob<T>* job = (const ON_MorphPointListJob<T>*)context;
+  const int i0 = i*job->m_range_count;
+  int n = job->m_count - i0;
+  if ( n > job->m_range_count )
+    n = job->m_range_count;
+  ON_MorphPointListHelper( *job->m_morph, job->m_dim, job->m_is_rat, n, job->m_stride,
+                           job->m_point + ((size_t)i0)*job->m_stride );
+}
+
+template <class T>
+static void ON_MorphPointListParallel(
+        const ON_SpaceMorph& morph,
+        int dim, 
+        int is_rat,
+        int count, 
+        int stride,
+        T* point
+        )
+{
+  // Ranges are whole 64 point blocks and at least 4096 points 
+  // long so the thread start up cost is small compared to the
+  // time spent morphing.
+  int thread_count = morph.ThreadCount();
+  if ( thread_count <= 0 )
+    thread_count = ON_ProcessorCount();
+  int task_count = count/4096;
+  if ( task_count > 4*thread_count )
+    task_count = 4*thread_count;
+  if ( thread_count < 2 || task_count < 2 )
+  {
+    ON_MorphPointListHelper(morph,dim,is_rat,count,stride,point);
+    return;
+  }
+
+  ON_MorphPointListJob<T> job;
+  job.m_morph = &morph;
+  job.m_dim = dim;
+  job.m_is_rat = is_rat;
+  job.m_count = count;
+  job.m_stride = stride;
+  job.m_range_count = 64*((count/task_count + 63)/64);
+  job.m_point = point;
+  task_count = (count + job.m_range_count - 1)/job.m_range_count;
+  ON_ParallelFor( thread_count, task_count, ON_MorphPointListTask<T>, &job );
+}
+
+void ON_SpaceMorph::MorphPointList(
+        int dim, 
+        int is_rat,
+        int count, 
+        int stride,
+        double* point
+        ) const
+{
+  if ( dim > 0 && stride >= (dim+(is_rat)?1:0) && count > 0 && point != 0 )
+  {
+    ON_MorphPointListParallel(*this,dim,is_rat,count,stride,point);
+  }
+}
+
 void ON_SpaceMorph::MorphPointList(
         int dim, 
         int is_rat,
@@ -581,47 +699,7 @@ void ON_SpaceMorph::MorphPointList(
 {
   if ( dim > 0 && stride >= (dim+(is_rat)?1:0) && count > 0 && point != 0 )
   {
-    int i;
-    if ( is_rat )
-    {
-      ON_4dPoint p(0.0,0.0,0.0,1.0), q;
-      for ( i = 0; i < count; i++ )
-      {
-        p.x = point[0];
-        if ( dim > 1 )
-          p.y = point[1];
-        if ( dim > 2 )
-          p.z = point[2];
-        p.w = point[dim];
-        q = MorphPoint(p);
-        point[0] = (float)q.x;
-        if ( dim > 1 )
-          point[1] = (float)q.y;
-        if ( dim > 2 )
-          point[2] = (float)q.z;
-        point[dim] = (float)q.w;
-        point += stride;
-      }
-    }
-    else
-    {
-      ON_3dPoint p(0.0,0.0,0.0), q;
-      for ( i = 0; i < count; i++ )
-      {
-        p.x = point[0];
-        if ( dim > 1 )
-          p.y = point[1];
-        if ( dim > 2 )
-          p.z = point[2];
-        q = MorphPoint(p);
-        point[0] = (float)q.x;
-        if ( dim > 1 )
-          point[1] = (float)q.y;
-        if ( dim > 2 )
-          point[2] = (float)q.z;
-        point += stride;
-      }
-    }
+    ON_MorphPointListParallel(*this,dim,is_rat,count,stride,point);
   }
 }
 
@@ -915,6 +993,7 @@ bool ON_BezierSurface::Morph( const ON_SpaceMorph& morph )
 
 bool ON_Brep::Morph( const ON_SpaceMorph& morph )
 {
+  UnshareGeometry();
   bool rc = IsMorphable();
   if ( rc )
   {
@@ -17,6 +17,53 @@
 
 ON_OBJECT_IMPLEMENT(ON_NurbsCurve,ON_Curve,"4ED7D4DD-E947-11d3-BFE5-0010830122F0");
 
+class ON_NurbsCurveSpanCache
+{
+  // Runtime cache of span Taylor coefficients used by
+  // ON_NurbsCurve::Evaluate(). See ON_NurbsCurve::SetEvaluationCacheSize().
+public:
+  ON_NurbsCurveSpanCache( int span_count );
+
+  // Power basis coefficients lose precision as the degree 
+  // grows, so only quadratic and cubic spans are cached.
+  enum { min_order = 3, max_order = 4 };
+
+  // One thread at a time uses the cache.  Lock() returns false
+  // if another thread is using it.
+  bool Lock();
+  void Unlock();
+
+  void Empty();
+
+  // Returns most recently used span index or 0.
+  int LastSpanIndex() const;
+
+  // Returns Taylor coefficients of the span or 0 if they cannot be computed.
+  const double* SpanCoefficients( const ON_NurbsCurve& curve, int span_index, double* tm );
+
+  bool Evaluate( const ON_NurbsCurve& curve, int span_index, 
+                 double t, int der_count, int v_stride, double* v );
+
+  int m_lock;     // 1 while a thread is using the cache
+  int m_capacity; // maximum number of cached spans
+  int m_count;    // number of cached spans
+  int m_next;     // slot used by the next cache miss
+  int m_last;     // most recently used slot or -1
+
+  // curve settings when the cache was filled
+  int m_cvdim;
+  int m_order;
+  int m_cv_count;
+  int m_cv_stride;
+  const double* m_knot;
+  const double* m_cv;
+
+  ON_SimpleArray<int> m_span_index; // span index of each slot
+  ON_SimpleArray<double> m_tm;      // expansion parameter of each slot
+  ON_SimpleArray<double> m_coef;    // m_order*m_cvdim coefficients per slot
+  ON_SimpleArray<double> m_hv;      // rational evaluation workspace
+};
+
 ON_NurbsCurve* ON_NurbsCurve::New()
 {
   return new ON_NurbsCurve();
@@ -48,12 +95,16 @@ ON_NurbsCurve* ON_NurbsCurve::New(
 
 
 ON_NurbsCurve::ON_NurbsCurve()
+: m_span_cache(0)
+, m_tight_bbox_crc(0)
 {
   ON__SET__THIS__PTR(m_s_ON_NurbsCurve_ptr);
   Initialize();
 }
 
 ON_NurbsCurve::ON_NurbsCurve( const ON_NurbsCurve& src )
+: m_span_cache(0)
+, m_tight_bbox_crc(0)
 {
   ON__SET__THIS__PTR(m_s_ON_NurbsCurve_ptr);
   Initialize();
@@ -61,6 +112,8 @@ ON_NurbsCurve::ON_NurbsCurve( const ON_NurbsCurve& src )
 }
 
 ON_NurbsCurve::ON_NurbsCurve( int dim, ON_BOOL32 bIsRational, int order, int cv_count )
+: m_span_cache(0)
+, m_tight_bbox_crc(0)
 {
   ON__SET__THIS__PTR(m_s_ON_NurbsCurve_ptr);
   Initialize();
@@ -68,6 +121,8 @@ ON_NurbsCurve::ON_NurbsCurve( int dim, ON_BOOL32 bIsRational, int order, int cv_
 }
 
 ON_NurbsCurve::ON_NurbsCurve(const ON_BezierCurve& src)
+: m_span_cache(0)
+, m_tight_bbox_crc(0)
 {
   ON__SET__THIS__PTR(m_s_ON_NurbsCurve_ptr);
   Initialize();
@@ -77,6 +132,11 @@ ON_NurbsCurve::ON_NurbsCurve(const ON_BezierCurve& src)
 ON_NurbsCurve::~ON_NurbsCurve()
 {
   Destroy();
+  if ( m_span_cache )
+  {
+    delete m_span_cache;
+    m_span_cache = 0;
+  }
 }
 
 unsigned int ON_NurbsCurve::SizeOf() const
@@ -278,6 +338,7 @@ void ON_NurbsCurve::Destroy()
 void ON_NurbsCurve::EmergencyDestroy()
 {
   Initialize();
+  m_span_cache = 0;
 }
 
 
@@ -1354,7 +1415,10 @@ ON_NurbsCurve::Evaluate( // returns false if unable to evaluate
   if( m_order<2)      // GBA added 01-12-06 to fix crash bug
      return false;
 
-  int span_index = ON_NurbsSpanIndex(m_order,m_cv_count,m_knot,t,side,(hint)?*hint:0);
+  ON_NurbsCurveSpanCache* span_cache = (0 != m_span_cache && m_span_cache->Lock()) ? m_span_cache : 0;
+
+  int span_index = ON_NurbsSpanIndex(m_order,m_cv_count,m_knot,t,side,
+                                     (hint) ? *hint : ((span_cache) ? span_cache->LastSpanIndex() : 0));
 
   if ( -2 == side || 2 == side )
   {
@@ -1372,19 +1436,386 @@ ON_NurbsCurve::Evaluate( // returns false if unable to evaluate
     }
   }
 
-  rc = ON_EvaluateNurbsSpan(
-     m_dim, m_is_rat, m_order, 
-     m_knot + span_index, 
-     m_cv_stride, m_cv + (m_cv_stride*span_index),
-     der_count, 
-     t,
-     v_stride, v 
-     );
+  if ( span_cache )
+  {
+    rc = span_cache->Evaluate( *this, span_index, t, der_count, v_stride, v );
+    span_cache->Unlock();
+  }
+
+  if ( !rc )
+  {
+    rc = ON_EvaluateNurbsSpan(
+       m_dim, m_is_rat, m_order, 
+       m_knot + span_index, 
+       m_cv_stride, m_cv + (m_cv_stride*span_index),
+       der_count, 
+       t,
+       v_stride, v 
+       );
+  }
   if ( hint ) 
     *hint = span_index;
   return rc;
 }
 
+ON_NurbsCurveSpanCache::ON_NurbsCurveSpanCache( int span_count )
+: m_lock(0)
+, m_capacity(span_count > 0 ? span_count : 1)
+, m_count(0)
+, m_next(0)
+, m_last(-1)
+, m_cvdim(0)
+, m_order(0)
+, m_cv_count(0)
+, m_cv_stride(0)
+, m_knot(0)
+, m_cv(0)
+{
+  m_span_index.Reserve(m_capacity);
+  m_span_index.SetCount(m_capacity);
+  m_tm.Reserve(m_capacity);
+  m_tm.SetCount(m_capacity);
+}
+
+bool ON_NurbsCurveSpanCache::Lock()
+{
+  return 0 == ON_ATOMIC_COMPARE_AND_SWAP(&m_lock,0,1);
+}
+
+void ON_NurbsCurveSpanCache::Unlock()
+{
+  ON_ATOMIC_COMPARE_AND_SWAP(&m_lock,1,0);
+}
+
+void ON_NurbsCurveSpanCache::Empty()
+{
+  m_count = 0;
+  m_next = 0;
+  m_last = -1;
+  m_cvdim = 0;
+  m_order = 0;
+  m_cv_count = 0;
+  m_cv_stride = 0;
+  m_knot = 0;
+  m_cv = 0;
+  m_coef.Destroy();
+  m_hv.Destroy();
+}
+
+int ON_NurbsCurveSpanCache::LastSpanIndex() const
+{
+  return (m_last >= 0) ? m_span_index[m_last] : 0;
+}
+
+const double* ON_NurbsCurveSpanCache::SpanCoefficients( 
+        const ON_NurbsCurve& curve, 
+        int span_index,
+        double* tm
+        )
+{
+  const int cvdim = curve.m_is_rat ? curve.m_dim+1 : curve.m_dim;
+  int i;
+
+  if (    cvdim != m_cvdim || curve.m_order != m_order 
+       || curve.m_cv_count != m_cv_count || curve.m_cv_stride != m_cv_stride
+       || curve.m_knot != m_knot || curve.m_cv != m_cv )
+  {
+    // The curve was changed without calling DestroyRuntimeCache().
+    Empty();
+    m_cvdim = cvdim;
+    m_order = curve.m_order;
+    m_cv_count = curve.m_cv_count;
+    m_cv_stride = curve.m_cv_stride;
+    m_knot = curve.m_knot;
+    m_cv = curve.m_cv;
+  }
+
+  const int coef_size = m_order*m_cvdim;
+
+  // marching evaluations usually stay in the same span
+  if ( m_last >= 0 && span_index == m_span_index[m_last] )
+  {
+    *tm = m_tm[m_last];
+    return m_coef.Array() + m_last*coef_size;
+  }
+
+  for ( i = 0; i < m_count; i++ )
+  {
+    if ( span_index == m_span_index[i] )
+    {
+      m_last = i;
+      *tm = m_tm[i];
+      return m_coef.Array() + i*coef_size;
+    }
+  }
+
+  if ( m_coef.Count() != m_capacity*coef_size )
+  {
+    m_coef.Reserve(m_capacity*coef_size);
+    m_coef.SetCount(m_capacity*coef_size);
+  }
+
+  // replace the oldest span
+  i = m_next;
+  m_next = (m_next+1) % m_capacity;
+  if ( m_count < m_capacity )
+    m_count++;
+  m_span_index[i] = -1;
+  m_last = -1;
+
+  const double* knot = m_knot + span_index;
+  m_tm[i] = 0.5*(knot[m_order-2] + knot[m_order-1]);
+  if ( !ON_GetNurbsSpanTaylorCoefficients( m_cvdim, m_order, knot, 
+                                           m_cv_stride, m_cv + span_index*m_cv_stride,
+                                           m_tm[i], m_coef.Array() + i*coef_size ) )
+    return 0;
+
+  m_span_index[i] = span_index;
+  m_last = i;
+  *tm = m_tm[i];
+  return m_coef.Array() + i*coef_size;
+}
+
+bool ON_NurbsCurveSpanCache::Evaluate(
+        const ON_NurbsCurve& curve, 
+        int span_index, 
+        double t, 
+        int der_count, 
+        int v_stride, 
+        double* v
+        )
+{
+  if ( curve.m_order < min_order || curve.m_order > max_order )
+    return false;
+
+  // Parameters at the ends of the span are evaluated by 
+  // ON_EvaluateNurbsSpan() so the results are exact there.
+  const double* knot = curve.m_knot + span_index;
+  if ( t == knot[curve.m_order-2] || t == knot[curve.m_order-1] )
+    return false;
+
+  double tm;
+  const double* c = SpanCoefficients( curve, span_index, &tm );
+  if ( 0 == c )
+    return false;
+
+  if ( !curve.m_is_rat )
+    return ON_EvaluateTaylorPolynomial( m_cvdim, m_order, m_cvdim, c, der_count, t-tm, v_stride, v );
+
+  m_hv.Reserve((der_count+1)*m_cvdim);
+  double* hv = m_hv.Array();
+  if ( !ON_EvaluateTaylorPolynomial( m_cvdim, m_order, m_cvdim, c, der_count, t-tm, m_cvdim, hv ) )
+    return false;
+  if ( !ON_EvaluateQuotientRule( curve.m_dim, der_count, m_cvdim, hv ) )
+    return false;
+  for ( int d = 0; d <= der_count; d++, v += v_stride, hv += m_cvdim )
+    memcpy( v, hv, curve.m_dim*sizeof(v[0]) );
+  return true;
+}
+
+void ON_NurbsCurve::DestroyRuntimeCache( bool bDelete )
+{
+  ON_Curve::DestroyRuntimeCache(bDelete);
+  m_tight_bbox.Destroy();
+  if ( m_span_cache )
+  {
+    if ( bDelete )
+      m_span_cache->Empty();
+    else
+      m_span_cache = 0; // the cache memory is gone
+  }
+}
+
+void ON_NurbsCurve::SetEvaluationCacheSize( int span_count )
+{
+  if ( span_count < 0 )
+    span_count = 0;
+  if ( m_span_cache )
+  {
+    if ( span_count == m_span_cache->m_capacity )
+      return;
+    delete m_span_cache;
+    m_span_cache = 0;
+  }
+  if ( span_count > 0 )
+    m_span_cache = new ON_NurbsCurveSpanCache(span_count);
+}
+
+int ON_NurbsCurve::EvaluationCacheSize() const
+{
+  return (m_span_cache) ? m_span_cache->m_capacity : 0;
+}
+
+struct ON_NurbsCurveEvaluateManyJob
+{
+  const ON_NurbsCurve* m_curve;
+  int m_count;
+  int m_range_count; // parameters per task
+  const double* m_t;
+  int m_der_count;
+  double* m_v;
+  int m_v_stride;
+  int m_side;
+  unsigned char* m_rc;
+};
+
+static void ON_NurbsCurveEvaluateManyTask( void* context, int i )
+{
+  const ON_NurbsCurveEvaluateManyJob* job = (const ON_NurbsCurveEvaluateManyJob*)context;
+  const int i0 = i*job->m_range_count;
+  int n = job->m_count - i0;
+  if ( n > job->m_range_count )
+    n = job->m_range_count;
+  const size_t v_size = ((size_t)(job->m_der_count+1))*job->m_v_stride;
+  job->m_rc[i] = job->m_curve->EvaluateMany( n, job->m_t + i0, job->m_der_count,
+                                             job->m_v + i0*v_size, job->m_v_stride, 
+                                             job->m_side, 1 )
+               ? 1 : 0;
+}
+
+bool ON_NurbsCurve::EvaluateMany(
+       int count,
+       const double* t,
+       int der_count,
+       double* v,
+       int v_stride,
+       int side,
+       int thread_count
+       ) const
+{
+  if ( 0 == count )
+    return true;
+  if (    count < 0 || 0 == t || 0 == v || der_count < 0 
+       || m_order < 2 || m_dim < 1 || m_cv_count < m_order 
+       || 0 == m_cv || 0 == m_knot )
+    return false;
+  if ( 0 == v_stride )
+    v_stride = m_dim;
+  else if ( v_stride < m_dim )
+    return false;
+
+  if ( 1 != thread_count )
+  {
+    // Ranges are at least 1024 parameters long so the thread 
+    // start up cost is small compared to the evaluations.
+    if ( thread_count <= 0 )
+      thread_count = ON_ProcessorCount();
+    int task_count = count/1024;
+    if ( task_count > 4*thread_count )
+      task_count = 4*thread_count;
+    if ( thread_count > 1 && task_count > 1 )
+    {
+      ON_SimpleArray<unsigned char> task_rc(task_count);
+      task_rc.SetCount(task_count);
+      task_rc.Zero();
+      ON_NurbsCurveEvaluateManyJob job;
+      job.m_curve = this;
+      job.m_count = count;
+      job.m_range_count = (count + task_count - 1)/task_count;
+      job.m_t = t;
+      job.m_der_count = der_count;
+      job.m_v = v;
+      job.m_v_stride = v_stride;
+      job.m_side = side;
+      job.m_rc = task_rc.Array();
+      task_count = (count + job.m_range_count - 1)/job.m_range_count;
+      ON_ParallelFor( thread_count, task_count, ON_NurbsCurveEvaluateManyTask, &job );
+      for ( int i = 0; i < task_count; i++ )
+      {
+        if ( !task_rc[i] )
+          return false;
+      }
+      return true;
+    }
+  }
+
+  const int order = m_order;
+  const int dim = m_dim;
+  const int cvdim = m_is_rat ? dim+1 : dim;
+  const int cv_stride = m_cv_stride;
+  const int basis_der_count = (der_count >= order) ? order-1 : der_count;
+  const int v_size = (der_count+1)*v_stride;
+  const double* knot;
+  const double* cv;
+  const double* cvj;
+  const double* Nd;
+  double* hvd;
+  double* vd;
+  double s, a;
+  int i, j, k, d;
+
+  // N[] = basis functions and derivatives, hv[] = (homogeneous) values
+  ON_Workspace ws;
+  double* N = ws.GetDoubleMemory( order*order + (der_count+1)*cvdim );
+  double* hv = N + order*order;
+
+  int span_index = -1;
+  double span_t0 = 0.0;
+  double span_t1 = 0.0;
+  double basis_t = ON_UNSET_VALUE;
+
+  for ( i = 0; i < count; i++, v += v_size )
+  {
+    s = t[i];
+
+    // The span is reused when s is inside the previous span.
+    if (    span_index < 0 
+         || (side < 0 && (s <= span_t0 || s > span_t1))
+         || (side >= 0 && (s < span_t0 || s >= span_t1))
+       )
+    {
+      span_index = ON_NurbsSpanIndex( order, m_cv_count, m_knot, s, side, (span_index > 0) ? span_index : 0 );
+      span_t0 = m_knot[span_index+order-2];
+      span_t1 = m_knot[span_index+order-1];
+      basis_t = ON_UNSET_VALUE;
+    }
+    knot = m_knot + span_index;
+    cv = m_cv + cv_stride*span_index;
+
+    if ( s != basis_t )
+    {
+      ON_EvaluateNurbsBasis( order, knot, s, N );
+      if ( basis_der_count > 0 )
+        ON_EvaluateNurbsBasisDerivatives( order, knot, basis_der_count, N );
+      basis_t = s;
+    }
+
+    // hv[] = sum of basis function values times cvs
+    memset( hv, 0, (der_count+1)*cvdim*sizeof(hv[0]) );
+    for ( d = 0, Nd = N, hvd = hv; d <= basis_der_count; d++, Nd += order, hvd += cvdim )
+    {
+      for ( j = 0, cvj = cv; j < order; j++, cvj += cv_stride )
+      {
+        a = Nd[j];
+        for ( k = 0; k < cvdim; k++ )
+          hvd[k] += a*cvj[k];
+      }
+    }
+
+    if ( 2 == order )
+    {
+      // Same fix as ON_EvaluateNurbsNonRationalSpan() for cases 
+      // when, numerically, t*a + (1.0-t)*a != a.
+      for ( k = 0; k < cvdim; k++ )
+      {
+        if ( cv[k] == cv[k+cv_stride] )
+          hv[k] = cv[k];
+      }
+    }
+
+    if ( m_is_rat )
+    {
+      if ( !ON_EvaluateQuotientRule( dim, der_count, cvdim, hv ) )
+        return false;
+    }
+
+    for ( d = 0, hvd = hv, vd = v; d <= der_count; d++, hvd += cvdim, vd += v_stride )
+      memcpy( vd, hvd, dim*sizeof(vd[0]) );
+  }
+
+  return true;
+}
+
 
 ON_BOOL32 
 ON_NurbsCurve::IsClosed() const
@@ -2928,11 +3359,9 @@ ON_BOOL32 ON_NurbsCurve::GetLength(
         const ON_Interval* sub_domain
         ) const
 {
-  // 3rd party developers who want to enhance openNURBS
-  // may provide a working GetLength here.
-  if ( length )
-    *length = 0;
-  return false;
+  // ON_Curve::GetLength integrates the speed of the curve
+  // span by span using ArcLengthTable().
+  return ON_Curve::GetLength(length,fractional_tolerance,sub_domain);
 }
 
 bool ON_NurbsCurve::Append( const ON_NurbsCurve& c )
@@ -3752,3 +4181,206 @@ bool ON_ChangeRationalNurbsCurveEndWeights(
   return true;
 }
 
+
+static
+bool ON_NurbsCurveFitParameters(
+          int dim,
+          int point_count,
+          int point_stride,
+          const double* point,
+          const double* point_parameters,
+          double* t
+          )
+{
+  int i;
+  if ( point_parameters )
+  {
+    memcpy( t, point_parameters, point_count*sizeof(t[0]) );
+    for ( i = 1; i < point_count; i++ )
+    {
+      if ( !(t[i-1] <= t[i]) )
+        return false;
+    }
+    return ( t[0] < t[point_count-1] );
+  }
+  return ON_GetChordLengthParameters( dim, point_count, point_stride, point, t );
+}
+
+bool ON_NurbsCurve::CreateInterpolatingCurve(
+          int dim,
+          int order,
+          int point_count,
+          int point_stride,
+          const double* point,
+          const double* point_parameters,
+          const double* knot
+          )
+{
+  int i, j, k, span_index;
+  bool rc;
+
+  if ( dim < 1 || order < 2 || point_count < order || point_stride < dim || 0 == point )
+    return false;
+
+  ON_SimpleArray<double> t(point_count);
+  t.SetCount(point_count);
+  if ( 0 == point_parameters && 0 != knot )
+    rc = ON_GetGrevilleAbcissae( order, point_count, knot, false, t.Array() );
+  else
+    rc = ON_NurbsCurveFitParameters( dim, point_count, point_stride, point, point_parameters, t.Array() );
+  if ( !rc )
+    return false;
+  for ( i = 1; i < point_count; i++ )
+  {
+    // each point needs its own parameter
+    if ( !(t[i-1] < t[i]) )
+      return false;
+  }
+
+  if ( !Create( dim, false, order, point_count ) )
+    return false;
+  if ( knot )
+    memcpy( m_knot, knot, KnotCount()*sizeof(m_knot[0]) );
+  else if ( !ON_GetGrevilleKnotVector( 1, t.Array(), false, order, point_count, m_knot ) )
+    return false;
+
+  // The collocation matrix has order non-zero entries per row.  When the 
+  // Schoenberg-Whitney conditions hold, row i has its entries in columns 
+  // span_index,...,span_index+order-1 with span_index <= i <= span_index+order-1,
+  // so the matrix has lower and upper bandwidth order-1.
+  const int bandwidth = order-1;
+  const int band_stride = 2*bandwidth+1;
+  ON_SimpleArray<double> band(point_count*band_stride);
+  band.SetCount(point_count*band_stride);
+  band.Zero();
+  ON_SimpleArray<double> N(order*order);
+  N.SetCount(order*order);
+
+  span_index = 0;
+  for ( i = 0; i < point_count; i++ )
+  {
+    span_index = ON_NurbsSpanIndex( order, point_count, m_knot, t[i], 0, span_index );
+    if ( !ON_EvaluateNurbsBasis( order, m_knot+span_index, t[i], N.Array() ) )
+      return false;
+    for ( k = 0; k < order; k++ )
+    {
+      j = span_index + k;
+      if ( j < i-bandwidth || j > i+bandwidth )
+      {
+        if ( 0.0 != N[k] )
+          return false; // Schoenberg-Whitney conditions fail
+        continue;
+      }
+      band[i*band_stride + j-i+bandwidth] = N[k];
+    }
+    memcpy( CV(i), point + i*point_stride, dim*sizeof(m_cv[0]) );
+  }
+
+  return ON_SolveBandedSystem( point_count, bandwidth, bandwidth, band.Array(), dim, m_cv_stride, m_cv );
+}
+
+bool ON_NurbsCurve::CreateLeastSquaresCurve(
+          int dim,
+          int order,
+          int cv_count,
+          int point_count,
+          int point_stride,
+          const double* point,
+          const double* point_parameters,
+          const double* point_weights,
+          const double* knot
+          )
+{
+  int i, j, k, a, b, span_index;
+  double w, s;
+  const double* P;
+  double* cv;
+
+  if ( dim < 1 || order < 2 || cv_count < order || point_count < cv_count 
+       || point_stride < dim || 0 == point )
+    return false;
+
+  ON_SimpleArray<double> t(point_count);
+  t.SetCount(point_count);
+  if ( !ON_NurbsCurveFitParameters( dim, point_count, point_stride, point, point_parameters, t.Array() ) )
+    return false;
+
+  if ( !Create( dim, false, order, cv_count ) )
+    return false;
+
+  if ( knot )
+  {
+    memcpy( m_knot, knot, KnotCount()*sizeof(m_knot[0]) );
+    if ( 0 == point_parameters )
+    {
+      // map chord length parameters to the knot domain
+      const double t0 = m_knot[order-2];
+      const double d = (m_knot[cv_count-1] - t0)/t[point_count-1];
+      for ( i = 0; i < point_count; i++ )
+        t[i] = t0 + d*t[i];
+    }
+  }
+  else
+  {
+    // Sample the parameters at cv_count evenly spaced point indices 
+    // and use these as Greville abcissae so each span gets roughly
+    // the same number of points.
+    ON_SimpleArray<double> g(cv_count);
+    g.SetCount(cv_count);
+    const double d = ((double)(point_count-1))/((double)(cv_count-1));
+    for ( i = 0; i < cv_count; i++ )
+    {
+      s = i*d;
+      j = (int)floor(s);
+      if ( j >= point_count-1 )
+        g[i] = t[point_count-1];
+      else
+      {
+        s -= j;
+        g[i] = (1.0-s)*t[j] + s*t[j+1];
+      }
+    }
+    if ( !ON_GetGrevilleKnotVector( 1, g.Array(), false, order, cv_count, m_knot ) )
+      return false;
+  }
+
+  // Accumulate the normal equations (N^T W N) X = N^T W P.  Only the
+  // lower band of the symmetric matrix is stored.
+  const int bandwidth = order-1;
+  const int band_stride = bandwidth+1;
+  ON_SimpleArray<double> band(cv_count*band_stride);
+  band.SetCount(cv_count*band_stride);
+  band.Zero();
+  ON_SimpleArray<double> N(order*order);
+  N.SetCount(order*order);
+  memset( m_cv, 0, cv_count*m_cv_stride*sizeof(m_cv[0]) );
+
+  span_index = 0;
+  for ( i = 0; i < point_count; i++ )
+  {
+    w = point_weights ? point_weights[i] : 1.0;
+    if ( !(w > 0.0) )
+    {
+      if ( 0.0 == w )
+        continue;
+      return false;
+    }
+    span_index = ON_NurbsSpanIndex( order, cv_count, m_knot, t[i], 0, span_index );
+    if ( !ON_EvaluateNurbsBasis( order, m_knot+span_index, t[i], N.Array() ) )
+      return false;
+    P = point + i*point_stride;
+    for ( a = 0; a < order; a++ )
+    {
+      s = w*N[a];
+      j = span_index + a;
+      double* row = band.Array() + j*band_stride + bandwidth - j + span_index;
+      for ( b = 0; b <= a; b++ )
+        row[b] += s*N[b];
+      cv = CV(j);
+      for ( k = 0; k < dim; k++ )
+        cv[k] += s*P[k];
+    }
+  }
+
+  return ON_SolveBandedSymmetricSystem( cv_count, bandwidth, band.Array(), dim, m_cv_stride, m_cv );
+}
@@ -22,6 +22,7 @@
 #if !defined(OPENNURBS_NURBSCURVE_INC_)
 #define OPENNURBS_NURBSCURVE_INC_
 
+class ON_NurbsCurveSpanCache;
 class ON_NurbsCurve;
 class ON_CLASS ON_NurbsCurve : public ON_Curve
 {
@@ -78,6 +79,9 @@ public:
   // virtual ON_Object::SizeOf override
   unsigned int SizeOf() const;
 
+  // virtual ON_Object::DestroyRuntimeCache override
+  void DestroyRuntimeCache( bool bDelete = true );
+
   // virtual ON_Object::DataCRC override
   ON__UINT32 DataCRC(ON__UINT32 current_remainder) const;
 
@@ -155,6 +159,94 @@ public:
           double knot_delta = 1.0
           );
 
+  /*
+  Description:
+    Create a non-rational NURBS curve that interpolates
+    a list of points.
+  Parameters:
+    dim - [in] (>=1) point dimension
+    order - [in] (>=2) order=degree+1
+    point_count - [in] (>=order) number of points to interpolate.
+        The curve will have point_count control points.
+    point_stride - [in] (>=dim) stride between points
+    point - [in] points to interpolate
+    point_parameters - [in] If not NULL, then point_parameters[]
+        is an increasing list of point_count curve parameters
+        where the curve will interpolate the points.  If NULL
+        and knot is not NULL, the Greville abcissae of knot[]
+        are used.  Otherwise chord length parameters are used.
+    knot - [in] If not NULL, knot[] is a list of 
+        ON_KnotCount(order,point_count) knots that satisfy the
+        Schoenberg-Whitney conditions with respect to the 
+        parameters.  If NULL, the knots are calculated from
+        the parameters with ON_GetGrevilleKnotVector().
+  Returns:
+    true if successful.
+  Remarks:
+    The collocation matrix is banded with bandwidth order-1 and
+    is solved with ON_SolveBandedSystem() in O(point_count*order^2)
+    time.
+  See Also:
+    ON_NurbsCurve::CreateLeastSquaresCurve
+    ON_GetChordLengthParameters
+  */
+  bool CreateInterpolatingCurve(
+          int dim,
+          int order,
+          int point_count,
+          int point_stride,
+          const double* point,
+          const double* point_parameters = 0,
+          const double* knot = 0
+          );
+
+  /*
+  Description:
+    Create a non-rational NURBS curve with cv_count control 
+    points that is the weighted least squares fit to a list
+    of points.
+  Parameters:
+    dim - [in] (>=1) point dimension
+    order - [in] (>=2) order=degree+1
+    cv_count - [in] (>=order) number of control points
+    point_count - [in] (>=cv_count) number of points to fit
+    point_stride - [in] (>=dim) stride between points
+    point - [in] points to fit
+    point_parameters - [in] If not NULL, then point_parameters[]
+        is a non-decreasing list of point_count curve parameters
+        to associate with the points.  If NULL, chord length 
+        parameters are used.
+    point_weights - [in] If not NULL, point_weights[] is a list
+        of point_count non-negative weights.  If NULL, all
+        points have weight 1.
+    knot - [in] If not NULL, knot[] is a list of 
+        ON_KnotCount(order,cv_count) knots.  If NULL, the 
+        knots are calculated so each span contains roughly 
+        the same number of points.
+  Returns:
+    true if successful.  False if the input is not valid or
+    the knots leave a control point without data.
+  Remarks:
+    The normal equations are symmetric, positive definite and
+    banded with bandwidth order-1.  They are accumulated in one
+    pass over the points and solved with 
+    ON_SolveBandedSymmetricSystem(), so the time is
+    O(point_count*order^2 + cv_count*order^2).
+  See Also:
+    ON_NurbsCurve::CreateInterpolatingCurve
+  */
+  bool CreateLeastSquaresCurve(
+          int dim,
+          int order,
+          int cv_count,
+          int point_count,
+          int point_stride,
+          const double* point,
+          const double* point_parameters = 0,
+          const double* point_weights = 0,
+          const double* knot = 0
+          );
+
   // Description:
   //   Deallocate knot and cv memory.  Zeros all fields.
   void Destroy();
@@ -244,6 +336,38 @@ public:
          int bGrowBox = false
          ) const;
 
+  /*
+	Description:
+    virtual ON_Geometry::GetTightBoundingBox override.
+    Gets the bounding box of the curve itself, which can be much
+    smaller than the bounding box of the control polygon that
+    GetBBox() returns.
+	Parameters:
+		tight_bbox - [in/out] tight bounding box
+		bGrowBox -[in]	(default=false)			
+      If true and the input tight_bbox is valid, then returned
+      tight_bbox is the union of the input tight_bbox and the 
+      curve's tight bounding box.
+		xform -[in] (default=NULL)
+      If not NULL, the tight bounding box of the transformed
+      curve is calculated.  The curve is not modified.
+	Returns:
+    True if the returned tight_bbox is set to a valid 
+    bounding box.
+  Remarks:
+    The spans are subdivided until the box is within 
+    ON_SQRT_EPSILON*(size of the curve) of the curve.
+    The box always contains the curve.  When xform is NULL
+    the result is cached until the curve is modified.  The
+    cache is updated under a lock, so several threads may call
+    GetTightBoundingBox() on the same curve at once.
+  */
+	bool GetTightBoundingBox( 
+			ON_BoundingBox& tight_bbox, 
+      int bGrowBox = false,
+			const ON_Xform* xform = 0
+      ) const;
+
   // Description:
   //   virtual ON_Geometry::Transform override.
   //   Transforms the NURBS curve.
@@ -578,6 +702,91 @@ public:
                          //            repeated evaluations
          ) const;
 
+  /*
+  Description:
+    Evaluate the curve at many parameters.
+  Parameters:
+    count - [in] number of parameters.
+    t - [in] array of count evaluation parameters.
+    der_count - [in] number of derivatives (>=0).
+    v - [out] array of length count*(der_count+1)*v_stride.
+       The results for t[i] begin at n = i*(der_count+1)*v_stride
+       and are returned as point = v[n],...,v[n+m_dim-1],
+       first derivative = v[n+v_stride],..., and so on.
+    v_stride - [in] (>= Dimension()) stride between the point
+       and derivative values of a single evaluation.  
+       If 0, Dimension() is used.
+    side - [in] determines which side to evaluate from
+            0 = default
+         <  0 to evaluate from below, 
+         >  0 to evaluate from above
+    thread_count - [in] maximum number of threads.
+       See ON_ParallelFor().
+  Returns:
+    True if successful.
+  Remarks:
+    The span search and scratch memory are shared by all the
+    evaluations.  When consecutive parameters lie in the same 
+    span the knot vector is not searched again, so increasing 
+    or decreasing parameter lists are evaluated fastest.
+    When several threads are used, the parameter list is split
+    into ranges that are evaluated at the same time; the 
+    results do not depend on the number of threads.  Do not 
+    modify the curve while EvaluateMany() is running.
+    The basis functions are computed one parameter at a time;
+    the SIMD kernels in opennurbs_simd.h are not used.
+  See Also:
+    ON_NurbsCurve::Evaluate
+  */
+  bool EvaluateMany(
+         int count,
+         const double* t,
+         int der_count,
+         double* v,
+         int v_stride = 0,
+         int side = 0,
+         int thread_count = 1
+         ) const;
+
+  /*
+  Description:
+    Enable or disable the span evaluation cache.
+  Parameters:
+    span_count - [in] maximum number of spans kept in the
+       cache.  0 disables the cache and frees its memory.
+  Remarks:
+    The cache is off by default.  When it is on, Evaluate()
+    converts each span it visits to Taylor (power basis) 
+    coefficients and evaluates later parameters in a cached
+    span with Horner's rule.  This speeds up marching and
+    other algorithms that evaluate many nearby parameters.
+    Only quadratic and cubic spans are cached, because power
+    basis coefficients lose precision as the degree grows.
+    Parameters on knots are always evaluated from the control
+    points, so span ends are exact.
+    The cache is runtime information.  It is not copied or
+    saved and it is emptied by DestroyRuntimeCache(), which 
+    DestroyCurveTree() calls when the curve is modified.
+    If you change m_cv[] or m_knot[] directly, call 
+    DestroyRuntimeCache().  One thread at a time uses the 
+    cache; other threads that evaluate the curve at the same
+    time do not use it.  Do not call SetEvaluationCacheSize()
+    or DestroyRuntimeCache() while another thread is 
+    evaluating the curve.
+  See Also:
+    ON_NurbsCurve::EvaluationCacheSize
+  */
+  void SetEvaluationCacheSize( int span_count );
+
+  /*
+  Returns:
+    Maximum number of spans in the evaluation cache.
+    0 if the cache is disabled.
+  See Also:
+    ON_NurbsCurve::SetEvaluationCacheSize
+  */
+  int EvaluationCacheSize() const;
+
   bool GetClosestPoint( 
           const ON_3dPoint&, // test_point
           double* t,       // parameter of local closest point returned here
@@ -1156,6 +1365,15 @@ public:
                             //
                             //           [ CV(i)[0], ..., CV(i)[m_dim] ].
                             //
+
+private:
+  // Runtime only - ignored by Read()/Write()
+  // m_span_cache, m_tight_bbox and m_tight_bbox_crc change the 
+  // size of the class; code that uses this class must be 
+  // compiled with this header.
+  ON_NurbsCurveSpanCache* m_span_cache;
+  ON_BoundingBox m_tight_bbox;   // cached GetTightBoundingBox() result
+  ON__UINT32 m_tight_bbox_crc;   // CRC of the knots and CVs m_tight_bbox came from
 };
 
 #endif
@@ -17,6 +17,53 @@
 
 ON_OBJECT_IMPLEMENT(ON_NurbsSurface,ON_Surface,"4ED7D4DE-E947-11d3-BFE5-0010830122F0");
 
+class ON_NurbsSurfaceSpanCache
+{
+  // Runtime cache of bispan Taylor coefficients used by
+  // ON_NurbsSurface::Evaluate(). See ON_NurbsSurface::SetEvaluationCacheSize().
+public:
+  ON_NurbsSurfaceSpanCache( int bispan_count );
+
+  // Power basis coefficients lose precision as the degree 
+  // grows, so only quadratic and cubic bispans are cached.
+  enum { min_order = 3, max_order = 4 };
+
+  // One thread at a time uses the cache.  Lock() returns false
+  // if another thread is using it.
+  bool Lock();
+  void Unlock();
+
+  void Empty();
+
+  // Returns most recently used span index in direction dir or 0.
+  int LastSpanIndex( int dir ) const;
+
+  // Returns Taylor coefficients of the bispan or 0 if they cannot be computed.
+  const double* SpanCoefficients( const ON_NurbsSurface& srf, const int span_index[2], double tm[2] );
+
+  bool Evaluate( const ON_NurbsSurface& srf, const int span_index[2],
+                 double s, double t, int der_count, int v_stride, double* v );
+
+  int m_lock;     // 1 while a thread is using the cache
+  int m_capacity; // maximum number of cached bispans
+  int m_count;    // number of cached bispans
+  int m_next;     // slot used by the next cache miss
+  int m_last;     // most recently used slot or -1
+
+  // surface settings when the cache was filled
+  int m_cvdim;
+  int m_order[2];
+  int m_cv_count[2];
+  int m_cv_stride[2];
+  const double* m_knot[2];
+  const double* m_cv;
+
+  ON_SimpleArray<int> m_span_index; // 2 span indices per slot
+  ON_SimpleArray<double> m_tm;      // 2 expansion parameters per slot
+  ON_SimpleArray<double> m_coef;    // m_order[0]*m_order[1]*m_cvdim coefficients per slot
+  ON_SimpleArray<double> m_work;    // evaluation workspace
+};
+
 
 ON_NurbsSurface* ON_NurbsSurface::New()
 {
@@ -54,12 +101,16 @@ ON_NurbsSurface* ON_NurbsSurface::New(
 }
 
 ON_NurbsSurface::ON_NurbsSurface()
+: m_span_cache(0)
+, m_tight_bbox_crc(0)
 {
   ON__SET__THIS__PTR(m_s_ON_NurbsSurface_ptr);
   Initialize();
 }
 
 ON_NurbsSurface::ON_NurbsSurface( const ON_NurbsSurface& src )
+: m_span_cache(0)
+, m_tight_bbox_crc(0)
 {
   ON__SET__THIS__PTR(m_s_ON_NurbsSurface_ptr);
   Initialize();
@@ -67,6 +118,8 @@ ON_NurbsSurface::ON_NurbsSurface( const ON_NurbsSurface& src )
 }
 
 ON_NurbsSurface::ON_NurbsSurface( const ON_BezierSurface& bezier_surface )
+: m_span_cache(0)
+, m_tight_bbox_crc(0)
 {
   ON__SET__THIS__PTR(m_s_ON_NurbsSurface_ptr);
   Initialize();
@@ -81,6 +134,8 @@ ON_NurbsSurface::ON_NurbsSurface(
         int cv_count0,  // cv count0 (>= order0)
         int cv_count1   // cv count1 (>= order1)
         )
+: m_span_cache(0)
+, m_tight_bbox_crc(0)
 {
   ON__SET__THIS__PTR(m_s_ON_NurbsSurface_ptr);
   Initialize();
@@ -90,6 +145,11 @@ ON_NurbsSurface::ON_NurbsSurface(
 ON_NurbsSurface::~ON_NurbsSurface()
 {
   Destroy();
+  if ( m_span_cache )
+  {
+    delete m_span_cache;
+    m_span_cache = 0;
+  }
 }
 
 
@@ -321,6 +381,7 @@ void ON_NurbsSurface::Destroy()
 void ON_NurbsSurface::EmergencyDestroy()
 {
   Initialize();
+  m_span_cache = 0;
 }
 
 
@@ -860,19 +921,30 @@ ON_NurbsSurface::Evaluate( // returns false if unable to evaluate
 {
   ON_BOOL32 rc = false;
   int span_index[2];
-  span_index[0] = ON_NurbsSpanIndex(m_order[0],m_cv_count[0],m_knot[0],s,(side==2||side==3)?-1:1,(hint)?hint[0]:0);
-  span_index[1] = ON_NurbsSpanIndex(m_order[1],m_cv_count[1],m_knot[1],t,(side==3||side==4)?-1:1,(hint)?hint[1]:0);
-  rc = ON_EvaluateNurbsSurfaceSpan(
-     m_dim, m_is_rat, 
-     m_order[0], m_order[1],
-     m_knot[0] + span_index[0], 
-     m_knot[1] + span_index[1],
-     m_cv_stride[0], m_cv_stride[1],
-     m_cv + (span_index[0]*m_cv_stride[0] + span_index[1]*m_cv_stride[1]),
-     der_count, 
-     s, t,
-     v_stride, v 
-     );
+  ON_NurbsSurfaceSpanCache* span_cache = (0 != m_span_cache && m_span_cache->Lock()) ? m_span_cache : 0;
+  span_index[0] = ON_NurbsSpanIndex(m_order[0],m_cv_count[0],m_knot[0],s,(side==2||side==3)?-1:1,
+                                    (hint) ? hint[0] : ((span_cache) ? span_cache->LastSpanIndex(0) : 0));
+  span_index[1] = ON_NurbsSpanIndex(m_order[1],m_cv_count[1],m_knot[1],t,(side==3||side==4)?-1:1,
+                                    (hint) ? hint[1] : ((span_cache) ? span_cache->LastSpanIndex(1) : 0));
+  if ( span_cache )
+  {
+    rc = span_cache->Evaluate( *this, span_index, s, t, der_count, v_stride, v );
+    span_cache->Unlock();
+  }
+  if ( !rc )
+  {
+    rc = ON_EvaluateNurbsSurfaceSpan(
+       m_dim, m_is_rat, 
+       m_order[0], m_order[1],
+       m_knot[0] + span_index[0], 
+       m_knot[1] + span_index[1],
+       m_cv_stride[0], m_cv_stride[1],
+       m_cv + (span_index[0]*m_cv_stride[0] + span_index[1]*m_cv_stride[1]),
+       der_count, 
+       s, t,
+       v_stride, v 
+       );
+  }
   if ( hint ) {
     hint[0] = span_index[0];
     hint[1] = span_index[1];
@@ -880,6 +952,667 @@ ON_NurbsSurface::Evaluate( // returns false if unable to evaluate
   return rc;
 }
 
+ON_NurbsSurfaceSpanCache::ON_NurbsSurfaceSpanCache( int bispan_count )
+: m_lock(0)
+, m_capacity(bispan_count > 0 ? bispan_count : 1)
+, m_count(0)
+, m_next(0)
+, m_last(-1)
+, m_cvdim(0)
+, m_cv(0)
+{
+  m_order[0] = m_order[1] = 0;
+  m_cv_count[0] = m_cv_count[1] = 0;
+  m_cv_stride[0] = m_cv_stride[1] = 0;
+  m_knot[0] = m_knot[1] = 0;
+  m_span_index.Reserve(2*m_capacity);
+  m_span_index.SetCount(2*m_capacity);
+  m_tm.Reserve(2*m_capacity);
+  m_tm.SetCount(2*m_capacity);
+}
+
+bool ON_NurbsSurfaceSpanCache::Lock()
+{
+  return 0 == ON_ATOMIC_COMPARE_AND_SWAP(&m_lock,0,1);
+}
+
+void ON_NurbsSurfaceSpanCache::Unlock()
+{
+  ON_ATOMIC_COMPARE_AND_SWAP(&m_lock,1,0);
+}
+
+void ON_NurbsSurfaceSpanCache::Empty()
+{
+  m_count = 0;
+  m_next = 0;
+  m_last = -1;
+  m_cvdim = 0;
+  m_order[0] = m_order[1] = 0;
+  m_cv_count[0] = m_cv_count[1] = 0;
+  m_cv_stride[0] = m_cv_stride[1] = 0;
+  m_knot[0] = m_knot[1] = 0;
+  m_cv = 0;
+  m_coef.Destroy();
+  m_work.Destroy();
+}
+
+int ON_NurbsSurfaceSpanCache::LastSpanIndex( int dir ) const
+{
+  return (m_last >= 0) ? m_span_index[2*m_last + (dir?1:0)] : 0;
+}
+
+const double* ON_NurbsSurfaceSpanCache::SpanCoefficients( 
+        const ON_NurbsSurface& srf, 
+        const int span_index[2],
+        double tm[2]
+        )
+{
+  const int cvdim = srf.m_is_rat ? srf.m_dim+1 : srf.m_dim;
+  int i, j, k;
+
+  if (    cvdim != m_cvdim 
+       || srf.m_order[0] != m_order[0] || srf.m_order[1] != m_order[1]
+       || srf.m_cv_count[0] != m_cv_count[0] || srf.m_cv_count[1] != m_cv_count[1]
+       || srf.m_cv_stride[0] != m_cv_stride[0] || srf.m_cv_stride[1] != m_cv_stride[1]
+       || srf.m_knot[0] != m_knot[0] || srf.m_knot[1] != m_knot[1] || srf.m_cv != m_cv )
+  {
+    // The surface was changed without calling DestroyRuntimeCache().
+    Empty();
+    m_cvdim = cvdim;
+    for ( i = 0; i < 2; i++ )
+    {
+      m_order[i] = srf.m_order[i];
+      m_cv_count[i] = srf.m_cv_count[i];
+      m_cv_stride[i] = srf.m_cv_stride[i];
+      m_knot[i] = srf.m_knot[i];
+    }
+    m_cv = srf.m_cv;
+  }
+
+  const int coef_size = m_order[0]*m_order[1]*m_cvdim;
+
+  // marching evaluations usually stay in the same bispan
+  if (    m_last >= 0 
+       && span_index[0] == m_span_index[2*m_last] 
+       && span_index[1] == m_span_index[2*m_last+1] )
+  {
+    tm[0] = m_tm[2*m_last];
+    tm[1] = m_tm[2*m_last+1];
+    return m_coef.Array() + m_last*coef_size;
+  }
+
+  for ( i = 0; i < m_count; i++ )
+  {
+    if ( span_index[0] == m_span_index[2*i] && span_index[1] == m_span_index[2*i+1] )
+    {
+      m_last = i;
+      tm[0] = m_tm[2*i];
+      tm[1] = m_tm[2*i+1];
+      return m_coef.Array() + i*coef_size;
+    }
+  }
+
+  if ( m_coef.Count() != m_capacity*coef_size )
+  {
+    m_coef.Reserve(m_capacity*coef_size);
+    m_coef.SetCount(m_capacity*coef_size);
+  }
+
+  // replace the oldest bispan
+  i = m_next;
+  m_next = (m_next+1) % m_capacity;
+  if ( m_count < m_capacity )
+    m_count++;
+  m_span_index[2*i] = -1;
+  m_span_index[2*i+1] = -1;
+  m_last = -1;
+
+  const double* knot0 = m_knot[0] + span_index[0];
+  const double* knot1 = m_knot[1] + span_index[1];
+  const double* cv = m_cv + (span_index[0]*m_cv_stride[0] + span_index[1]*m_cv_stride[1]);
+  const int row_size = m_order[1]*m_cvdim;
+  double* c = m_coef.Array() + i*coef_size;
+  m_tm[2*i]   = 0.5*(knot0[m_order[0]-2] + knot0[m_order[0]-1]);
+  m_tm[2*i+1] = 0.5*(knot1[m_order[1]-2] + knot1[m_order[1]-1]);
+
+  // The "t" coefficients of the control point rows are the control
+  // points of "s" spans whose "s" coefficients are c[].
+  m_work.Reserve(m_order[0]*row_size + m_order[0]*m_cvdim);
+  double* R = m_work.Array();
+  double* Rs = R + m_order[0]*row_size;
+  for ( j = 0; j < m_order[0]; j++ )
+  {
+    if ( !ON_GetNurbsSpanTaylorCoefficients( m_cvdim, m_order[1], knot1, 
+                                             m_cv_stride[1], cv + j*m_cv_stride[0], 
+                                             m_tm[2*i+1], R + j*row_size ) )
+      return 0;
+  }
+  for ( j = 0; j < m_order[1]; j++ )
+  {
+    if ( !ON_GetNurbsSpanTaylorCoefficients( m_cvdim, m_order[0], knot0, 
+                                             row_size, R + j*m_cvdim, 
+                                             m_tm[2*i], Rs ) )
+      return 0;
+    for ( k = 0; k < m_order[0]; k++ )
+      memcpy( c + (k*m_order[1] + j)*m_cvdim, Rs + k*m_cvdim, m_cvdim*sizeof(c[0]) );
+  }
+
+  m_span_index[2*i] = span_index[0];
+  m_span_index[2*i+1] = span_index[1];
+  m_last = i;
+  tm[0] = m_tm[2*i];
+  tm[1] = m_tm[2*i+1];
+  return c;
+}
+
+bool ON_NurbsSurfaceSpanCache::Evaluate(
+        const ON_NurbsSurface& srf, 
+        const int span_index[2], 
+        double s, double t, 
+        int der_count, 
+        int v_stride, 
+        double* v
+        )
+{
+  int dir;
+  for ( dir = 0; dir < 2; dir++ )
+  {
+    if ( srf.m_order[dir] < min_order || srf.m_order[dir] > max_order )
+      return false;
+  }
+
+  // Parameters on the edges of the bispan are evaluated by 
+  // ON_EvaluateNurbsSurfaceSpan() so the results are exact there.
+  const double* knot0 = srf.m_knot[0] + span_index[0];
+  const double* knot1 = srf.m_knot[1] + span_index[1];
+  if (    s == knot0[srf.m_order[0]-2] || s == knot0[srf.m_order[0]-1] 
+       || t == knot1[srf.m_order[1]-2] || t == knot1[srf.m_order[1]-1] )
+    return false;
+
+  double tm[2];
+  const double* c = SpanCoefficients( srf, span_index, tm );
+  if ( 0 == c )
+    return false;
+
+  const int order0 = m_order[0];
+  const int order1 = m_order[1];
+  const int cvdim = m_cvdim;
+  const int der_count1 = (der_count >= order1) ? order1-1 : der_count;
+  const int Pcount = ((der_count+1)*(der_count+2))/2;
+  const int R_stride = (der_count1+1)*cvdim;
+  int d, d0, d1, i;
+
+  // R[i*R_stride + d1*cvdim] = d1-th "t" derivative of the (s-tm[0])^i coefficient
+  // W[d0*cvdim] = (d0,d1) partial
+  m_work.Reserve( order0*R_stride + (der_count+1)*cvdim + Pcount*cvdim );
+  double* R = m_work.Array();
+  double* W = R + order0*R_stride;
+  double* P = W + (der_count+1)*cvdim;
+  memset( P, 0, Pcount*cvdim*sizeof(P[0]) );
+
+  for ( i = 0; i < order0; i++ )
+  {
+    if ( !ON_EvaluateTaylorPolynomial( cvdim, order1, cvdim, c + i*order1*cvdim, 
+                                       der_count1, t-tm[1], cvdim, R + i*R_stride ) )
+      return false;
+  }
+  for ( d1 = 0; d1 <= der_count1; d1++ )
+  {
+    if ( !ON_EvaluateTaylorPolynomial( cvdim, order0, R_stride, R + d1*cvdim, 
+                                       der_count-d1, s-tm[0], cvdim, W ) )
+      return false;
+    for ( d0 = 0; d0 <= der_count-d1; d0++ )
+    {
+      d = d0+d1;
+      memcpy( P + ((d*(d+1))/2 + d1)*cvdim, W + d0*cvdim, cvdim*sizeof(P[0]) );
+    }
+  }
+
+  if ( srf.m_is_rat )
+  {
+    if ( !ON_EvaluateQuotientRule2( srf.m_dim, der_count, cvdim, P ) )
+      return false;
+  }
+
+  for ( i = 0; i < Pcount; i++, v += v_stride, P += cvdim )
+    memcpy( v, P, srf.m_dim*sizeof(v[0]) );
+
+  return true;
+}
+
+void ON_NurbsSurface::DestroyRuntimeCache( bool bDelete )
+{
+  ON_Surface::DestroyRuntimeCache(bDelete);
+  m_tight_bbox.Destroy();
+  if ( m_span_cache )
+  {
+    if ( bDelete )
+      m_span_cache->Empty();
+    else
+      m_span_cache = 0; // the cache memory is gone
+  }
+}
+
+void ON_NurbsSurface::SetEvaluationCacheSize( int bispan_count )
+{
+  if ( bispan_count < 0 )
+    bispan_count = 0;
+  if ( m_span_cache )
+  {
+    if ( bispan_count == m_span_cache->m_capacity )
+      return;
+    delete m_span_cache;
+    m_span_cache = 0;
+  }
+  if ( bispan_count > 0 )
+    m_span_cache = new ON_NurbsSurfaceSpanCache(bispan_count);
+}
+
+int ON_NurbsSurface::EvaluationCacheSize() const
+{
+  return (m_span_cache) ? m_span_cache->m_capacity : 0;
+}
+
+static int ON_NurbsSurfaceSpanHelper(
+        int order, int cv_count, const double* knot,
+        double t, int side,
+        int span_index // previous span index or -1
+        )
+{
+  // reuse the previous span when t is inside of it
+  if ( span_index >= 0 )
+  {
+    const double t0 = knot[span_index+order-2];
+    const double t1 = knot[span_index+order-1];
+    if ( (side < 0) ? (t0 < t && t <= t1) : (t0 <= t && t < t1) )
+      return span_index;
+  }
+  return ON_NurbsSpanIndex( order, cv_count, knot, t, side, (span_index > 0) ? span_index : 0 );
+}
+
+static void ON_NurbsSurfaceBasisHelper(
+        int order, const double* knot, double t,
+        int der_count, // <= order-1
+        double* N      // N[order*order]
+        )
+{
+  ON_EvaluateNurbsBasis( order, knot, t, N );
+  if ( der_count > 0 )
+    ON_EvaluateNurbsBasisDerivatives( order, knot, der_count, N );
+}
+
+static void ON_NurbsSurfaceRowHelper(
+        int cvdim,
+        int order1,
+        const double* cv,   // cv at (r0,span_index1)
+        int cv_stride0, int cv_stride1,
+        int der_count1,     // <= order1-1
+        const double* N1,   // "t" basis functions
+        int row_count,
+        double* Q           // Q[(der_count1+1)*row_count*cvdim]
+        )
+{
+  // Q[(d1*row_count + r)*cvdim + k] = sum of N1[d1*order1+j1]*cv(r0+r,span_index1+j1)[k]
+  const double* cvr;
+  double* q;
+  double c;
+  int r, j1, d1, k;
+  memset( Q, 0, (der_count1+1)*row_count*cvdim*sizeof(Q[0]) );
+  for ( r = 0; r < row_count; r++, cv += cv_stride0 )
+  {
+    for ( j1 = 0, cvr = cv; j1 < order1; j1++, cvr += cv_stride1 )
+    {
+      for ( d1 = 0; d1 <= der_count1; d1++ )
+      {
+        c = N1[d1*order1 + j1];
+        q = Q + (d1*row_count + r)*cvdim;
+        for ( k = 0; k < cvdim; k++ )
+          q[k] += c*cvr[k];
+      }
+    }
+  }
+}
+
+static bool ON_NurbsSurfaceContractHelper(
+        int dim, bool bIsRational,
+        int order0,
+        int der_count, int der_count0, int der_count1,
+        const double* N0,   // "s" basis functions
+        const double* Q,    // from ON_NurbsSurfaceRowHelper()
+        int row_count,
+        int row_offset,     // index of the first row of the "s" span in Q[]
+        double* P,          // scratch P[Pcount*cvdim]
+        int v_stride,
+        double* v
+        )
+{
+  const int cvdim = bIsRational ? dim+1 : dim;
+  const int Pcount = ((der_count+1)*(der_count+2))/2;
+  const double* q;
+  double* Pd;
+  double c;
+  int d, d0, d1, j0, k;
+
+  memset( P, 0, Pcount*cvdim*sizeof(P[0]) );
+  for ( d = 0; d <= der_count; d++ )
+  {
+    for ( d1 = 0; d1 <= d; d1++ )
+    {
+      d0 = d - d1;
+      if ( d0 > der_count0 || d1 > der_count1 )
+        continue; // this partial is zero
+      Pd = P + ((d*(d+1))/2 + d1)*cvdim;
+      for ( j0 = 0; j0 < order0; j0++ )
+      {
+        c = N0[d0*order0 + j0];
+        q = Q + (d1*row_count + row_offset + j0)*cvdim;
+        for ( k = 0; k < cvdim; k++ )
+          Pd[k] += c*q[k];
+      }
+    }
+  }
+
+  if ( bIsRational )
+  {
+    if ( !ON_EvaluateQuotientRule2( dim, der_count, cvdim, P ) )
+      return false;
+  }
+
+  for ( d = 0; d < Pcount; d++, P += cvdim, v += v_stride )
+    memcpy( v, P, dim*sizeof(v[0]) );
+
+  return true;
+}
+
+struct ON_NurbsSurfaceEvaluateJob
+{
+  const ON_NurbsSurface* m_surface;
+  int m_count;       // number of s[] parameters
+  int m_range_count; // s[] parameters per task
+  const double* m_s;
+  int m_t_count;     // EvaluateGrid() only
+  const double* m_t;
+  int m_der_count;
+  double* m_v;
+  int m_v_stride;
+  int m_side;
+  unsigned char* m_rc;
+};
+
+static int ON_NurbsSurfaceEvaluateTaskCount( int& thread_count, double evaluation_count, int count )
+{
+  // Each task does at least 1024 evaluations so the thread 
+  // start up cost is small compared to the evaluations.
+  if ( thread_count <= 0 )
+    thread_count = ON_ProcessorCount();
+  double d = floor(evaluation_count/1024.0);
+  if ( d > 4.0*thread_count )
+    d = 4.0*thread_count;
+  int task_count = (int)d;
+  if ( task_count > count )
+    task_count = count;
+  return ( thread_count < 2 || task_count < 2 ) ? 1 : task_count;
+}
+
+static bool ON_NurbsSurfaceEvaluateParallel( 
+  int thread_count, 
+  int task_count,
+  ON_NurbsSurfaceEvaluateJob& job,
+  void (*task)(void*,int) 
+  )
+{
+  job.m_range_count = (job.m_count + task_count - 1)/task_count;
+  task_count = (job.m_count + job.m_range_count - 1)/job.m_range_count;
+  ON_SimpleArray<unsigned char> task_rc(task_count);
+  task_rc.SetCount(task_count);
+  task_rc.Zero();
+  job.m_rc = task_rc.Array();
+  ON_ParallelFor( thread_count, task_count, task, &job );
+  for ( int i = 0; i < task_count; i++ )
+  {
+    if ( !task_rc[i] )
+      return false;
+  }
+  return true;
+}
+
+static void ON_NurbsSurfaceEvaluateGridTask( void* context, int i )
+{
+  // Each task evaluates a range of s[] at every t[].  The range's
+  // results are one contiguous block of v[].
+  const ON_NurbsSurfaceEvaluateJob* job = (const ON_NurbsSurfaceEvaluateJob*)context;
+  const int i0 = i*job->m_range_count;
+  int n = job->m_count - i0;
+  if ( n > job->m_range_count )
+    n = job->m_range_count;
+  const size_t v_size = ((size_t)((job->m_der_count+1)*(job->m_der_count+2))/2)*job->m_v_stride;
+  job->m_rc[i] = job->m_surface->EvaluateGrid( n, job->m_s + i0, job->m_t_count, job->m_t,
+                                               job->m_der_count, 
+                                               job->m_v + ((size_t)i0)*job->m_t_count*v_size, 
+                                               job->m_v_stride, job->m_side, 1 )
+               ? 1 : 0;
+}
+
+static void ON_NurbsSurfaceEvaluateManyTask( void* context, int i )
+{
+  const ON_NurbsSurfaceEvaluateJob* job = (const ON_NurbsSurfaceEvaluateJob*)context;
+  const int i0 = i*job->m_range_count;
+  int n = job->m_count - i0;
+  if ( n > job->m_range_count )
+    n = job->m_range_count;
+  const size_t v_size = ((size_t)((job->m_der_count+1)*(job->m_der_count+2))/2)*job->m_v_stride;
+  job->m_rc[i] = job->m_surface->EvaluateMany( n, job->m_s + i0, job->m_t + i0,
+                                               job->m_der_count, job->m_v + i0*v_size, 
+                                               job->m_v_stride, job->m_side, 1 )
+               ? 1 : 0;
+}
+
+bool ON_NurbsSurface::EvaluateGrid(
+       int s_count,
+       const double* s,
+       int t_count,
+       const double* t,
+       int der_count,
+       double* v,
+       int v_stride,
+       int side,
+       int thread_count
+       ) const
+{
+  if ( 0 == s_count || 0 == t_count )
+    return true;
+  if (    s_count < 0 || t_count < 0 || 0 == s || 0 == t || 0 == v || der_count < 0
+       || m_dim < 1 || m_order[0] < 2 || m_order[1] < 2 
+       || m_cv_count[0] < m_order[0] || m_cv_count[1] < m_order[1]
+       || 0 == m_cv || 0 == m_knot[0] || 0 == m_knot[1] )
+    return false;
+  if ( 0 == v_stride )
+    v_stride = m_dim;
+  else if ( v_stride < m_dim )
+    return false;
+
+  if ( 1 != thread_count )
+  {
+    const int task_count = ON_NurbsSurfaceEvaluateTaskCount( thread_count, ((double)s_count)*t_count, s_count );
+    if ( task_count > 1 )
+    {
+      ON_NurbsSurfaceEvaluateJob job;
+      memset(&job,0,sizeof(job));
+      job.m_surface = this;
+      job.m_count = s_count;
+      job.m_s = s;
+      job.m_t_count = t_count;
+      job.m_t = t;
+      job.m_der_count = der_count;
+      job.m_v = v;
+      job.m_v_stride = v_stride;
+      job.m_side = side;
+      return ON_NurbsSurfaceEvaluateParallel( thread_count, task_count, job, ON_NurbsSurfaceEvaluateGridTask );
+    }
+  }
+
+  const int side0 = (side==2||side==3) ? -1 : 1;
+  const int side1 = (side==3||side==4) ? -1 : 1;
+  const int order0 = m_order[0];
+  const int order1 = m_order[1];
+  const int cvdim = m_is_rat ? m_dim+1 : m_dim;
+  const int der_count0 = (der_count >= order0) ? order0-1 : der_count;
+  const int der_count1 = (der_count >= order1) ? order1-1 : der_count;
+  const int Pcount = ((der_count+1)*(der_count+2))/2;
+  const int v_size = Pcount*v_stride;
+  int i, j, r0, r1;
+
+  ON_Workspace ws;
+
+  // basis functions for each s[i]
+  int* span0 = ws.GetIntMemory( s_count );
+  double* N0 = ws.GetDoubleMemory( ((size_t)s_count)*order0*order0 );
+  r0 = m_cv_count[0];
+  r1 = 0;
+  for ( i = 0; i < s_count; i++ )
+  {
+    span0[i] = ON_NurbsSurfaceSpanHelper( order0, m_cv_count[0], m_knot[0], s[i], side0, (i > 0) ? span0[i-1] : -1 );
+    if ( i > 0 && s[i] == s[i-1] && span0[i] == span0[i-1] )
+      memcpy( N0 + i*order0*order0, N0 + (i-1)*order0*order0, order0*order0*sizeof(N0[0]) );
+    else
+      ON_NurbsSurfaceBasisHelper( order0, m_knot[0] + span0[i], s[i], der_count0, N0 + i*order0*order0 );
+    if ( span0[i] < r0 )
+      r0 = span0[i];
+    if ( span0[i] + order0 > r1 )
+      r1 = span0[i] + order0;
+  }
+
+  // Only the rows of control points used by some s[i] are reduced.
+  const int row_count = r1 - r0;
+  double* N1 = ws.GetDoubleMemory( order1*order1 );
+  double* Q = ws.GetDoubleMemory( ((size_t)(der_count1+1))*row_count*cvdim );
+  double* P = ws.GetDoubleMemory( Pcount*cvdim );
+
+  int span1 = -1;
+  for ( j = 0; j < t_count; j++ )
+  {
+    if ( j > 0 && t[j] == t[j-1] )
+    {
+      // same row values as the previous t
+    }
+    else
+    {
+      span1 = ON_NurbsSurfaceSpanHelper( order1, m_cv_count[1], m_knot[1], t[j], side1, span1 );
+      ON_NurbsSurfaceBasisHelper( order1, m_knot[1] + span1, t[j], der_count1, N1 );
+      ON_NurbsSurfaceRowHelper( cvdim, order1,
+                                m_cv + (r0*m_cv_stride[0] + span1*m_cv_stride[1]),
+                                m_cv_stride[0], m_cv_stride[1],
+                                der_count1, N1, row_count, Q );
+    }
+
+    for ( i = 0; i < s_count; i++ )
+    {
+      if ( !ON_NurbsSurfaceContractHelper( m_dim, m_is_rat?true:false, order0,
+                                           der_count, der_count0, der_count1,
+                                           N0 + i*order0*order0, Q, row_count, span0[i] - r0,
+                                           P, v_stride, v + (((size_t)i)*t_count + j)*v_size ) )
+        return false;
+    }
+  }
+
+  return true;
+}
+
+bool ON_NurbsSurface::EvaluateMany(
+       int count,
+       const double* s,
+       const double* t,
+       int der_count,
+       double* v,
+       int v_stride,
+       int side,
+       int thread_count
+       ) const
+{
+  if ( 0 == count )
+    return true;
+  if (    count < 0 || 0 == s || 0 == t || 0 == v || der_count < 0
+       || m_dim < 1 || m_order[0] < 2 || m_order[1] < 2 
+       || m_cv_count[0] < m_order[0] || m_cv_count[1] < m_order[1]
+       || 0 == m_cv || 0 == m_knot[0] || 0 == m_knot[1] )
+    return false;
+  if ( 0 == v_stride )
+    v_stride = m_dim;
+  else if ( v_stride < m_dim )
+    return false;
+
+  if ( 1 != thread_count )
+  {
+    const int task_count = ON_NurbsSurfaceEvaluateTaskCount( thread_count, count, count );
+    if ( task_count > 1 )
+    {
+      ON_NurbsSurfaceEvaluateJob job;
+      memset(&job,0,sizeof(job));
+      job.m_surface = this;
+      job.m_count = count;
+      job.m_s = s;
+      job.m_t = t;
+      job.m_der_count = der_count;
+      job.m_v = v;
+      job.m_v_stride = v_stride;
+      job.m_side = side;
+      return ON_NurbsSurfaceEvaluateParallel( thread_count, task_count, job, ON_NurbsSurfaceEvaluateManyTask );
+    }
+  }
+
+  const int side0 = (side==2||side==3) ? -1 : 1;
+  const int side1 = (side==3||side==4) ? -1 : 1;
+  const int order0 = m_order[0];
+  const int order1 = m_order[1];
+  const int cvdim = m_is_rat ? m_dim+1 : m_dim;
+  const int der_count0 = (der_count >= order0) ? order0-1 : der_count;
+  const int der_count1 = (der_count >= order1) ? order1-1 : der_count;
+  const int Pcount = ((der_count+1)*(der_count+2))/2;
+  const int v_size = Pcount*v_stride;
+  int i, span0 = -1, span1 = -1, prev_span0, prev_span1;
+  bool bNewRows;
+
+  ON_Workspace ws;
+  double* N0 = ws.GetDoubleMemory( order0*order0 );
+  double* N1 = ws.GetDoubleMemory( order1*order1 );
+  double* Q = ws.GetDoubleMemory( (der_count1+1)*order0*cvdim );
+  double* P = ws.GetDoubleMemory( Pcount*cvdim );
+
+  for ( i = 0; i < count; i++, v += v_size )
+  {
+    prev_span0 = span0;
+    prev_span1 = span1;
+    span0 = ON_NurbsSurfaceSpanHelper( order0, m_cv_count[0], m_knot[0], s[i], side0, span0 );
+    span1 = ON_NurbsSurfaceSpanHelper( order1, m_cv_count[1], m_knot[1], t[i], side1, span1 );
+
+    if ( 0 == i || s[i] != s[i-1] || span0 != prev_span0 )
+      ON_NurbsSurfaceBasisHelper( order0, m_knot[0] + span0, s[i], der_count0, N0 );
+
+    bNewRows = ( 0 == i || span0 != prev_span0 );
+    if ( 0 == i || t[i] != t[i-1] || span1 != prev_span1 )
+    {
+      ON_NurbsSurfaceBasisHelper( order1, m_knot[1] + span1, t[i], der_count1, N1 );
+      bNewRows = true;
+    }
+
+    if ( bNewRows )
+    {
+      ON_NurbsSurfaceRowHelper( cvdim, order1,
+                                m_cv + (span0*m_cv_stride[0] + span1*m_cv_stride[1]),
+                                m_cv_stride[0], m_cv_stride[1],
+                                der_count1, N1, order0, Q );
+    }
+
+    if ( !ON_NurbsSurfaceContractHelper( m_dim, m_is_rat?true:false, order0,
+                                         der_count, der_count0, der_count1,
+                                         N0, Q, order0, 0,
+                                         P, v_stride, v ) )
+      return false;
+  }
+
+  return true;
+}
+
 
 ON_Curve* ON_NurbsSurface::IsoCurve(
        int dir,          // 0 first parameter varies and second parameter is constant
@@ -3112,3 +3845,309 @@ ON_BOOL32 ON_NurbsSurface::ConvertSpanToBezier(
   }
   return true;
 }
+
+static
+bool ON_NurbsSurfaceFitParameters(
+          int dim,
+          int order,
+          int point_count0,
+          int point_count1,
+          int point_stride0,
+          int point_stride1,
+          const double* point,
+          const double* point_parameters,
+          const double* knot,
+          double* t
+          )
+{
+  // Gets the parameters for the first direction.  Swap the counts and
+  // strides to get the parameters for the second direction.
+  int i, j, valid_count;
+  if ( point_parameters )
+    memcpy( t, point_parameters, point_count0*sizeof(t[0]) );
+  else if ( knot )
+  {
+    if ( !ON_GetGrevilleAbcissae( order, point_count0, knot, false, t ) )
+      return false;
+  }
+  else
+  {
+    // average the normalized chord lengths of the rows of points
+    ON_SimpleArray<double> row_t(point_count0);
+    row_t.SetCount(point_count0);
+    ON_SimpleArray<double> P(point_count0*dim);
+    P.SetCount(point_count0*dim);
+    memset( t, 0, point_count0*sizeof(t[0]) );
+    valid_count = 0;
+    for ( j = 0; j < point_count1; j++ )
+    {
+      for ( i = 0; i < point_count0; i++ )
+        memcpy( P.Array() + i*dim, point + i*point_stride0 + j*point_stride1, dim*sizeof(P[0]) );
+      if ( !ON_GetChordLengthParameters( dim, point_count0, dim, P.Array(), row_t.Array() ) )
+        continue; // degenerate row
+      const double d = 1.0/row_t[point_count0-1];
+      for ( i = 0; i < point_count0; i++ )
+        t[i] += d*row_t[i];
+      valid_count++;
+    }
+    if ( valid_count <= 0 )
+      return false;
+    for ( i = 1; i < point_count0-1; i++ )
+      t[i] /= valid_count;
+    t[0] = 0.0;
+    t[point_count0-1] = 1.0;
+  }
+
+  for ( i = 1; i < point_count0; i++ )
+  {
+    if ( !(t[i-1] < t[i]) )
+      return false;
+  }
+  return true;
+}
+
+static
+bool ON_NurbsSurfaceCollocationBand(
+          int order,
+          int count,
+          const double* knot,
+          const double* t,
+          double* band
+          )
+{
+  // See ON_NurbsCurve::CreateInterpolatingCurve() for the band layout.
+  int i, j, k, span_index;
+  const int bandwidth = order-1;
+  const int band_stride = 2*bandwidth+1;
+  ON_SimpleArray<double> N(order*order);
+  N.SetCount(order*order);
+  memset( band, 0, count*band_stride*sizeof(band[0]) );
+  span_index = 0;
+  for ( i = 0; i < count; i++ )
+  {
+    span_index = ON_NurbsSpanIndex( order, count, knot, t[i], 0, span_index );
+    if ( !ON_EvaluateNurbsBasis( order, knot+span_index, t[i], N.Array() ) )
+      return false;
+    for ( k = 0; k < order; k++ )
+    {
+      j = span_index + k;
+      if ( j < i-bandwidth || j > i+bandwidth )
+      {
+        if ( 0.0 != N[k] )
+          return false;
+        continue;
+      }
+      band[i*band_stride + j-i+bandwidth] = N[k];
+    }
+  }
+  return true;
+}
+
+bool ON_NurbsSurface::CreateInterpolatingSurface(
+          int dim,
+          int order0,
+          int order1,
+          int point_count0,
+          int point_count1,
+          int point_stride0,
+          int point_stride1,
+          const double* point,
+          const double* point_parameters0,
+          const double* point_parameters1,
+          const double* knot0,
+          const double* knot1
+          )
+{
+  int i, j;
+
+  if ( dim < 1 || order0 < 2 || order1 < 2 
+       || point_count0 < order0 || point_count1 < order1 
+       || 0 == point_stride0 || 0 == point_stride1 || 0 == point )
+    return false;
+
+  ON_SimpleArray<double> t0(point_count0), t1(point_count1);
+  t0.SetCount(point_count0);
+  t1.SetCount(point_count1);
+  if ( !ON_NurbsSurfaceFitParameters( dim, order0, point_count0, point_count1, point_stride0, point_stride1, 
+                                      point, point_parameters0, knot0, t0.Array() ) )
+    return false;
+  if ( !ON_NurbsSurfaceFitParameters( dim, order1, point_count1, point_count0, point_stride1, point_stride0, 
+                                      point, point_parameters1, knot1, t1.Array() ) )
+    return false;
+
+  if ( !Create( dim, false, order0, order1, point_count0, point_count1 ) )
+    return false;
+  if ( knot0 )
+    memcpy( m_knot[0], knot0, KnotCount(0)*sizeof(m_knot[0][0]) );
+  else if ( !ON_GetGrevilleKnotVector( 1, t0.Array(), false, order0, point_count0, m_knot[0] ) )
+    return false;
+  if ( knot1 )
+    memcpy( m_knot[1], knot1, KnotCount(1)*sizeof(m_knot[1][0]) );
+  else if ( !ON_GetGrevilleKnotVector( 1, t1.Array(), false, order1, point_count1, m_knot[1] ) )
+    return false;
+
+  for ( i = 0; i < point_count0; i++ )
+  {
+    for ( j = 0; j < point_count1; j++ )
+      memcpy( CV(i,j), point + i*point_stride0 + j*point_stride1, dim*sizeof(m_cv[0]) );
+  }
+
+  // Create() sets m_cv_stride[1] = dim and m_cv_stride[0] = dim*point_count1,
+  // so the first direction is solved with all the point_count1 columns as
+  // one right hand side of dimension dim*point_count1.
+  const int bandwidth0 = order0-1;
+  const int bandwidth1 = order1-1;
+  ON_SimpleArray<double> band0(point_count0*(2*bandwidth0+1));
+  band0.SetCount(point_count0*(2*bandwidth0+1));
+  if ( !ON_NurbsSurfaceCollocationBand( order0, point_count0, m_knot[0], t0.Array(), band0.Array() ) )
+    return false;
+  if ( !ON_SolveBandedSystem( point_count0, bandwidth0, bandwidth0, band0.Array(), 
+                              m_cv_stride[0], m_cv_stride[0], m_cv ) )
+    return false;
+
+  // The second direction is solved one row of control points at a time.
+  const int band1_count = point_count1*(2*bandwidth1+1);
+  ON_SimpleArray<double> band1(band1_count), lu1(band1_count);
+  band1.SetCount(band1_count);
+  lu1.SetCount(band1_count);
+  if ( !ON_NurbsSurfaceCollocationBand( order1, point_count1, m_knot[1], t1.Array(), band1.Array() ) )
+    return false;
+  for ( i = 0; i < point_count0; i++ )
+  {
+    memcpy( lu1.Array(), band1.Array(), band1_count*sizeof(lu1[0]) );
+    if ( !ON_SolveBandedSystem( point_count1, bandwidth1, bandwidth1, lu1.Array(),
+                                dim, m_cv_stride[1], CV(i,0) ) )
+      return false;
+  }
+
+  return true;
+}
+
+bool ON_NurbsSurface::CreateLeastSquaresSurface(
+          int dim,
+          int order0,
+          int order1,
+          int cv_count0,
+          int cv_count1,
+          int point_count,
+          int point_stride,
+          const double* point,
+          const double* point_uv,
+          const double* knot0,
+          const double* knot1,
+          double smoothing
+          )
+{
+  int i, j, k, a, b, span0, span1, dir;
+
+  if ( dim < 1 || order0 < 2 || order1 < 2 || cv_count0 < order0 || cv_count1 < order1
+       || point_count < 1 || point_stride < dim || 0 == point || 0 == point_uv 
+       || !(smoothing >= 0.0) )
+    return false;
+
+  if ( !Create( dim, false, order0, order1, cv_count0, cv_count1 ) )
+    return false;
+
+  const double* knot[2] = {knot0,knot1};
+  for ( dir = 0; dir < 2; dir++ )
+  {
+    if ( knot[dir] )
+    {
+      memcpy( m_knot[dir], knot[dir], KnotCount(dir)*sizeof(m_knot[dir][0]) );
+      continue;
+    }
+    // clamped uniform knots on the range of the parameters
+    ON_Interval range( point_uv[dir], point_uv[dir] );
+    for ( i = 1; i < point_count; i++ )
+    {
+      const double s = point_uv[2*i+dir];
+      if ( s < range[0] ) range[0] = s; else if ( s > range[1] ) range[1] = s;
+    }
+    if ( !(range[0] < range[1]) )
+      return false;
+    const int span_count = m_cv_count[dir] - m_order[dir] + 1;
+    if ( !ON_MakeClampedUniformKnotVector( m_order[dir], m_cv_count[dir], m_knot[dir], 1.0 ) )
+      return false;
+    const int knot_count = KnotCount(dir);
+    const double k0 = m_knot[dir][0];
+    for ( k = 0; k < knot_count; k++ )
+      m_knot[dir][k] = range.ParameterAt( (m_knot[dir][k] - k0)/span_count );
+  }
+
+  // Control point (i,j) is unknown i*cv_count1 + j.  A point's 
+  // order0*order1 basis functions are non-zero for unknowns that
+  // are at most (order0-1)*cv_count1 + order1-1 apart.
+  const int n = cv_count0*cv_count1;
+  const int bandwidth = (order0-1)*cv_count1 + order1-1;
+  const int band_stride = bandwidth+1;
+  const size_t band_size = ((size_t)n)*((size_t)band_stride);
+  double* band = (double*)onmalloc( band_size*sizeof(band[0]) );
+  if ( 0 == band )
+    return false;
+  memset( band, 0, band_size*sizeof(band[0]) );
+  memset( m_cv, 0, n*dim*sizeof(m_cv[0]) );
+
+  ON_SimpleArray<double> N0(order0*order0), N1(order1*order1), B(order0*order1);
+  ON_SimpleArray<int> index(order0*order1);
+  N0.SetCount(order0*order0);
+  N1.SetCount(order1*order1);
+  B.SetCount(order0*order1);
+  index.SetCount(order0*order1);
+  const int local_count = order0*order1;
+
+  span0 = span1 = 0;
+  for ( i = 0; i < point_count; i++ )
+  {
+    const double u = point_uv[2*i];
+    const double v = point_uv[2*i+1];
+    span0 = ON_NurbsSpanIndex( order0, cv_count0, m_knot[0], u, 0, span0 );
+    span1 = ON_NurbsSpanIndex( order1, cv_count1, m_knot[1], v, 0, span1 );
+    ON_EvaluateNurbsBasis( order0, m_knot[0]+span0, u, N0.Array() );
+    ON_EvaluateNurbsBasis( order1, m_knot[1]+span1, v, N1.Array() );
+    const double* P = point + ((size_t)i)*point_stride;
+
+    // The local unknowns are listed in increasing order.
+    for ( a = k = 0; a < order0; a++ ) for ( b = 0; b < order1; b++, k++ )
+    {
+      B[k] = N0[a]*N1[b];
+      index[k] = (span0+a)*cv_count1 + span1+b;
+    }
+    for ( a = 0; a < local_count; a++ )
+    {
+      const double s = B[a];
+      if ( 0.0 == s )
+        continue;
+      double* row = band + ((size_t)index[a])*band_stride + bandwidth - index[a];
+      for ( b = 0; b <= a; b++ )
+        row[index[b]] += s*B[b];
+      double* cv = m_cv + ((size_t)index[a])*dim;
+      for ( j = 0; j < dim; j++ )
+        cv[j] += s*P[j];
+    }
+  }
+
+  if ( smoothing > 0.0 )
+  {
+    // membrane energy: smoothing*|cv(i,j) - cv(i',j')|^2 for adjacent control points
+    for ( i = 0; i < cv_count0; i++ ) for ( j = 0; j < cv_count1; j++ )
+    {
+      k = i*cv_count1 + j;
+      if ( i > 0 )
+      {
+        band[((size_t)k)*band_stride + bandwidth] += smoothing;
+        band[((size_t)(k-cv_count1))*band_stride + bandwidth] += smoothing;
+        band[((size_t)k)*band_stride + bandwidth - cv_count1] -= smoothing;
+      }
+      if ( j > 0 )
+      {
+        band[((size_t)k)*band_stride + bandwidth] += smoothing;
+        band[((size_t)(k-1))*band_stride + bandwidth] += smoothing;
+        band[((size_t)k)*band_stride + bandwidth - 1] -= smoothing;
+      }
+    }
+  }
+
+  const bool rc = ON_SolveBandedSymmetricSystem( n, bandwidth, band, dim, dim, m_cv );
+  onfree(band);
+  return rc;
+}
@@ -22,6 +22,7 @@
 #if !defined(OPENNURBS_NURBSSURFACE_INC_)
 #define OPENNURBS_NURBSSURFACE_INC_
 
+class ON_NurbsSurfaceSpanCache;
 class ON_CLASS ON_TensorProduct
 {
   // Pure virtual tensor passed to ON_NurbsSurface::TensorProduct()
@@ -102,6 +103,9 @@ public:
   // virtual ON_Object::SizeOf override
   unsigned int SizeOf() const;
 
+  // virtual ON_Object::DestroyRuntimeCache override
+  void DestroyRuntimeCache( bool bDelete = true );
+
   // virtual ON_Object::DataCRC override
   ON__UINT32 DataCRC(ON__UINT32 current_remainder) const;
 
@@ -134,6 +138,106 @@ public:
           int cv_count1  // cv count1 (>= order1)
           );
 
+  /*
+  Description:
+    Create a non-rational NURBS surface that interpolates
+    a grid of points.
+  Parameters:
+    dim - [in] (>=1) point dimension
+    order0 - [in] (>=2) order in the first direction
+    order1 - [in] (>=2) order in the second direction
+    point_count0 - [in] (>=order0) number of points in the first direction
+    point_count1 - [in] (>=order1) number of points in the second direction
+    point_stride0 - [in] stride between point[i][j] and point[i+1][j]
+    point_stride1 - [in] stride between point[i][j] and point[i][j+1]
+    point - [in] grid of points to interpolate. Point[i][j] is
+        point + i*point_stride0 + j*point_stride1.
+    point_parameters0 - [in] If not NULL, an increasing list of 
+        point_count0 parameters.  If NULL and knot0 is not NULL,
+        the Greville abcissae of knot0 are used.  Otherwise the
+        normalized chord lengths of the point rows are averaged.
+    point_parameters1 - [in] same as point_parameters0 for the 
+        second direction.
+    knot0 - [in] If not NULL, ON_KnotCount(order0,point_count0) knots.
+        If NULL, the knots are calculated from the parameters.
+    knot1 - [in] same as knot0 for the second direction.
+  Returns:
+    true if successful.
+  Remarks:
+    The tensor product system is solved as one banded system in
+    each direction, so the time is O(point_count0*point_count1*
+    (order0^2 + order1^2)).
+  See Also:
+    ON_NurbsCurve::CreateInterpolatingCurve
+    ON_NurbsSurface::CreateLeastSquaresSurface
+  */
+  bool CreateInterpolatingSurface(
+          int dim,
+          int order0,
+          int order1,
+          int point_count0,
+          int point_count1,
+          int point_stride0,
+          int point_stride1,
+          const double* point,
+          const double* point_parameters0 = 0,
+          const double* point_parameters1 = 0,
+          const double* knot0 = 0,
+          const double* knot1 = 0
+          );
+
+  /*
+  Description:
+    Create a non-rational NURBS surface that is the least squares
+    fit to a set of scattered points with known surface parameters.
+  Parameters:
+    dim - [in] (>=1) point dimension
+    order0 - [in] (>=2) order in the first direction
+    order1 - [in] (>=2) order in the second direction
+    cv_count0 - [in] (>=order0) number of control points in the 
+        first direction
+    cv_count1 - [in] (>=order1) number of control points in the 
+        second direction
+    point_count - [in] number of points to fit
+    point_stride - [in] (>=dim) stride between points
+    point - [in] points to fit
+    point_uv - [in] array of 2*point_count surface parameters.
+        (point_uv[2*i],point_uv[2*i+1]) are the parameters for
+        the i-th point.
+    knot0 - [in] If not NULL, ON_KnotCount(order0,cv_count0) knots.
+        If NULL, clamped uniform knots spanning the first parameters
+        of point_uv[] are used.
+    knot1 - [in] same as knot0 for the second direction.
+    smoothing - [in] (>=0) If > 0, then smoothing*(sum of squared 
+        distances between adjacent control points) is added to 
+        the least squares error.  This makes the fit well defined
+        when some control points have no points in their support.
+  Returns:
+    true if successful.
+  Remarks:
+    The normal equations are accumulated in one pass over the points
+    and solved with ON_SolveBandedSymmetricSystem().  The control
+    points are ordered so the bandwidth is 
+    (order0-1)*cv_count1 + order1-1.  Use the smaller cv count for
+    the second direction to keep the band narrow.
+  See Also:
+    ON_NurbsCurve::CreateLeastSquaresCurve
+  */
+  bool CreateLeastSquaresSurface(
+          int dim,
+          int order0,
+          int order1,
+          int cv_count0,
+          int cv_count1,
+          int point_count,
+          int point_stride,
+          const double* point,
+          const double* point_uv,
+          const double* knot0 = 0,
+          const double* knot1 = 0,
+          double smoothing = 0.0
+          );
+
   /*
   Description:
     Create a ruled surface from two curves.
@@ -283,6 +387,38 @@ public:
          ON_BOOL32 = false  // true means grow box
          ) const;
 
+  /*
+	Description:
+    virtual ON_Geometry::GetTightBoundingBox override.
+    Gets the bounding box of the surface itself, which can be much
+    smaller than the bounding box of the control net that
+    GetBBox() returns.
+	Parameters:
+		tight_bbox - [in/out] tight bounding box
+		bGrowBox -[in]	(default=false)			
+      If true and the input tight_bbox is valid, then returned
+      tight_bbox is the union of the input tight_bbox and the 
+      surface's tight bounding box.
+		xform -[in] (default=NULL)
+      If not NULL, the tight bounding box of the transformed
+      surface is calculated.  The surface is not modified.
+	Returns:
+    True if the returned tight_bbox is set to a valid 
+    bounding box.
+  Remarks:
+    The bispans are subdivided until the box is within 
+    ON_SQRT_EPSILON*(size of the surface) of the surface.
+    The box always contains the surface.  When xform is NULL
+    the result is cached until the surface is modified.  The
+    cache is updated under a lock, so several threads may call
+    GetTightBoundingBox() on the same surface at once.
+  */
+	bool GetTightBoundingBox( 
+			ON_BoundingBox& tight_bbox, 
+      int bGrowBox = false,
+			const ON_Xform* xform = 0
+      ) const;
+
   ON_BOOL32 Transform( 
          const ON_Xform&
          );
@@ -511,6 +647,135 @@ public:
                          //            repeated evaluations
          ) const;
 
+  /*
+  Description:
+    Evaluate the surface at every (s[i],t[j]) grid point.
+  Parameters:
+    s_count - [in] number of "s" parameters.
+    s - [in] array of s_count "s" parameters.
+    t_count - [in] number of "t" parameters.
+    t - [in] array of t_count "t" parameters.
+    der_count - [in] number of derivatives (>=0).
+    v - [out] array of length s_count*t_count*Pcount*v_stride,
+       where Pcount = (der_count+1)*(der_count+2)/2.
+       The results for (s[i],t[j]) begin at 
+       n = (i*t_count + j)*Pcount*v_stride and are in the
+       same order as ON_NurbsSurface::Evaluate() returns them:
+       point, Ds, Dt, Dss, Dst, Dtt, ...
+    v_stride - [in] (>= Dimension()) stride between the point
+       and derivative values of a single evaluation.
+       If 0, Dimension() is used.
+    side - [in] same as ON_NurbsSurface::Evaluate().
+    thread_count - [in] maximum number of threads.
+       See ON_ParallelFor().
+  Returns:
+    True if successful.
+  Remarks:
+    The basis functions for each s[i] are computed once.  For
+    each t[j] the control points are reduced to one row per "s"
+    control point and that row is shared by all s[i].  Dense
+    grids are much faster than calling Evaluate() for each point.
+    When several threads are used, each thread evaluates a range
+    of s[] at every t[] and reduces only the rows its range uses;
+    the results do not depend on the number of threads.  The 
+    results keep the Evaluate() layout rather than a structure
+    of arrays, and the SIMD kernels in opennurbs_simd.h are not
+    used.
+  See Also:
+    ON_NurbsSurface::Evaluate
+    ON_NurbsSurface::EvaluateMany
+  */
+  bool EvaluateGrid(
+         int s_count,
+         const double* s,
+         int t_count,
+         const double* t,
+         int der_count,
+         double* v,
+         int v_stride = 0,
+         int side = 0,
+         int thread_count = 1
+         ) const;
+
+  /*
+  Description:
+    Evaluate the surface at many (s[i],t[i]) parameters.
+  Parameters:
+    count - [in] number of parameters.
+    s - [in] array of count "s" parameters.
+    t - [in] array of count "t" parameters.
+    der_count - [in] number of derivatives (>=0).
+    v - [out] array of length count*Pcount*v_stride,
+       where Pcount = (der_count+1)*(der_count+2)/2.
+       The results for (s[i],t[i]) begin at n = i*Pcount*v_stride.
+    v_stride - [in] (>= Dimension()) stride between the point
+       and derivative values of a single evaluation.
+       If 0, Dimension() is used.
+    side - [in] same as ON_NurbsSurface::Evaluate().
+    thread_count - [in] maximum number of threads.
+       See ON_ParallelFor().
+  Returns:
+    True if successful.
+  Remarks:
+    Spans and basis functions are reused when consecutive
+    parameters are in the same span or repeat a value.
+    When several threads are used, the parameter list is split
+    into ranges that are evaluated at the same time; the 
+    results do not depend on the number of threads.
+  See Also:
+    ON_NurbsSurface::Evaluate
+    ON_NurbsSurface::EvaluateGrid
+  */
+  bool EvaluateMany(
+         int count,
+         const double* s,
+         const double* t,
+         int der_count,
+         double* v,
+         int v_stride = 0,
+         int side = 0,
+         int thread_count = 1
+         ) const;
+
+  /*
+  Description:
+    Enable or disable the bispan evaluation cache.
+  Parameters:
+    bispan_count - [in] maximum number of bispans kept in the
+       cache.  0 disables the cache and frees its memory.
+  Remarks:
+    The cache is off by default.  When it is on, Evaluate()
+    converts each bispan it visits to Taylor (power basis) 
+    coefficients and evaluates later parameters in a cached
+    bispan with Horner's rule.  This speeds up marching and
+    other algorithms that evaluate many nearby parameters.
+    Only quadratic and cubic bispans are cached, because power
+    basis coefficients lose precision as the degree grows.
+    Parameters on knots are always evaluated from the control
+    points, so bispan ends are exact.
+    The cache is runtime information.  It is not copied or
+    saved and it is emptied by DestroyRuntimeCache(), which 
+    DestroySurfaceTree() calls when the surface is modified.
+    If you change m_cv[] or m_knot[] directly, call 
+    DestroyRuntimeCache().  One thread at a time uses the 
+    cache; other threads that evaluate the surface at the same
+    time do not use it.  Do not call SetEvaluationCacheSize()
+    or DestroyRuntimeCache() while another thread is 
+    evaluating the surface.
+  See Also:
+    ON_NurbsSurface::EvaluationCacheSize
+  */
+  void SetEvaluationCacheSize( int bispan_count );
+
+  /*
+  Returns:
+    Maximum number of bispans in the evaluation cache.
+    0 if the cache is disabled.
+  See Also:
+    ON_NurbsSurface::SetEvaluationCacheSize
+  */
+  int EvaluationCacheSize() const;
+
   /*
   Description:
     Get isoparametric curve.
@@ -1025,6 +1290,15 @@ public:
                             //
                             //         [ CV(i)[0], ..., CV(i)[m_dim] ].
                             // 
+
+private:
+  // Runtime only - ignored by Read()/Write()
+  // m_span_cache, m_tight_bbox and m_tight_bbox_crc change the 
+  // size of the class; code that uses this class must be 
+  // compiled with this header.
+  ON_NurbsSurfaceSpanCache* m_span_cache;
+  ON_BoundingBox m_tight_bbox;   // cached GetTightBoundingBox() result
+  ON__UINT32 m_tight_bbox_crc;   // CRC of the knots and CVs m_tight_bbox came from
 };
 
 
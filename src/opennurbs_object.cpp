@@ -607,13 +607,221 @@ ON_ClassId* ON_ClassId::m_p0 = 0; // static pointer to first id in list
 ON_ClassId* ON_ClassId::m_p1 = 0; // static pointer to last id in list
 int ON_ClassId::m_mark0 = 0;
 
+/*
+The ON_ClassId::ClassId() lookups happen for every object and
+every piece of user data read from an archive.  The class ids
+are indexed by uuid and by name in two open addressing hash
+tables so these lookups do not have to walk the m_p0 list.
+
+The tables are updated as class ids are appended to the list
+and are rebuilt from the list the next time they are needed
+after a Purge() or PurgeAfter() call.  Unused slots are NULL.
+The table capacity is a power of 2 and is always at least twice
+the number of class ids so probe sequences are short.
+*/
+static const ON_ClassId** g_classid_uuid_table = 0;
+static const ON_ClassId** g_classid_name_table = 0;
+static unsigned int g_classid_table_capacity = 0;
+static unsigned int g_classid_table_count = 0;
+static bool g_bClassIdTableIsValid = false;
+
+static unsigned int ON_ClassIdUuidHash( const ON_UUID& uuid )
+{
+  unsigned int h = uuid.Data1;
+  h ^= (((unsigned int)uuid.Data2) << 16) | ((unsigned int)uuid.Data3);
+  h ^= (((unsigned int)uuid.Data4[4]) << 24) 
+     | (((unsigned int)uuid.Data4[5]) << 16)
+     | (((unsigned int)uuid.Data4[6]) << 8)
+     | ((unsigned int)uuid.Data4[7]);
+  h ^= (h >> 16);
+  h *= 0x85EBCA6B;
+  h ^= (h >> 13);
+  return h;
+}
+
+static unsigned int ON_ClassIdNameHash( const char* sClassName )
+{
+  // FNV-1a
+  unsigned int h = 2166136261U;
+  while ( *sClassName )
+  {
+    h ^= (unsigned char)(*sClassName++);
+    h *= 16777619U;
+  }
+  return h;
+}
+
+static void ON_ClassIdTableInsertHelper( const ON_ClassId* p )
+{
+  const unsigned int mask = g_classid_table_capacity - 1;
+  unsigned int i;
+
+  i = ON_ClassIdUuidHash(p->Uuid()) & mask;
+  while ( 0 != g_classid_uuid_table[i] )
+    i = (i+1) & mask;
+  g_classid_uuid_table[i] = p;
+
+  i = ON_ClassIdNameHash(p->ClassName()) & mask;
+  while ( 0 != g_classid_name_table[i] )
+    i = (i+1) & mask;
+  g_classid_name_table[i] = p;
+
+  g_classid_table_count++;
+}
+
+static bool ON_ClassIdTableRebuildHelper( const ON_ClassId* p0, unsigned int count )
+{
+  unsigned int capacity = 256;
+  while ( capacity < 2*count )
+    capacity *= 2;
+
+  if ( capacity != g_classid_table_capacity || 0 == g_classid_uuid_table )
+  {
+    if ( g_classid_uuid_table )
+      free(g_classid_uuid_table);
+    // The table is built by static ON_ClassId constructors before
+    // main() and lives as long as the class list, so it comes from
+    // the C runtime instead of the on*() memory functions.  That 
+    // keeps it out of memory pools and lets an application call
+    // ON_SetMemoryAllocator() at startup.
+    g_classid_uuid_table = (const ON_ClassId**)calloc( 2*capacity, sizeof(g_classid_uuid_table[0]) );
+    if ( 0 == g_classid_uuid_table )
+    {
+      g_classid_name_table = 0;
+      g_classid_table_capacity = 0;
+      g_classid_table_count = 0;
+      g_bClassIdTableIsValid = false;
+      return false;
+    }
+    g_classid_name_table = g_classid_uuid_table + capacity;
+    g_classid_table_capacity = capacity;
+  }
+  else
+  {
+    memset( g_classid_uuid_table, 0, 2*capacity*sizeof(g_classid_uuid_table[0]) );
+  }
+
+  g_classid_table_count = 0;
+  for ( const ON_ClassId* p = p0; p; p = p->NextClassId() )
+    ON_ClassIdTableInsertHelper(p);
+  g_bClassIdTableIsValid = true;
+  return true;
+}
+
+static bool ON_ClassIdTableIsReady( const ON_ClassId* p0 )
+{
+  if ( !g_bClassIdTableIsValid )
+  {
+    unsigned int count = 0;
+    for ( const ON_ClassId* p = p0; p; p = p->NextClassId() )
+      count++;
+    ON_ClassIdTableRebuildHelper( p0, count );
+  }
+  return g_bClassIdTableIsValid;
+}
+
+static void ON_ClassIdTableAppend( const ON_ClassId* p0, const ON_ClassId* p )
+{
+  if ( g_bClassIdTableIsValid )
+  {
+    if ( 2*(g_classid_table_count+1) <= g_classid_table_capacity )
+      ON_ClassIdTableInsertHelper(p);
+    else
+      ON_ClassIdTableRebuildHelper( p0, g_classid_table_count+1 );
+  }
+}
+
+static const ON_ClassId* ON_ClassIdFindName( const ON_ClassId* p0, const char* sClassName )
+{
+  const ON_ClassId* p;
+  if ( ON_ClassIdTableIsReady(p0) )
+  {
+    const unsigned int mask = g_classid_table_capacity - 1;
+    unsigned int i = ON_ClassIdNameHash(sClassName) & mask;
+    while ( 0 != (p = g_classid_name_table[i]) )
+    {
+      if ( !strcmp( sClassName, p->ClassName() ) )
+        break;
+      i = (i+1) & mask;
+    }
+  }
+  else
+  {
+    // hash table could not be allocated - search the list
+    for ( p = p0; p; p = p->NextClassId() )
+    {
+      if ( !strcmp( sClassName, p->ClassName() ) )
+        break;
+    }
+  }
+  return p;
+}
+
+static const ON_ClassId* ON_ClassIdFindUuid( const ON_ClassId* p0, const ON_UUID& uuid )
+{
+  const ON_ClassId* p;
+  ON_UUID class_uuid;
+  if ( ON_ClassIdTableIsReady(p0) )
+  {
+    const unsigned int mask = g_classid_table_capacity - 1;
+    unsigned int i = ON_ClassIdUuidHash(uuid) & mask;
+    while ( 0 != (p = g_classid_uuid_table[i]) )
+    {
+      class_uuid = p->Uuid();
+      if ( !ON_UuidCompare(&class_uuid,&uuid) )
+        break;
+      i = (i+1) & mask;
+    }
+  }
+  else
+  {
+    // hash table could not be allocated - search the list
+    for ( p = p0; p; p = p->NextClassId() )
+    {
+      class_uuid = p->Uuid();
+      if ( !ON_UuidCompare(&class_uuid,&uuid) )
+        break;
+    }
+  }
+  return p;
+}
+
+/*
+The class id list, the lookup tables and m_mark0 are shared by 
+every thread.  Registration, purging and lookups hold this lock.
+It is a spin lock on a zero initialized int so it can be used 
+while static ON_ClassId members are being constructed.
+*/
+static int g_classid_lock = 0;
+
+class ON__ClassIdListLock
+{
+public:
+  ON__ClassIdListLock()
+  {
+    while ( 0 != ON_ATOMIC_COMPARE_AND_SWAP(&g_classid_lock,0,1) )
+    {
+      // spin - the lock is only held for short list and table operations
+    }
+  }
+  ~ON__ClassIdListLock()
+  {
+    ON_ATOMIC_COMPARE_AND_SWAP(&g_classid_lock,1,0);
+  }
+private:
+  ON__ClassIdListLock(const ON__ClassIdListLock&);
+  ON__ClassIdListLock& operator=(const ON__ClassIdListLock&);
+};
+
 int ON_ClassId::CurrentMark()
 {
+  ON__ClassIdListLock lock;
   return m_mark0;
 }
 
 int ON_ClassId::IncrementMark()
 {
+  ON__ClassIdListLock lock;
   m_mark0++;
   return m_mark0;
 }
@@ -623,6 +831,7 @@ int ON_ClassId::Purge( int mark_value )
   // Fundamental openNURBS class ids have a mark value of 0 and cannot be purged.
   int purge_count = 0;
   if ( mark_value > 0 ) {
+    ON__ClassIdListLock lock;
     ON_ClassId* prev = 0;
     ON_ClassId* next = 0;
     ON_ClassId* p;
@@ -640,17 +849,21 @@ int ON_ClassId::Purge( int mark_value )
       else
         prev = p;
     }
+    if ( purge_count > 0 )
+      g_bClassIdTableIsValid = false;
   }
   return purge_count;
 }
 
 const ON_ClassId* ON_ClassId::LastClassId()
 {
+  ON__ClassIdListLock lock;
   return m_p1;
 }
 
 bool ON_ClassId::PurgeAfter(const ON_ClassId* pClassId)
 {
+  ON__ClassIdListLock lock;
   // If you crash in on the p=p->m_pNext iterator in
   // the for() loop, it is because somebody incorrectly
   // unloaded a dll that contains an ON_OBJECT_IMPLEMENT 
@@ -663,6 +876,7 @@ bool ON_ClassId::PurgeAfter(const ON_ClassId* pClassId)
       // be bad.
       p->m_pNext = 0;
       m_p1 = p;
+      g_bClassIdTableIsValid = false;
       return true;
     }
   }
@@ -673,8 +887,6 @@ bool ON_ClassId::PurgeAfter(const ON_ClassId* pClassId)
 
 //////////////////////////////////////////////////////////////////////////////
 
-static ON_BOOL32 g_bDisableDemotion = false;
-
 static void IntToString( int i, char s[7] )
 {
   // avoid format printing during early start up
@@ -760,6 +972,7 @@ void ON_ClassId::ConstructorHelper( const char* sClassName,
   // Do not initialize "m_class_id_version" or any fields
   // after it in this helper.  See comments in the constructors
   // for more information.
+  ON__ClassIdListLock lock;
   memset( m_sClassName, 0, sizeof(m_sClassName) );
   memset( m_sBaseClassName, 0, sizeof(m_sBaseClassName) );
   m_uuid = ON_UuidFromString(sUUID);
@@ -769,14 +982,14 @@ void ON_ClassId::ConstructorHelper( const char* sClassName,
   if ( sBaseClassName ) {
     strncpy( m_sBaseClassName, sBaseClassName, sizeof(m_sBaseClassName)-1 );
   }
-  m_pBaseClassId = ClassId( m_sBaseClassName );
+  m_pBaseClassId = m_sBaseClassName[0] ? ON_ClassIdFindName( m_p0, m_sBaseClassName ) : 0;
 
   if ( !m_sClassName[0] ) {
     ON_ERROR("ON_ClassId::ON_ClassId() - missing class name");
     return;
   }
 
-  const ON_ClassId* duplicate_class = ClassId( m_sClassName );
+  const ON_ClassId* duplicate_class = ON_ClassIdFindName( m_p0, m_sClassName );
   // The m_mark0 > 2 test prevents opennurbs and Rhino from
   // having two ON_Object derived classes that have the same
   // name.  Plug-ins are free to use any name.
@@ -791,7 +1004,7 @@ void ON_ClassId::ConstructorHelper( const char* sClassName,
       s[6] = 0;
       strncpy( m_sClassName, sClassName, sizeof(m_sClassName)-1 );
       strncat( m_sClassName, s, sizeof(m_sClassName)-1 );
-      duplicate_class = ClassId( m_sClassName );
+      duplicate_class = ON_ClassIdFindName( m_p0, m_sClassName );
     }
   }
 
@@ -819,14 +1032,11 @@ void ON_ClassId::ConstructorHelper( const char* sClassName,
     }
   }
 
-  g_bDisableDemotion = true;
-  if ( ClassId( m_uuid ) ) 
+  if ( ON_ClassIdFindUuid( m_p0, m_uuid ) ) 
   {
-    g_bDisableDemotion = false;
     ON_ERROR("ON_ClassId::ON_ClassId() - class uuid already in use.");
     return;
   }
-  g_bDisableDemotion = false;
 
   if ( ON_UuidIsNil( m_uuid ) ) {
     ON_ERROR("ON_ClassId::ON_ClassId() - class uuid is nill.");
@@ -859,12 +1069,14 @@ void ON_ClassId::ConstructorHelper( const char* sClassName,
   }
   m_p1 = this;
   m_p1->m_pNext = 0;
+
+  ON_ClassIdTableAppend( m_p0, this );
 }
 
 ON_ClassId::~ON_ClassId()
 {}
 
-static ON_UUID s_most_recent_class_id_create_uuid;
+static ON_THREAD_LOCAL ON_UUID s_most_recent_class_id_create_uuid;
 
 ON_UUID ON_GetMostRecentClassIdCreateUuid()
 {
@@ -884,26 +1096,10 @@ const ON_ClassId* ON_ClassId::ClassId( const char* sClassName )
 {
   // static member function
   // search list of class ids for one with a matching class name
-  ON_ClassId* p;
-  const char* s0;
-  const char* s1;
   if ( !sClassName || !sClassName[0] || sClassName[0] == '0' )
     return NULL;
-  for(p = m_p0; p; p = p->m_pNext) {
-    // avoid strcmp() because it crashes on NULL strings
-    s0 = sClassName;
-    s1 = p->m_sClassName;
-    if ( s0 && s1 && *s0 ) {
-      while ( *s0 && *s0 == *s1 )
-        {s0++; s1++;}
-      if ( !(*s0) && !(*s1) )
-        break;
-    }
-    else {
-      break;
-    }
-  }
-  return p;
+  ON__ClassIdListLock lock;
+  return ON_ClassIdFindName( m_p0, sClassName );
 }
 
 
@@ -912,13 +1108,12 @@ const ON_ClassId* ON_ClassId::ClassId( ON_UUID uuid )
   // static member function
   // search list of class ids for one with a matching typecode
   const ON_ClassId* p;
-  for(p = m_p0; p; p = p->m_pNext) 
   {
-    if ( !ON_UuidCompare(&p->m_uuid,&uuid) )
-      break;
+    ON__ClassIdListLock lock;
+    p = ON_ClassIdFindUuid( m_p0, uuid );
   }
 
-  if ( !p && !g_bDisableDemotion) 
+  if ( !p ) 
   {
     // enable OpenNURBS toolkit to read files that contain old uuids even when
     // old class definitions are not loaded.
@@ -1153,6 +1348,7 @@ bool ON__ClassIdDumpNode::Dump( int depth, ON_TextLog& text_log )
 
 void ON_ClassId::Dump( ON_TextLog& dump )
 {
+  ON__ClassIdListLock lock;
   int i, j, count = 0;
   const ON_ClassId* p;
   for(p = m_p0; p && count < 1000000; p = p->m_pNext) 
@@ -1233,6 +1429,11 @@ const char* ON_ClassId::BaseClassName() const
   return m_sBaseClassName;
 }
 
+const ON_ClassId* ON_ClassId::NextClassId() const
+{
+  return m_pNext;
+}
+
 ON_UUID ON_ClassId::Uuid() const
 {
   return m_uuid;
@@ -1410,7 +1611,8 @@ ON_UserData* ON_Object::GetUserData( const ON_UUID& userdata_uuid ) const
   {
     if ( !ON_UuidCompare( &p->m_userdata_uuid, &userdata_uuid ) ) 
     {
-      if ( p->IsUnknownUserData() ) 
+      const ON_DeferredUserData* dud = p->IsUnknownUserData() ? 0 : ON_DeferredUserData::Cast(p);
+      if ( p->IsUnknownUserData() || 0 != dud ) 
       {
         // See if we can convert this unknown user data into something useful.
         // Unknown user data is created when a 3dm archive is read and
@@ -1418,9 +1620,11 @@ ON_UserData* ON_Object::GetUserData( const ON_UUID& userdata_uuid ) const
         // If something is getting around to asking for a specific kind
         // of user data, the class definition has probably be dynamically
         // loaded.
+        // Deferred user data is read from its file the first time it
+        // is asked for.
         ON_UnknownUserData* uud = ON_UnknownUserData::Cast(p);
-        if ( uud ) {
-          ON_UserData* realp = uud->Convert();
+        if ( uud || dud ) {
+          ON_UserData* realp = uud ? uud->Convert() : dud->Convert();
           if ( realp ) 
           {
             // replace unknown user data with the real thing
@@ -1451,6 +1655,30 @@ ON_UserData* ON_Object::GetUserData( const ON_UUID& userdata_uuid ) const
 
 ON_UserData* ON_Object::FirstUserData() const
 {
+  // Replace deferred user data with the real thing so the caller
+  // sees the classes it expects.
+  ON_UserData* prev = NULL;
+  ON_UserData* p;
+  for ( p = m_userdata_list; p; prev = p, p = p->m_userdata_next )
+  {
+    const ON_DeferredUserData* dud = ON_DeferredUserData::Cast(p);
+    if ( !dud )
+      continue;
+    ON_UserData* realp = dud->Convert();
+    if ( !realp )
+      continue;
+    ON_Object* pNotConst = const_cast<ON_Object*>(this);
+    if ( prev )
+      prev->m_userdata_next = realp;
+    else
+      pNotConst->m_userdata_list = realp;
+    realp->m_userdata_owner = pNotConst;
+    realp->m_userdata_next = p->m_userdata_next;
+    p->m_userdata_next = 0;
+    p->m_userdata_owner = 0;
+    delete p;
+    p = realp;
+  }
   return m_userdata_list;
 }
 
@@ -1458,7 +1686,8 @@ ON_UserData* ON_Object::FirstUserData() const
 void ON_Object::TransformUserData( const ON_Xform& x )
 {
   ON_UserData *p, *next;
-  for ( p = m_userdata_list; p; p = next ) {
+  // deferred user data must be read before it can be transformed
+  for ( p = FirstUserData(); p; p = next ) {
     next = p->m_userdata_next;
     if ( !p->Transform(x) )
       delete p;
@@ -1706,6 +1935,13 @@ void ON_Curve::DestroyRuntimeCache( bool bDelete )
 #else
   m_ctree = 0;
 #endif
+  ON_CurveArcLengthTable* table = m_arclength_table;
+  m_arclength_table = 0;
+  m_arclength_lock = 0;
+  if ( 0 != table && bDelete )
+  {
+    delete table;
+  }
 }
 
 
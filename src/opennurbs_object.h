@@ -150,6 +150,11 @@ public:
   //   base class id
   const ON_ClassId* BaseClass() const;
 
+  // Returns:
+  //   next class id in the list of class ids or NULL
+  //   if this is the last class id.
+  const ON_ClassId* NextClassId() const;
+
   // Description:
   //   Determine if the class associated with this ON_ClassId
   //   is derived from another class.
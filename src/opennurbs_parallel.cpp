@@ -0,0 +1,136 @@
+/* $NoKeywords: $ */
+/*
+//
+// Copyright (c) 1993-2007 Robert McNeel & Associates. All rights reserved.
+// Rhinoceros is a registered trademark of Robert McNeel & Assoicates.
+//
+// THIS SOFTWARE IS PROVIDED "AS IS" WITHOUT EXPRESS OR IMPLIED WARRANTY.
+// ALL IMPLIED WARRANTIES OF FITNESS FOR ANY PARTICULAR PURPOSE AND OF
+// MERCHANTABILITY ARE HEREBY DISCLAIMED.
+//				
+// For complete openNURBS copyright information see <http://www.opennurbs.org>.
+//
+////////////////////////////////////////////////////////////////
+*/
+
+#include "opennurbs.h"
+
+#if defined(ON_THREAD_SUPPORT) && !defined(ON_COMPILER_MSC)
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+int ON_ProcessorCount()
+{
+  int count = 1;
+#if defined(ON_THREAD_SUPPORT)
+#if defined(ON_COMPILER_MSC)
+  SYSTEM_INFO system_info;
+  memset(&system_info,0,sizeof(system_info));
+  GetSystemInfo(&system_info);
+  count = (int)system_info.dwNumberOfProcessors;
+#elif defined(_SC_NPROCESSORS_ONLN)
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  if ( n > 0 && n < 4096 )
+    count = (int)n;
+#endif
+#endif
+  return (count > 0) ? count : 1;
+}
+
+struct ON_ParallelForContext
+{
+  int m_count;
+  int m_next; // index of the most recently started task
+  void (*m_task)(void*,int);
+  void* m_context;
+};
+
+static void ON_ParallelForWorker( struct ON_ParallelForContext* pfc )
+{
+  int i;
+  while ( (i = ON_ATOMIC_INCREMENT(&pfc->m_next)) < pfc->m_count )
+  {
+    pfc->m_task(pfc->m_context,i);
+  }
+}
+
+#if defined(ON_THREAD_SUPPORT)
+#if defined(ON_COMPILER_MSC)
+static DWORD WINAPI ON_ParallelForThread( LPVOID p )
+{
+  ON_ParallelForWorker((struct ON_ParallelForContext*)p);
+  return 0;
+}
+#else
+static void* ON_ParallelForThread( void* p )
+{
+  ON_ParallelForWorker((struct ON_ParallelForContext*)p);
+  return 0;
+}
+#endif
+#endif
+
+void ON_ParallelFor( 
+        int thread_count,
+        int count,
+        void (*task)(void* context, int i),
+        void* context
+        )
+{
+  if ( count <= 0 || 0 == task )
+    return;
+
+  struct ON_ParallelForContext pfc;
+  pfc.m_count = count;
+  pfc.m_next = -1;
+  pfc.m_task = task;
+  pfc.m_context = context;
+
+  if ( thread_count <= 0 )
+    thread_count = ON_ProcessorCount();
+  if ( thread_count > count )
+    thread_count = count;
+  if ( thread_count > 64 )
+    thread_count = 64;
+
+#if defined(ON_THREAD_SUPPORT)
+  if ( thread_count > 1 )
+  {
+    // Start thread_count-1 helper threads. If a thread cannot be
+    // created, the threads that did start do all the work.
+    int i, started = 0;
+#if defined(ON_COMPILER_MSC)
+    HANDLE thread[64];
+    for ( i = 1; i < thread_count; i++ )
+    {
+      thread[started] = CreateThread(0,0,ON_ParallelForThread,&pfc,0,0);
+      if ( 0 == thread[started] )
+        break;
+      started++;
+    }
+    ON_ParallelForWorker(&pfc);
+    if ( started > 0 )
+    {
+      WaitForMultipleObjects((DWORD)started,thread,TRUE,INFINITE);
+      for ( i = 0; i < started; i++ )
+        CloseHandle(thread[i]);
+    }
+#else
+    pthread_t thread[64];
+    for ( i = 1; i < thread_count; i++ )
+    {
+      if ( 0 != pthread_create(&thread[started],0,ON_ParallelForThread,&pfc) )
+        break;
+      started++;
+    }
+    ON_ParallelForWorker(&pfc);
+    for ( i = 0; i < started; i++ )
+      pthread_join(thread[i],0);
+#endif
+    return;
+  }
+#endif
+
+  ON_ParallelForWorker(&pfc);
+}
@@ -0,0 +1,59 @@
+/* $NoKeywords: $ */
+/*
+//
+// Copyright (c) 1993-2007 Robert McNeel & Associates. All rights reserved.
+// Rhinoceros is a registered trademark of Robert McNeel & Assoicates.
+//
+// THIS SOFTWARE IS PROVIDED "AS IS" WITHOUT EXPRESS OR IMPLIED WARRANTY.
+// ALL IMPLIED WARRANTIES OF FITNESS FOR ANY PARTICULAR PURPOSE AND OF
+// MERCHANTABILITY ARE HEREBY DISCLAIMED.
+//				
+// For complete openNURBS copyright information see <http://www.opennurbs.org>.
+//
+////////////////////////////////////////////////////////////////
+*/
+
+#if !defined(OPENNURBS_PARALLEL_INC_)
+#define OPENNURBS_PARALLEL_INC_
+
+/*
+Returns:
+  Number of processors available to this process. 
+  The returned value is always >= 1.
+*/
+ON_DECL
+int ON_ProcessorCount();
+
+/*
+Description:
+  Calls task(context,i) for i = 0, ..., count-1 using up 
+  to thread_count threads.  The calling thread is one of
+  the threads and ON_ParallelFor() returns after every
+  task has finished.
+Parameters:
+  thread_count - [in]
+    Maximum number of threads to use. If thread_count <= 0,
+    ON_ProcessorCount() threads are used. If thread_count
+    is 1, the tasks are run in the calling thread.
+  count - [in]
+    number of tasks
+  task - [in]
+    function to call
+  context - [in]
+    passed to task
+Remarks:
+  Tasks are started in increasing index order, but they 
+  may finish in any order and task() must be safe to call 
+  from several threads at once.  If ON_THREAD_SUPPORT is not
+  defined in opennurbs_system.h, or threads cannot be created,
+  the tasks are run in the calling thread.
+*/
+ON_DECL
+void ON_ParallelFor( 
+        int thread_count,
+        int count,
+        void (*task)(void* context, int i),
+        void* context
+        );
+
+#endif
@@ -217,10 +217,14 @@ ON_BOOL32 ON_PointCloud::Transform(
        )
 {
   TransformUserData(xform);
-  ON_BOOL32 rc = m_P.Transform(xform);
+  // transform the points and get the new box in one pass
+  const int count = m_P.Count();
+  ON_BOOL32 rc = ON_TransformPointList( 3, false, count, 3, (count > 0) ? &m_P.Array()->x : 0, 
+                                        xform, m_bbox, false );
   if (rc && HasPlane() )
     rc = m_plane.Transform(xform);
-  m_bbox.Destroy();
+  if ( !rc )
+    m_bbox.Destroy();
   return rc;
 }
 
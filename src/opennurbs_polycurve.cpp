@@ -18,17 +18,18 @@
 ON_OBJECT_IMPLEMENT(ON_PolyCurve,ON_Curve,"4ED7D4E0-E947-11d3-BFE5-0010830122F0");
 
 ON_PolyCurve::ON_PolyCurve()
+              : m_compiled(0), m_compiled_lock(0)
 {
 }
 
 ON_PolyCurve::ON_PolyCurve( int capacity )
-              : m_segment(capacity), m_t(capacity+1)
+              : m_segment(capacity), m_t(capacity+1), m_compiled(0), m_compiled_lock(0)
 {
   m_segment.Zero();
 }
 
 ON_PolyCurve::ON_PolyCurve( const ON_PolyCurve& src )
-              : m_segment(src.Count()), m_t(src.Count()+1)
+              : m_segment(src.Count()), m_t(src.Count()+1), m_compiled(0), m_compiled_lock(0)
 {
   *this = src;
 }
@@ -36,6 +37,7 @@ ON_PolyCurve::ON_PolyCurve( const ON_PolyCurve& src )
 void ON_PolyCurve::Destroy()
 {
   // release memory
+  DestroyRuntimeCache();
   m_segment.Destroy();
   m_t.Destroy();
 }
@@ -49,11 +51,18 @@ void ON_PolyCurve::EmergencyDestroy()
 {
   m_segment.EmergencyDestroy();
   m_t.EmergencyDestroy();
+  m_compiled = 0;
+  m_compiled_lock = 0;
 }
 
 void ON_PolyCurve::DestroyRuntimeCache( bool bDelete )
 {
   ON_Curve::DestroyRuntimeCache(bDelete);
+  ON_CompiledPolyCurve* compiled = m_compiled;
+  m_compiled = 0;
+  m_compiled_lock = 0;
+  if ( 0 != compiled && bDelete )
+    delete compiled;
   int i, count = m_segment.Count();
   for ( i = 0; i < count; i++ )
   {
@@ -498,6 +507,7 @@ bool ON_PolyCurve::ChangeDimension( int desired_dimension )
 {
   int i, count = m_segment.Count();
   bool rc = (count>0);
+  DestroyRuntimeCache();
   for ( i = 0; i < count; i++ )
   {
     ON_Curve* curve = m_segment[i];
@@ -530,6 +540,7 @@ bool ON_PolyCurve::SetParameterization( const double* t )
       m_t.Reserve(count);
       m_t.SetCount(0);
       m_t.Append( count, t );
+      DestroyRuntimeCache();
       rc = true;
     }
   }
@@ -1814,6 +1825,7 @@ ON_BOOL32 ON_PolyCurve::Remove( int segment_index )
   ON_BOOL32 rc = false;
   const int segment_count = Count();
   if ( segment_index >= 0 && segment_index < segment_count ) {
+    DestroyRuntimeCache();
     delete m_segment[segment_index];
     m_segment[segment_index] = 0;
     m_segment.Remove(segment_index);
@@ -1845,6 +1857,7 @@ ON_BOOL32 ON_PolyCurve::Insert( int segment_index, ON_Curve* c )
   if ( segment_index >= 0 && segment_index <= count && c && c != this && c->GetDomain(&s0,&s1) ) 
   {
     rc = true;
+    DestroyRuntimeCache();
     m_segment.Insert( segment_index, c );
 
     // determine polycurve parameters for this segment
@@ -2503,6 +2516,7 @@ ON_Curve* ON_PolyCurve::HarvestSegment( int i )
 {
   ON_Curve* segment_curve = 0;
   if ( i >= 0 && i < m_segment.Count() ) {
+    DestroyRuntimeCache();
     segment_curve = m_segment[i];
     m_segment[i] = 0;
   }
@@ -3210,6 +3224,8 @@ bool ON_PolyCurve::SynchronizeSegmentDomains()
      rc = true; // indicates a change was made
     }
   }
+  if ( rc )
+    DestroyRuntimeCache();
   return rc;
 }
 
@@ -3225,6 +3241,7 @@ bool ON_PolyCurve::RemoveNestingEx( )
   bool rc = false;
 	int n = Count();
 
+	DestroyRuntimeCache();
 	ON_SimpleArray<double> old_t = m_t;
 	ON_SimpleArray<ON_Curve*> old_seg = m_segment;
 
@@ -3264,8 +3281,10 @@ bool ON_PolyCurve::IsNested() const
 
 //   Sets the m_segment[index] to crv. 
 void ON_PolyCurve::SetSegment(int i, ON_Curve* crv){
-	if(i>=0 && i<Count())
+	if(i>=0 && i<Count()){
+		DestroyRuntimeCache();
 		m_segment[i] = crv;
+	}
 }
 
 // returns true if t is sufficiently close to m_t[index]
@@ -3282,3 +3301,446 @@ const ON_SimpleArray<double>& ON_PolyCurve::SegmentParameters() const
 {
   return m_t;
 }
+
+const ON_CompiledPolyCurve* ON_PolyCurve::CompiledCurve() const
+{
+  // m_compiled_lock is 0 when there is no compiled curve, 1 while
+  // a thread is compiling and 2 after compiling is finished
+  // (m_compiled is null if the polycurve cannot be compiled).
+  ON_PolyCurve* polycurve = const_cast<ON_PolyCurve*>(this);
+  for(;;)
+  {
+    const int lock = ON_ATOMIC_COMPARE_AND_SWAP(&polycurve->m_compiled_lock,0,1);
+    if ( 2 == lock )
+      return m_compiled;
+    if ( 0 == lock )
+      break;
+    // Another thread is compiling.
+  }
+
+  ON_CompiledPolyCurve* compiled = new ON_CompiledPolyCurve();
+  if ( !compiled->Create(*this) )
+  {
+    delete compiled;
+    compiled = 0;
+  }
+  polycurve->m_compiled = compiled;
+  ON_ATOMIC_COMPARE_AND_SWAP(&polycurve->m_compiled_lock,1,2);
+  return compiled;
+}
+
+// ON_CompiledPolyCurve span types
+//
+// polynomial:  m_coef[] = tm, order Taylor coefficients of dimension m_dim
+// rational:    m_coef[] = tm, order homogeneous Taylor coefficients of dimension m_dim+1
+// arc:         m_coef[] = tm, angle at tm, d(angle)/dt, center, radius*xaxis, radius*yaxis
+// curve:       m_coef[] = m0, m1 where t = m0 + m1*(segment curve parameter)
+#define ON_COMPILED_POLYNOMIAL_SPAN 1
+#define ON_COMPILED_RATIONAL_SPAN 2
+#define ON_COMPILED_ARC_SPAN 3
+#define ON_COMPILED_CURVE_SPAN 4
+
+ON_CompiledPolyCurve::ON_CompiledPolyCurve()
+: m_dim(0)
+{}
+
+ON_CompiledPolyCurve::~ON_CompiledPolyCurve()
+{}
+
+void ON_CompiledPolyCurve::Destroy()
+{
+  m_dim = 0;
+  m_t.Destroy();
+  m_span.Destroy();
+  m_coef.Destroy();
+  m_curve.Destroy();
+}
+
+int ON_CompiledPolyCurve::Dimension() const
+{
+  return m_dim;
+}
+
+ON_Interval ON_CompiledPolyCurve::Domain() const
+{
+  return (m_t.Count() > 1) 
+         ? ON_Interval(m_t[0],*m_t.Last()) 
+         : ON_Interval(ON_UNSET_VALUE,ON_UNSET_VALUE);
+}
+
+int ON_CompiledPolyCurve::SpanCount() const
+{
+  return (m_t.Count() > 1) ? (m_t.Count()-1) : 0;
+}
+
+int ON_CompiledPolyCurve::CurveSpanCount() const
+{
+  return m_curve.Count();
+}
+
+ON_Interval ON_CompiledPolyCurve::SpanDomain( int span_index ) const
+{
+  return ( span_index >= 0 && span_index < SpanCount() )
+         ? ON_Interval(m_t[span_index],m_t[span_index+1])
+         : ON_Interval(ON_UNSET_VALUE,ON_UNSET_VALUE);
+}
+
+bool ON_CompiledPolyCurve::AddSpan( int type, int order, double t0, double t1, int curve_index )
+{
+  // Pieces are added in increasing order.  Pieces that are 
+  // empty after they are mapped to the polycurve are skipped.
+  const double t = (t0 < t1) ? t1 : t0;
+  if ( !(t > *m_t.Last()) )
+    return false;
+  m_t.Append(t);
+  m_span.Append(type);
+  m_span.Append(order);
+  m_span.Append(m_coef.Count());
+  m_span.Append(curve_index);
+  return true;
+}
+
+bool ON_CompiledPolyCurve::AppendCurve( 
+  const ON_Curve& curve, 
+  double s0, double s1,
+  double m0, double m1,
+  int depth 
+  )
+{
+  // Appends the part of curve from s0 to s1.  The polycurve 
+  // parameter is t = m0 + m1*s.  When m1 < 0, the curve is
+  // reversed and its pieces are added from s1 to s0.
+  if ( depth > 32 || !(m1 != 0.0) )
+    return false;
+  if ( !(s0 < s1) )
+    return true;
+  if ( curve.Dimension() != m_dim )
+    return false;
+  const bool bReversed = (m1 < 0.0);
+  const int dim = m_dim;
+  int i, j, k, n;
+
+  const ON_PolyCurve* polycurve = ON_PolyCurve::Cast(&curve);
+  if ( polycurve )
+  {
+    const ON_SimpleArray<double>& pt = polycurve->SegmentParameters();
+    const int count = polycurve->Count();
+    if ( pt.Count() != count+1 )
+      return false;
+    for ( k = 0; k < count; k++ )
+    {
+      i = bReversed ? (count-1-k) : k;
+      const double a = pt[i];
+      const double b = pt[i+1];
+      if ( !(a < s1 && b > s0) )
+        continue;
+      const ON_Curve* segment = polycurve->SegmentCurve(i);
+      if ( 0 == segment )
+        return false;
+      const ON_Interval sd = segment->Domain();
+      if ( !sd.IsIncreasing() || !(a < b) )
+        return false;
+      // polycurve parameter = a + (segment parameter - sd[0])*r
+      const double r = (b-a)/sd.Length();
+      const double q0 = (a < s0) ? (sd[0] + (s0-a)/r) : sd[0];
+      const double q1 = (b > s1) ? (sd[0] + (s1-a)/r) : sd[1];
+      if ( !AppendCurve( *segment, q0, q1, m0 + m1*(a - sd[0]*r), m1*r, depth+1 ) )
+        return false;
+    }
+    return true;
+  }
+
+  const ON_CurveProxy* proxy = ON_CurveProxy::Cast(&curve);
+  if ( proxy && proxy->ProxyCurve() )
+  {
+    const ON_Interval pd = proxy->Domain();
+    const ON_Interval rd = proxy->ProxyCurveDomain();
+    if ( !pd.IsIncreasing() || !rd.IsIncreasing() )
+      return false;
+    // proxy parameter = c0 + c1*(real curve parameter)
+    const double r = pd.Length()/rd.Length();
+    double c0, c1, r0, r1;
+    if ( proxy->ProxyCurveIsReversed() )
+    {
+      c0 = pd[0] + rd[1]*r;
+      c1 = -r;
+      r0 = rd[1] - (s1 - pd[0])/r;
+      r1 = rd[1] - (s0 - pd[0])/r;
+    }
+    else
+    {
+      c0 = pd[0] - rd[0]*r;
+      c1 = r;
+      r0 = rd[0] + (s0 - pd[0])/r;
+      r1 = rd[0] + (s1 - pd[0])/r;
+    }
+    return AppendCurve( *proxy->ProxyCurve(), r0, r1, m0 + m1*c0, m1*c1, depth+1 );
+  }
+
+  const ON_NurbsCurve* nurbs_curve = ON_NurbsCurve::Cast(&curve);
+  if ( nurbs_curve )
+  {
+    const int order = nurbs_curve->m_order;
+    const int cvdim = nurbs_curve->CVSize();
+    const int span_count = nurbs_curve->m_cv_count - order + 1;
+    const int type = nurbs_curve->m_is_rat ? ON_COMPILED_RATIONAL_SPAN : ON_COMPILED_POLYNOMIAL_SPAN;
+    if ( order < 2 || span_count < 1 || 0 == nurbs_curve->m_knot || 0 == nurbs_curve->m_cv )
+      return false;
+    for ( k = 0; k < span_count; k++ )
+    {
+      i = bReversed ? (span_count-1-k) : k;
+      const double* knot = nurbs_curve->m_knot + i;
+      const double ka = knot[order-2];
+      const double kb = knot[order-1];
+      if ( !(ka < kb) || !(ka < s1 && kb > s0) )
+        continue;
+      const double a = (ka < s0) ? s0 : ka;
+      const double b = (kb > s1) ? s1 : kb;
+      if ( !AddSpan( type, order, m0 + m1*a, m0 + m1*b, -1 ) )
+        continue;
+      const double sm = 0.5*(a+b);
+      n = m_coef.Count();
+      m_coef.Reserve(n + 1 + order*cvdim);
+      m_coef.SetCount(n + 1 + order*cvdim);
+      double* c = m_coef.Array() + n;
+      c[0] = m0 + m1*sm;
+      c++;
+      if ( !ON_GetNurbsSpanTaylorCoefficients( cvdim, order, knot, 
+                                               nurbs_curve->m_cv_stride, nurbs_curve->m_cv + i*nurbs_curve->m_cv_stride,
+                                               sm, c ) )
+        return false;
+      // chain rule for the change of parameter
+      double d = 1.0;
+      for ( j = 1; j < order; j++ )
+      {
+        d /= m1;
+        c += cvdim;
+        for ( n = 0; n < cvdim; n++ )
+          c[n] *= d;
+      }
+    }
+    return true;
+  }
+
+  const ON_LineCurve* line_curve = ON_LineCurve::Cast(&curve);
+  const ON_PolylineCurve* polyline_curve = ON_PolylineCurve::Cast(&curve);
+  if ( line_curve || polyline_curve )
+  {
+    const int count = line_curve ? 1 : (polyline_curve->m_pline.Count()-1);
+    if ( polyline_curve && polyline_curve->m_t.Count() != count+1 )
+      return false;
+    for ( k = 0; k < count; k++ )
+    {
+      i = bReversed ? (count-1-k) : k;
+      const double a = line_curve ? line_curve->m_t[0] : polyline_curve->m_t[i];
+      const double b = line_curve ? line_curve->m_t[1] : polyline_curve->m_t[i+1];
+      if ( !(a < b) || !(a < s1 && b > s0) )
+        continue;
+      const ON_3dPoint P0 = line_curve ? line_curve->m_line.from : polyline_curve->m_pline[i];
+      const ON_3dPoint P1 = line_curve ? line_curve->m_line.to : polyline_curve->m_pline[i+1];
+      const double sa = (a < s0) ? s0 : a;
+      const double sb = (b > s1) ? s1 : b;
+      if ( !AddSpan( ON_COMPILED_POLYNOMIAL_SPAN, 2, m0 + m1*sa, m0 + m1*sb, -1 ) )
+        continue;
+      const double sm = 0.5*(sa+sb);
+      const double u = (sm - a)/(b - a);
+      const ON_3dPoint P = (1.0-u)*P0 + u*P1;
+      const ON_3dVector D = (P1 - P0)/((b - a)*m1);
+      m_coef.Append(m0 + m1*sm);
+      m_coef.Append(dim,&P.x);
+      m_coef.Append(dim,&D.x);
+    }
+    return true;
+  }
+
+  const ON_ArcCurve* arc_curve = ON_ArcCurve::Cast(&curve);
+  if ( arc_curve )
+  {
+    const ON_Interval ad = arc_curve->m_arc.DomainRadians();
+    const ON_Interval d = arc_curve->m_t;
+    if ( !d.IsIncreasing() )
+      return false;
+    const double a = (d[0] < s0) ? s0 : d[0];
+    const double b = (d[1] > s1) ? s1 : d[1];
+    if ( a < b && AddSpan( ON_COMPILED_ARC_SPAN, 0, m0 + m1*a, m0 + m1*b, -1 ) )
+    {
+      const double sm = 0.5*(a+b);
+      const ON_Plane& plane = arc_curve->m_arc.plane;
+      const double radius = arc_curve->m_arc.radius;
+      const ON_3dVector X = radius*plane.xaxis;
+      const ON_3dVector Y = radius*plane.yaxis;
+      m_coef.Append(m0 + m1*sm);
+      m_coef.Append(ad.ParameterAt(d.NormalizedParameterAt(sm)));
+      m_coef.Append(ad.Length()/(d.Length()*m1));
+      m_coef.Append(3,&plane.origin.x);
+      m_coef.Append(3,&X.x);
+      m_coef.Append(3,&Y.x);
+    }
+    return true;
+  }
+
+  // evaluated with ON_Curve::Evaluate()
+  if ( AddSpan( ON_COMPILED_CURVE_SPAN, 0, m0 + m1*s0, m0 + m1*s1, m_curve.Count() ) )
+  {
+    m_coef.Append(m0);
+    m_coef.Append(m1);
+    m_curve.Append(&curve);
+  }
+  return true;
+}
+
+bool ON_CompiledPolyCurve::Create( const ON_PolyCurve& polycurve )
+{
+  Destroy();
+  const ON_Interval domain = polycurve.Domain();
+  m_dim = polycurve.Dimension();
+  if ( m_dim < 1 || !domain.IsIncreasing() )
+  {
+    Destroy();
+    return false;
+  }
+
+  m_t.Reserve(polycurve.SpanCount()+1);
+  m_span.Reserve(4*polycurve.SpanCount());
+  m_t.Append(domain[0]);
+  if ( !AppendCurve( polycurve, domain[0], domain[1], 0.0, 1.0, 0 ) || m_t.Count() < 2 )
+  {
+    Destroy();
+    return false;
+  }
+  *m_t.Last() = domain[1];
+  return true;
+}
+
+bool ON_CompiledPolyCurve::Evaluate(
+  double t,
+  int der_count,
+  int v_stride,
+  double* v,
+  int side,
+  int* hint
+  ) const
+{
+  const int span_count = SpanCount();
+  if ( span_count < 1 || der_count < 0 || v_stride < m_dim || 0 == v )
+    return false;
+
+  const int i = ON_NurbsSpanIndex( 2, span_count+1, m_t.Array(), t, side, (hint) ? *hint : 0 );
+  if ( hint )
+    *hint = i;
+
+  const int* span = m_span.Array() + 4*i;
+  const double* c = m_coef.Array() + span[2];
+  const int dim = m_dim;
+  int j, k;
+
+  switch( span[0] )
+  {
+  case ON_COMPILED_POLYNOMIAL_SPAN:
+    return ON_EvaluateTaylorPolynomial( dim, span[1], dim, c+1, der_count, t - c[0], v_stride, v );
+
+  case ON_COMPILED_RATIONAL_SPAN:
+    {
+      const int cvdim = dim+1;
+      const int hv_count = (der_count+1)*cvdim;
+      double stack_hv[64];
+      double* hv = ( hv_count <= 64 ) ? stack_hv : (double*)onmalloc(hv_count*sizeof(hv[0]));
+      bool rc =    ON_EvaluateTaylorPolynomial( cvdim, span[1], cvdim, c+1, der_count, t - c[0], cvdim, hv )
+                && ON_EvaluateQuotientRule( dim, der_count, cvdim, hv );
+      if ( rc )
+      {
+        for ( k = 0; k <= der_count; k++ )
+          memcpy( v + k*v_stride, hv + k*cvdim, dim*sizeof(v[0]) );
+      }
+      if ( hv != stack_hv )
+        onfree(hv);
+      return rc;
+    }
+
+  case ON_COMPILED_ARC_SPAN:
+    {
+      // P = center + cos(a)*X + sin(a)*Y, a = c[1] + c[2]*(t - c[0])
+      const double a = c[1] + c[2]*(t - c[0]);
+      double x = cos(a);
+      double y = sin(a);
+      double scale = 1.0;
+      for ( k = 0; k <= der_count; k++ )
+      {
+        for ( j = 0; j < dim; j++ )
+          v[j] = scale*(x*c[6+j] + y*c[9+j]);
+        if ( 0 == k )
+        {
+          for ( j = 0; j < dim; j++ )
+            v[j] += c[3+j];
+        }
+        // derivative of (cos,sin) is (-sin,cos)
+        const double z = x;
+        x = -y;
+        y = z;
+        scale *= c[2];
+        v += v_stride;
+      }
+      return true;
+    }
+
+  case ON_COMPILED_CURVE_SPAN:
+    {
+      const ON_Curve* curve = m_curve[span[3]];
+      const double r = 1.0/c[1];
+      if ( r < 0.0 )
+        side = -side;
+      if ( -1 == side )
+        side = -2;
+      else if ( 1 == side )
+        side = 2;
+      if ( !curve->Evaluate( (t - c[0])*r, der_count, v_stride, v, side ) )
+        return false;
+      double scale = 1.0;
+      for ( k = 1; k <= der_count; k++ )
+      {
+        scale *= r;
+        v += v_stride;
+        for ( j = 0; j < dim; j++ )
+          v[j] *= scale;
+      }
+      return true;
+    }
+  }
+
+  return false;
+}
+
+ON_3dPoint ON_CompiledPolyCurve::PointAt( double t ) const
+{
+  double v[3] = {0.0,0.0,0.0};
+  if ( m_dim > 3 || !Evaluate( t, 0, 3, v ) )
+    return ON_3dPoint::UnsetPoint;
+  return ON_3dPoint(v);
+}
+
+ON_3dVector ON_CompiledPolyCurve::DerivativeAt( double t ) const
+{
+  double v[6] = {0.0,0.0,0.0,0.0,0.0,0.0};
+  if ( m_dim > 3 || !Evaluate( t, 1, 3, v ) )
+    return ON_3dVector::UnsetVector;
+  return ON_3dVector(v+3);
+}
+
+bool ON_CompiledPolyCurve::PointsAt( 
+  int count, 
+  const double* t, 
+  ON_3dPoint* points 
+  ) const
+{
+  if ( count < 0 || m_dim > 3 || (count > 0 && (0 == t || 0 == points)) )
+    return false;
+  int i, hint = 0;
+  for ( i = 0; i < count; i++ )
+  {
+    double v[3] = {0.0,0.0,0.0};
+    if ( !Evaluate( t[i], 0, 3, v, 0, &hint ) )
+      return false;
+    points[i].Set(v[0],v[1],v[2]);
+  }
+  return true;
+}
@@ -34,6 +34,7 @@
 	is mapped to 	m_t[i] and m_segment[i].Domain()[1] is mapped to m_t[i+1]. 
 */
 class ON_PolyCurve;
+class ON_CompiledPolyCurve;
 class ON_CLASS ON_PolyCurve : public ON_Curve
 {
   ON_OBJECT_DECLARE(ON_PolyCurve)
@@ -900,6 +901,25 @@ public:
   */
   const ON_SimpleArray<double>& SegmentParameters() const;
 
+  /*
+  Description:
+    Get a flattened copy of the polycurve that evaluates 
+    without virtual function calls.
+  Returns:
+    Pointer to the compiled curve or NULL if the polycurve 
+    is not valid.
+  Remarks:
+    The compiled curve is made the first time it is needed and
+    is deleted by DestroyRuntimeCache().  The polycurve functions
+    that change segments or m_t[] call DestroyRuntimeCache().  If
+    you change a segment curve directly, call DestroyRuntimeCache().
+    Several threads may call CompiledCurve() on the same polycurve
+    at once.  The first thread compiles it and the others wait.
+  See Also:
+    ON_CompiledPolyCurve
+  */
+  const ON_CompiledPolyCurve* CompiledCurve() const;
+
   /////////////////////////////////////////////////////////////////
   // Implementation
 private:
@@ -912,6 +932,129 @@ private:
                              // and are contiguous to tolerance
 
   ON_SimpleArray<double> m_t; // ON_PolyCurve segment parameterizations
+
+  // Runtime only - ignored by Read()/Write()
+  ON_CompiledPolyCurve* volatile m_compiled;
+  volatile int m_compiled_lock;
+};
+
+/*
+Description:
+  An ON_CompiledPolyCurve is a flattened copy of an ON_PolyCurve.
+  Nested polycurves and curve proxies are expanded, and line,
+  polyline, arc and NURBS segments are converted into spans whose
+  coefficients are in one array and are expressed in terms of the
+  polycurve's parameter.  Evaluation is a binary search in the
+  span parameters followed by a Horner evaluation of the span's
+  Taylor polynomial, or a sine and cosine for arcs.  Segments of
+  any other type are evaluated through their virtual Evaluate().
+Remarks:
+  Use ON_PolyCurve::CompiledCurve() to get a compiled curve that
+  is cached on the polycurve.
+*/
+class ON_CLASS ON_CompiledPolyCurve
+{
+public:
+  ON_CompiledPolyCurve();
+  ~ON_CompiledPolyCurve();
+
+  /*
+  Description:
+    Compile a polycurve.
+  Parameters:
+    polycurve - [in]
+  Returns:
+    True if successful.
+  Remarks:
+    Segments that cannot be compiled are referenced, not copied,
+    so polycurve must exist while the compiled curve is used.
+  */
+  bool Create( const ON_PolyCurve& polycurve );
+
+  void Destroy();
+
+  int Dimension() const;
+
+  ON_Interval Domain() const;
+
+  /*
+  Returns:
+    Number of spans.
+  */
+  int SpanCount() const;
+
+  /*
+  Returns:
+    Number of spans that are evaluated by calling a segment
+    curve's Evaluate().
+  */
+  int CurveSpanCount() const;
+
+  /*
+  Parameters:
+    span_index - [in] 0 <= span_index < SpanCount()
+  Returns:
+    Polycurve domain of the span.
+  */
+  ON_Interval SpanDomain( int span_index ) const;
+
+  /*
+  Description:
+    Evaluate the compiled curve.
+  Parameters:
+    Same as ON_Curve::Evaluate().  The hint is the span index.
+  Returns:
+    True if successful.
+  */
+  bool Evaluate(
+    double t,
+    int der_count,
+    int v_stride,
+    double* v,
+    int side = 0,
+    int* hint = 0
+    ) const;
+
+  ON_3dPoint PointAt( double t ) const;
+
+  ON_3dVector DerivativeAt( double t ) const;
+
+  /*
+  Description:
+    Evaluate points at a list of parameters.
+  Parameters:
+    count - [in] number of parameters
+    t - [in] parameters
+    points - [out] points
+  Returns:
+    True if successful.
+  Remarks:
+    Increasing parameters are evaluated without searching.
+  */
+  bool PointsAt( 
+    int count, 
+    const double* t, 
+    ON_3dPoint* points 
+    ) const;
+
+private:
+  bool AppendCurve( 
+    const ON_Curve& curve, 
+    double s0, double s1,
+    double m0, double m1,
+    int depth 
+    );
+  bool AddSpan( 
+    int type, int order, 
+    double t0, double t1, 
+    int curve_index 
+    );
+
+  int m_dim;
+  ON_SimpleArray<double> m_t;     // m_t[i] = start of i-th span, m_t[SpanCount()] = end of domain
+  ON_SimpleArray<int> m_span;     // m_span[4*i],... = type, order, coefficient index, curve index
+  ON_SimpleArray<double> m_coef;  // span coefficients
+  ON_SimpleArray<const ON_Curve*> m_curve; // segments evaluated with ON_Curve::Evaluate()
 };
 
 
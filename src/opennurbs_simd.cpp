@@ -0,0 +1,697 @@
+/* $NoKeywords: $ */
+/*
+//
+// Copyright (c) 1993-2007 Robert McNeel & Associates. All rights reserved.
+// Rhinoceros is a registered trademark of Robert McNeel & Assoicates.
+//
+// THIS SOFTWARE IS PROVIDED "AS IS" WITHOUT EXPRESS OR IMPLIED WARRANTY.
+// ALL IMPLIED WARRANTIES OF FITNESS FOR ANY PARTICULAR PURPOSE AND OF
+// MERCHANTABILITY ARE HEREBY DISCLAIMED.
+//				
+// For complete openNURBS copyright information see <http://www.opennurbs.org>.
+//
+////////////////////////////////////////////////////////////////
+*/
+
+#include "opennurbs.h"
+
+/*
+ON_SSE2 is defined when SSE2 instructions are always available
+(every x64 processor has them). ON_AVX is defined when the 
+compiler can build AVX functions. The AVX functions are only 
+called after ON_SIMDLevel() has checked the processor.
+
+The kernels only use multiplies, adds and divides in the same 
+order as the portable loops, so every level gives bit for bit
+the same points and boxes.
+*/
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ON_SSE2
+#include <emmintrin.h>
+#if defined(ON_COMPILER_MSC1600)
+#define ON_AVX
+#define ON_AVX_FUNCTION
+#include <intrin.h>
+#include <immintrin.h>
+#elif defined(ON_COMPILER_GNU) && (defined(__clang__) || __GNUC__ > 4 || (4 == __GNUC__ && __GNUC_MINOR__ >= 9))
+#define ON_AVX
+#define ON_AVX_FUNCTION __attribute__((target("avx")))
+#include <immintrin.h>
+#endif
+#endif
+
+static int ON_SIMD_ProcessorLevel()
+{
+  int level = 0;
+#if defined(ON_SSE2)
+  level = 1;
+#if defined(ON_AVX)
+#if defined(ON_COMPILER_MSC)
+  int info[4];
+  __cpuid(info,1);
+  // AVX and OSXSAVE bits, then check the OS saves the ymm registers
+  if ( 0x18000000 == (info[2] & 0x18000000) && 6 == (_xgetbv(0) & 6) )
+    level = 2;
+#else
+  __builtin_cpu_init();
+  if ( __builtin_cpu_supports("avx") )
+    level = 2;
+#endif
+#endif
+#endif
+  return level;
+}
+
+static int ON_simd_level = -1;
+
+int ON_SIMDLevel()
+{
+  if ( ON_simd_level < 0 )
+    ON_simd_level = ON_SIMD_ProcessorLevel();
+  return ON_simd_level;
+}
+
+int ON_SetSIMDLevel( int level )
+{
+  const int processor_level = ON_SIMD_ProcessorLevel();
+  if ( level < 0 )
+    level = 0;
+  if ( level > processor_level )
+    level = processor_level;
+  ON_simd_level = level;
+  return level;
+}
+
+#if defined(ON_SSE2)
+
+// Lane k of lo[] and hi[] holds coordinate k%stride of some points.
+static void ON_SIMD_GrowBox( int dim, int stride, int lane_count, 
+                             const double* lo, const double* hi,
+                             double* boxmin, double* boxmax )
+{
+  int k, c;
+  for ( k = 0; k < lane_count; k++ )
+  {
+    c = k%stride;
+    if ( c < dim )
+    {
+      if ( boxmin[c] > lo[k] ) boxmin[c] = lo[k];
+      if ( boxmax[c] < hi[k] ) boxmax[c] = hi[k];
+    }
+  }
+}
+
+static void ON_SIMD_GrowBox( int dim, int stride, int lane_count, 
+                             const float* lo, const float* hi,
+                             double* boxmin, double* boxmax )
+{
+  int k, c;
+  for ( k = 0; k < lane_count; k++ )
+  {
+    c = k%stride;
+    if ( c < dim )
+    {
+      if ( boxmin[c] > lo[k] ) boxmin[c] = lo[k];
+      if ( boxmax[c] < hi[k] ) boxmax[c] = hi[k];
+    }
+  }
+}
+
+/*
+Zero tests written with < and > so the kernels compare exactly
+without tripping -Wfloat-equal.  A NaN counts as zero, which makes
+the kernels stop and leave that point to the scalar code.
+*/
+static inline bool ON_SIMD_IsZero( double x )
+{
+  return !(x < 0.0 || x > 0.0);
+}
+
+static bool ON_SIMD_IsAffine( const double m[4][4] )
+{
+  return ON_SIMD_IsZero(m[3][0]) && ON_SIMD_IsZero(m[3][1]) && ON_SIMD_IsZero(m[3][2])
+         && ON_SIMD_IsZero(m[3][3] - 1.0);
+}
+
+/*
+Non-rational bounding box kernels.  The points are read as a flat
+array in blocks of 6 vectors.  A block is a whole number of points
+for strides 1, 2, 3 and 4, so every lane always holds the same 
+coordinate and the min/max is taken lane by lane.  The min and
+max instructions return their second operand when the first one
+is a NaN, so NaN coordinates are skipped.
+*/
+static int ON_SIMD_BlockCount( int dim, int count, int stride, int block )
+{
+  // (count-1)*stride + dim values can be read
+  const size_t value_count = ((size_t)(count-1))*stride + dim;
+  return (int)(value_count/block);
+}
+
+static int ON_SIMD_BBox_SSE2( int dim, int count, int stride, const double* p,
+                              double* boxmin, double* boxmax )
+{
+  const int block = 12;
+  const int block_count = ON_SIMD_BlockCount(dim,count,stride,block);
+  if ( block_count <= 0 )
+    return 0;
+  __m128d lo0, lo1, lo2, lo3, lo4, lo5, hi0, hi1, hi2, hi3, hi4, hi5, v;
+  lo0 = lo1 = lo2 = lo3 = lo4 = lo5 = _mm_set1_pd(ON_DBL_PINF);
+  hi0 = hi1 = hi2 = hi3 = hi4 = hi5 = _mm_set1_pd(-ON_DBL_PINF);
+  int i;
+  for ( i = 0; i < block_count; i++, p += block )
+  {
+    v = _mm_loadu_pd(p);    lo0 = _mm_min_pd(v,lo0); hi0 = _mm_max_pd(v,hi0);
+    v = _mm_loadu_pd(p+2);  lo1 = _mm_min_pd(v,lo1); hi1 = _mm_max_pd(v,hi1);
+    v = _mm_loadu_pd(p+4);  lo2 = _mm_min_pd(v,lo2); hi2 = _mm_max_pd(v,hi2);
+    v = _mm_loadu_pd(p+6);  lo3 = _mm_min_pd(v,lo3); hi3 = _mm_max_pd(v,hi3);
+    v = _mm_loadu_pd(p+8);  lo4 = _mm_min_pd(v,lo4); hi4 = _mm_max_pd(v,hi4);
+    v = _mm_loadu_pd(p+10); lo5 = _mm_min_pd(v,lo5); hi5 = _mm_max_pd(v,hi5);
+  }
+  double lo[12], hi[12];
+  _mm_storeu_pd(lo,lo0); _mm_storeu_pd(lo+2,lo1); _mm_storeu_pd(lo+4,lo2);
+  _mm_storeu_pd(lo+6,lo3); _mm_storeu_pd(lo+8,lo4); _mm_storeu_pd(lo+10,lo5);
+  _mm_storeu_pd(hi,hi0); _mm_storeu_pd(hi+2,hi1); _mm_storeu_pd(hi+4,hi2);
+  _mm_storeu_pd(hi+6,hi3); _mm_storeu_pd(hi+8,hi4); _mm_storeu_pd(hi+10,hi5);
+  ON_SIMD_GrowBox(dim,stride,block,lo,hi,boxmin,boxmax);
+  return block_count*(block/stride);
+}
+
+static int ON_SIMD_BBox_SSE2( int dim, int count, int stride, const float* p,
+                              double* boxmin, double* boxmax )
+{
+  const int block = 24;
+  const int block_count = ON_SIMD_BlockCount(dim,count,stride,block);
+  if ( block_count <= 0 )
+    return 0;
+  __m128 lo0, lo1, lo2, lo3, lo4, lo5, hi0, hi1, hi2, hi3, hi4, hi5, v;
+  lo0 = lo1 = lo2 = lo3 = lo4 = lo5 = _mm_set1_ps((float)ON_DBL_PINF);
+  hi0 = hi1 = hi2 = hi3 = hi4 = hi5 = _mm_set1_ps((float)(-ON_DBL_PINF));
+  int i;
+  for ( i = 0; i < block_count; i++, p += block )
+  {
+    v = _mm_loadu_ps(p);    lo0 = _mm_min_ps(v,lo0); hi0 = _mm_max_ps(v,hi0);
+    v = _mm_loadu_ps(p+4);  lo1 = _mm_min_ps(v,lo1); hi1 = _mm_max_ps(v,hi1);
+    v = _mm_loadu_ps(p+8);  lo2 = _mm_min_ps(v,lo2); hi2 = _mm_max_ps(v,hi2);
+    v = _mm_loadu_ps(p+12); lo3 = _mm_min_ps(v,lo3); hi3 = _mm_max_ps(v,hi3);
+    v = _mm_loadu_ps(p+16); lo4 = _mm_min_ps(v,lo4); hi4 = _mm_max_ps(v,hi4);
+    v = _mm_loadu_ps(p+20); lo5 = _mm_min_ps(v,lo5); hi5 = _mm_max_ps(v,hi5);
+  }
+  float lo[24], hi[24];
+  _mm_storeu_ps(lo,lo0); _mm_storeu_ps(lo+4,lo1); _mm_storeu_ps(lo+8,lo2);
+  _mm_storeu_ps(lo+12,lo3); _mm_storeu_ps(lo+16,lo4); _mm_storeu_ps(lo+20,lo5);
+  _mm_storeu_ps(hi,hi0); _mm_storeu_ps(hi+4,hi1); _mm_storeu_ps(hi+8,hi2);
+  _mm_storeu_ps(hi+12,hi3); _mm_storeu_ps(hi+16,hi4); _mm_storeu_ps(hi+20,hi5);
+  ON_SIMD_GrowBox(dim,stride,block,lo,hi,boxmin,boxmax);
+  return block_count*(block/stride);
+}
+
+/*
+Homogeneous 3d points: the portable loops compute w = 1/w and
+then w*x, w*y and w*z.
+*/
+static int ON_SIMD_RatBBox_SSE2( int count, int stride, const double* p,
+                                 double* boxmin, double* boxmax )
+{
+  const __m128d one = _mm_set1_pd(1.0);
+  __m128d loxy, lozw, hixy, hizw, r, v;
+  loxy = lozw = _mm_set1_pd(ON_DBL_PINF);
+  hixy = hizw = _mm_set1_pd(-ON_DBL_PINF);
+  int i;
+  for ( i = 0; i < count; i++, p += stride )
+  {
+    if ( ON_SIMD_IsZero((double)p[3]) )
+      break;
+    r = _mm_div_pd(one,_mm_set1_pd(p[3]));
+    v = _mm_mul_pd(_mm_loadu_pd(p),r);   loxy = _mm_min_pd(v,loxy); hixy = _mm_max_pd(v,hixy);
+    v = _mm_mul_pd(_mm_loadu_pd(p+2),r); lozw = _mm_min_pd(v,lozw); hizw = _mm_max_pd(v,hizw);
+  }
+  double lo[4], hi[4];
+  _mm_storeu_pd(lo,loxy); _mm_storeu_pd(lo+2,lozw);
+  _mm_storeu_pd(hi,hixy); _mm_storeu_pd(hi+2,hizw);
+  ON_SIMD_GrowBox(3,4,4,lo,hi,boxmin,boxmax);
+  return i;
+}
+
+static int ON_SIMD_RatBBox_SSE2( int count, int stride, const float* p,
+                                 double* boxmin, double* boxmax )
+{
+  const __m128d one = _mm_set1_pd(1.0);
+  __m128d loxy, lozw, hixy, hizw, r, v;
+  __m128 f;
+  loxy = lozw = _mm_set1_pd(ON_DBL_PINF);
+  hixy = hizw = _mm_set1_pd(-ON_DBL_PINF);
+  int i;
+  for ( i = 0; i < count; i++, p += stride )
+  {
+    if ( ON_SIMD_IsZero((double)p[3]) )
+      break;
+    f = _mm_loadu_ps(p);
+    r = _mm_div_pd(one,_mm_set1_pd((double)p[3]));
+    v = _mm_mul_pd(_mm_cvtps_pd(f),r);               loxy = _mm_min_pd(v,loxy); hixy = _mm_max_pd(v,hixy);
+    v = _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(f,f)),r); lozw = _mm_min_pd(v,lozw); hizw = _mm_max_pd(v,hizw);
+  }
+  double lo[4], hi[4];
+  _mm_storeu_pd(lo,loxy); _mm_storeu_pd(lo+2,lozw);
+  _mm_storeu_pd(hi,hixy); _mm_storeu_pd(hi+2,hizw);
+  ON_SIMD_GrowBox(3,4,4,lo,hi,boxmin,boxmax);
+  return i;
+}
+
+/*
+Transform kernels. Each point is computed as 
+  column0*x + column1*y + column2*z + column3 (*w)
+which adds the products in the same order as the portable loops.
+*/
+static inline void ON_SIMD_Round_SSE2( const double*, __m128d&, __m128d& )
+{
+}
+
+static inline void ON_SIMD_Round_SSE2( const float*, __m128d& xy, __m128d& zw )
+{
+  // values the float points will have
+  xy = _mm_cvtps_pd(_mm_cvtpd_ps(xy));
+  zw = _mm_cvtps_pd(_mm_cvtpd_ps(zw));
+}
+
+static inline void ON_SIMD_Store_SSE2( double* q, int is_rat, __m128d xy, __m128d zw )
+{
+  _mm_storeu_pd(q,xy);
+  if ( is_rat )
+    _mm_storeu_pd(q+2,zw);
+  else
+    _mm_store_sd(q+2,zw);
+}
+
+static inline void ON_SIMD_Store_SSE2( float* q, int is_rat, __m128d xy, __m128d zw )
+{
+  const __m128 fxy = _mm_cvtpd_ps(xy);
+  const __m128 fzw = _mm_cvtpd_ps(zw);
+  if ( is_rat )
+    _mm_storeu_ps(q,_mm_movelh_ps(fxy,fzw));
+  else
+  {
+    _mm_storel_pi((__m64*)q,fxy);
+    _mm_store_ss(q+2,fzw);
+  }
+}
+
+template <class T>
+static int ON_SIMD_Xform_SSE2( int is_rat, int count, int stride, 
+                               const T* p, T* q, const ON_Xform& xform, 
+                               double* boxmin, double* boxmax )
+{
+  const double (*m)[4] = xform.m_xform;
+  const bool bAffine = !is_rat && ON_SIMD_IsAffine(m);
+  const __m128d c0xy = _mm_set_pd(m[1][0],m[0][0]), c0zw = _mm_set_pd(m[3][0],m[2][0]);
+  const __m128d c1xy = _mm_set_pd(m[1][1],m[0][1]), c1zw = _mm_set_pd(m[3][1],m[2][1]);
+  const __m128d c2xy = _mm_set_pd(m[1][2],m[0][2]), c2zw = _mm_set_pd(m[3][2],m[2][2]);
+  const __m128d c3xy = _mm_set_pd(m[1][3],m[0][3]), c3zw = _mm_set_pd(m[3][3],m[2][3]);
+  const __m128d one = _mm_set1_pd(1.0);
+  __m128d loxy, lozw, hixy, hizw, x, y, z, w, xy, zw;
+  double ww;
+  loxy = lozw = _mm_set1_pd(ON_DBL_PINF);
+  hixy = hizw = _mm_set1_pd(-ON_DBL_PINF);
+  int i;
+  for ( i = 0; i < count; i++, p += stride )
+  {
+    x = _mm_set1_pd((double)p[0]);
+    y = _mm_set1_pd((double)p[1]);
+    z = _mm_set1_pd((double)p[2]);
+    xy = _mm_add_pd(_mm_add_pd(_mm_mul_pd(c0xy,x),_mm_mul_pd(c1xy,y)),_mm_mul_pd(c2xy,z));
+    zw = _mm_add_pd(_mm_add_pd(_mm_mul_pd(c0zw,x),_mm_mul_pd(c1zw,y)),_mm_mul_pd(c2zw,z));
+    if ( is_rat )
+    {
+      w = _mm_set1_pd((double)p[3]);
+      xy = _mm_add_pd(xy,_mm_mul_pd(c3xy,w));
+      zw = _mm_add_pd(zw,_mm_mul_pd(c3zw,w));
+    }
+    else
+    {
+      xy = _mm_add_pd(xy,c3xy);
+      zw = _mm_add_pd(zw,c3zw);
+      if ( !bAffine )
+      {
+        ww = _mm_cvtsd_f64(_mm_unpackhi_pd(zw,zw));
+        if ( ON_SIMD_IsZero(ww) )
+          break;
+        w = _mm_div_pd(one,_mm_set1_pd(ww));
+        xy = _mm_mul_pd(w,xy);
+        zw = _mm_mul_pd(w,zw);
+      }
+    }
+
+    if ( q )
+      ON_SIMD_Round_SSE2(q,xy,zw);
+
+    if ( boxmin )
+    {
+      if ( is_rat )
+      {
+        ww = _mm_cvtsd_f64(_mm_unpackhi_pd(zw,zw));
+        if ( ON_SIMD_IsZero(ww) )
+          break;
+        w = _mm_div_pd(one,_mm_set1_pd(ww));
+        x = _mm_mul_pd(xy,w); loxy = _mm_min_pd(x,loxy); hixy = _mm_max_pd(x,hixy);
+        z = _mm_mul_pd(zw,w); lozw = _mm_min_pd(z,lozw); hizw = _mm_max_pd(z,hizw);
+      }
+      else
+      {
+        loxy = _mm_min_pd(xy,loxy); hixy = _mm_max_pd(xy,hixy);
+        lozw = _mm_min_pd(zw,lozw); hizw = _mm_max_pd(zw,hizw);
+      }
+    }
+
+    if ( q )
+    {
+      ON_SIMD_Store_SSE2(q,is_rat,xy,zw);
+      q += stride;
+    }
+  }
+
+  if ( boxmin && i > 0 )
+  {
+    double lo[4], hi[4];
+    _mm_storeu_pd(lo,loxy); _mm_storeu_pd(lo+2,lozw);
+    _mm_storeu_pd(hi,hixy); _mm_storeu_pd(hi+2,hizw);
+    ON_SIMD_GrowBox(3,4,4,lo,hi,boxmin,boxmax);
+  }
+  return i;
+}
+
+#if defined(ON_AVX)
+
+ON_AVX_FUNCTION
+static int ON_SIMD_BBox_AVX( int dim, int count, int stride, const double* p,
+                             double* boxmin, double* boxmax )
+{
+  const int block = 24;
+  const int block_count = ON_SIMD_BlockCount(dim,count,stride,block);
+  if ( block_count <= 0 )
+    return 0;
+  __m256d lo0, lo1, lo2, lo3, lo4, lo5, hi0, hi1, hi2, hi3, hi4, hi5, v;
+  lo0 = lo1 = lo2 = lo3 = lo4 = lo5 = _mm256_set1_pd(ON_DBL_PINF);
+  hi0 = hi1 = hi2 = hi3 = hi4 = hi5 = _mm256_set1_pd(-ON_DBL_PINF);
+  int i;
+  for ( i = 0; i < block_count; i++, p += block )
+  {
+    v = _mm256_loadu_pd(p);    lo0 = _mm256_min_pd(v,lo0); hi0 = _mm256_max_pd(v,hi0);
+    v = _mm256_loadu_pd(p+4);  lo1 = _mm256_min_pd(v,lo1); hi1 = _mm256_max_pd(v,hi1);
+    v = _mm256_loadu_pd(p+8);  lo2 = _mm256_min_pd(v,lo2); hi2 = _mm256_max_pd(v,hi2);
+    v = _mm256_loadu_pd(p+12); lo3 = _mm256_min_pd(v,lo3); hi3 = _mm256_max_pd(v,hi3);
+    v = _mm256_loadu_pd(p+16); lo4 = _mm256_min_pd(v,lo4); hi4 = _mm256_max_pd(v,hi4);
+    v = _mm256_loadu_pd(p+20); lo5 = _mm256_min_pd(v,lo5); hi5 = _mm256_max_pd(v,hi5);
+  }
+  double lo[24], hi[24];
+  _mm256_storeu_pd(lo,lo0); _mm256_storeu_pd(lo+4,lo1); _mm256_storeu_pd(lo+8,lo2);
+  _mm256_storeu_pd(lo+12,lo3); _mm256_storeu_pd(lo+16,lo4); _mm256_storeu_pd(lo+20,lo5);
+  _mm256_storeu_pd(hi,hi0); _mm256_storeu_pd(hi+4,hi1); _mm256_storeu_pd(hi+8,hi2);
+  _mm256_storeu_pd(hi+12,hi3); _mm256_storeu_pd(hi+16,hi4); _mm256_storeu_pd(hi+20,hi5);
+  _mm256_zeroupper();
+  ON_SIMD_GrowBox(dim,stride,block,lo,hi,boxmin,boxmax);
+  return block_count*(block/stride);
+}
+
+ON_AVX_FUNCTION
+static int ON_SIMD_BBox_AVX( int dim, int count, int stride, const float* p,
+                             double* boxmin, double* boxmax )
+{
+  const int block = 48;
+  const int block_count = ON_SIMD_BlockCount(dim,count,stride,block);
+  if ( block_count <= 0 )
+    return 0;
+  __m256 lo0, lo1, lo2, lo3, lo4, lo5, hi0, hi1, hi2, hi3, hi4, hi5, v;
+  lo0 = lo1 = lo2 = lo3 = lo4 = lo5 = _mm256_set1_ps((float)ON_DBL_PINF);
+  hi0 = hi1 = hi2 = hi3 = hi4 = hi5 = _mm256_set1_ps((float)(-ON_DBL_PINF));
+  int i;
+  for ( i = 0; i < block_count; i++, p += block )
+  {
+    v = _mm256_loadu_ps(p);    lo0 = _mm256_min_ps(v,lo0); hi0 = _mm256_max_ps(v,hi0);
+    v = _mm256_loadu_ps(p+8);  lo1 = _mm256_min_ps(v,lo1); hi1 = _mm256_max_ps(v,hi1);
+    v = _mm256_loadu_ps(p+16); lo2 = _mm256_min_ps(v,lo2); hi2 = _mm256_max_ps(v,hi2);
+    v = _mm256_loadu_ps(p+24); lo3 = _mm256_min_ps(v,lo3); hi3 = _mm256_max_ps(v,hi3);
+    v = _mm256_loadu_ps(p+32); lo4 = _mm256_min_ps(v,lo4); hi4 = _mm256_max_ps(v,hi4);
+    v = _mm256_loadu_ps(p+40); lo5 = _mm256_min_ps(v,lo5); hi5 = _mm256_max_ps(v,hi5);
+  }
+  float lo[48], hi[48];
+  _mm256_storeu_ps(lo,lo0); _mm256_storeu_ps(lo+8,lo1); _mm256_storeu_ps(lo+16,lo2);
+  _mm256_storeu_ps(lo+24,lo3); _mm256_storeu_ps(lo+32,lo4); _mm256_storeu_ps(lo+40,lo5);
+  _mm256_storeu_ps(hi,hi0); _mm256_storeu_ps(hi+8,hi1); _mm256_storeu_ps(hi+16,hi2);
+  _mm256_storeu_ps(hi+24,hi3); _mm256_storeu_ps(hi+32,hi4); _mm256_storeu_ps(hi+40,hi5);
+  _mm256_zeroupper();
+  ON_SIMD_GrowBox(dim,stride,block,lo,hi,boxmin,boxmax);
+  return block_count*(block/stride);
+}
+
+ON_AVX_FUNCTION
+static inline __m256d ON_SIMD_Load4_AVX( const double* p )
+{
+  return _mm256_loadu_pd(p);
+}
+
+ON_AVX_FUNCTION
+static inline __m256d ON_SIMD_Load4_AVX( const float* p )
+{
+  return _mm256_cvtps_pd(_mm_loadu_ps(p));
+}
+
+template <class T>
+ON_AVX_FUNCTION
+static int ON_SIMD_RatBBox_AVX( int count, int stride, const T* p,
+                                double* boxmin, double* boxmax )
+{
+  const __m256d one = _mm256_set1_pd(1.0);
+  __m256d lo, hi, v;
+  lo = _mm256_set1_pd(ON_DBL_PINF);
+  hi = _mm256_set1_pd(-ON_DBL_PINF);
+  int i;
+  for ( i = 0; i < count; i++, p += stride )
+  {
+    if ( ON_SIMD_IsZero((double)p[3]) )
+      break;
+    v = _mm256_mul_pd(ON_SIMD_Load4_AVX(p),_mm256_div_pd(one,_mm256_set1_pd((double)p[3])));
+    lo = _mm256_min_pd(v,lo); 
+    hi = _mm256_max_pd(v,hi);
+  }
+  double a[4], b[4];
+  _mm256_storeu_pd(a,lo);
+  _mm256_storeu_pd(b,hi);
+  _mm256_zeroupper();
+  ON_SIMD_GrowBox(3,4,4,a,b,boxmin,boxmax);
+  return i;
+}
+
+ON_AVX_FUNCTION
+static inline void ON_SIMD_Round_AVX( const double*, __m256d& )
+{
+}
+
+ON_AVX_FUNCTION
+static inline void ON_SIMD_Round_AVX( const float*, __m256d& v )
+{
+  v = _mm256_cvtps_pd(_mm256_cvtpd_ps(v));
+}
+
+ON_AVX_FUNCTION
+static inline void ON_SIMD_Store_AVX( double* q, int is_rat, __m256d v )
+{
+  if ( is_rat )
+    _mm256_storeu_pd(q,v);
+  else
+  {
+    _mm_storeu_pd(q,_mm256_castpd256_pd128(v));
+    _mm_store_sd(q+2,_mm256_extractf128_pd(v,1));
+  }
+}
+
+ON_AVX_FUNCTION
+static inline void ON_SIMD_Store_AVX( float* q, int is_rat, __m256d v )
+{
+  const __m128 f = _mm256_cvtpd_ps(v);
+  if ( is_rat )
+    _mm_storeu_ps(q,f);
+  else
+  {
+    _mm_storel_pi((__m64*)q,f);
+    _mm_store_ss(q+2,_mm_movehl_ps(f,f));
+  }
+}
+
+ON_AVX_FUNCTION
+static inline double ON_SIMD_W_AVX( __m256d v )
+{
+  const __m128d zw = _mm256_extractf128_pd(v,1);
+  return _mm_cvtsd_f64(_mm_unpackhi_pd(zw,zw));
+}
+
+template <class T>
+ON_AVX_FUNCTION
+static int ON_SIMD_Xform_AVX( int is_rat, int count, int stride, 
+                              const T* p, T* q, const ON_Xform& xform, 
+                              double* boxmin, double* boxmax )
+{
+  const double (*m)[4] = xform.m_xform;
+  const bool bAffine = !is_rat && ON_SIMD_IsAffine(m);
+  const __m256d c0 = _mm256_set_pd(m[3][0],m[2][0],m[1][0],m[0][0]);
+  const __m256d c1 = _mm256_set_pd(m[3][1],m[2][1],m[1][1],m[0][1]);
+  const __m256d c2 = _mm256_set_pd(m[3][2],m[2][2],m[1][2],m[0][2]);
+  const __m256d c3 = _mm256_set_pd(m[3][3],m[2][3],m[1][3],m[0][3]);
+  const __m256d one = _mm256_set1_pd(1.0);
+  __m256d lo, hi, v, b;
+  double w;
+  lo = _mm256_set1_pd(ON_DBL_PINF);
+  hi = _mm256_set1_pd(-ON_DBL_PINF);
+  int i;
+  for ( i = 0; i < count; i++, p += stride )
+  {
+    v = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(c0,_mm256_set1_pd((double)p[0])),
+                                    _mm256_mul_pd(c1,_mm256_set1_pd((double)p[1]))),
+                                    _mm256_mul_pd(c2,_mm256_set1_pd((double)p[2])));
+    if ( is_rat )
+      v = _mm256_add_pd(v,_mm256_mul_pd(c3,_mm256_set1_pd((double)p[3])));
+    else
+    {
+      v = _mm256_add_pd(v,c3);
+      if ( !bAffine )
+      {
+        w = ON_SIMD_W_AVX(v);
+        if ( ON_SIMD_IsZero(w) )
+          break;
+        v = _mm256_mul_pd(_mm256_div_pd(one,_mm256_set1_pd(w)),v);
+      }
+    }
+
+    if ( q )
+      ON_SIMD_Round_AVX(q,v);
+
+    if ( boxmin )
+    {
+      if ( is_rat )
+      {
+        w = ON_SIMD_W_AVX(v);
+        if ( ON_SIMD_IsZero(w) )
+          break;
+        b = _mm256_mul_pd(v,_mm256_div_pd(one,_mm256_set1_pd(w)));
+      }
+      else
+        b = v;
+      lo = _mm256_min_pd(b,lo);
+      hi = _mm256_max_pd(b,hi);
+    }
+
+    if ( q )
+    {
+      ON_SIMD_Store_AVX(q,is_rat,v);
+      q += stride;
+    }
+  }
+
+  double a[4], c[4];
+  _mm256_storeu_pd(a,lo);
+  _mm256_storeu_pd(c,hi);
+  _mm256_zeroupper();
+  if ( boxmin && i > 0 )
+    ON_SIMD_GrowBox(3,4,4,a,c,boxmin,boxmax);
+  return i;
+}
+
+#endif
+
+template <class T>
+static int ON_SIMD_GetPointListBoundingBox( int dim, int is_rat, int count, int stride, const T* points,
+                                            double* boxmin, double* boxmax )
+{
+  const int level = ON_SIMDLevel();
+  if ( level < 1 || count < 1 || 0 == points || 0 == boxmin || 0 == boxmax )
+    return 0;
+
+  if ( is_rat )
+  {
+    if ( 3 != dim || stride < 4 )
+      return 0;
+#if defined(ON_AVX)
+    if ( level >= 2 )
+      return ON_SIMD_RatBBox_AVX(count,stride,points,boxmin,boxmax);
+#endif
+    return ON_SIMD_RatBBox_SSE2(count,stride,points,boxmin,boxmax);
+  }
+
+  if ( dim > 3 )
+    dim = 3;
+  if ( dim < 1 || stride < dim || stride > 4 )
+    return 0;
+#if defined(ON_AVX)
+  if ( level >= 2 )
+    return ON_SIMD_BBox_AVX(dim,count,stride,points,boxmin,boxmax);
+#endif
+  return ON_SIMD_BBox_SSE2(dim,count,stride,points,boxmin,boxmax);
+}
+
+template <class T>
+static int ON_SIMD_TransformPointList( int dim, int is_rat, int count, int stride, 
+                                       const T* points, T* transformed_points,
+                                       const ON_Xform& xform, 
+                                       double* boxmin, double* boxmax )
+{
+  const int level = ON_SIMDLevel();
+  if ( level < 1 || count < 1 || 0 == points )
+    return 0;
+  if ( is_rat ? (3 != dim || stride < 4) : (dim < 3 || stride < dim) )
+    return 0;
+  if ( 0 == boxmin || 0 == boxmax )
+    boxmin = boxmax = 0;
+  is_rat = is_rat ? 1 : 0;
+#if defined(ON_AVX)
+  if ( level >= 2 )
+    return ON_SIMD_Xform_AVX(is_rat,count,stride,points,transformed_points,xform,boxmin,boxmax);
+#endif
+  return ON_SIMD_Xform_SSE2(is_rat,count,stride,points,transformed_points,xform,boxmin,boxmax);
+}
+
+#endif
+
+int ON_SIMDGetPointListBoundingBox( int dim, int is_rat, int count, int stride, 
+                                    const double* points,
+                                    double* boxmin, double* boxmax )
+{
+#if defined(ON_SSE2)
+  return ON_SIMD_GetPointListBoundingBox(dim,is_rat,count,stride,points,boxmin,boxmax);
+#else
+  return 0;
+#endif
+}
+
+int ON_SIMDGetPointListBoundingBox( int dim, int is_rat, int count, int stride, 
+                                    const float* points,
+                                    double* boxmin, double* boxmax )
+{
+#if defined(ON_SSE2)
+  return ON_SIMD_GetPointListBoundingBox(dim,is_rat,count,stride,points,boxmin,boxmax);
+#else
+  return 0;
+#endif
+}
+
+int ON_SIMDTransformPointList( int dim, int is_rat, int count, int stride, 
+                               const double* points, double* transformed_points,
+                               const ON_Xform& xform,
+                               double* boxmin, double* boxmax )
+{
+#if defined(ON_SSE2)
+  return ON_SIMD_TransformPointList(dim,is_rat,count,stride,points,transformed_points,xform,boxmin,boxmax);
+#else
+  return 0;
+#endif
+}
+
+int ON_SIMDTransformPointList( int dim, int is_rat, int count, int stride, 
+                               const float* points, float* transformed_points,
+                               const ON_Xform& xform,
+                               double* boxmin, double* boxmax )
+{
+#if defined(ON_SSE2)
+  return ON_SIMD_TransformPointList(dim,is_rat,count,stride,points,transformed_points,xform,boxmin,boxmax);
+#else
+  return 0;
+#endif
+}
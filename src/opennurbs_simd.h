@@ -0,0 +1,143 @@
+/* $NoKeywords: $ */
+/*
+//
+// Copyright (c) 1993-2007 Robert McNeel & Associates. All rights reserved.
+// Rhinoceros is a registered trademark of Robert McNeel & Assoicates.
+//
+// THIS SOFTWARE IS PROVIDED "AS IS" WITHOUT EXPRESS OR IMPLIED WARRANTY.
+// ALL IMPLIED WARRANTIES OF FITNESS FOR ANY PARTICULAR PURPOSE AND OF
+// MERCHANTABILITY ARE HEREBY DISCLAIMED.
+//				
+// For complete openNURBS copyright information see <http://www.opennurbs.org>.
+//
+////////////////////////////////////////////////////////////////
+*/
+
+#if !defined(OPENNURBS_SIMD_INC_)
+#define OPENNURBS_SIMD_INC_
+
+/*
+Returns:
+  Instruction set used by the point list kernels below:
+    0 = portable C++ loops
+    1 = SSE2
+    2 = AVX
+  The first call checks what the processor supports.
+*/
+ON_DECL
+int ON_SIMDLevel();
+
+/*
+Description:
+  Limits the instruction set used by the point list kernels.
+Parameters:
+  level - [in]
+    0 = portable C++ loops, 1 = at most SSE2, 2 = at most AVX.
+Returns:
+  The level that will be used. It is never more than the 
+  processor supports.
+Remarks:
+  Intended for testing and timing. Call it before other
+  threads use the kernels.
+*/
+ON_DECL
+int ON_SetSIMDLevel( int level );
+
+/*
+Description:
+  Grows a bounding box to contain a leading part of a point 
+  list. ON_GetPointListBoundingBox() calls this function and
+  finishes the rest of the list with its own loop.
+Parameters:
+  dim - [in] >= 1
+  is_rat - [in] true if points are homogeneous rational
+  count - [in] number of points
+  stride - [in] >= (is_rat) ? dim+1 : dim
+  points - [in]
+  boxmin - [in/out] array of min(dim,3) doubles
+  boxmax - [in/out] array of min(dim,3) doubles
+    The box must be valid on input. 
+Returns:
+  Number of leading points that were added to the box. 
+  0 when no kernel handles this kind of point list. 
+  Homogeneous points are handled up to the first point
+  with a zero weight. Coordinates that are NaNs are ignored.
+*/
+ON_DECL
+int ON_SIMDGetPointListBoundingBox(
+        int dim,
+        int is_rat,
+        int count,
+        int stride,
+        const double* points,
+        double* boxmin,
+        double* boxmax
+        );
+
+ON_DECL
+int ON_SIMDGetPointListBoundingBox(
+        int dim,
+        int is_rat,
+        int count,
+        int stride,
+        const float* points,
+        double* boxmin,
+        double* boxmax
+        );
+
+/*
+Description:
+  Transforms a leading part of a 3d point list.
+  ON_TransformPointList() calls this function and finishes
+  the rest of the list with its own loop.
+Parameters:
+  dim - [in] >= 3
+  is_rat - [in] true if points are homogeneous rational
+  count - [in] number of points
+  stride - [in] >= (is_rat) ? dim+1 : dim
+  points - [in]
+  transformed_points - [out]
+    Transformed points are saved here. It may be the same
+    as points or NULL when only the bounding box is wanted.
+  xform - [in]
+  boxmin - [in/out]
+  boxmax - [in/out]
+    If not NULL, the box is grown to contain the euclidean
+    locations of the transformed points. The box must be 
+    valid on input, or have boxmin[] = ON_DBL_PINF and
+    boxmax[] = -ON_DBL_PINF.
+Returns:
+  Number of leading points that were transformed.
+  0 when no kernel handles this kind of point list. 
+  The results are identical to the portable loops in
+  ON_TransformPointList() and ON_3dPoint::Transform().
+  A kernel stops at a point with a zero weight so that the
+  caller can handle it.
+*/
+ON_DECL
+int ON_SIMDTransformPointList(
+        int dim,
+        int is_rat,
+        int count,
+        int stride,
+        const double* points,
+        double* transformed_points,
+        const ON_Xform& xform,
+        double* boxmin,
+        double* boxmax
+        );
+
+ON_DECL
+int ON_SIMDTransformPointList(
+        int dim,
+        int is_rat,
+        int count,
+        int stride,
+        const float* points,
+        float* transformed_points,
+        const ON_Xform& xform,
+        double* boxmin,
+        double* boxmax
+        );
+
+#endif
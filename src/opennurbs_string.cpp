@@ -110,8 +110,11 @@ void ON_String::CreateArray( int capacity )
 {
   Destroy();
   if ( capacity > 0 ) {
+    ON_MemorySubsystemScope ms(ON_MEMORY_SUBSYSTEM_STRING);
+    // Strings are shared by reference counting and copies can
+    // outlive the current memory pool, so they use the heap.
 		ON_aStringHeader* p =
-			(ON_aStringHeader*)onmalloc( sizeof(ON_aStringHeader) + (capacity+1)*sizeof(*m_s) );
+			(ON_aStringHeader*)onmalloc_from_pool( 0, sizeof(ON_aStringHeader) + (capacity+1)*sizeof(*m_s) );
 		p->ref_count = 1;
 		p->string_length = 0;
 		p->string_capacity = capacity;
@@ -119,6 +119,33 @@ public:
   // override ON_Object::ObjectType() - returns ON::surface_object
   ON::object_type ObjectType() const;
 
+  /*
+	Description:
+    Get tight bounding box of the surface.
+	Parameters:
+		tight_bbox - [in/out] tight bounding box
+		bGrowBox -[in]	(default=false)			
+      If true and the input tight_bbox is valid, then returned
+      tight_bbox is the union of the input tight_bbox and the 
+      surface's tight bounding box.
+		xform -[in] (default=NULL)
+      If not NULL, the tight bounding box of the transformed
+      surface is calculated.  The surface is not modified.
+	Returns:
+    True if the returned tight_bbox is set to a valid 
+    bounding box.
+  Remarks:
+    Overrides virtual ON_Geometry::GetTightBoundingBox.
+    This implementation uses the NURBS form of the surface.
+  See Also:
+    ON_NurbsSurface::GetTightBoundingBox
+  */
+	bool GetTightBoundingBox( 
+			ON_BoundingBox& tight_bbox, 
+      int bGrowBox = false,
+			const ON_Xform* xform = 0
+      ) const;
+
 
   /////////////////////////////
   //
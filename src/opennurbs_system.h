@@ -276,6 +276,52 @@
 #define ON_MSC_CDECL
 #endif
 
+/*
+// Thread support used by the opennurbs core.
+//
+// ON_THREAD_LOCAL
+//   Declares a static variable that has a separate instance in
+//   each thread.  The variable must be a plain old data type.
+//
+// ON_ATOMIC_INCREMENT(p)
+//   Atomically increments the int *p and returns the new value.
+//
+// ON_ATOMIC_DECREMENT(p)
+//   Atomically decrements the int *p and returns the new value.
+//
+// ON_ATOMIC_COMPARE_AND_SWAP(p,oldval,newval)
+//   Atomically sets the int *p to newval if *p is oldval and
+//   returns the value *p had before the call.
+//
+// If ON_THREAD_SUPPORT is not defined, these fall back to 
+// plain code and the opennurbs core cannot be used from more
+// than one thread.  See the "Threads" section in faq.txt.
+*/
+#if defined(ON_COMPILER_MSC)
+
+#define ON_THREAD_SUPPORT
+#define ON_THREAD_LOCAL __declspec(thread)
+#define ON_ATOMIC_INCREMENT(p) ((int)InterlockedIncrement((volatile LONG*)(p)))
+#define ON_ATOMIC_DECREMENT(p) ((int)InterlockedDecrement((volatile LONG*)(p)))
+#define ON_ATOMIC_COMPARE_AND_SWAP(p,oldval,newval) ((int)InterlockedCompareExchange((volatile LONG*)(p),(LONG)(newval),(LONG)(oldval)))
+
+#elif defined(ON_COMPILER_GNU)
+
+#define ON_THREAD_SUPPORT
+#define ON_THREAD_LOCAL __thread
+#define ON_ATOMIC_INCREMENT(p) __sync_add_and_fetch((p),1)
+#define ON_ATOMIC_DECREMENT(p) __sync_sub_and_fetch((p),1)
+#define ON_ATOMIC_COMPARE_AND_SWAP(p,oldval,newval) __sync_val_compare_and_swap((p),(oldval),(newval))
+
+#else
+
+#define ON_THREAD_LOCAL
+#define ON_ATOMIC_INCREMENT(p) (++(*(p)))
+#define ON_ATOMIC_DECREMENT(p) (--(*(p)))
+#define ON_ATOMIC_COMPARE_AND_SWAP(p,oldval,newval) ((*(p) == (oldval)) ? ((*(p) = (newval)),(oldval)) : *(p))
+
+#endif
+
 #if !defined(ON_OS_WINDOWS)
 
 /* define wchar_t, true, false, NULL */
@@ -504,6 +504,126 @@ ON_UserData* ON_UnknownUserData::Convert() const
   return ud;
 }
 
+ON_OBJECT_IMPLEMENT(ON_DeferredUserData,ON_UserData,"3A1F64C2-7B52-4E0D-9C38-5D0E1B7A2F91");
+
+ON_DeferredUserData::ON_DeferredUserData() 
+: m_deferredclass_uuid(ON_nil_uuid)
+, m_deferredapp_uuid(ON_nil_uuid)
+, m_3dm_version(0)
+, m_3dm_opennurbs_version(0)
+, m_offset(0)
+, m_length(0)
+, m_reader(0)
+{}
+
+ON_DeferredUserData::ON_DeferredUserData(const ON_DeferredUserData& src) 
+: ON_UserData(src)
+, m_deferredclass_uuid(src.m_deferredclass_uuid)
+, m_deferredapp_uuid(src.m_deferredapp_uuid)
+, m_3dm_version(src.m_3dm_version)
+, m_3dm_opennurbs_version(src.m_3dm_opennurbs_version)
+, m_offset(src.m_offset)
+, m_length(src.m_length)
+, m_reader(0)
+{
+  SetReader(src.m_reader);
+}
+
+ON_DeferredUserData& ON_DeferredUserData::operator=(const ON_DeferredUserData& src)
+{
+  if ( this != &src ) 
+  {
+    ON_UserData::operator=(src);
+    // Like ON_UnknownUserData, the user data and application
+    // ids come from the class that has not been read.
+    m_userdata_uuid = src.m_userdata_uuid;
+    m_application_uuid = src.m_application_uuid;
+    m_deferredclass_uuid = src.m_deferredclass_uuid;
+    m_deferredapp_uuid = src.m_deferredapp_uuid;
+    m_3dm_version = src.m_3dm_version;
+    m_3dm_opennurbs_version = src.m_3dm_opennurbs_version;
+    m_offset = src.m_offset;
+    m_length = src.m_length;
+    SetReader(src.m_reader);
+  }
+  return *this;
+}
+
+ON_DeferredUserData::~ON_DeferredUserData()
+{
+  SetReader(0);
+}
+
+void ON_DeferredUserData::SetReader( ON_3dmDeferredReader* reader )
+{
+  if ( reader )
+    reader->AddRef();
+  if ( m_reader )
+    m_reader->Release();
+  m_reader = reader;
+}
+
+ON_3dmDeferredReader* ON_DeferredUserData::Reader() const
+{
+  return m_reader;
+}
+
+unsigned int ON_DeferredUserData::SizeOf() const
+{
+  return ON_UserData::SizeOf() 
+    + (sizeof(ON_DeferredUserData)-sizeof(ON_UserData));
+}
+
+ON_BOOL32 ON_DeferredUserData::GetDescription( ON_wString& s )
+{
+  s = "Deferred user data. (The user data has not been read from the file yet.)";
+  return true;
+}
+
+ON_BOOL32 ON_DeferredUserData::IsValid( ON_TextLog* text_log ) const
+{
+  ON_BOOL32 rc = ON_UserData::IsValid(text_log);
+  if (rc)
+    rc = ( 0 != m_reader && m_length > 0 );
+  if (rc)
+    rc = ON_UuidCompare( &m_deferredclass_uuid, &ON_nil_uuid );
+  return rc?true:false;
+}
+
+void ON_DeferredUserData::Dump( ON_TextLog& dump ) const
+{
+  ON_UserData::Dump(dump);
+  dump.PushIndent();
+  dump.Print( "deferred class uuid: ");
+  dump.Print( m_deferredclass_uuid );
+  dump.Print( "\n");
+  dump.Print( "Data size in 3dm archive: %d bytes\n",(int)m_length);
+  dump.PopIndent();
+}
+
+ON_BOOL32 ON_DeferredUserData::Archive() const
+{
+  // The placeholder is replaced with the real user data
+  // before an object is written.
+  return false;
+}
+
+ON_UserData* ON_DeferredUserData::Convert() const
+{
+  ON_UserData* ud = 0;
+  if ( 0 != m_reader && 0 != Owner() )
+  {
+    ud = m_reader->ReadUserData(*this,*Owner());
+    if ( ud )
+    {
+      // copy values that may have changed since the placeholder was read
+      ud->m_userdata_copycount = m_userdata_copycount;
+      ud->m_userdata_xform = m_userdata_xform;
+    }
+  }
+  return ud;
+}
+
 bool ON_UserDataHolder::MoveUserDataFrom( const ON_Object& source_object )
 {
   PurgeUserData();
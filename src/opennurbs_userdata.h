@@ -182,6 +182,8 @@ private: // don't look and don't touch - these may change
   friend bool ON_BinaryArchive::WriteObject( const ON_Object& );
   friend bool ON_BinaryArchive::ReadObjectUserData( ON_Object& );
   friend bool ON_BinaryArchive::WriteObjectUserData( const ON_Object& );
+  // ReadObjectUserDataHelper() sets m_userdata_owner for deferred reads
+  friend class ON_BinaryArchive;
   friend class ON_Object;
   ON_Object* m_userdata_owner; 
   ON_UserData* m_userdata_next;
@@ -260,6 +262,61 @@ public:
   int m_3dm_opennurbs_version; // 0 or YYYYMMDDN
 };
 
+class ON_CLASS ON_DeferredUserData : public ON_UserData
+{
+  ON_OBJECT_DECLARE(ON_DeferredUserData)
+  // Used to hold the place of user data that has not been read
+  // from a file yet.  See ON_3dmDeferredReader::m_bDeferUserData.
+  // ON_Object::GetUserData() and ON_Object::FirstUserData() 
+  // replace the placeholder with the real user data.
+public:
+  ON_DeferredUserData();
+  ON_DeferredUserData(const ON_DeferredUserData&);
+  ~ON_DeferredUserData();
+  ON_DeferredUserData& operator=(const ON_DeferredUserData&);
+
+  // ON_Object overrides
+  ON_BOOL32 IsValid( ON_TextLog* text_log = NULL ) const;
+  void Dump( ON_TextLog& ) const;
+  unsigned int SizeOf() const;
+
+  // ON_UserData overrides
+  ON_BOOL32 GetDescription( ON_wString& );
+  ON_BOOL32 Archive() const; 
+
+  /*
+  Description:
+    Reads the user data this placeholder stands for.
+  Returns:
+    The user data or NULL if it cannot be read.  The caller 
+    replaces the placeholder with it.
+  */
+  ON_UserData* Convert() const;
+
+  /*
+  Description:
+    Sets the reader the user data is read from.
+  Parameters:
+    reader - [in] A reference is added.  NULL releases the
+                  current reader.
+  */
+  void SetReader( ON_3dmDeferredReader* reader );
+  ON_3dmDeferredReader* Reader() const;
+
+  // Information from the TCODE_OPENNURBS_CLASS_USERDATA chunk header.
+  ON_UUID m_deferredclass_uuid; // class of the user data
+  ON_UUID m_deferredapp_uuid;   // application id saved in the file
+  int m_3dm_version;
+  int m_3dm_opennurbs_version;
+
+  // Location and length of the TCODE_ANONYMOUS_CHUNK with the data.
+  ON__UINT64 m_offset;
+  ON__INT64 m_length;
+
+private:
+  ON_3dmDeferredReader* m_reader;
+};
+
 class ON_CLASS ON_UserStringList : public ON_UserData
 {
   ON_OBJECT_DECLARE(ON_UserStringList)
@@ -45,6 +45,7 @@ void* ON_Workspace::GetMemory( size_t size )
   void* p = NULL;
   if ( size > 0 ) 
   {
+    ON_MemorySubsystemScope ms(ON_MEMORY_SUBSYSTEM_WORKSPACE);
     struct MBLK* pBlk = (struct MBLK*)onmalloc(sizeof(*pBlk));
     if ( pBlk ) 
     {
@@ -154,8 +154,11 @@ void ON_wString::CreateArray( int capacity )
 {
   Destroy();
   if ( capacity > 0 ) {
+    ON_MemorySubsystemScope ms(ON_MEMORY_SUBSYSTEM_STRING);
+    // Strings are shared by reference counting and copies can
+    // outlive the current memory pool, so they use the heap.
 		ON_wStringHeader* p =
-			(ON_wStringHeader*)onmalloc( sizeof(ON_wStringHeader) + (capacity+1)*sizeof(*m_s) );
+			(ON_wStringHeader*)onmalloc_from_pool( 0, sizeof(ON_wStringHeader) + (capacity+1)*sizeof(*m_s) );
 		p->ref_count = 1;
 		p->string_length = 0;
 		p->string_capacity = capacity;
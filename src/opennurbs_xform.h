@@ -1345,10 +1345,65 @@ public:
           bool bPreserveStructure
           );
 
+  /*
+  Returns:
+    Maximum number of threads MorphPointList() uses.
+    If ThreadCount() <= 0, ON_ProcessorCount() threads 
+    are used.
+  Remarks:
+    The default is 1 and the points are morphed in the 
+    calling thread.
+  */
+  int ThreadCount() const;
+
+  /*
+  Description:
+    Set the maximum number of threads MorphPointList() uses.
+  Parameters:
+    thread_count - [in] See ON_ParallelFor().
+  Remarks:
+    Long point lists are split into ranges that are morphed
+    at the same time, so only set a value other than 1 when
+    MorphPoint(), MorphPoints() and IsIdentity() are safe to
+    call from several threads at once.  ON_BezierCageMorph
+    meets this requirement.  Mesh, point cloud, NURBS and
+    brep morphing all go through MorphPointList().
+  */
+  void SetThreadCount( 
+          int thread_count
+          );
+
+  /*
+  Description:
+    Morphs an array of euclidean points.
+  Parameters:
+    count - [in] number of points
+    points - [in/out] points to morph
+  Remarks:
+    The default calls MorphPoint() for each point.
+    MorphPointList() passes blocks of non-rational points
+    to this function.  Override it when many points can be
+    morphed more efficiently together than one at a time.
+    The override must give the same results as MorphPoint().
+    This is the last virtual function of ON_SpaceMorph, so
+    the vtable slots of the older functions did not move when
+    it was added, but classes derived from ON_SpaceMorph must
+    be recompiled.
+  */
+  virtual
+  void MorphPoints(
+          int count,
+          ON_3dPoint* points
+          ) const;
+
 private:
   double m_tolerance;
   bool m_bQuickPreview;
   bool m_bPreserveStructure;
+  // On 64-bit platforms m_thread_count fits in the padding after
+  // the bools and sizeof(ON_SpaceMorph) did not change when it
+  // was added.
+  int m_thread_count;
 };
 
 #if defined(ON_DLL_TEMPLATE)
@@ -24,7 +24,10 @@
 
 voidpf zcalloc (voidpf, unsigned items, unsigned size)
 {
-    return oncalloc(items, size);
+    // zlib's working memory is freed as soon as a buffer is
+    // inflated or deflated, so it comes from the heap even
+    // when a memory pool is current.
+    return oncalloc_from_pool(0, items, size);
 }
 
 void  zcfree (voidpf, voidpf ptr)